@@ -12496,6 +12496,75 @@ void CGUIInfoManager::ResetCache()
   ++m_refreshCounter;
 }
 
+void CGUIInfoManager::ResetSkinSettingsCache()
+{
+  // Called from JSON-RPC and builtins, while the GUI thread reads the counter without a lock
+  m_skinSettingsRefreshCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
+const std::atomic<unsigned int>& CGUIInfoManager::GetRefreshCounter(INFO::InfoDependency dependency) const
+{
+  switch (dependency)
+  {
+    case INFO::InfoDependency::NONE:
+      return m_constantRefreshCounter;
+    case INFO::InfoDependency::SKIN_SETTINGS:
+      return m_skinSettingsRefreshCounter;
+    case INFO::InfoDependency::FRAME:
+    default:
+      return m_refreshCounter;
+  }
+}
+
+INFO::InfoDependency CGUIInfoManager::GetBoolDependency(int condition) const
+{
+  condition = std::abs(condition);
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END)
+  {
+    if (condition - MULTI_INFO_START >= static_cast<int>(m_multiInfo.size()))
+      return INFO::InfoDependency::FRAME;
+
+    switch (std::abs(m_multiInfo[condition - MULTI_INFO_START].GetInfo()))
+    {
+      case SKIN_BOOL:
+      case SKIN_STRING:
+      case SKIN_STRING_IS_EQUAL:
+        return INFO::InfoDependency::SKIN_SETTINGS;
+      default:
+        return INFO::InfoDependency::FRAME;
+    }
+  }
+
+  switch (condition)
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+    case SYSTEM_PLATFORM_LINUX:
+    case SYSTEM_PLATFORM_WINDOWS:
+    case SYSTEM_PLATFORM_UWP:
+    case SYSTEM_PLATFORM_DARWIN:
+    case SYSTEM_PLATFORM_DARWIN_OSX:
+    case SYSTEM_PLATFORM_DARWIN_IOS:
+    case SYSTEM_PLATFORM_DARWIN_TVOS:
+    case SYSTEM_PLATFORM_ANDROID:
+    case SYSTEM_PLATFORM_WEBOS:
+      return INFO::InfoDependency::NONE;
+    default:
+      return INFO::InfoDependency::FRAME;
+  }
+}
+
+void CGUIInfoManager::ResetBoolUpdates()
+{
+  m_lastFrameBoolUpdates = m_boolUpdates.exchange(0, std::memory_order_relaxed);
+}
+
+std::pair<unsigned int, size_t> CGUIInfoManager::GetBoolUpdates()
+{
+  std::unique_lock lock(m_critInfo);
+  return {m_lastFrameBoolUpdates, m_bools.size()};
+}
+
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag& tag)
 {
   m_currentFile->SetFromVideoInfoTag(tag);
@@ -14,11 +14,13 @@
 #include "messaging/IMessageTarget.h"
 #include "threads/CriticalSection.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 class CFileItem;
@@ -59,6 +61,34 @@ public:
   void Clear();
   void ResetCache();
 
+  /*! \brief Mark the conditions on skin settings as dirty, to call when a skin setting changes
+   */
+  void ResetSkinSettingsCache();
+
+  /*! \brief Get the counter the info bools with the given dependency are refreshed on
+   \sa INFO::InfoBool::SetDependency
+   */
+  const std::atomic<unsigned int>& GetRefreshCounter(INFO::InfoDependency dependency) const;
+
+  /*! \brief Get what the value of a single condition depends on
+   \param condition the condition, as returned from TranslateSingleString
+   */
+  INFO::InfoDependency GetBoolDependency(int condition) const;
+
+  /*! \brief Count an update of a registered condition or expression
+   \sa GetBoolUpdates
+   */
+  void CountBoolUpdate() { m_boolUpdates.fetch_add(1, std::memory_order_relaxed); }
+
+  /*! \brief Start counting the updates of the conditions for a new frame
+   */
+  void ResetBoolUpdates();
+
+  /*! \brief Get the number of conditions and expressions updated in the last frame, and the
+   number registered, for the skin debug info
+   */
+  std::pair<unsigned int, size_t> GetBoolUpdates();
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
@@ -243,7 +273,12 @@ private:
   }
 
   INFOBOOLTYPE m_bools{&CGUIInfoManager::InfoBoolComparator};
-  unsigned int m_refreshCounter = 0;
+  std::atomic<unsigned int> m_refreshCounter{0};
+  // start at 1, as info bools are always updated while their counter is 0
+  std::atomic<unsigned int> m_skinSettingsRefreshCounter{1};
+  const std::atomic<unsigned int> m_constantRefreshCounter{1};
+  std::atomic<unsigned int> m_boolUpdates{0};
+  unsigned int m_lastFrameBoolUpdates = 0;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
@@ -512,6 +512,22 @@ std::shared_ptr<XFILE::CBlurayDiscCache> CServiceBroker::GetBlurayDiscCache()
   return g_serviceBroker.m_blurayDiscCache;
 }
 
+void CServiceBroker::RegisterVideoLibraryIndex(
+    const std::shared_ptr<KODI::VIDEO::CVideoLibraryIndex>& index)
+{
+  g_serviceBroker.m_videoLibraryIndex = index;
+}
+
+void CServiceBroker::UnregisterVideoLibraryIndex()
+{
+  g_serviceBroker.m_videoLibraryIndex.reset();
+}
+
+std::shared_ptr<KODI::VIDEO::CVideoLibraryIndex> CServiceBroker::GetVideoLibraryIndex()
+{
+  return g_serviceBroker.m_videoLibraryIndex;
+}
+
 XFILE::CIPFSService& CServiceBroker::GetIPFSService()
 {
   return g_application.m_ServiceManager->GetIPFSService();
@@ -146,6 +146,11 @@ namespace KODI::UTILS::I18N
 class CSubTagRegistryManager;
 }
 
+namespace KODI::VIDEO
+{
+class CVideoLibraryIndex;
+}
+
 class CServiceBroker
 {
 public:
@@ -269,6 +274,11 @@ public:
   static void RegisterBlurayDiscCache(const std::shared_ptr<XFILE::CBlurayDiscCache>& cache);
   static void UnregisterBlurayDiscCache();
   static std::shared_ptr<XFILE::CBlurayDiscCache> GetBlurayDiscCache();
+
+  static void RegisterVideoLibraryIndex(
+      const std::shared_ptr<KODI::VIDEO::CVideoLibraryIndex>& index);
+  static void UnregisterVideoLibraryIndex();
+  static std::shared_ptr<KODI::VIDEO::CVideoLibraryIndex> GetVideoLibraryIndex();
   static XFILE::CIPFSService& GetIPFSService();
 
   static KODI::RETRO_ENGINE::CRetroEngineServices& GetRetroEngineServices();
@@ -294,6 +304,7 @@ private:
   std::shared_ptr<CSlideShowDelegator> m_slideshowDelegator;
   std::shared_ptr<CDNSNameCache> m_dnsNameCache;
   std::shared_ptr<XFILE::CBlurayDiscCache> m_blurayDiscCache;
+  std::shared_ptr<KODI::VIDEO::CVideoLibraryIndex> m_videoLibraryIndex;
 };
 
 XBMC_GLOBAL_REF(CServiceBroker, g_serviceBroker);
@@ -10,6 +10,7 @@
 
 #include "FileItem.h"
 #include "FileItemList.h"
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "addons/addoninfo/AddonType.h"
@@ -64,6 +65,14 @@ constexpr const char* XML_ATTR_ID = "id";
 
 constexpr auto DELAY = 500ms;
 
+void ResetSkinSettingsCache()
+{
+  // the conditions on skin settings are only updated when one of them changes
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().ResetSkinSettingsCache();
+}
+
 } // unnamed namespace
 
 namespace ADDON
@@ -709,6 +718,7 @@ void CSkinInfo::SetString(int setting, std::string_view label)
   {
     it->second->value = label;
     m_settingsUpdateHandler->TriggerSave();
+    ResetSkinSettingsCache();
     return;
   }
 
@@ -753,6 +763,7 @@ void CSkinInfo::SetBool(int setting, bool set)
   {
     it->second->value = set;
     m_settingsUpdateHandler->TriggerSave();
+    ResetSkinSettingsCache();
     return;
   }
 
@@ -797,6 +808,7 @@ void CSkinInfo::Reset(const std::string &setting)
     {
       settingstring->value.clear();
       m_settingsUpdateHandler->TriggerSave();
+      ResetSkinSettingsCache();
       return;
     }
   }
@@ -808,6 +820,7 @@ void CSkinInfo::Reset(const std::string &setting)
     {
       settingbool->value = false;
       m_settingsUpdateHandler->TriggerSave();
+      ResetSkinSettingsCache();
       return;
     }
   }
@@ -823,6 +836,7 @@ void CSkinInfo::Reset()
     settingstring->value.clear();
 
   m_settingsUpdateHandler->TriggerSave();
+  ResetSkinSettingsCache();
 }
 
 std::set<CSkinSettingPtr> CSkinInfo::ParseSettings(const TiXmlElement* rootElement)
@@ -906,6 +920,7 @@ bool CSkinInfo::SettingsFromXML(const CXBMCTinyXML& doc,
                 setting->GetType());
   }
 
+  ResetSkinSettingsCache();
   return true;
 }
 
@@ -150,6 +150,7 @@
 #include "utils/Variant.h"
 #include "utils/log.h"
 #include "video/PlayerController.h"
+#include "video/VideoLibraryIndex.h"
 #include "video/VideoLibraryQueue.h"
 #include "video/dialogs/GUIDialogVideoBookmarks.h"
 #ifdef TARGET_WINDOWS
@@ -362,6 +363,8 @@ bool CApplication::Create()
   CServiceBroker::RegisterBlurayDiscCache(std::make_shared<CBlurayDiscCache>());
 #endif
 
+  CServiceBroker::RegisterVideoLibraryIndex(std::make_shared<VIDEO::CVideoLibraryIndex>());
+
   if (!m_ServiceManager->InitStageTwo(
           settingsComponent->GetProfileManager()->GetProfileUserDataFolder()))
   {
@@ -962,6 +965,7 @@ void CApplication::Render()
   // isn't called)
   CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
   infoMgr.ResetCache();
+  infoMgr.ResetBoolUpdates();
   infoMgr.GetInfoProviders().GetGUIControlsInfoProvider().ResetContainerMovingCache();
 
   if (hasRendered)
@@ -1710,6 +1714,8 @@ bool CApplication::Cleanup()
     CServiceBroker::UnregisterBlurayDiscCache();
 #endif
 
+    CServiceBroker::UnregisterVideoLibraryIndex();
+
     CServiceBroker::UnregisterSpeechRecognition();
 
     CLog::Log(LOGINFO, "unload skin");
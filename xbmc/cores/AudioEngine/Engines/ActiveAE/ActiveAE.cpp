@@ -42,6 +42,7 @@ constexpr float MIN_WATER_LEVEL = 0.02f; // min buffer time to prevent underrun
 constexpr float MIN_WATER_LEVEL_RESAMPLE = 0.1f; // min buffer time in resample mode
 constexpr float BUFFER_LEVEL_INCREMENT = 0.0001f; // increment step for ramp-up
 constexpr double MAX_BUFFER_TIME = 0.1; // max time of a buffer in seconds;
+constexpr auto BUFFER_STATS_INTERVAL = 10s; // interval of buffer statistics in audio debug log
 
 bool IsDefaultDevice(const AESinkDevice& device)
 {
@@ -290,7 +291,8 @@ CActiveAE::CActiveAE() :
   CThread("ActiveAE"),
   m_controlPort("OutputControlPort", &m_inMsgEvent, &m_outMsgEvent),
   m_dataPort("OutputDataPort", &m_inMsgEvent, &m_outMsgEvent),
-  m_sink(&m_outMsgEvent)
+  m_sink(&m_outMsgEvent),
+  m_mixKernels(GetAEMixKernels())
 {
   m_volume = 1.0;
   m_volumeScaled = 1.0;
@@ -1454,6 +1456,16 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     m_sinkBuffers->Create(MAX_WATER_LEVEL*1000, true, false);
   }
 
+  // preallocate the resample and atempo stages of a stream in the internal
+  // format, so that opening or reconfiguring streams doesn't allocate
+  if (m_internalFormat.m_dataFormat != AE_FMT_RAW)
+  {
+    const unsigned int count =
+        CActiveAEBufferPool::GetBufferCount(m_internalFormat, MAX_CACHE_LEVEL * 1000);
+    CActiveAEBufferPool::GetArena().Reserve(CActiveAEBufferPool::GetSampleConfig(m_internalFormat),
+                                            m_internalFormat.m_frames, 2 * count);
+  }
+
   ConfigureLowLatency();
 
   // reset gui sounds
@@ -1643,6 +1655,43 @@ void CActiveAE::ClearDiscardedBuffers()
   }
 }
 
+void CActiveAE::LogBufferStats()
+{
+  const auto logPool = [](const std::string& stage, CActiveAEBufferPool* pool)
+  {
+    if (!pool)
+      return;
+
+    const CActiveAEBufferPool::Stats stats = pool->GetStats();
+    CLog::Log(LOGDEBUG, LOGAUDIO,
+              "CActiveAE::LogBufferStats - {}: {}/{} buffers in use, max {}, held {:.1f} ms "
+              "average, {:.1f} ms max",
+              stage, stats.inUse, stats.buffers, stats.highWaterMark, stats.averageHoldMs,
+              stats.maxHoldMs);
+    pool->ResetStats();
+  };
+
+  for (CActiveAEStream* stream : m_streams)
+  {
+    const std::string name = StringUtils::Format("stream {}", stream->m_id);
+    logPool(name + " input", stream->m_inputBuffers.get());
+    if (stream->m_processingBuffers)
+    {
+      CLog::Log(LOGDEBUG, LOGAUDIO, "CActiveAE::LogBufferStats - {}: {:.1f} ms in processing",
+                name, stream->m_processingBuffers->GetDelay() * 1000);
+      logPool(name + " resample", stream->m_processingBuffers->GetResamplePool());
+      logPool(name + " atempo", stream->m_processingBuffers->GetAtempoPool());
+    }
+  }
+  logPool("sink", m_sinkBuffers.get());
+
+  const CActiveAEBufferArena::Stats arena = CActiveAEBufferPool::GetArena().GetStats();
+  CLog::Log(LOGDEBUG, LOGAUDIO,
+            "CActiveAE::LogBufferStats - arena: {} hits, {} misses, {} idle packets, {} of {} "
+            "bytes held",
+            arena.hits, arena.misses, arena.idlePackets, arena.bytesHeld, arena.capacity);
+}
+
 void CActiveAE::SStopSound(CActiveAESound *sound)
 {
   std::list<SoundState>::iterator it;
@@ -1971,6 +2020,9 @@ void CActiveAE::UnconfigureSink()
   m_openedDriver = "";
   m_currentDeviceFollowsDefault = false;
 
+  // next configuration reserves packets for its own format
+  CActiveAEBufferPool::GetArena().Clear();
+
   m_inMsgEvent.Reset();
 }
 
@@ -2198,38 +2250,21 @@ bool CActiveAE::RunStages()
               nb_loops = out->pkt->nb_samples;
             }
 
-            for(int i=0; i<nb_loops; i++)
+            if (nb_loops > 1 || (*it)->m_fadingSamples > 0)
             {
-              if ((*it)->m_fadingSamples > 0)
-              {
-                (*it)->m_volume += fadingStep;
-                (*it)->m_fadingSamples--;
-
-                if ((*it)->m_fadingSamples == 0)
-                {
-                  // set variables being polled via stream interface
-                  std::unique_lock lock((*it)->m_streamLock);
-                  (*it)->m_streamFading = false;
-                }
-              }
+              const float* gains = GetFrameGains(*it, *out->pkt, nb_loops, fadingStep);
 
+              for (int j = 0; j < out->pkt->planes; j++)
+                m_mixKernels.scaleFrames(reinterpret_cast<float*>(out->pkt->data[j]), gains,
+                                         nb_loops, nb_floats);
+            }
+            else
+            {
               // volume for stream
               float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)out->pkt->data, out->pkt->config.channels, i*nb_floats, out->pkt->planes > 1);
 
-              for(int j=0; j<out->pkt->planes; j++)
-              {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
-              }
+              for (int j = 0; j < out->pkt->planes; j++)
+                m_mixKernels.scale(reinterpret_cast<float*>(out->pkt->data[j]), volume, nb_floats);
             }
           }
           else
@@ -2265,50 +2300,35 @@ bool CActiveAE::RunStages()
               nb_loops = out->pkt->nb_samples;
             }
 
-            for(int i=0; i<nb_loops; i++)
+            float peak = 0.0f;
+            if (nb_loops > 1 || (*it)->m_fadingSamples > 0)
             {
-              if ((*it)->m_fadingSamples > 0)
+              nb_loops = std::min(nb_loops, mix->pkt->nb_samples);
+              const float* gains = GetFrameGains(*it, *mix->pkt, nb_loops, fadingStep);
+
+              for (int j = 0; j < out->pkt->planes && j < mix->pkt->planes; j++)
               {
-                (*it)->m_volume += fadingStep;
-                (*it)->m_fadingSamples--;
-
-                if ((*it)->m_fadingSamples == 0)
-                {
-                  // set variables being polled via stream interface
-                  std::unique_lock lock((*it)->m_streamLock);
-                  (*it)->m_streamFading = false;
-                }
+                float* dst = reinterpret_cast<float*>(out->pkt->data[j]);
+                const float* src = reinterpret_cast<const float*>(mix->pkt->data[j]);
+                peak = std::max(peak,
+                                m_mixKernels.mixAddFrames(dst, src, gains, nb_loops, nb_floats));
               }
-
+            }
+            else
+            {
               // volume for stream
               float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)mix->pkt->data, mix->pkt->config.channels, i*nb_floats, mix->pkt->planes > 1);
 
-              for(int j=0; j<out->pkt->planes && j<mix->pkt->planes; j++)
+              for (int j = 0; j < out->pkt->planes && j < mix->pkt->planes; j++)
               {
-                float *dst = (float*)out->pkt->data[j]+i*nb_floats;
-                float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                float* dst = reinterpret_cast<float*>(out->pkt->data[j]);
+                const float* src = reinterpret_cast<const float*>(mix->pkt->data[j]);
+                peak = std::max(peak, m_mixKernels.mixAdd(dst, src, volume, nb_floats));
               }
             }
+            if (peak > 1.0f)
+              needClamp = true;
+
             mix->Return();
           }
           busy = true;
@@ -2450,6 +2470,13 @@ bool CActiveAE::RunStages()
     busy = true;
   }
 
+  if (m_bufferStatsTimer.IsTimePast())
+  {
+    if (CServiceBroker::GetLogging().CanLogComponent(LOGAUDIO))
+      LogBufferStats();
+    m_bufferStatsTimer.Set(BUFFER_STATS_INTERVAL);
+  }
+
   return busy;
 }
 
@@ -2695,12 +2722,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      m_mixKernels.mixAdd(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2725,17 +2747,50 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      m_mixKernels.scale(buffer, volume, nb_floats);
     }
   }
 }
 
+const float* CActiveAE::GetFrameGains(CActiveAEStream* stream,
+                                      const CSoundPacket& pkt,
+                                      int frames,
+                                      float fadingStep)
+{
+  m_framePeaks.assign(frames, 0.0f);
+  m_frameGains.resize(frames);
+
+  // peaks feed the limiter, which needs the loudest sample of each frame
+  // across all planes
+  const int channels = pkt.config.channels / pkt.planes;
+  for (int j = 0; j < pkt.planes; j++)
+    m_mixKernels.framePeaks(m_framePeaks.data(), reinterpret_cast<const float*>(pkt.data[j]),
+                            frames, channels);
+
+  for (int i = 0; i < frames; i++)
+  {
+    if (stream->m_fadingSamples > 0)
+    {
+      stream->m_volume += fadingStep;
+      stream->m_fadingSamples--;
+
+      if (stream->m_fadingSamples == 0)
+      {
+        // set variables being polled via stream interface
+        std::unique_lock lock(stream->m_streamLock);
+        stream->m_streamFading = false;
+      }
+    }
+
+    // volume for stream
+    m_frameGains[i] = stream->m_volume * stream->m_rgain;
+  }
+
+  stream->m_limiter.Run(m_framePeaks.data(), m_frameGains.data(), frames);
+
+  return m_frameGains.data();
+}
+
 //-----------------------------------------------------------------------------
 // Configuration
 //-----------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 #include "cores/AudioEngine/Interfaces/AESound.h"
 #include "cores/AudioEngine/Interfaces/AEStream.h"
+#include "cores/AudioEngine/Utils/AEMixKernels.h"
 #include "guilib/DispResource.h"
 #include "threads/SystemClock.h"
 #include "threads/Thread.h"
@@ -326,6 +327,7 @@ protected:
   void SFlushStream(CActiveAEStream *stream);
   void FlushEngine();
   void ClearDiscardedBuffers();
+  void LogBufferStats();
   void SStopSound(CActiveAESound *sound);
   void DiscardSound(CActiveAESound *sound);
   void ChangeResamplers();
@@ -339,6 +341,10 @@ protected:
   bool ResampleSound(CActiveAESound *sound);
   void MixSounds(CSoundPacket &dstSample);
   void Deamplify(CSoundPacket &dstSample);
+  const float* GetFrameGains(CActiveAEStream* stream,
+                             const CSoundPacket& pkt,
+                             int frames,
+                             float fadingStep);
 
   bool CompareFormat(const AEAudioFormat& lhs, const AEAudioFormat& rhs);
 
@@ -392,6 +398,12 @@ protected:
   std::list<CActiveAEStream*> m_streams;
   std::list<std::unique_ptr<CActiveAEBufferPool>> m_discardBufferPools;
   unsigned int m_streamIdGen;
+  XbmcThreads::EndTime<> m_bufferStatsTimer;
+
+  // mixing
+  const AEMixKernels& m_mixKernels;
+  std::vector<float> m_framePeaks;
+  std::vector<float> m_frameGains;
 
   // gui sounds
   struct SoundState
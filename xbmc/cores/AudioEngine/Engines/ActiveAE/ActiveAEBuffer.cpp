@@ -13,7 +13,9 @@
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 
 using namespace ActiveAE;
 
@@ -57,11 +59,10 @@ CActiveAEBufferPool::CActiveAEBufferPool(const AEAudioFormat& format) : m_format
 
 CActiveAEBufferPool::~CActiveAEBufferPool()
 {
-  CSampleBuffer *buffer;
-  while(!m_allSamples.empty())
+  CActiveAEBufferArena& arena = GetArena();
+  for (CSampleBuffer* buffer : m_allSamples)
   {
-    buffer = m_allSamples.front();
-    m_allSamples.pop_front();
+    arena.Release(std::move(buffer->pkt));
     delete buffer;
   }
 }
@@ -70,12 +71,18 @@ CSampleBuffer* CActiveAEBufferPool::GetFreeBuffer()
 {
   CSampleBuffer* buf = NULL;
 
+  // hand out the most recently returned buffer, its samples are likely still cached
   if (!m_freeSamples.empty())
   {
-    buf = m_freeSamples.front();
-    m_freeSamples.pop_front();
+    buf = m_freeSamples.back();
+    m_freeSamples.pop_back();
     buf->refCount = 1;
     buf->centerMixLevel = M_SQRT1_2;
+    buf->acquireTime = std::chrono::steady_clock::now();
+
+    const unsigned int inUse = m_allSamples.size() - m_freeSamples.size();
+    if (inUse > m_highWaterMark)
+      m_highWaterMark = inUse;
   }
   return buf;
 }
@@ -85,39 +92,207 @@ void CActiveAEBufferPool::ReturnBuffer(CSampleBuffer *buffer)
   buffer->pkt->nb_samples = 0;
   buffer->pkt->pause_burst_ms = 0;
   m_freeSamples.push_back(buffer);
+
+  const auto holdTime = std::chrono::steady_clock::now() - buffer->acquireTime;
+  m_holdTime += holdTime;
+  if (holdTime > m_maxHoldTime)
+    m_maxHoldTime = holdTime;
+  m_returned++;
+}
+
+CActiveAEBufferPool::Stats CActiveAEBufferPool::GetStats() const
+{
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  Stats stats;
+  stats.buffers = m_allSamples.size();
+  stats.inUse = m_allSamples.size() - m_freeSamples.size();
+  stats.highWaterMark = m_highWaterMark;
+  stats.returned = m_returned;
+  if (m_returned > 0)
+    stats.averageHoldMs = Milliseconds(m_holdTime).count() / m_returned;
+  stats.maxHoldMs = Milliseconds(m_maxHoldTime).count();
+  return stats;
+}
+
+void CActiveAEBufferPool::ResetStats()
+{
+  m_highWaterMark = m_allSamples.size() - m_freeSamples.size();
+  m_returned = 0;
+  m_holdTime = {};
+  m_maxHoldTime = {};
 }
 
 bool CActiveAEBufferPool::Create(unsigned int totaltime)
 {
-  CSampleBuffer *buffer;
+  const SampleConfig config = GetSampleConfig(m_format);
+  const unsigned int count = GetBufferCount(m_format, totaltime);
+
+  m_allSamples.reserve(m_allSamples.size() + count);
+  m_freeSamples.reserve(m_freeSamples.size() + count);
+
+  CActiveAEBufferArena& arena = GetArena();
+  for (unsigned int n = 0; n < count; n++)
+  {
+    CSampleBuffer* buffer = new CSampleBuffer();
+    buffer->pool = this;
+    buffer->pkt = arena.Acquire(config, m_format.m_frames);
+
+    m_allSamples.push_back(buffer);
+    m_freeSamples.push_back(buffer);
+  }
+
+  return true;
+}
+
+CActiveAEBufferArena& CActiveAEBufferPool::GetArena()
+{
+  static CActiveAEBufferArena arena;
+  return arena;
+}
+
+SampleConfig CActiveAEBufferPool::GetSampleConfig(const AEAudioFormat& format)
+{
   SampleConfig config;
-  config.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
-  config.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
-  config.dither_bits = CAEUtil::DataFormatToDitherBits(m_format.m_dataFormat);
-  config.channels = m_format.m_channelLayout.Count();
-  config.sample_rate = m_format.m_sampleRate;
-  config.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
+  config.fmt = CAEUtil::GetAVSampleFormat(format.m_dataFormat);
+  config.bits_per_sample = CAEUtil::DataFormatToUsedBits(format.m_dataFormat);
+  config.dither_bits = CAEUtil::DataFormatToDitherBits(format.m_dataFormat);
+  config.channels = format.m_channelLayout.Count();
+  config.sample_rate = format.m_sampleRate;
+  config.channel_layout = CAEUtil::GetAVChannelLayout(format.m_channelLayout);
+  return config;
+}
 
-  unsigned int time = 0;
-  unsigned int buffertime = (m_format.m_frames*1000) / m_format.m_sampleRate;
-  if (m_format.m_dataFormat == AE_FMT_RAW)
+unsigned int CActiveAEBufferPool::GetBufferCount(const AEAudioFormat& format,
+                                                 unsigned int totaltime)
+{
+  unsigned int buffertime = (format.m_frames * 1000) / format.m_sampleRate;
+  if (format.m_dataFormat == AE_FMT_RAW)
   {
-    buffertime = m_format.m_streamInfo.GetDuration();
+    buffertime = format.m_streamInfo.GetDuration();
   }
+
+  unsigned int time = 0;
   unsigned int n = 0;
   while (time < totaltime || n < 5)
   {
-    buffer = new CSampleBuffer();
-    buffer->pool = this;
-    buffer->pkt = std::make_unique<CSoundPacket>(config, m_format.m_frames);
-
-    m_allSamples.push_back(buffer);
-    m_freeSamples.push_back(buffer);
     time += buffertime;
     n++;
   }
+  return n;
+}
 
-  return true;
+// ----------------------------------------------------------------------------------
+// Arena
+// ----------------------------------------------------------------------------------
+
+std::unique_ptr<CSoundPacket> CActiveAEBufferArena::Acquire(const SampleConfig& config,
+                                                            int samples)
+{
+  {
+    std::unique_lock lock(m_section);
+    auto it = m_packets.find(GetKey(config, samples));
+    if (it != m_packets.end() && !it->second.empty())
+    {
+      std::unique_ptr<CSoundPacket> pkt = std::move(it->second.back());
+      it->second.pop_back();
+      m_bytesHeld -= GetSize(*pkt);
+      m_hits++;
+
+      // layout, rate and bits don't affect the allocation
+      pkt->config = config;
+      pkt->nb_samples = 0;
+      pkt->pause_burst_ms = 0;
+      return pkt;
+    }
+    m_misses++;
+  }
+
+  return std::make_unique<CSoundPacket>(config, samples);
+}
+
+void CActiveAEBufferArena::Release(std::unique_ptr<CSoundPacket> pkt)
+{
+  if (!pkt || !pkt->data)
+    return;
+
+  std::unique_lock lock(m_section);
+  m_bytesHeld += GetSize(*pkt);
+  m_packets[GetKey(pkt->config, pkt->max_nb_samples)].push_back(std::move(pkt));
+  Trim();
+}
+
+void CActiveAEBufferArena::Reserve(const SampleConfig& config, int samples, unsigned int count)
+{
+  std::unique_lock lock(m_section);
+
+  m_reservedKey = GetKey(config, samples);
+  auto& packets = m_packets[m_reservedKey];
+  while (packets.size() < count)
+  {
+    packets.push_back(std::make_unique<CSoundPacket>(config, samples));
+    m_bytesHeld += GetSize(*packets.back());
+  }
+
+  if (!packets.empty())
+    m_capacity = std::max(DEFAULT_CAPACITY, 2 * count * GetSize(*packets.front()));
+
+  Trim();
+}
+
+void CActiveAEBufferArena::Clear()
+{
+  std::unique_lock lock(m_section);
+  m_packets.clear();
+  m_bytesHeld = 0;
+}
+
+CActiveAEBufferArena::Stats CActiveAEBufferArena::GetStats() const
+{
+  std::unique_lock lock(m_section);
+
+  Stats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  for (const auto& [key, packets] : m_packets)
+    stats.idlePackets += packets.size();
+  stats.bytesHeld = m_bytesHeld;
+  stats.capacity = m_capacity;
+  return stats;
+}
+
+CActiveAEBufferArena::Key CActiveAEBufferArena::GetKey(const SampleConfig& config, int samples)
+{
+  return {config.fmt, config.channels, samples};
+}
+
+size_t CActiveAEBufferArena::GetSize(const CSoundPacket& pkt)
+{
+  return static_cast<size_t>(pkt.linesize) * pkt.planes;
+}
+
+void CActiveAEBufferArena::Trim()
+{
+  // free packets of other formats first, the reserved format is the one
+  // the engine is going to ask for
+  for (auto it = m_packets.begin(); it != m_packets.end() && m_bytesHeld > m_capacity;)
+  {
+    if (it->first == m_reservedKey)
+    {
+      ++it;
+      continue;
+    }
+    for (const auto& pkt : it->second)
+      m_bytesHeld -= GetSize(*pkt);
+    it = m_packets.erase(it);
+  }
+
+  auto reserved = m_packets.find(m_reservedKey);
+  while (m_bytesHeld > m_capacity && reserved != m_packets.end() && !reserved->second.empty())
+  {
+    m_bytesHeld -= GetSize(*reserved->second.back());
+    reserved->second.pop_back();
+  }
 }
 
 // ----------------------------------------------------------------------------------
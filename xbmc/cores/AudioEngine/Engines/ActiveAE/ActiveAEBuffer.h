@@ -10,9 +10,16 @@
 
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
 #include <cmath>
 #include <deque>
+#include <map>
 #include <memory>
+#include <stdint.h>
+#include <tuple>
+#include <vector>
 
 extern "C" {
 #include <libavutil/avutil.h>
@@ -55,19 +62,112 @@ public:
   int pkt_start_offset = 0;
   int refCount = 0;
   double centerMixLevel;
+  std::chrono::steady_clock::time_point acquireTime;
+};
+
+/*!
+ * \brief Sound packets shared by the buffer pools of all engine stages
+ *
+ * Pools take their packets from the arena when they are created and give them
+ * back when they are destroyed. Format changes and reconfigurations therefore
+ * recreate stream, resample and atempo pools from already allocated packets
+ * instead of going back to the heap.
+ *
+ * Packets are interchangeable if their sample format, channel count and
+ * capacity in frames match.
+ */
+class CActiveAEBufferArena
+{
+public:
+  struct Stats
+  {
+    uint64_t hits = 0; // packets served from the arena
+    uint64_t misses = 0; // packets that had to be allocated
+    unsigned int idlePackets = 0;
+    size_t bytesHeld = 0;
+    size_t capacity = 0;
+  };
+
+  CActiveAEBufferArena() = default;
+  ~CActiveAEBufferArena() = default;
+
+  std::unique_ptr<CSoundPacket> Acquire(const SampleConfig& config, int samples);
+  void Release(std::unique_ptr<CSoundPacket> pkt);
+
+  /*!
+   * \brief Preallocate packets for the format the engine is about to use
+   *
+   * Also sets the capacity to twice the reserved size, leaving room for the
+   * packets of pools being replaced.
+   */
+  void Reserve(const SampleConfig& config, int samples, unsigned int count);
+
+  /*!
+   * \brief Free all idle packets
+   */
+  void Clear();
+
+  Stats GetStats() const;
+
+  static constexpr size_t DEFAULT_CAPACITY = 16 * 1024 * 1024;
+
+private:
+  using Key = std::tuple<int, int, int>; // sample format, channels, frames
+
+  static Key GetKey(const SampleConfig& config, int samples);
+  static size_t GetSize(const CSoundPacket& pkt);
+  void Trim();
+
+  mutable CCriticalSection m_section;
+  std::map<Key, std::vector<std::unique_ptr<CSoundPacket>>> m_packets;
+  Key m_reservedKey{-1, 0, 0};
+  size_t m_bytesHeld = 0;
+  size_t m_capacity = DEFAULT_CAPACITY;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
 };
 
 class CActiveAEBufferPool
 {
 public:
+  /*!
+   * \brief Occupancy of a pool and the time its buffers spend in the next stage
+   *
+   * A buffer is held from GetFreeBuffer() until its last reference is
+   * returned, which covers the queue of the consuming stage and its
+   * processing.
+   */
+  struct Stats
+  {
+    unsigned int buffers = 0;
+    unsigned int inUse = 0;
+    unsigned int highWaterMark = 0;
+    uint64_t returned = 0;
+    double averageHoldMs = 0.0;
+    double maxHoldMs = 0.0;
+  };
+
   explicit CActiveAEBufferPool(const AEAudioFormat& format);
   virtual ~CActiveAEBufferPool();
   virtual bool Create(unsigned int totaltime);
   CSampleBuffer *GetFreeBuffer();
   void ReturnBuffer(CSampleBuffer *buffer);
+  Stats GetStats() const;
+  void ResetStats();
+
+  static CActiveAEBufferArena& GetArena();
+  static SampleConfig GetSampleConfig(const AEAudioFormat& format);
+  static unsigned int GetBufferCount(const AEAudioFormat& format, unsigned int totaltime);
+
   AEAudioFormat m_format;
-  std::deque<CSampleBuffer*> m_allSamples;
-  std::deque<CSampleBuffer*> m_freeSamples;
+  std::vector<CSampleBuffer*> m_allSamples;
+  std::vector<CSampleBuffer*> m_freeSamples;
+
+private:
+  unsigned int m_highWaterMark = 0;
+  uint64_t m_returned = 0;
+  std::chrono::steady_clock::duration m_holdTime{};
+  std::chrono::steady_clock::duration m_maxHoldTime{};
 };
 
 class IAEResample;
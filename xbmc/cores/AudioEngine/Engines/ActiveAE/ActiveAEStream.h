@@ -117,6 +117,8 @@ public:
   bool HasWork();
   std::unique_ptr<CActiveAEBufferPool> GetResampleBuffers();
   std::unique_ptr<CActiveAEBufferPool> GetAtempoBuffers();
+  CActiveAEBufferPool* GetResamplePool() const { return m_resampleBuffers.get(); }
+  CActiveAEBufferPool* GetAtempoPool() const { return m_atempoBuffers.get(); }
 
   bool IsAtempoActive() const;
 
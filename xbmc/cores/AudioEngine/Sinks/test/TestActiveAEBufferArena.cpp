@@ -0,0 +1,138 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+
+#include <gtest/gtest.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+AEAudioFormat GetFormat(CAEChannelInfo layout, unsigned int frames)
+{
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_FLOAT;
+  format.m_sampleRate = 48000;
+  format.m_channelLayout = layout;
+  format.m_frames = frames;
+  format.m_frameSize = layout.Count() * sizeof(float);
+  return format;
+}
+} // namespace
+
+TEST(TestActiveAEBufferArena, ReusesReleasedPackets)
+{
+  CActiveAEBufferArena arena;
+  const SampleConfig config =
+      CActiveAEBufferPool::GetSampleConfig(GetFormat(AE_CH_LAYOUT_2_0, 1024));
+
+  std::unique_ptr<CSoundPacket> pkt = arena.Acquire(config, 1024);
+  ASSERT_NE(pkt, nullptr);
+  CSoundPacket* first = pkt.get();
+  pkt->nb_samples = 512;
+  arena.Release(std::move(pkt));
+
+  pkt = arena.Acquire(config, 1024);
+  EXPECT_EQ(pkt.get(), first);
+  EXPECT_EQ(pkt->nb_samples, 0);
+
+  // a packet with a different capacity can't be served from the arena
+  std::unique_ptr<CSoundPacket> other = arena.Acquire(config, 2048);
+  EXPECT_EQ(other->max_nb_samples, 2048);
+
+  const CActiveAEBufferArena::Stats stats = arena.GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.idlePackets, 0u);
+  EXPECT_EQ(stats.bytesHeld, 0u);
+}
+
+TEST(TestActiveAEBufferArena, ReserveServesPools)
+{
+  CActiveAEBufferArena& arena = CActiveAEBufferPool::GetArena();
+  arena.Clear();
+
+  const AEAudioFormat format = GetFormat(AE_CH_LAYOUT_5_1, 1600);
+  const unsigned int count = CActiveAEBufferPool::GetBufferCount(format, 400);
+  arena.Reserve(CActiveAEBufferPool::GetSampleConfig(format), format.m_frames, count);
+  EXPECT_EQ(arena.GetStats().idlePackets, count);
+
+  const CActiveAEBufferArena::Stats before = arena.GetStats();
+  {
+    CActiveAEBufferPool pool(format);
+    pool.Create(400);
+    EXPECT_EQ(pool.m_allSamples.size(), count);
+
+    const CActiveAEBufferArena::Stats stats = arena.GetStats();
+    EXPECT_EQ(stats.hits - before.hits, count);
+    EXPECT_EQ(stats.misses, before.misses);
+    EXPECT_EQ(stats.idlePackets, 0u);
+  }
+
+  // destroying the pool gives its packets back
+  EXPECT_EQ(arena.GetStats().idlePackets, count);
+
+  arena.Clear();
+  EXPECT_EQ(arena.GetStats().bytesHeld, 0u);
+}
+
+TEST(TestActiveAEBufferArena, TrimsToCapacity)
+{
+  CActiveAEBufferArena arena;
+
+  // keep the reserved packets, free others once the capacity is exceeded
+  const SampleConfig reserved =
+      CActiveAEBufferPool::GetSampleConfig(GetFormat(AE_CH_LAYOUT_2_0, 4800));
+  arena.Reserve(reserved, 4800, 4);
+
+  const SampleConfig config =
+      CActiveAEBufferPool::GetSampleConfig(GetFormat(AE_CH_LAYOUT_7_1, 48000));
+  for (int i = 0; i < 16; i++)
+    arena.Release(std::make_unique<CSoundPacket>(config, 48000));
+
+  const CActiveAEBufferArena::Stats stats = arena.GetStats();
+  EXPECT_LE(stats.bytesHeld, stats.capacity);
+  EXPECT_GE(stats.idlePackets, 4u);
+
+  for (int i = 0; i < 4; i++)
+    arena.Acquire(reserved, 4800);
+  EXPECT_EQ(arena.GetStats().hits, 4u);
+}
+
+TEST(TestActiveAEBufferPool, Stats)
+{
+  CActiveAEBufferPool pool(GetFormat(AE_CH_LAYOUT_2_0, 480));
+  pool.Create(100);
+
+  CSampleBuffer* first = pool.GetFreeBuffer();
+  CSampleBuffer* second = pool.GetFreeBuffer();
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+
+  CActiveAEBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.inUse, 2u);
+  EXPECT_EQ(stats.highWaterMark, 2u);
+
+  first->Return();
+  second->Return();
+
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.inUse, 0u);
+  EXPECT_EQ(stats.highWaterMark, 2u);
+  EXPECT_EQ(stats.returned, 2u);
+  EXPECT_GE(stats.maxHoldMs, stats.averageHoldMs);
+
+  // the most recently returned buffer is handed out first
+  EXPECT_EQ(pool.GetFreeBuffer(), second);
+
+  pool.ResetStats();
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.highWaterMark, 1u);
+  EXPECT_EQ(stats.returned, 0u);
+}
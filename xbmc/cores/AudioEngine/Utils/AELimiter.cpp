@@ -43,14 +43,31 @@ float CAELimiter::Run(float* frame[AE_CH_MAX], int channels, int offset /*= 0*/,
     }
   }
 
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  return Process(highest, advancedSettings->m_limiterHold, advancedSettings->m_limiterRelease);
+}
+
+void CAELimiter::Run(const float* peaks, float* gains, int frames)
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const float hold = advancedSettings->m_limiterHold;
+  const float release = advancedSettings->m_limiterRelease;
+
+  for (int i = 0; i < frames; i++)
+    gains[i] *= Process(peaks[i], hold, release);
+}
+
+float CAELimiter::Process(float highest, float hold, float release)
+{
   float sample = highest * m_amplify;
   if (sample * m_attenuation > 1.0f)
   {
     m_attenuation = 1.0f / sample;
-    m_holdcounter = MathUtils::round_int(static_cast<double>(
-        m_samplerate *
-        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_limiterHold));
-    m_increase = powf(std::min(sample, 10000.0f), 1.0f / (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_limiterRelease * m_samplerate));
+    m_holdcounter = MathUtils::round_int(static_cast<double>(m_samplerate * hold));
+    m_increase = powf(std::min(sample, 10000.0f), 1.0f / (release * m_samplerate));
   }
 
   float attenuation = m_attenuation;
@@ -74,4 +91,3 @@ float CAELimiter::Run(float* frame[AE_CH_MAX], int channels, int offset /*= 0*/,
 
   return attenuation * m_amplify;
 }
-
@@ -40,4 +40,16 @@ class CAELimiter
     }
 
     float Run(float* frame[AE_CH_MAX], int channels, int offset = 0, bool planar = false);
+
+    /*!
+     * \brief Apply the limiter to a block of frames
+     *
+     * \param peaks The highest absolute sample value of each frame
+     * \param[in,out] gains The gain of each frame, multiplied by the limiter gain
+     * \param frames The number of frames
+     */
+    void Run(const float* peaks, float* gains, int frames);
+
+  private:
+    float Process(float highest, float hold, float release);
 };
@@ -0,0 +1,240 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// This file is compiled with AVX2 enabled. It must only be entered after
+// checking for CPU_FEATURE_AVX2 at runtime.
+
+#include "AEMixKernels.h"
+
+#include <algorithm>
+#include <math.h>
+
+#include <immintrin.h>
+
+namespace
+{
+__m256 Abs(__m256 value)
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value);
+}
+
+// Fold the upper half onto the lower half
+__m128 Fold(__m256 value)
+{
+  return _mm_max_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+}
+
+float HorizontalMax(__m128 value)
+{
+  value = _mm_max_ps(value, _mm_movehl_ps(value, value));
+  value = _mm_max_ss(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(value);
+}
+
+// Multiply 8 samples by their gains, adding them to the destination if mixing
+template<bool Mix>
+void Apply(float* dst, const float* src, __m256 gains, __m256& peak)
+{
+  if constexpr (Mix)
+  {
+    // Not fused, so that results match the other kernels
+    const __m256 value =
+        _mm256_add_ps(_mm256_loadu_ps(dst), _mm256_mul_ps(_mm256_loadu_ps(src), gains));
+    _mm256_storeu_ps(dst, value);
+    peak = _mm256_max_ps(peak, Abs(value));
+  }
+  else
+  {
+    _mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_loadu_ps(dst), gains));
+  }
+}
+
+// Same for 4 samples, for the remainder of frames
+template<bool Mix>
+void Apply(float* dst, const float* src, __m128 gains, __m128& peak)
+{
+  if constexpr (Mix)
+  {
+    const __m128 value = _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_loadu_ps(src), gains));
+    _mm_storeu_ps(dst, value);
+    peak = _mm_max_ps(peak, _mm_andnot_ps(_mm_set1_ps(-0.0f), value));
+  }
+  else
+  {
+    _mm_storeu_ps(dst, _mm_mul_ps(_mm_loadu_ps(dst), gains));
+  }
+}
+
+template<bool Mix>
+float ApplyFrames(float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  __m256 peak = _mm256_setzero_ps();
+  __m128 remainderPeak = _mm_setzero_ps();
+  float tailPeak = 0.0f;
+
+  for (size_t i = 0; i < frames;)
+  {
+    if (channels == 1 && i + 8 <= frames)
+    {
+      Apply<Mix>(dst + i, src + i, _mm256_loadu_ps(gains + i), peak);
+      i += 8;
+    }
+    else if (channels == 2 && i + 4 <= frames)
+    {
+      // Duplicate the gains of 4 frames for both channels
+      const __m128 quad = _mm_loadu_ps(gains + i);
+      const __m256 pairs =
+          _mm256_set_m128(_mm_unpackhi_ps(quad, quad), _mm_unpacklo_ps(quad, quad));
+      Apply<Mix>(dst + i * 2, src + i * 2, pairs, peak);
+      i += 4;
+    }
+    else if (channels == 4 && i + 2 <= frames)
+    {
+      const __m256 pair = _mm256_set_m128(_mm_set1_ps(gains[i + 1]), _mm_set1_ps(gains[i]));
+      Apply<Mix>(dst + i * 4, src + i * 4, pair, peak);
+      i += 2;
+    }
+    else
+    {
+      const __m256 gain = _mm256_set1_ps(gains[i]);
+      float* frameDst = dst + i * channels;
+      const float* frameSrc = src + i * channels;
+
+      size_t j = 0;
+      for (; j + 8 <= channels; j += 8)
+        Apply<Mix>(frameDst + j, frameSrc + j, gain, peak);
+
+      if (j + 4 <= channels)
+      {
+        Apply<Mix>(frameDst + j, frameSrc + j, _mm256_castps256_ps128(gain), remainderPeak);
+        j += 4;
+      }
+
+      for (; j < channels; j++)
+      {
+        if constexpr (Mix)
+        {
+          frameDst[j] += frameSrc[j] * gains[i];
+          tailPeak = std::max(tailPeak, fabsf(frameDst[j]));
+        }
+        else
+          frameDst[j] *= gains[i];
+      }
+      i++;
+    }
+  }
+
+  return std::max(HorizontalMax(_mm_max_ps(Fold(peak), remainderPeak)), tailPeak);
+}
+
+void Scale(float* data, float gain, size_t count)
+{
+  const __m256 gains = _mm256_set1_ps(gain);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), gains));
+
+  for (; i < count; i++)
+    data[i] *= gain;
+}
+
+float MixAdd(float* dst, const float* src, float gain, size_t count)
+{
+  const __m256 gains = _mm256_set1_ps(gain);
+  __m256 peak = _mm256_setzero_ps();
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    Apply<true>(dst + i, src + i, gains, peak);
+
+  float tailPeak = 0.0f;
+  for (; i < count; i++)
+  {
+    dst[i] += src[i] * gain;
+    tailPeak = std::max(tailPeak, fabsf(dst[i]));
+  }
+
+  return std::max(HorizontalMax(Fold(peak)), tailPeak);
+}
+
+void ScaleFrames(float* data, const float* gains, size_t frames, size_t channels)
+{
+  ApplyFrames<false>(data, data, gains, frames, channels);
+}
+
+float MixAddFrames(float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  return ApplyFrames<true>(dst, src, gains, frames, channels);
+}
+
+void FramePeaks(float* peaks, const float* data, size_t frames, size_t channels)
+{
+  size_t i = 0;
+
+  if (channels == 1)
+  {
+    for (; i + 8 <= frames; i += 8)
+    {
+      const __m256 value = Abs(_mm256_loadu_ps(data + i));
+      _mm256_storeu_ps(peaks + i, _mm256_max_ps(_mm256_loadu_ps(peaks + i), value));
+    }
+  }
+  else if (channels == 2)
+  {
+    for (; i + 8 <= frames; i += 8)
+    {
+      // Pairs of adjacent samples are maxed within each 128-bit lane, which
+      // leaves the frames in the order 0 1 4 5 2 3 6 7
+      const __m256 a = Abs(_mm256_loadu_ps(data + i * 2));
+      const __m256 b = Abs(_mm256_loadu_ps(data + i * 2 + 8));
+      const __m256 max = _mm256_max_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                                       _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      const __m256 value = _mm256_castpd_ps(
+          _mm256_permute4x64_pd(_mm256_castps_pd(max), _MM_SHUFFLE(3, 1, 2, 0)));
+      _mm256_storeu_ps(peaks + i, _mm256_max_ps(_mm256_loadu_ps(peaks + i), value));
+    }
+  }
+
+  for (; i < frames; i++)
+  {
+    const float* frame = data + i * channels;
+    float peak = peaks[i];
+
+    size_t j = 0;
+    if (channels >= 4)
+    {
+      __m256 max = _mm256_setzero_ps();
+      for (; j + 8 <= channels; j += 8)
+        max = _mm256_max_ps(max, Abs(_mm256_loadu_ps(frame + j)));
+
+      __m128 remainder = Fold(max);
+      if (j + 4 <= channels)
+      {
+        remainder =
+            _mm_max_ps(remainder, _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_loadu_ps(frame + j)));
+        j += 4;
+      }
+      peak = std::max(peak, HorizontalMax(remainder));
+    }
+
+    for (; j < channels; j++)
+      peak = std::max(peak, fabsf(frame[j]));
+    peaks[i] = peak;
+  }
+}
+
+constexpr AEMixKernels AVX_KERNELS = {
+    "AVX", Scale, MixAdd, ScaleFrames, MixAddFrames, FramePeaks,
+};
+} // namespace
+
+const AEMixKernels& GetAvxAEMixKernels()
+{
+  return AVX_KERNELS;
+}
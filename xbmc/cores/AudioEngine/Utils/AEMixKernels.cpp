@@ -0,0 +1,481 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEMixKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <math.h>
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#if defined(HAS_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define AE_MIX_NEON
+#endif
+
+namespace
+{
+// Portable C++ kernels
+
+void ScaleScalar(float* data, float gain, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    data[i] *= gain;
+}
+
+float MixAddScalar(float* dst, const float* src, float gain, size_t count)
+{
+  float peak = 0.0f;
+  for (size_t i = 0; i < count; i++)
+  {
+    dst[i] += src[i] * gain;
+    peak = std::max(peak, fabsf(dst[i]));
+  }
+  return peak;
+}
+
+void ScaleFramesScalar(float* data, const float* gains, size_t frames, size_t channels)
+{
+  for (size_t i = 0; i < frames; i++)
+    ScaleScalar(data + i * channels, gains[i], channels);
+}
+
+float MixAddFramesScalar(
+    float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  float peak = 0.0f;
+  for (size_t i = 0; i < frames; i++)
+    peak = std::max(peak, MixAddScalar(dst + i * channels, src + i * channels, gains[i], channels));
+  return peak;
+}
+
+void FramePeaksScalar(float* peaks, const float* data, size_t frames, size_t channels)
+{
+  for (size_t i = 0; i < frames; i++)
+  {
+    float peak = peaks[i];
+    for (size_t j = 0; j < channels; j++)
+      peak = std::max(peak, fabsf(data[i * channels + j]));
+    peaks[i] = peak;
+  }
+}
+
+constexpr AEMixKernels SCALAR_KERNELS = {
+    "C++", ScaleScalar, MixAddScalar, ScaleFramesScalar, MixAddFramesScalar, FramePeaksScalar,
+};
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+
+// SSE kernels, processing 4 samples at a time
+
+__m128 AbsSSE(__m128 value)
+{
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+float HorizontalMaxSSE(__m128 value)
+{
+  value = _mm_max_ps(value, _mm_movehl_ps(value, value));
+  value = _mm_max_ss(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(value);
+}
+
+// Multiply 4 samples by their gains, adding them to the destination if mixing
+template<bool Mix>
+void ApplySSE(float* dst, const float* src, __m128 gains, __m128& peak)
+{
+  if constexpr (Mix)
+  {
+    const __m128 value = _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_loadu_ps(src), gains));
+    _mm_storeu_ps(dst, value);
+    peak = _mm_max_ps(peak, AbsSSE(value));
+  }
+  else
+  {
+    _mm_storeu_ps(dst, _mm_mul_ps(_mm_loadu_ps(dst), gains));
+  }
+}
+
+template<bool Mix>
+float ApplyFramesSSE(
+    float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  __m128 peak = _mm_setzero_ps();
+  size_t i = 0;
+
+  if (channels == 1)
+  {
+    for (; i + 4 <= frames; i += 4)
+      ApplySSE<Mix>(dst + i, src + i, _mm_loadu_ps(gains + i), peak);
+  }
+  else if (channels == 2)
+  {
+    for (; i + 2 <= frames; i += 2)
+    {
+      const __m128 pair = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(gains + i));
+      ApplySSE<Mix>(dst + i * 2, src + i * 2, _mm_unpacklo_ps(pair, pair), peak);
+    }
+  }
+  else if (channels >= 4)
+  {
+    for (; i < frames; i++)
+    {
+      const __m128 gain = _mm_set1_ps(gains[i]);
+      float* frameDst = dst + i * channels;
+      const float* frameSrc = src + i * channels;
+
+      size_t j = 0;
+      for (; j + 4 <= channels; j += 4)
+        ApplySSE<Mix>(frameDst + j, frameSrc + j, gain, peak);
+
+      for (; j < channels; j++)
+      {
+        if constexpr (Mix)
+        {
+          frameDst[j] += frameSrc[j] * gains[i];
+          peak = _mm_max_ss(peak, _mm_set_ss(fabsf(frameDst[j])));
+        }
+        else
+          frameDst[j] *= gains[i];
+      }
+    }
+  }
+
+  const size_t offset = i * channels;
+  if constexpr (Mix)
+  {
+    return std::max(HorizontalMaxSSE(peak), MixAddFramesScalar(dst + offset, src + offset,
+                                                               gains + i, frames - i, channels));
+  }
+  else
+  {
+    ScaleFramesScalar(dst + offset, gains + i, frames - i, channels);
+    return 0.0f;
+  }
+}
+
+void ScaleSSE(float* data, float gain, size_t count)
+{
+  const __m128 gains = _mm_set1_ps(gain);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), gains));
+
+  ScaleScalar(data + i, gain, count - i);
+}
+
+float MixAddSSE(float* dst, const float* src, float gain, size_t count)
+{
+  const __m128 gains = _mm_set1_ps(gain);
+  __m128 peak = _mm_setzero_ps();
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    ApplySSE<true>(dst + i, src + i, gains, peak);
+
+  return std::max(HorizontalMaxSSE(peak), MixAddScalar(dst + i, src + i, gain, count - i));
+}
+
+void ScaleFramesSSE(float* data, const float* gains, size_t frames, size_t channels)
+{
+  ApplyFramesSSE<false>(data, data, gains, frames, channels);
+}
+
+float MixAddFramesSSE(
+    float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  return ApplyFramesSSE<true>(dst, src, gains, frames, channels);
+}
+
+void FramePeaksSSE(float* peaks, const float* data, size_t frames, size_t channels)
+{
+  size_t i = 0;
+
+  if (channels == 1)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      const __m128 value = AbsSSE(_mm_loadu_ps(data + i));
+      _mm_storeu_ps(peaks + i, _mm_max_ps(_mm_loadu_ps(peaks + i), value));
+    }
+  }
+  else if (channels == 2)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      const __m128 a = AbsSSE(_mm_loadu_ps(data + i * 2));
+      const __m128 b = AbsSSE(_mm_loadu_ps(data + i * 2 + 4));
+      const __m128 value = _mm_max_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                                      _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      _mm_storeu_ps(peaks + i, _mm_max_ps(_mm_loadu_ps(peaks + i), value));
+    }
+  }
+  else if (channels >= 4)
+  {
+    for (; i < frames; i++)
+    {
+      const float* frame = data + i * channels;
+      __m128 peak = _mm_set_ss(peaks[i]);
+
+      size_t j = 0;
+      for (; j + 4 <= channels; j += 4)
+        peak = _mm_max_ps(peak, AbsSSE(_mm_loadu_ps(frame + j)));
+
+      float value = HorizontalMaxSSE(peak);
+      for (; j < channels; j++)
+        value = std::max(value, fabsf(frame[j]));
+      peaks[i] = value;
+    }
+  }
+
+  FramePeaksScalar(peaks + i, data + i * channels, frames - i, channels);
+}
+
+constexpr AEMixKernels SSE_KERNELS = {
+    "SSE", ScaleSSE, MixAddSSE, ScaleFramesSSE, MixAddFramesSSE, FramePeaksSSE,
+};
+
+#endif
+
+#if defined(AE_MIX_NEON)
+
+// NEON kernels, processing 4 samples at a time
+
+float HorizontalMaxNEON(float32x4_t value)
+{
+  float32x2_t max = vpmax_f32(vget_low_f32(value), vget_high_f32(value));
+  max = vpmax_f32(max, max);
+  return vget_lane_f32(max, 0);
+}
+
+template<bool Mix>
+float32x4_t ApplyNEON(float32x4_t dst, float32x4_t src, float32x4_t gains, float32x4_t& peak)
+{
+  if constexpr (Mix)
+  {
+    // Not fused, so that results match the other kernels
+    const float32x4_t value = vaddq_f32(dst, vmulq_f32(src, gains));
+    peak = vmaxq_f32(peak, vabsq_f32(value));
+    return value;
+  }
+  else
+    return vmulq_f32(dst, gains);
+}
+
+template<bool Mix>
+float ApplyFramesNEON(
+    float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  float32x4_t peak = vdupq_n_f32(0.0f);
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  size_t i = 0;
+
+  if (channels == 1)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      const float32x4_t value = ApplyNEON<Mix>(
+          vld1q_f32(dst + i), Mix ? vld1q_f32(src + i) : zero, vld1q_f32(gains + i), peak);
+      vst1q_f32(dst + i, value);
+    }
+  }
+  else if (channels == 2)
+  {
+    // Deinterleave 4 frames, so that both channels line up with the gains
+    for (; i + 4 <= frames; i += 4)
+    {
+      const float32x4_t frameGains = vld1q_f32(gains + i);
+      float32x4x2_t value = vld2q_f32(dst + i * 2);
+      float32x4x2_t add = {{zero, zero}};
+      if constexpr (Mix)
+        add = vld2q_f32(src + i * 2);
+
+      value.val[0] = ApplyNEON<Mix>(value.val[0], add.val[0], frameGains, peak);
+      value.val[1] = ApplyNEON<Mix>(value.val[1], add.val[1], frameGains, peak);
+      vst2q_f32(dst + i * 2, value);
+    }
+  }
+  else if (channels >= 4)
+  {
+    for (; i < frames; i++)
+    {
+      const float32x4_t gain = vdupq_n_f32(gains[i]);
+      float* frameDst = dst + i * channels;
+      const float* frameSrc = src + i * channels;
+
+      size_t j = 0;
+      for (; j + 4 <= channels; j += 4)
+      {
+        const float32x4_t value = ApplyNEON<Mix>(
+            vld1q_f32(frameDst + j), Mix ? vld1q_f32(frameSrc + j) : zero, gain, peak);
+        vst1q_f32(frameDst + j, value);
+      }
+
+      if (j < channels)
+      {
+        if constexpr (Mix)
+        {
+          const float tail = MixAddScalar(frameDst + j, frameSrc + j, gains[i], channels - j);
+          peak = vmaxq_f32(peak, vdupq_n_f32(tail));
+        }
+        else
+          ScaleScalar(frameDst + j, gains[i], channels - j);
+      }
+    }
+  }
+
+  const size_t offset = i * channels;
+  if constexpr (Mix)
+  {
+    return std::max(HorizontalMaxNEON(peak), MixAddFramesScalar(dst + offset, src + offset,
+                                                                gains + i, frames - i, channels));
+  }
+  else
+  {
+    ScaleFramesScalar(dst + offset, gains + i, frames - i, channels);
+    return 0.0f;
+  }
+}
+
+void ScaleNEON(float* data, float gain, size_t count)
+{
+  const float32x4_t gains = vdupq_n_f32(gain);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), gains));
+
+  ScaleScalar(data + i, gain, count - i);
+}
+
+float MixAddNEON(float* dst, const float* src, float gain, size_t count)
+{
+  const float32x4_t gains = vdupq_n_f32(gain);
+  float32x4_t peak = vdupq_n_f32(0.0f);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, ApplyNEON<true>(vld1q_f32(dst + i), vld1q_f32(src + i), gains, peak));
+
+  return std::max(HorizontalMaxNEON(peak), MixAddScalar(dst + i, src + i, gain, count - i));
+}
+
+void ScaleFramesNEON(float* data, const float* gains, size_t frames, size_t channels)
+{
+  ApplyFramesNEON<false>(data, data, gains, frames, channels);
+}
+
+float MixAddFramesNEON(
+    float* dst, const float* src, const float* gains, size_t frames, size_t channels)
+{
+  return ApplyFramesNEON<true>(dst, src, gains, frames, channels);
+}
+
+void FramePeaksNEON(float* peaks, const float* data, size_t frames, size_t channels)
+{
+  size_t i = 0;
+
+  if (channels == 1)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      const float32x4_t value = vabsq_f32(vld1q_f32(data + i));
+      vst1q_f32(peaks + i, vmaxq_f32(vld1q_f32(peaks + i), value));
+    }
+  }
+  else if (channels == 2)
+  {
+    for (; i + 4 <= frames; i += 4)
+    {
+      const float32x4x2_t value = vld2q_f32(data + i * 2);
+      const float32x4_t peak = vmaxq_f32(vabsq_f32(value.val[0]), vabsq_f32(value.val[1]));
+      vst1q_f32(peaks + i, vmaxq_f32(vld1q_f32(peaks + i), peak));
+    }
+  }
+  else if (channels >= 4)
+  {
+    for (; i < frames; i++)
+    {
+      const float* frame = data + i * channels;
+      float32x4_t peak = vdupq_n_f32(peaks[i]);
+
+      size_t j = 0;
+      for (; j + 4 <= channels; j += 4)
+        peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(frame + j)));
+
+      float value = HorizontalMaxNEON(peak);
+      for (; j < channels; j++)
+        value = std::max(value, fabsf(frame[j]));
+      peaks[i] = value;
+    }
+  }
+
+  FramePeaksScalar(peaks + i, data + i * channels, frames - i, channels);
+}
+
+constexpr AEMixKernels NEON_KERNELS = {
+    "NEON", ScaleNEON, MixAddNEON, ScaleFramesNEON, MixAddFramesNEON, FramePeaksNEON,
+};
+
+#endif
+
+unsigned int GetCPUFeatures()
+{
+  // CPU info may not be registered yet, e.g. in unit tests
+  const std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  return cpuInfo ? cpuInfo->GetCPUFeatures() : 0;
+}
+} // namespace
+
+const AEMixKernels& GetAEMixKernels()
+{
+  static const AEMixKernels& kernels = []() -> const AEMixKernels&
+  {
+    const AEMixKernels& selected = *GetSupportedAEMixKernels().back();
+    CLog::Log(LOGDEBUG, "ActiveAE: Using {} kernels for mixing", selected.name);
+    return selected;
+  }();
+
+  return kernels;
+}
+
+const AEMixKernels& GetScalarAEMixKernels()
+{
+  return SCALAR_KERNELS;
+}
+
+std::vector<const AEMixKernels*> GetSupportedAEMixKernels()
+{
+  std::vector<const AEMixKernels*> kernels{&SCALAR_KERNELS};
+
+  [[maybe_unused]] const unsigned int features = GetCPUFeatures();
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+  // Like CAEUtil, use SSE whenever the build enables it
+  kernels.push_back(&SSE_KERNELS);
+#endif
+
+#if defined(HAVE_AVX2)
+  if (features & CPU_FEATURE_AVX2)
+    kernels.push_back(&GetAvxAEMixKernels());
+#endif
+
+#if defined(AE_MIX_NEON)
+  if (features & CPU_FEATURE_NEON)
+    kernels.push_back(&NEON_KERNELS);
+#endif
+
+  return kernels;
+}
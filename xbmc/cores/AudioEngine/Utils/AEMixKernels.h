@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+/*!
+ * \brief Set of kernels that mix and scale float samples
+ *
+ * Samples are either interleaved frames of a number of channels, or a single
+ * plane of planar audio, which is handled as frames of one channel. Gain
+ * ramps provide one gain per frame, as computed for stream fading and the
+ * limiter.
+ *
+ * Buffers don't need to be aligned, and source and destination don't overlap.
+ */
+struct AEMixKernels
+{
+  /*!
+   * \brief Name of the instruction set, for logging
+   */
+  const char* name;
+
+  /*!
+   * \brief Multiply samples by a gain
+   */
+  void (*scale)(float* data, float gain, size_t count);
+
+  /*!
+   * \brief Add samples multiplied by a gain
+   *
+   * \return The highest absolute value of the mixed samples
+   */
+  float (*mixAdd)(float* dst, const float* src, float gain, size_t count);
+
+  /*!
+   * \brief Multiply each frame by its gain
+   */
+  void (*scaleFrames)(float* data, const float* gains, size_t frames, size_t channels);
+
+  /*!
+   * \brief Add frames multiplied by their gain
+   *
+   * \return The highest absolute value of the mixed samples
+   */
+  float (*mixAddFrames)(
+      float* dst, const float* src, const float* gains, size_t frames, size_t channels);
+
+  /*!
+   * \brief Raise the peak of each frame to the highest absolute value of its samples
+   *
+   * Peaks of planar audio are found by running this on each plane with one
+   * channel.
+   */
+  void (*framePeaks)(float* peaks, const float* data, size_t frames, size_t channels);
+};
+
+/*!
+ * \brief Get the fastest kernels supported by the running CPU
+ *
+ * The selection is made once, based on the features reported by CCPUInfo,
+ * and falls back to portable C++ if no vector unit is available.
+ */
+const AEMixKernels& GetAEMixKernels();
+
+/*!
+ * \brief Get the portable C++ kernels, used as a reference implementation
+ */
+const AEMixKernels& GetScalarAEMixKernels();
+
+/*!
+ * \brief Get all kernels that can run on this CPU, for tests and benchmarks
+ */
+std::vector<const AEMixKernels*> GetSupportedAEMixKernels();
+
+#if defined(HAVE_AVX2)
+/*!
+ * \brief Get the AVX kernels, compiled in a separate translation unit
+ */
+const AEMixKernels& GetAvxAEMixKernels();
+#endif
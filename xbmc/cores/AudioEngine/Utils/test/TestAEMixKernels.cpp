@@ -0,0 +1,235 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEMixKernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Channel counts of mono, stereo, 2.1, 5.1 and 7.1, plus the odd counts of
+// planes and partial layouts
+const std::vector<size_t> CHANNELS = {1, 2, 3, 4, 5, 6, 8};
+
+// Frame counts that exercise the vector bodies and their scalar tails
+const std::vector<size_t> FRAMES = {0, 1, 3, 7, 8, 9, 31, 257};
+
+std::vector<float> Random(size_t count, std::mt19937& rng, float range = 1.0f)
+{
+  std::uniform_real_distribution<float> value(-range, range);
+  std::vector<float> samples(count);
+  for (float& sample : samples)
+    sample = value(rng);
+  return samples;
+}
+
+class TestAEMixKernels : public ::testing::TestWithParam<const AEMixKernels*>
+{
+protected:
+  const AEMixKernels& Scalar() const { return GetScalarAEMixKernels(); }
+  const AEMixKernels& Kernels() const { return *GetParam(); }
+
+  std::mt19937 m_rng{4321};
+};
+
+std::string KernelName(const ::testing::TestParamInfo<const AEMixKernels*>& info)
+{
+  // Test names may only contain alphanumeric characters
+  std::string name = info.param->name;
+  std::replace_if(
+      name.begin(), name.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); },
+      'x');
+  return name;
+}
+} // namespace
+
+TEST(TestAEMixKernels, Selection)
+{
+  const std::vector<const AEMixKernels*> supported = GetSupportedAEMixKernels();
+  ASSERT_FALSE(supported.empty());
+  EXPECT_EQ(supported.front(), &GetScalarAEMixKernels());
+  EXPECT_EQ(supported.back(), &GetAEMixKernels());
+}
+
+TEST_P(TestAEMixKernels, Scale)
+{
+  for (size_t count : FRAMES)
+  {
+    const std::vector<float> input = Random(count, m_rng);
+    std::vector<float> expected = input;
+    std::vector<float> actual = input;
+
+    Scalar().scale(expected.data(), 0.7f, count);
+    Kernels().scale(actual.data(), 0.7f, count);
+
+    for (size_t i = 0; i < count; i++)
+      EXPECT_FLOAT_EQ(expected[i], actual[i]) << "count " << count << " sample " << i;
+  }
+}
+
+TEST_P(TestAEMixKernels, MixAdd)
+{
+  for (size_t count : FRAMES)
+  {
+    const std::vector<float> dst = Random(count, m_rng);
+    const std::vector<float> src = Random(count, m_rng, 2.0f);
+    std::vector<float> expected = dst;
+    std::vector<float> actual = dst;
+
+    const float expectedPeak = Scalar().mixAdd(expected.data(), src.data(), 0.5f, count);
+    const float actualPeak = Kernels().mixAdd(actual.data(), src.data(), 0.5f, count);
+
+    EXPECT_FLOAT_EQ(expectedPeak, actualPeak) << "count " << count;
+    for (size_t i = 0; i < count; i++)
+      EXPECT_FLOAT_EQ(expected[i], actual[i]) << "count " << count << " sample " << i;
+  }
+}
+
+TEST_P(TestAEMixKernels, ScaleFrames)
+{
+  for (size_t channels : CHANNELS)
+  {
+    for (size_t frames : FRAMES)
+    {
+      const std::vector<float> input = Random(frames * channels, m_rng);
+      const std::vector<float> gains = Random(frames, m_rng);
+      std::vector<float> expected = input;
+      std::vector<float> actual = input;
+
+      Scalar().scaleFrames(expected.data(), gains.data(), frames, channels);
+      Kernels().scaleFrames(actual.data(), gains.data(), frames, channels);
+
+      for (size_t i = 0; i < frames * channels; i++)
+        EXPECT_FLOAT_EQ(expected[i], actual[i])
+            << "channels " << channels << " frames " << frames << " sample " << i;
+    }
+  }
+}
+
+TEST_P(TestAEMixKernels, MixAddFrames)
+{
+  for (size_t channels : CHANNELS)
+  {
+    for (size_t frames : FRAMES)
+    {
+      const std::vector<float> dst = Random(frames * channels, m_rng);
+      const std::vector<float> src = Random(frames * channels, m_rng);
+      const std::vector<float> gains = Random(frames, m_rng, 2.0f);
+      std::vector<float> expected = dst;
+      std::vector<float> actual = dst;
+
+      const float expectedPeak =
+          Scalar().mixAddFrames(expected.data(), src.data(), gains.data(), frames, channels);
+      const float actualPeak =
+          Kernels().mixAddFrames(actual.data(), src.data(), gains.data(), frames, channels);
+
+      EXPECT_FLOAT_EQ(expectedPeak, actualPeak) << "channels " << channels << " frames " << frames;
+      for (size_t i = 0; i < frames * channels; i++)
+        EXPECT_FLOAT_EQ(expected[i], actual[i])
+            << "channels " << channels << " frames " << frames << " sample " << i;
+    }
+  }
+}
+
+TEST_P(TestAEMixKernels, FramePeaks)
+{
+  for (size_t channels : CHANNELS)
+  {
+    for (size_t frames : FRAMES)
+    {
+      const std::vector<float> data = Random(frames * channels, m_rng, 2.0f);
+
+      // Peaks are raised, never lowered
+      std::vector<float> expected(frames, 0.5f);
+      std::vector<float> actual(frames, 0.5f);
+
+      Scalar().framePeaks(expected.data(), data.data(), frames, channels);
+      Kernels().framePeaks(actual.data(), data.data(), frames, channels);
+
+      for (size_t i = 0; i < frames; i++)
+      {
+        EXPECT_FLOAT_EQ(expected[i], actual[i])
+            << "channels " << channels << " frames " << frames << " frame " << i;
+        EXPECT_GE(actual[i], 0.5f);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels,
+                         TestAEMixKernels,
+                         ::testing::ValuesIn(GetSupportedAEMixKernels()),
+                         KernelName);
+
+// Compares the kernels on the layouts ActiveAE mixes most, interleaved and
+// planar. Disabled by default, run with --gtest_also_run_disabled_tests.
+TEST(TestAEMixKernels, DISABLED_Benchmark)
+{
+  struct Layout
+  {
+    const char* name;
+    size_t channels;
+    size_t planes;
+  };
+
+  const Layout layouts[] = {
+      {"2.0", 2, 1},
+      {"5.1", 6, 1},
+      {"7.1", 8, 1},
+      {"5.1 planar", 6, 6},
+      {"7.1 planar", 8, 8},
+  };
+
+  // Period of the sink at 192 kHz, as large as ActiveAE processes
+  constexpr size_t FRAMES = 192000 / 50;
+  constexpr int ITERATIONS = 2000;
+
+  std::mt19937 rng(1234);
+
+  for (const Layout& layout : layouts)
+  {
+    const size_t channels = layout.channels / layout.planes;
+    const std::vector<float> src = Random(FRAMES * layout.channels, rng);
+    const std::vector<float> gains = Random(FRAMES, rng);
+    std::vector<float> dst(FRAMES * layout.channels);
+    std::vector<float> peaks(FRAMES);
+
+    for (const AEMixKernels* kernels : GetSupportedAEMixKernels())
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      float peak = 0.0f;
+      for (int i = 0; i < ITERATIONS; i++)
+      {
+        std::fill(peaks.begin(), peaks.end(), 0.0f);
+        for (size_t plane = 0; plane < layout.planes; plane++)
+        {
+          const size_t offset = plane * FRAMES * channels;
+          kernels->framePeaks(peaks.data(), src.data() + offset, FRAMES, channels);
+          kernels->scale(dst.data() + offset, 0.5f, FRAMES * channels);
+          peak = std::max(peak, kernels->mixAddFrames(dst.data() + offset, src.data() + offset,
+                                                      gains.data(), FRAMES, channels));
+        }
+      }
+
+      const std::chrono::duration<double, std::micro> elapsed =
+          std::chrono::steady_clock::now() - start;
+
+      std::cout << layout.name << " " << kernels->name << ": " << elapsed.count() / ITERATIONS
+                << " us per period (peak " << peak << ")" << std::endl;
+    }
+  }
+}
@@ -677,7 +677,7 @@ void CRetroPlayer::CreatePlayback(const std::string& savestatePath)
   {
     m_playback->Deinitialize();
     m_playback = std::make_unique<CReversiblePlayback>(
-        m_gameClient.get(), *m_renderManager, m_cheevos.get(), *m_guiMessenger,
+        m_gameClient.get(), *m_renderManager, *m_streamManager, m_cheevos.get(), *m_guiMessenger,
         m_gameClient->GetFrameRate(), m_gameClient->GetSerializeSize());
   }
   else
@@ -70,10 +70,18 @@ uint32_t CRenderBufferDMA::GetStride() const
 
 uint8_t* CRenderBufferDMA::GetMemory()
 {
-  // Map first, then open CPU access over the mapping that will be written
-  uint8_t* const memory = m_bo->GetMemory();
+  // Map first, then open CPU access over the mapping that will be written.
+  // Persistent mappings are created once and reused for every frame.
+  uint8_t* memory = m_map;
   if (memory == nullptr)
-    return nullptr;
+  {
+    memory = m_bo->GetMemory();
+    if (memory == nullptr)
+      return nullptr;
+
+    if (HasPersistentMapping())
+      m_map = memory;
+  }
 
   m_bo->SyncStart();
 
@@ -85,7 +93,9 @@ void CRenderBufferDMA::ReleaseMemory()
   // Close CPU access while the mapping is still there, then drop it. Ending it
   // after the unmap leaves the writes outside the bracket the GPU relies on.
   m_bo->SyncEnd();
-  m_bo->ReleaseMemory();
+
+  if (m_map == nullptr)
+    m_bo->ReleaseMemory();
 }
 
 void CRenderBufferDMA::CreateTexture()
@@ -117,6 +127,15 @@ bool CRenderBufferDMA::RequiresCoherencyWorkaround() const
   return false;
 }
 
+bool CRenderBufferDMA::HasPersistentMapping() const
+{
+  // DMAHeap and UDMABuf buffers are mapped with mmap() of the dma-buf, which
+  // stays coherent for as long as CPU access is bracketed by SyncStart() and
+  // SyncEnd(). GBM maps through a transfer that is only written back when
+  // unmapped.
+  return RequiresCoherencyWorkaround();
+}
+
 bool CRenderBufferDMA::UploadTexture()
 {
   if (m_bo->GetFd() < 0)
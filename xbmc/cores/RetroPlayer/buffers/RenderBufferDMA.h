@@ -59,9 +59,13 @@ private:
   void CreateTexture();
   void DeleteTexture();
   bool RequiresCoherencyWorkaround() const;
+  bool HasPersistentMapping() const;
 
   std::unique_ptr<CEGLImage> m_egl;
   std::unique_ptr<IBufferObject> m_bo;
+
+  // Mapping kept for the lifetime of the buffer object, if supported
+  uint8_t* m_map = nullptr;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -8,8 +8,10 @@
 
 #include "GameLoop.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <mutex>
 
 using namespace KODI;
 using namespace RETRO;
@@ -22,6 +24,10 @@ constexpr double DEFAULT_FPS = 60.0;
 
 // Duration to sleep while the game loop is paused
 constexpr auto PAUSE_SLEEP = 5s;
+
+// Time left between the end of a just-in-time frame and its deadline, which
+// absorbs wakeup latency and frame time jitter
+constexpr auto JIT_MARGIN = 2ms;
 } // namespace
 
 CGameLoop::CGameLoop(IGameLoopCallback* callback, double fps)
@@ -75,6 +81,17 @@ void CGameLoop::PauseAsync()
   SetSpeed(0.0);
 }
 
+void CGameLoop::SetLatencyReduction(bool bEnabled)
+{
+  m_latencyReduction.store(bEnabled);
+}
+
+GameLoopStats CGameLoop::GetStats() const
+{
+  std::unique_lock lock(m_statsMutex);
+  return m_stats;
+}
+
 void CGameLoop::Process(void)
 {
   // Main game loop that runs until the thread is requested to stop
@@ -105,17 +122,28 @@ void CGameLoop::Process(void)
       if (m_lastFrameUs == std::chrono::microseconds::zero())
         m_lastFrameUs = NowUs();
 
+      // Calculate the time for the next frame by adding the frame duration to
+      // the last frame time
+      const std::chrono::microseconds nextFrameUs = m_lastFrameUs + FrameTimeUs();
+
       // Trigger the appropriate callback depending on the direction of time
       // (forward or rewind)
       if (m_loopSpeedFactor > 0.0)
+      {
+        // Start over if the speed changed or the loop was stopped while
+        // waiting for the frame to start
+        if (m_latencyReduction.load() && !SleepUntilFrameStart())
+          continue;
+
+        const std::chrono::microseconds frameStartUs = NowUs();
         m_callback->FrameEvent();
+        const std::chrono::microseconds frameEndUs = NowUs();
+
+        AddFrameTime(frameEndUs - frameStartUs, frameEndUs > nextFrameUs);
+      }
       else if (m_loopSpeedFactor < 0.0)
         m_callback->RewindEvent();
 
-      // Calculate the time for the next frame by adding the frame duration to
-      // the last frame time
-      const std::chrono::microseconds nextFrameUs = m_lastFrameUs + FrameTimeUs();
-
       // Update the last frame time to ensure accurate timing for the next loop
       // iteration
       m_lastFrameUs = nextFrameUs;
@@ -133,6 +161,46 @@ void CGameLoop::Process(void)
   m_callback->EndEvent();
 }
 
+bool CGameLoop::SleepUntilFrameStart()
+{
+  std::chrono::microseconds frameTimeEstimateUs;
+  {
+    std::unique_lock lock(m_statsMutex);
+    frameTimeEstimateUs = m_stats.frameTimeEstimate;
+  }
+
+  // Start the frame so that it finishes just before the end of its period
+  const std::chrono::microseconds frameStartUs =
+      m_lastFrameUs + FrameTimeUs() - frameTimeEstimateUs - JIT_MARGIN;
+
+  const std::chrono::microseconds sleepTimeUs = frameStartUs - NowUs();
+  if (sleepTimeUs > std::chrono::microseconds::zero())
+  {
+    // The event is only set to stop the loop or change its speed
+    if (m_sleepEvent.Wait(sleepTimeUs))
+      return false;
+  }
+
+  return true;
+}
+
+void CGameLoop::AddFrameTime(std::chrono::microseconds frameTimeUs, bool bMissedDeadline)
+{
+  // Estimate the time of the next frame from the slowest recent frame, so that
+  // a single slow frame makes the following frames start earlier
+  m_frameTimes[m_frameTimeIndex] = frameTimeUs;
+  m_frameTimeIndex = (m_frameTimeIndex + 1) % m_frameTimes.size();
+
+  std::unique_lock lock(m_statsMutex);
+
+  m_stats.frameCount++;
+  m_stats.totalFrameTime += frameTimeUs;
+  m_stats.maxFrameTime = std::max(m_stats.maxFrameTime, frameTimeUs);
+  m_stats.frameTimeEstimate = *std::ranges::max_element(m_frameTimes);
+  if (bMissedDeadline)
+    m_stats.missedDeadlines++;
+}
+
 std::chrono::microseconds CGameLoop::FrameTimeUs() const
 {
   // Calculate the duration of one frame in microseconds based on the FPS and
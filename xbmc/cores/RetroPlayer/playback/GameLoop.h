@@ -8,11 +8,14 @@
 
 #pragma once
 
+#include "threads/CriticalSection.h"
 #include "threads/Event.h"
 #include "threads/Thread.h"
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <stdint.h>
 
 namespace KODI
 {
@@ -51,6 +54,27 @@ public:
   virtual void EndEvent() = 0;
 };
 
+/*!
+ * \brief Timing of the frames run by the game loop
+ */
+struct GameLoopStats
+{
+  //! Number of frames run forward
+  uint64_t frameCount{0};
+
+  //! Total time spent in the frame callback
+  std::chrono::microseconds totalFrameTime{0};
+
+  //! Longest time spent in the frame callback
+  std::chrono::microseconds maxFrameTime{0};
+
+  //! Current estimate of the frame time, used to schedule frames just in time
+  std::chrono::microseconds frameTimeEstimate{0};
+
+  //! Number of frames that finished after their deadline
+  uint64_t missedDeadlines{0};
+};
+
 /*!
  * \brief The game loop class
  *
@@ -61,6 +85,12 @@ public:
  * updates frame timing, and uses precise sleep intervals to maintain a
  * consistent frame rate while invoking the appropriate callbacks for frame
  * events.
+ *
+ * By default, a frame is run at the start of its frame period and the result
+ * waits until the next frame is shown. With latency reduction enabled, the
+ * loop measures how long the callback takes and delays running the frame
+ * until just before the end of the period, so that input is polled as late
+ * as possible.
  */
 class CGameLoop : protected CThread
 {
@@ -79,6 +109,18 @@ public:
   void SetSpeed(double speedFactor);
   void PauseAsync();
 
+  /*!
+   * \brief Schedule frames just in time for the end of their frame period
+   *
+   * \param bEnabled True to delay frames by the time left after running them
+   */
+  void SetLatencyReduction(bool bEnabled);
+
+  /*!
+   * \brief Get the timing of the frames run since the loop was created
+   */
+  GameLoopStats GetStats() const;
+
 protected:
   // implementation of CThread
   void Process() override;
@@ -86,6 +128,8 @@ protected:
 private:
   std::chrono::microseconds FrameTimeUs() const;
   std::chrono::microseconds NowUs() const;
+  bool SleepUntilFrameStart();
+  void AddFrameTime(std::chrono::microseconds frameTimeUs, bool bMissedDeadline);
 
   IGameLoopCallback* const m_callback;
   std::atomic<double> m_fps;
@@ -93,6 +137,15 @@ private:
   double m_loopSpeedFactor{0.0};
   std::chrono::microseconds m_lastFrameUs{std::chrono::microseconds::zero()};
   CEvent m_sleepEvent;
+
+  // Latency reduction
+  std::atomic<bool> m_latencyReduction{false};
+  std::array<std::chrono::microseconds, 32> m_frameTimes{};
+  unsigned int m_frameTimeIndex{0};
+
+  // Frame stats
+  GameLoopStats m_stats;
+  mutable CCriticalSection m_statsMutex;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -16,11 +16,10 @@
 #include "cores/RetroPlayer/rendering/RPRenderManager.h"
 #include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
-#include "cores/RetroPlayer/savestates/SavestateThumbnail.h"
 #include "cores/RetroPlayer/savestates/SavestateWriteQueue.h"
 #include "cores/RetroPlayer/savestates/SavestateWriteRequest.h"
-#include "cores/RetroPlayer/streams/memory/DeltaPairMemoryStream.h"
-#include "filesystem/File.h"
+#include "cores/RetroPlayer/streams/RPStreamManager.h"
+#include "cores/RetroPlayer/streams/memory/XorDeltaMemoryStream.h"
 #include "games/GameServices.h"
 #include "games/GameSettings.h"
 #include "games/addons/GameClient.h"
@@ -31,6 +30,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
@@ -40,14 +40,22 @@ using namespace RETRO;
 
 #define REWIND_FACTOR 0.25 // Rewind at 25% of gameplay speed
 
+namespace
+{
+// Interval between logging the frame timing and latency
+constexpr auto LATENCY_LOG_INTERVAL = std::chrono::seconds(30);
+} // namespace
+
 CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient,
                                          CRPRenderManager& renderManager,
+                                         CRPStreamManager& streamManager,
                                          CCheevos* cheevos,
                                          CGUIGameMessenger& guiMessenger,
                                          double fps,
                                          size_t serializeSize)
   : m_gameClient(gameClient),
     m_renderManager(renderManager),
+    m_streamManager(streamManager),
     m_cheevos(cheevos),
     m_guiMessenger(guiMessenger),
     m_gameLoop(this, fps),
@@ -55,6 +63,7 @@ CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient,
     m_savestateWriteQueue(std::make_unique<CSavestateWriteQueue>(m_guiMessenger))
 {
   UpdateMemoryStream();
+  UpdateLatencySettings();
 
   GAME::CGameSettings& gameSettings = CServiceBroker::GetGameServices().GameSettings();
   gameSettings.RegisterObserver(this);
@@ -185,31 +194,37 @@ std::string CReversiblePlayback::CreateSavestate(bool autosave,
 std::optional<SavestateWriteRequest> CReversiblePlayback::CaptureSavestateWriteRequest(
     bool autosave, const std::string& savePath, const CDateTime& nowUTC, uint64_t timestampFrames)
 {
-  std::unique_ptr<ISavestate> savestate = CSavestateDatabase::AllocateSavestate();
-  std::unique_ptr<ISavestate> loadedSavestate;
+  const auto start = std::chrono::steady_clock::now();
 
   const size_t memorySize = m_gameClient->SerializeSize();
   if (memorySize == 0)
     return std::nullopt;
 
+  std::unique_ptr<ISavestate> savestate = m_savestateWriteQueue->AcquireSavestate();
+
   uint8_t* const memoryData = savestate->GetMemoryBuffer(memorySize);
   if (memoryData == nullptr)
     return std::nullopt;
 
-  if (!m_gameClient->Serialize(memoryData, memorySize))
-    return std::nullopt;
-
-  // Attempt to get existing properties
+  // The rewind buffer already holds the state of the last frame, so copy it
+  // instead of asking the game client to serialize again
+  bool bCopied = false;
   {
-    std::unique_lock lock(m_savestateMutex);
-    if (!savePath.empty() && XFILE::CFile::Exists(savePath))
+    std::unique_lock lock(m_mutex);
+    if (m_memoryStream && m_memoryStream->FrameSize() == memorySize)
     {
-      loadedSavestate = CSavestateDatabase::AllocateSavestate();
-      if (!m_savestateDatabase->GetSavestate(savePath, *loadedSavestate))
-        loadedSavestate.reset();
+      const uint8_t* const currentFrame = m_memoryStream->CurrentFrame();
+      if (currentFrame != nullptr)
+      {
+        std::memcpy(memoryData, currentFrame, memorySize);
+        bCopied = true;
+      }
     }
   }
 
+  if (!bCopied && !m_gameClient->Serialize(memoryData, memorySize))
+    return std::nullopt;
+
   const std::string caption = m_cheevos->GetRichPresenceEvaluation();
   const std::string gameFileName = URIUtils::GetFileName(m_gameClient->GetGamePath());
   const double timestampWallClock =
@@ -218,8 +233,8 @@ std::optional<SavestateWriteRequest> CReversiblePlayback::CaptureSavestateWriteR
   const std::string gameClientId = m_gameClient->ID();
   const std::string gameClientVersion = m_gameClient->Version().asString();
 
+  // The label of an existing savestate is looked up by the write queue
   savestate->SetType(autosave ? SAVE_TYPE::AUTO : SAVE_TYPE::MANUAL);
-  savestate->SetLabel(loadedSavestate ? loadedSavestate->Label() : "");
   savestate->SetCaption(caption);
   savestate->SetCreated(nowUTC);
   savestate->SetGameFileName(gameFileName);
@@ -230,21 +245,22 @@ std::optional<SavestateWriteRequest> CReversiblePlayback::CaptureSavestateWriteR
 
   m_renderManager.SaveVideoFrame(savePath, *savestate);
 
-  const std::string thumbnailPath = CSavestateDatabase::MakeThumbnailPath(savePath);
-  std::optional<SavestateThumbnailPayload> thumbnail =
-      CreateSavestateThumbnailPayload(thumbnailPath, *savestate);
-  if (!thumbnail)
-    CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: No thumbnail captured for savestate {}", savePath);
+  const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const bool compressSavedGame = settings->GetBool(CSettings::SETTING_GAMES_COMPRESSSAVEDGAMES);
+
+  savestate->SetDeduplicateMemory(
+      settings->GetBool(CSettings::SETTING_GAMES_DEDUPLICATESAVEDGAMES));
 
-  const bool compressSavedGame = CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
-      CSettings::SETTING_GAMES_COMPRESSSAVEDGAMES);
+  const auto captureTime = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
 
   return SavestateWriteRequest{
       savePath,
       m_gameClient->GetGamePath(),
       std::move(savestate),
-      std::move(thumbnail),
+      CSavestateDatabase::MakeThumbnailPath(savePath),
       compressSavedGame,
+      captureTime,
   };
 }
 
@@ -299,10 +315,23 @@ bool CReversiblePlayback::LoadSavestate(const std::string& savestatePath)
 
 void CReversiblePlayback::FrameEvent()
 {
+  const unsigned int runAheadFrames = m_runAheadFrames.load();
+
+  // Input is polled at the start of the frame. When running ahead, the frame
+  // that is shown is the last one run ahead, which sees the same input.
+  m_renderManager.SetFrameInputTime(std::chrono::steady_clock::now());
+  if (runAheadFrames > 0)
+    m_renderManager.SetFramesHidden(true);
+
   m_gameClient->RunFrame();
   UpdateFrameRate();
 
-  AddFrame();
+  const bool bFrameAdded = AddFrame();
+
+  if (runAheadFrames > 0)
+    RunAhead(runAheadFrames, bFrameAdded);
+
+  LogLatencyStats();
 }
 
 void CReversiblePlayback::RewindEvent()
@@ -318,20 +347,99 @@ void CReversiblePlayback::EndEvent()
   m_renderManager.DestroyContext();
 }
 
-void CReversiblePlayback::AddFrame()
+bool CReversiblePlayback::AddFrame()
 {
   std::unique_lock lock(m_mutex);
 
+  bool bFrameAdded = false;
+
   if (m_memoryStream)
   {
     if (m_gameClient->Serialize(m_memoryStream->BeginFrame(), m_memoryStream->FrameSize()))
     {
       m_memoryStream->SubmitFrame();
       UpdatePlaybackStats();
+      bFrameAdded = true;
     }
   }
 
   m_totalFrameCount++;
+
+  return bFrameAdded;
+}
+
+void CReversiblePlayback::RunAhead(unsigned int frames, bool bFrameAdded)
+{
+  const size_t memorySize = m_gameClient->SerializeSize();
+
+  // Save the state of the real frame, which the rewind buffer already holds
+  // if it was just added
+  bool bSaved = false;
+  if (memorySize > 0)
+  {
+    m_runAheadState.resize(memorySize);
+
+    {
+      std::unique_lock lock(m_mutex);
+      if (bFrameAdded && m_memoryStream && m_memoryStream->FrameSize() == memorySize &&
+          m_memoryStream->CurrentFrame() != nullptr)
+      {
+        std::memcpy(m_runAheadState.data(), m_memoryStream->CurrentFrame(), memorySize);
+        bSaved = true;
+      }
+    }
+
+    if (!bSaved)
+      bSaved = m_gameClient->Serialize(m_runAheadState.data(), memorySize);
+  }
+
+  if (bSaved)
+  {
+    // Only the real frame is heard and only the last frame run ahead is seen
+    m_streamManager.SuppressAudio(true);
+
+    for (unsigned int frame = 1; frame <= frames; frame++)
+    {
+      if (frame == frames)
+        m_renderManager.SetFramesHidden(false);
+
+      m_gameClient->RunFrame();
+    }
+
+    m_streamManager.SuppressAudio(false);
+
+    // Roll back to the real frame
+    if (!m_gameClient->Deserialize(m_runAheadState.data(), memorySize))
+      CLog::Log(LOGERROR, "RetroPlayer[PLAYER]: Failed to roll back {} frames run ahead", frames);
+  }
+
+  m_renderManager.SetFramesHidden(false);
+}
+
+void CReversiblePlayback::LogLatencyStats()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now < m_nextLatencyLogTime)
+    return;
+
+  const bool bFirstLog = (m_nextLatencyLogTime == std::chrono::steady_clock::time_point{});
+  m_nextLatencyLogTime = now + LATENCY_LOG_INTERVAL;
+  if (bFirstLog)
+    return;
+
+  const GameLoopStats loopStats = m_gameLoop.GetStats();
+  const FrameLatencyStats latencyStats = m_renderManager.GetLatencyStats();
+
+  if (loopStats.frameCount == 0 || latencyStats.frameCount == 0)
+    return;
+
+  CLog::Log(LOGDEBUG,
+            "RetroPlayer[PLAYER]: Frame time {:.2f} ms avg, {:.2f} ms max, {} missed deadlines; "
+            "input-to-render latency {:.2f} ms avg, {:.2f} ms max; run-ahead {} frames",
+            loopStats.totalFrameTime.count() / 1000.0 / loopStats.frameCount,
+            loopStats.maxFrameTime.count() / 1000.0, loopStats.missedDeadlines,
+            latencyStats.totalLatency.count() / 1000.0 / latencyStats.frameCount,
+            latencyStats.maxLatency.count() / 1000.0, m_runAheadFrames.load());
 }
 
 void CReversiblePlayback::UpdateFrameRate()
@@ -378,7 +486,10 @@ void CReversiblePlayback::UpdatePlaybackStats()
 
   const uint64_t played = m_pastFrameCount + (m_memoryStream->CurrentFrame() ? 1 : 0);
   const uint64_t total = m_memoryStream->MaxFrameCount();
-  const uint64_t cached = m_futureFrameCount;
+
+  // The history actually held by the stream, which is less than the max
+  // frame count when the memory budget is reached first
+  const uint64_t cached = m_pastFrameCount + m_futureFrameCount;
 
   m_playTimeMs = MathUtils::round_int(1000.0 * played / m_gameLoop.FPS());
   m_totalTimeMs = MathUtils::round_int(1000.0 * total / m_gameLoop.FPS());
@@ -391,6 +502,7 @@ void CReversiblePlayback::Notify(const Observable& obs, const ObservableMessage
   {
     case ObservableMessageSettingsChanged:
       UpdateMemoryStream();
+      UpdateLatencySettings();
       break;
     default:
       break;
@@ -416,22 +528,29 @@ void CReversiblePlayback::UpdateMemoryStream()
 
     unsigned int frameCount = MathUtils::round_int(rewindBufferSec * m_gameLoop.FPS());
 
+    const size_t maxHistoryBytes =
+        static_cast<size_t>(gameSettings.MaxRewindMemoryMB()) * 1024 * 1024;
+
     if (!m_memoryStream)
     {
       const size_t memorySize = m_gameClient->SerializeSize();
 
-      // The rewind buffer holds one serialized state per frame, so its cost is
-      // the state size multiplied by the whole rewind window. Logged because
-      // a large state and a long window together run to gigabytes, which is
-      // otherwise invisible until the process is killed.
+      // The rewind buffer is bounded by both the rewind window and the memory
+      // budget. Logged because the window that fits in the budget depends on
+      // how well the game's state compresses, which is otherwise invisible.
       CLog::Log(LOGINFO,
-                "RetroPlayer[SAVE]: Rewind buffer: {} frames of {} bytes ({:.1f} MB) for {} "
-                "seconds at {:.2f} fps",
-                frameCount, memorySize,
-                static_cast<double>(memorySize) * frameCount / (1024.0 * 1024.0), rewindBufferSec,
-                m_gameLoop.FPS());
+                "RetroPlayer[SAVE]: Rewind buffer: up to {} frames of {} bytes for {} seconds at "
+                "{:.2f} fps, limited to {} MB",
+                frameCount, memorySize, rewindBufferSec, m_gameLoop.FPS(),
+                maxHistoryBytes / (1024 * 1024));
+
+      auto memoryStream = std::make_unique<CXorDeltaMemoryStream>();
 
-      m_memoryStream = std::make_unique<CDeltaPairMemoryStream>();
+      // Keep seeks cheap by placing a keyframe every second of gameplay
+      memoryStream->SetKeyframeInterval(
+          static_cast<uint64_t>(std::max(MathUtils::round_int(m_gameLoop.FPS()), 1)));
+
+      m_memoryStream = std::move(memoryStream);
       m_memoryStream->Init(memorySize, frameCount);
     }
 
@@ -439,6 +558,11 @@ void CReversiblePlayback::UpdateMemoryStream()
     {
       m_memoryStream->SetMaxFrameCount(frameCount);
     }
+
+    if (m_memoryStream->MaxHistoryBytes() != maxHistoryBytes)
+    {
+      m_memoryStream->SetMaxHistoryBytes(maxHistoryBytes);
+    }
   }
   else
   {
@@ -452,3 +576,17 @@ void CReversiblePlayback::UpdateMemoryStream()
     m_cacheTimeMs = 0;
   }
 }
+
+void CReversiblePlayback::UpdateLatencySettings()
+{
+  GAME::CGameSettings& gameSettings = CServiceBroker::GetGameServices().GameSettings();
+
+  m_gameLoop.SetLatencyReduction(gameSettings.LatencyReductionEnabled());
+
+  // Running ahead needs to roll back to the real frame
+  unsigned int runAheadFrames = 0;
+  if (m_gameClient->SerializeSize() > 0)
+    runAheadFrames = gameSettings.RunAheadFrames();
+
+  m_runAheadFrames.store(runAheadFrames);
+}
@@ -13,10 +13,13 @@
 #include "threads/CriticalSection.h"
 #include "utils/Observer.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 
 class CDateTime;
 
@@ -32,6 +35,7 @@ namespace RETRO
 class CCheevos;
 class CGUIGameMessenger;
 class CRPRenderManager;
+class CRPStreamManager;
 class CSavestateDatabase;
 class CSavestateWriteQueue;
 class IMemoryStream;
@@ -42,6 +46,7 @@ class CReversiblePlayback : public IPlayback, public IGameLoopCallback, public O
 public:
   CReversiblePlayback(GAME::CGameClient* gameClient,
                       CRPRenderManager& renderManager,
+                      CRPStreamManager& streamManager,
                       CCheevos* cheevos,
                       CGUIGameMessenger& guiMessenger,
                       double fps,
@@ -73,12 +78,15 @@ public:
   void Notify(const Observable& obs, const ObservableMessage msg) override;
 
 private:
-  void AddFrame();
+  bool AddFrame();
+  void RunAhead(unsigned int frames, bool bFrameAdded);
+  void LogLatencyStats();
   void UpdateFrameRate();
   void RewindFrames(uint64_t frames);
   void AdvanceFrames(uint64_t frames);
   void UpdatePlaybackStats();
   void UpdateMemoryStream();
+  void UpdateLatencySettings();
   std::optional<SavestateWriteRequest> CaptureSavestateWriteRequest(bool autosave,
                                                                     const std::string& savePath,
                                                                     const CDateTime& nowUTC,
@@ -87,6 +95,7 @@ private:
   // Construction parameter
   GAME::CGameClient* const m_gameClient;
   CRPRenderManager& m_renderManager;
+  CRPStreamManager& m_streamManager;
   CCheevos* const m_cheevos;
   CGUIGameMessenger& m_guiMessenger;
 
@@ -95,6 +104,11 @@ private:
   std::unique_ptr<IMemoryStream> m_memoryStream;
   CCriticalSection m_mutex;
 
+  // Latency reduction
+  std::atomic<unsigned int> m_runAheadFrames{0};
+  std::vector<uint8_t> m_runAheadState; // Only access from game loop thread
+  std::chrono::steady_clock::time_point m_nextLatencyLogTime; // Only access from game loop thread
+
   // Savestate functionality
   std::unique_ptr<CSavestateDatabase> m_savestateDatabase;
   std::unique_ptr<CSavestateWriteQueue> m_savestateWriteQueue;
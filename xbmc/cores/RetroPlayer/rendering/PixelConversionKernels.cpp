@@ -0,0 +1,333 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PixelConversionKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <cstring>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(HAS_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define PIXEL_CONVERSION_NEON
+#endif
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+// Portable C++ kernels
+
+uint8_t Expand5(unsigned int value)
+{
+  return static_cast<uint8_t>((value << 3) | (value >> 2));
+}
+
+uint8_t Expand6(unsigned int value)
+{
+  return static_cast<uint8_t>((value << 2) | (value >> 4));
+}
+
+void WriteBgra(uint8_t* target, uint8_t red, uint8_t green, uint8_t blue)
+{
+  target[0] = blue;
+  target[1] = green;
+  target[2] = red;
+  target[3] = 0xFF;
+}
+
+void Rgb565ToBgraScalar(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++)
+  {
+    uint16_t pixel;
+    std::memcpy(&pixel, source + i * sizeof(pixel), sizeof(pixel));
+
+    WriteBgra(target + i * 4, Expand5((pixel >> 11) & 0x1F), Expand6((pixel >> 5) & 0x3F),
+              Expand5(pixel & 0x1F));
+  }
+}
+
+void Rgb555ToBgraScalar(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++)
+  {
+    uint16_t pixel;
+    std::memcpy(&pixel, source + i * sizeof(pixel), sizeof(pixel));
+
+    WriteBgra(target + i * 4, Expand5((pixel >> 10) & 0x1F), Expand5((pixel >> 5) & 0x1F),
+              Expand5(pixel & 0x1F));
+  }
+}
+
+void XrgbToBgraScalar(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  for (size_t i = 0; i < pixelCount; i++)
+  {
+    uint32_t pixel;
+    std::memcpy(&pixel, source + i * sizeof(pixel), sizeof(pixel));
+
+    WriteBgra(target + i * 4, static_cast<uint8_t>(pixel >> 16), static_cast<uint8_t>(pixel >> 8),
+              static_cast<uint8_t>(pixel));
+  }
+}
+
+constexpr PixelConversionKernels SCALAR_KERNELS = {
+    "C++",
+    Rgb565ToBgraScalar,
+    Rgb555ToBgraScalar,
+    XrgbToBgraScalar,
+};
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+
+// SSE2 kernels, converting 8 pixels at a time
+
+__m128i Expand5SSE2(__m128i value)
+{
+  return _mm_or_si128(_mm_slli_epi16(value, 3), _mm_srli_epi16(value, 2));
+}
+
+__m128i Expand6SSE2(__m128i value)
+{
+  return _mm_or_si128(_mm_slli_epi16(value, 2), _mm_srli_epi16(value, 4));
+}
+
+// Interleave 8-bit channels held in 16-bit lanes into 8 BGRA pixels
+void StoreBgraSSE2(uint8_t* target, __m128i red, __m128i green, __m128i blue)
+{
+  const __m128i blueGreen = _mm_or_si128(blue, _mm_slli_epi16(green, 8));
+  const __m128i redAlpha = _mm_or_si128(red, _mm_set1_epi16(static_cast<short>(0xFF00)));
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_unpacklo_epi16(blueGreen, redAlpha));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 16),
+                   _mm_unpackhi_epi16(blueGreen, redAlpha));
+}
+
+void Rgb565ToBgraSSE2(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  const __m128i mask5 = _mm_set1_epi16(0x1F);
+  const __m128i mask6 = _mm_set1_epi16(0x3F);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+
+    const __m128i red = Expand5SSE2(_mm_srli_epi16(pixels, 11));
+    const __m128i green = Expand6SSE2(_mm_and_si128(_mm_srli_epi16(pixels, 5), mask6));
+    const __m128i blue = Expand5SSE2(_mm_and_si128(pixels, mask5));
+
+    StoreBgraSSE2(target + i * 4, red, green, blue);
+  }
+
+  Rgb565ToBgraScalar(target + i * 4, source + i * 2, pixelCount - i);
+}
+
+void Rgb555ToBgraSSE2(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  const __m128i mask5 = _mm_set1_epi16(0x1F);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+
+    const __m128i red = Expand5SSE2(_mm_and_si128(_mm_srli_epi16(pixels, 10), mask5));
+    const __m128i green = Expand5SSE2(_mm_and_si128(_mm_srli_epi16(pixels, 5), mask5));
+    const __m128i blue = Expand5SSE2(_mm_and_si128(pixels, mask5));
+
+    StoreBgraSSE2(target + i * 4, red, green, blue);
+  }
+
+  Rgb555ToBgraScalar(target + i * 4, source + i * 2, pixelCount - i);
+}
+
+void XrgbToBgraSSE2(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  // 0RGB32 in little endian is already laid out as BGRX
+  const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+  size_t i = 0;
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i * 4), _mm_or_si128(pixels, alpha));
+  }
+
+  XrgbToBgraScalar(target + i * 4, source + i * 4, pixelCount - i);
+}
+
+constexpr PixelConversionKernels SSE2_KERNELS = {
+    "SSE2",
+    Rgb565ToBgraSSE2,
+    Rgb555ToBgraSSE2,
+    XrgbToBgraSSE2,
+};
+
+#endif
+
+#if defined(PIXEL_CONVERSION_NEON)
+
+// NEON kernels, converting 8 pixels at a time
+
+uint8x8_t Expand5NEON(uint16x8_t value)
+{
+  return vmovn_u16(vorrq_u16(vshlq_n_u16(value, 3), vshrq_n_u16(value, 2)));
+}
+
+uint8x8_t Expand6NEON(uint16x8_t value)
+{
+  return vmovn_u16(vorrq_u16(vshlq_n_u16(value, 2), vshrq_n_u16(value, 4)));
+}
+
+void Rgb565ToBgraNEON(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+  const uint16x8_t mask6 = vdupq_n_u16(0x3F);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const uint16x8_t pixels = vld1q_u16(reinterpret_cast<const uint16_t*>(source + i * 2));
+
+    uint8x8x4_t bgra;
+    bgra.val[0] = Expand5NEON(vandq_u16(pixels, mask5));
+    bgra.val[1] = Expand6NEON(vandq_u16(vshrq_n_u16(pixels, 5), mask6));
+    bgra.val[2] = Expand5NEON(vshrq_n_u16(pixels, 11));
+    bgra.val[3] = vdup_n_u8(0xFF);
+
+    vst4_u8(target + i * 4, bgra);
+  }
+
+  Rgb565ToBgraScalar(target + i * 4, source + i * 2, pixelCount - i);
+}
+
+void Rgb555ToBgraNEON(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+
+  size_t i = 0;
+  for (; i + 8 <= pixelCount; i += 8)
+  {
+    const uint16x8_t pixels = vld1q_u16(reinterpret_cast<const uint16_t*>(source + i * 2));
+
+    uint8x8x4_t bgra;
+    bgra.val[0] = Expand5NEON(vandq_u16(pixels, mask5));
+    bgra.val[1] = Expand5NEON(vandq_u16(vshrq_n_u16(pixels, 5), mask5));
+    bgra.val[2] = Expand5NEON(vandq_u16(vshrq_n_u16(pixels, 10), mask5));
+    bgra.val[3] = vdup_n_u8(0xFF);
+
+    vst4_u8(target + i * 4, bgra);
+  }
+
+  Rgb555ToBgraScalar(target + i * 4, source + i * 2, pixelCount - i);
+}
+
+void XrgbToBgraNEON(uint8_t* target, const uint8_t* source, size_t pixelCount)
+{
+  // 0RGB32 in little endian is already laid out as BGRX
+  const uint32x4_t alpha = vdupq_n_u32(0xFF000000);
+
+  size_t i = 0;
+  for (; i + 4 <= pixelCount; i += 4)
+  {
+    const uint32x4_t pixels = vreinterpretq_u32_u8(vld1q_u8(source + i * 4));
+    vst1q_u8(target + i * 4, vreinterpretq_u8_u32(vorrq_u32(pixels, alpha)));
+  }
+
+  XrgbToBgraScalar(target + i * 4, source + i * 4, pixelCount - i);
+}
+
+constexpr PixelConversionKernels NEON_KERNELS = {
+    "NEON",
+    Rgb565ToBgraNEON,
+    Rgb555ToBgraNEON,
+    XrgbToBgraNEON,
+};
+
+#endif
+
+unsigned int GetCPUFeatures()
+{
+  // CPU info may not be registered yet, e.g. in unit tests
+  const std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  return cpuInfo ? cpuInfo->GetCPUFeatures() : 0;
+}
+} // namespace
+
+const PixelConversionKernels& KODI::RETRO::GetPixelConversionKernels()
+{
+  static const PixelConversionKernels& kernels = []() -> const PixelConversionKernels&
+  {
+    const PixelConversionKernels& selected = *GetSupportedPixelConversionKernels().back();
+    CLog::Log(LOGDEBUG, "RetroPlayer[RENDER]: Using {} kernels for pixel conversion",
+              selected.name);
+    return selected;
+  }();
+
+  return kernels;
+}
+
+const PixelConversionKernels& KODI::RETRO::GetScalarPixelConversionKernels()
+{
+  return SCALAR_KERNELS;
+}
+
+std::vector<const PixelConversionKernels*> KODI::RETRO::GetSupportedPixelConversionKernels()
+{
+  std::vector<const PixelConversionKernels*> kernels{&SCALAR_KERNELS};
+
+  [[maybe_unused]] const unsigned int features = GetCPUFeatures();
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  // SSE2 is part of every x86-64 CPU, so only 32-bit builds need to check
+#if defined(__x86_64__) || defined(_M_X64)
+  kernels.push_back(&SSE2_KERNELS);
+#else
+  if (features & CPU_FEATURE_SSE2)
+    kernels.push_back(&SSE2_KERNELS);
+#endif
+#endif
+
+#if defined(PIXEL_CONVERSION_NEON)
+  if (features & CPU_FEATURE_NEON)
+    kernels.push_back(&NEON_KERNELS);
+#endif
+
+  return kernels;
+}
+
+PixelConversionFunc KODI::RETRO::GetPixelConversion(const PixelConversionKernels& kernels,
+                                                    AVPixelFormat sourceFormat,
+                                                    AVPixelFormat targetFormat)
+{
+  if (targetFormat != AV_PIX_FMT_BGRA)
+    return nullptr;
+
+  switch (sourceFormat)
+  {
+    case AV_PIX_FMT_RGB565:
+      return kernels.rgb565ToBgra;
+    case AV_PIX_FMT_RGB555:
+      return kernels.rgb555ToBgra;
+    case AV_PIX_FMT_0RGB32:
+      return kernels.xrgbToBgra;
+    default:
+      break;
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+extern "C"
+{
+#include <libavutil/pixfmt.h>
+}
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Convert a row of pixels without scaling
+ *
+ * \param target The converted pixels
+ * \param source The pixels to convert
+ * \param pixelCount The number of pixels in the row
+ *
+ * Buffers don't need to be aligned.
+ */
+using PixelConversionFunc = void (*)(uint8_t* target, const uint8_t* source, size_t pixelCount);
+
+/*!
+ * \brief Set of kernels that convert the pixel formats of game clients
+ *
+ * Game clients output 0RGB32, RGB565 or RGB555 pixels in native endianness.
+ * Renderers that can't sample these formats directly use BGRA textures.
+ * Colors are expanded by replicating their high bits, so that the full
+ * range maps to 0-255.
+ */
+struct PixelConversionKernels
+{
+  /*!
+   * \brief Name of the instruction set, for logging
+   */
+  const char* name;
+
+  PixelConversionFunc rgb565ToBgra;
+  PixelConversionFunc rgb555ToBgra;
+  PixelConversionFunc xrgbToBgra;
+};
+
+/*!
+ * \brief Get the fastest kernels supported by the running CPU
+ *
+ * The selection is made once, based on the features reported by CCPUInfo,
+ * and falls back to portable C++ if no vector unit is available.
+ */
+const PixelConversionKernels& GetPixelConversionKernels();
+
+/*!
+ * \brief Get the portable C++ kernels, used as a reference implementation
+ */
+const PixelConversionKernels& GetScalarPixelConversionKernels();
+
+/*!
+ * \brief Get all kernels that can run on this CPU, for tests and benchmarks
+ *
+ * The kernels are ordered from slowest to fastest.
+ */
+std::vector<const PixelConversionKernels*> GetSupportedPixelConversionKernels();
+
+/*!
+ * \brief Get the kernel for a conversion between two formats
+ *
+ * \return The kernel, or nullptr if the conversion isn't supported
+ */
+PixelConversionFunc GetPixelConversion(const PixelConversionKernels& kernels,
+                                       AVPixelFormat sourceFormat,
+                                       AVPixelFormat targetFormat);
+} // namespace RETRO
+} // namespace KODI
@@ -8,6 +8,7 @@
 
 #include "RPRenderManager.h"
 
+#include "PixelConversionKernels.h"
 #include "RenderContext.h"
 #include "RenderSettings.h"
 #include "RenderTranslator.h"
@@ -150,6 +151,10 @@ bool CRPRenderManager::GetVideoBuffer(unsigned int width,
   if (m_bFlush || m_state != RENDER_STATE::CONFIGURED)
     return false;
 
+  // Let the client draw hidden frames into its own memory
+  if (m_bFramesHidden)
+    return false;
+
   // We should do our best to get a valid render buffer. If we return false,
   // the game add-on will likely allocate its own memory.
   IRenderBuffer* renderBuffer = nullptr;
@@ -208,6 +213,9 @@ void CRPRenderManager::AddFrame(const uint8_t* data,
   if (m_bFlush || m_state != RENDER_STATE::CONFIGURED)
     return;
 
+  if (m_bFramesHidden)
+    return;
+
   // Validate parameters
   if (data == nullptr || size == 0 || width == 0 || height == 0 || displayAspectRatio < 0.0f)
     return;
@@ -261,6 +269,7 @@ void CRPRenderManager::AddFrame(const uint8_t* data,
     for (auto renderBuffer : m_renderBuffers)
       renderBuffer->Release();
     m_renderBuffers = std::move(renderBuffers);
+    m_renderBuffersInputTime = m_frameInputTime;
 
     // Apply video properties to render buffers
     for (auto renderBuffer : m_renderBuffers)
@@ -301,6 +310,16 @@ void CRPRenderManager::AddFrame(const uint8_t* data,
   }
 }
 
+void CRPRenderManager::SetFrameInputTime(std::chrono::steady_clock::time_point inputTime)
+{
+  m_frameInputTime = inputTime;
+}
+
+void CRPRenderManager::SetFramesHidden(bool bHidden)
+{
+  m_bFramesHidden = bHidden;
+}
+
 void CRPRenderManager::Flush()
 {
   m_bFlush = true;
@@ -376,6 +395,12 @@ void CRPRenderManager::FrameMove()
   }
 }
 
+FrameLatencyStats CRPRenderManager::GetLatencyStats() const
+{
+  std::unique_lock lock(m_bufferMutex);
+  return m_latencyStats;
+}
+
 void CRPRenderManager::CheckFlush()
 {
   if (m_bFlush)
@@ -688,6 +713,20 @@ IRenderBuffer* CRPRenderManager::GetRenderBuffer(IRenderBufferPool* bufferPool)
   {
     renderBuffer = *it;
     renderBuffer->Acquire();
+
+    // Only the first render of a frame counts toward its latency
+    if (m_renderBuffersInputTime != std::chrono::steady_clock::time_point{} &&
+        m_renderBuffersInputTime != m_renderedInputTime)
+    {
+      const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - m_renderBuffersInputTime);
+
+      m_latencyStats.frameCount++;
+      m_latencyStats.totalLatency += latency;
+      m_latencyStats.maxLatency = std::max(m_latencyStats.maxLatency, latency);
+
+      m_renderedInputTime = m_renderBuffersInputTime;
+    }
   }
 
   return renderBuffer;
@@ -805,6 +844,15 @@ void CRPRenderManager::CopyFrame(IRenderBuffer* renderBuffer,
         }
       }
     }
+    else if (const PixelConversionFunc convert =
+                 GetPixelConversion(GetPixelConversionKernels(), format, renderBuffer->GetFormat());
+             convert != nullptr && renderBuffer->GetWidth() == width &&
+             renderBuffer->GetHeight() == height)
+    {
+      // Common game client formats are converted without going through swscale
+      for (unsigned int i = 0; i < height; i++)
+        convert(target + targetStride * i, source + sourceStride * i, width);
+    }
     else
     {
       SwsContext*& scalerContext = m_scalers[format][renderBuffer->GetFormat()];
@@ -19,6 +19,7 @@ extern "C"
 }
 
 #include <atomic>
+#include <chrono>
 #include <future>
 #include <map>
 #include <memory>
@@ -44,6 +45,21 @@ class IRenderBufferPool;
 class ISavestate;
 struct VideoStreamBuffer;
 
+/*!
+ * \brief Latency between polling input and rendering the resulting frame
+ */
+struct FrameLatencyStats
+{
+  //! Number of frames rendered with a known input time
+  uint64_t frameCount{0};
+
+  //! Total time from polling input to first rendering the frame
+  std::chrono::microseconds totalLatency{0};
+
+  //! Longest time from polling input to first rendering the frame
+  std::chrono::microseconds maxLatency{0};
+};
+
 /*!
  * \brief Renders video frames provided by the game loop
  *
@@ -104,6 +120,22 @@ public:
   void Flush();
   void DestroyContext();
 
+  /*!
+   * \brief Set the time at which input was polled for the frames that follow
+   *
+   * The time is attached to added frames and used to measure the latency
+   * until they are rendered.
+   */
+  void SetFrameInputTime(std::chrono::steady_clock::time_point inputTime);
+
+  /*!
+   * \brief Drop the frames that follow instead of showing them
+   *
+   * Used for frames that are emulated but replaced before they can be shown,
+   * such as the frames run ahead to reduce input latency.
+   */
+  void SetFramesHidden(bool bHidden);
+
   // Hardware rendering functions
   //! @todo These are only examples pulled from the history of the OpenGL
   //! effort and the required redesign will probably remove or change these
@@ -118,6 +150,14 @@ public:
   // Functions called from render thread
   void FrameMove();
 
+  /*!
+   * \brief Get the input-to-render latency of the frames rendered so far
+   *
+   * Latency ends when a frame is first rendered, which precedes the buffer
+   * swap by the time the GPU and display take to present it.
+   */
+  FrameLatencyStats GetLatencyStats() const;
+
   // Implementation of IRenderManager
   void RenderWindow(bool bClear, const RESOLUTION_INFO& coordsRes) override;
   void RenderControl(bool bClear,
@@ -262,6 +302,8 @@ private:
     uint8_t* memory;
   };
   std::vector<PendingBuffer> m_pendingBuffers; // Only access from game thread
+  bool m_bFramesHidden{false}; // Only access from game thread
+  std::chrono::steady_clock::time_point m_frameInputTime; // Only access from game thread
   std::vector<IRenderBuffer*> m_renderBuffers;
   std::map<AVPixelFormat, std::map<AVPixelFormat, SwsContext*>> m_scalers; // From -> to -> context
   std::vector<uint8_t> m_cachedFrame;
@@ -273,6 +315,11 @@ private:
       m_savestateBuffers; // Render buffers for savestates
   std::vector<std::future<void>> m_savestateThreads;
 
+  // Latency parameters, protected by m_bufferMutex
+  std::chrono::steady_clock::time_point m_renderBuffersInputTime;
+  std::chrono::steady_clock::time_point m_renderedInputTime;
+  FrameLatencyStats m_latencyStats;
+
   // State parameters
   enum class RENDER_STATE
   {
@@ -290,7 +337,7 @@ private:
 
   // Synchronization parameters
   CCriticalSection m_stateMutex;
-  CCriticalSection m_bufferMutex;
+  mutable CCriticalSection m_bufferMutex;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/rendering/PixelConversionKernels.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+std::vector<uint8_t> MakePixels(size_t size)
+{
+  std::mt19937 rng(size);
+  std::vector<uint8_t> pixels(size);
+  for (uint8_t& byte : pixels)
+    byte = static_cast<uint8_t>(rng());
+  return pixels;
+}
+
+void ExpectMatchesScalar(AVPixelFormat sourceFormat, size_t bytesPerPixel)
+{
+  const PixelConversionFunc scalar =
+      GetPixelConversion(GetScalarPixelConversionKernels(), sourceFormat, AV_PIX_FMT_BGRA);
+  ASSERT_NE(scalar, nullptr);
+
+  for (const PixelConversionKernels* kernels : GetSupportedPixelConversionKernels())
+  {
+    const PixelConversionFunc kernel =
+        GetPixelConversion(*kernels, sourceFormat, AV_PIX_FMT_BGRA);
+    ASSERT_NE(kernel, nullptr) << kernels->name;
+
+    // Pixel counts that leave a remainder after the vector loop
+    for (size_t pixelCount : {1, 7, 8, 9, 33, 320})
+    {
+      const std::vector<uint8_t> source = MakePixels(pixelCount * bytesPerPixel);
+
+      std::vector<uint8_t> expected(pixelCount * 4);
+      std::vector<uint8_t> actual(pixelCount * 4);
+      scalar(expected.data(), source.data(), pixelCount);
+      kernel(actual.data(), source.data(), pixelCount);
+
+      EXPECT_EQ(actual, expected) << kernels->name << ", pixel count " << pixelCount;
+    }
+  }
+}
+} // namespace
+
+TEST(TestPixelConversionKernels, Rgb565)
+{
+  const PixelConversionFunc convert = GetPixelConversion(GetScalarPixelConversionKernels(),
+                                                         AV_PIX_FMT_RGB565, AV_PIX_FMT_BGRA);
+  ASSERT_NE(convert, nullptr);
+
+  const uint16_t source[] = {0xF800, 0x07E0, 0x001F, 0xFFFF, 0x0000};
+  uint8_t target[sizeof(source) / sizeof(source[0]) * 4];
+  convert(target, reinterpret_cast<const uint8_t*>(source), sizeof(source) / sizeof(source[0]));
+
+  const uint8_t expected[] = {
+      0x00, 0x00, 0xFF, 0xFF, // Red
+      0x00, 0xFF, 0x00, 0xFF, // Green
+      0xFF, 0x00, 0x00, 0xFF, // Blue
+      0xFF, 0xFF, 0xFF, 0xFF, // White
+      0x00, 0x00, 0x00, 0xFF, // Black
+  };
+  EXPECT_EQ(std::memcmp(target, expected, sizeof(expected)), 0);
+
+  ExpectMatchesScalar(AV_PIX_FMT_RGB565, 2);
+}
+
+TEST(TestPixelConversionKernels, Rgb555)
+{
+  const PixelConversionFunc convert = GetPixelConversion(GetScalarPixelConversionKernels(),
+                                                         AV_PIX_FMT_RGB555, AV_PIX_FMT_BGRA);
+  ASSERT_NE(convert, nullptr);
+
+  // The unused high bit is ignored
+  const uint16_t source[] = {0x7C00, 0x83E0, 0x001F};
+  uint8_t target[sizeof(source) / sizeof(source[0]) * 4];
+  convert(target, reinterpret_cast<const uint8_t*>(source), sizeof(source) / sizeof(source[0]));
+
+  const uint8_t expected[] = {
+      0x00, 0x00, 0xFF, 0xFF, // Red
+      0x00, 0xFF, 0x00, 0xFF, // Green
+      0xFF, 0x00, 0x00, 0xFF, // Blue
+  };
+  EXPECT_EQ(std::memcmp(target, expected, sizeof(expected)), 0);
+
+  ExpectMatchesScalar(AV_PIX_FMT_RGB555, 2);
+}
+
+TEST(TestPixelConversionKernels, Xrgb)
+{
+  const PixelConversionFunc convert = GetPixelConversion(GetScalarPixelConversionKernels(),
+                                                         AV_PIX_FMT_0RGB32, AV_PIX_FMT_BGRA);
+  ASSERT_NE(convert, nullptr);
+
+  // The unused byte is replaced by an opaque alpha
+  const uint32_t source[] = {0x12345678};
+  uint8_t target[4];
+  convert(target, reinterpret_cast<const uint8_t*>(source), 1);
+
+  const uint8_t expected[] = {0x78, 0x56, 0x34, 0xFF};
+  EXPECT_EQ(std::memcmp(target, expected, sizeof(expected)), 0);
+
+  ExpectMatchesScalar(AV_PIX_FMT_0RGB32, 4);
+}
+
+TEST(TestPixelConversionKernels, Unsupported)
+{
+  const PixelConversionKernels& kernels = GetPixelConversionKernels();
+
+  EXPECT_EQ(GetPixelConversion(kernels, AV_PIX_FMT_RGB565, AV_PIX_FMT_RGBA), nullptr);
+  EXPECT_EQ(GetPixelConversion(kernels, AV_PIX_FMT_YUV420P, AV_PIX_FMT_BGRA), nullptr);
+}
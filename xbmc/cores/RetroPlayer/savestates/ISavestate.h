@@ -206,6 +206,17 @@ public:
    * \brief Copy the memory data to another savestate without requiring decompression
    */
   virtual bool CopyMemoryDataTo(ISavestate& target) const = 0;
+
+  /*!
+   * \brief The chunks of the memory data, or empty if the memory data isn't
+   *        stored in a chunk store
+   */
+  virtual std::vector<SavestateChunk> GetMemoryChunks() const = 0;
+
+  /*!
+   * \brief Set the chunk store folder that chunked memory data is read from
+   */
+  virtual void SetChunkFolder(const std::string& folderPath) = 0;
   ///}
 
   /// @name Builders for setting individual fields
@@ -232,6 +243,15 @@ public:
   virtual void SetDisplayAspectRatio(float displayAspectRatio) = 0;
   virtual void SetRotationDegCCW(unsigned int rotationCCW) = 0;
   virtual uint8_t* GetMemoryBuffer(size_t size) = 0;
+
+  /*!
+   * \brief Split the memory data into content-defined chunks when finalizing
+   *
+   * The chunks are written to the game's chunk store by CSavestateDatabase
+   * instead of being embedded in the savestate.
+   */
+  virtual void SetDeduplicateMemory(bool deduplicate) = 0;
+
   virtual void Finalize(bool compress) = 0;
   ///}
 
@@ -8,9 +8,11 @@
 
 #include "SavestateBlob.h"
 
+#include "SavestateChunkStore.h"
 #include "SavestateCompression.h"
 #include "utils/log.h"
 
+#include <cstring>
 #include <limits>
 
 using namespace KODI;
@@ -107,6 +109,7 @@ void PendingSavestateBlob::Clear()
   compressed.clear();
   uncompressedSize = 0;
   compression = SAVESTATE::CompressionType_None;
+  chunks.clear();
 }
 
 bool PendingSavestateBlob::HasCompressedData() const
@@ -161,6 +164,34 @@ SavestateBlobOffsets CSavestateBlob::CreateWriteOffsets(flatbuffers::FlatBufferB
                                                         const char* fieldName,
                                                         bool compress)
 {
+  if (!pending.chunks.empty())
+  {
+    std::vector<uint8_t> digests;
+    std::vector<uint32_t> sizes;
+    digests.reserve(pending.chunks.size() * SAVESTATE_CHUNK_DIGEST_SIZE);
+    sizes.reserve(pending.chunks.size());
+
+    for (const SavestateChunk& chunk : pending.chunks)
+    {
+      digests.insert(digests.end(), chunk.digest.begin(), chunk.digest.end());
+      sizes.push_back(chunk.size);
+    }
+
+    SavestateBlobOffsets offsets;
+
+    const std::vector<uint8_t> emptyData;
+    offsets.raw = builder.CreateVector(emptyData);
+    offsets.compressionType = SAVESTATE::CompressionType_None;
+    offsets.uncompressedSize = CSavestateChunkStore::GetTotalSize(pending.chunks);
+    offsets.chunkDigests = builder.CreateVector(digests);
+    offsets.chunkSizes = builder.CreateVector(sizes);
+
+    CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Split {} of {} bytes into {} chunks",
+              fieldName ? fieldName : "blob", offsets.uncompressedSize, pending.chunks.size());
+
+    return offsets;
+  }
+
   if (!compress)
   {
     if (pending.raw.empty() && pending.HasCompressedData())
@@ -271,6 +302,83 @@ bool CSavestateBlob::PrepareVideoData(const SAVESTATE::Savestate& savestate,
   return true;
 }
 
+bool CSavestateBlob::HasMemoryChunks(const SAVESTATE::Savestate& savestate)
+{
+  return savestate.memory_chunk_sizes() != nullptr && savestate.memory_chunk_sizes()->size() > 0;
+}
+
+bool CSavestateBlob::GetMemoryChunks(const SAVESTATE::Savestate& savestate,
+                                     std::vector<SavestateChunk>& chunks)
+{
+  chunks.clear();
+
+  const auto* digests = savestate.memory_chunk_digests();
+  const auto* sizes = savestate.memory_chunk_sizes();
+  if (digests == nullptr || sizes == nullptr ||
+      digests->size() != static_cast<size_t>(sizes->size()) * SAVESTATE_CHUNK_DIGEST_SIZE)
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid memory chunk references");
+    return false;
+  }
+
+  chunks.resize(sizes->size());
+
+  uint64_t totalSize = 0;
+  for (unsigned int i = 0; i < sizes->size(); i++)
+  {
+    SavestateChunk& chunk = chunks[i];
+    std::memcpy(chunk.digest.data(), digests->data() + i * SAVESTATE_CHUNK_DIGEST_SIZE,
+                SAVESTATE_CHUNK_DIGEST_SIZE);
+    chunk.size = sizes->Get(i);
+    totalSize += chunk.size;
+  }
+
+  if (totalSize != savestate.memory_data_uncompressed_size() ||
+      totalSize > MAX_SAVESTATE_MEMORY_SIZE)
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid chunked memory size {}, expected {}",
+              totalSize, savestate.memory_data_uncompressed_size());
+    chunks.clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool CSavestateBlob::PrepareChunkedMemoryData(const SAVESTATE::Savestate& savestate,
+                                              size_t expectedSize,
+                                              const CSavestateChunkStore& chunkStore,
+                                              std::vector<uint8_t>& memoryData)
+{
+  memoryData.clear();
+
+  if (!IsSupportedMemorySize(expectedSize))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid memory size: {}", expectedSize);
+    return false;
+  }
+
+  std::vector<SavestateChunk> chunks;
+  if (!GetMemoryChunks(savestate, chunks))
+    return false;
+
+  if (savestate.memory_data_uncompressed_size() != expectedSize)
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid chunked memory size {}, expected {}",
+              savestate.memory_data_uncompressed_size(), expectedSize);
+    return false;
+  }
+
+  memoryData.resize(expectedSize);
+  if (!chunkStore.ReadChunks(chunks, memoryData.data(), memoryData.size()))
+  {
+    memoryData.clear();
+    return false;
+  }
+
+  return true;
+}
+
 bool CSavestateBlob::IsValidRawMemoryData(const SAVESTATE::Savestate& savestate,
                                           size_t expectedSize)
 {
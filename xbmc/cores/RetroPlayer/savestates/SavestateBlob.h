@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "SavestateTypes.h"
 #include "savestate_generated.h"
 
 #include <cstddef>
@@ -20,6 +21,8 @@ namespace KODI
 {
 namespace RETRO
 {
+class CSavestateChunkStore;
+
 /*!
  * \brief FlatBuffer offsets and metadata for a serialized savestate blob
  *
@@ -39,6 +42,12 @@ struct SavestateBlobOffsets
 
   //! \brief Size of the blob after decompression, or zero for raw data
   uint64_t uncompressedSize{0};
+
+  //! \brief Offset of the concatenated chunk digests, for chunked data
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> chunkDigests;
+
+  //! \brief Offset of the chunk sizes, for chunked data
+  flatbuffers::Offset<flatbuffers::Vector<uint32_t>> chunkSizes;
 };
 
 /*!
@@ -61,6 +70,9 @@ struct PendingSavestateBlob
   //! \brief Compression applied to the compressed blob data
   SAVESTATE::CompressionType compression{SAVESTATE::CompressionType_None};
 
+  //! \brief Chunks of the blob in a chunk store, written instead of the data
+  std::vector<SavestateChunk> chunks;
+
   /*!
    * \brief Clear the blob data and reset its compression metadata
    */
@@ -97,7 +109,8 @@ public:
   /*!
    * \brief Create FlatBuffer offsets for pending raw or compressed blob data
    *
-   * Valid compressed data is copied without decompression. Invalid compressed
+   * Chunk references take precedence and are written without the data. Valid
+   * compressed data is copied without decompression. Invalid compressed
    * metadata falls back to the pending raw data.
    *
    * \param builder The builder that will own the returned offsets
@@ -141,6 +154,41 @@ public:
   static bool PrepareVideoData(const SAVESTATE::Savestate& savestate,
                                std::vector<uint8_t>& decompressedVideoData);
 
+  /*!
+   * \brief Check whether a savestate stores its memory data in a chunk store
+   *
+   * \param savestate The savestate to inspect
+   *
+   * \return True if chunk references are present, false otherwise
+   */
+  static bool HasMemoryChunks(const SAVESTATE::Savestate& savestate);
+
+  /*!
+   * \brief Get the validated chunk references of the memory data
+   *
+   * \param savestate The savestate containing the chunk references
+   * \param chunks Receives the chunks, in order
+   *
+   * \return True if the chunk references are valid, false otherwise
+   */
+  static bool GetMemoryChunks(const SAVESTATE::Savestate& savestate,
+                              std::vector<SavestateChunk>& chunks);
+
+  /*!
+   * \brief Read chunked memory data from a chunk store
+   *
+   * \param savestate The savestate containing the chunk references
+   * \param expectedSize The expected memory size in bytes
+   * \param chunkStore The chunk store of the savestate
+   * \param memoryData Receives the memory data
+   *
+   * \return True if the memory data was read, false on invalid or missing chunks
+   */
+  static bool PrepareChunkedMemoryData(const SAVESTATE::Savestate& savestate,
+                                       size_t expectedSize,
+                                       const CSavestateChunkStore& chunkStore,
+                                       std::vector<uint8_t>& memoryData);
+
   /*!
    * \brief Check whether raw memory data has the expected supported size
    *
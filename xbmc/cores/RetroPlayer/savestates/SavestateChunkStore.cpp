@@ -0,0 +1,524 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SavestateChunkStore.h"
+
+#include "SavestateCompression.h"
+#include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/IFileTypes.h"
+#include "utils/Digest.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr auto CHUNK_FOLDER = "chunks";
+constexpr auto CHUNK_EXTENSION = ".chunk";
+constexpr auto CHUNK_TEMP_EXTENSION = ".tmp";
+constexpr auto REFERENCES_FILE = "references.idx";
+
+/*!
+ * \brief Version of the references index, stored in its first byte
+ *
+ * The index is followed by the number of savestates and, for each savestate,
+ * its file name and the digests and sizes of its chunks. Integers are stored
+ * as little-endian uint32.
+ */
+constexpr uint8_t REFERENCES_VERSION = 1;
+
+/*!
+ * \brief Content-defined chunking parameters
+ *
+ * Chunk boundaries are found with the FastCDC gear hash. The stricter mask is
+ * used below the average chunk size and the looser mask above it, which
+ * keeps chunk sizes close to the average.
+ */
+constexpr size_t MIN_CHUNK_SIZE = 2 * 1024;
+constexpr size_t AVG_CHUNK_SIZE = 8 * 1024;
+constexpr size_t MAX_CHUNK_SIZE = 64 * 1024;
+constexpr uint64_t MASK_STRICT = 0x0003590703530000ULL;
+constexpr uint64_t MASK_LOOSE = 0x0000d90003530000ULL;
+
+/*!
+ * \brief Format of a chunk file, stored in its first byte
+ */
+enum ChunkFormat : uint8_t
+{
+  CHUNK_FORMAT_RAW = 0,
+  CHUNK_FORMAT_ZSTD = 1,
+};
+
+constexpr size_t CHUNK_HEADER_SIZE = 1;
+
+/*!
+ * \brief Generate the gear table with splitmix64
+ *
+ * The table must never change, or chunk boundaries would move and unchanged
+ * data would no longer be shared with existing savestates.
+ */
+constexpr std::array<uint64_t, 256> MakeGearTable()
+{
+  std::array<uint64_t, 256> table{};
+
+  uint64_t state = 0;
+  for (uint64_t& entry : table)
+  {
+    state += 0x9e3779b97f4a7c15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    entry = z ^ (z >> 31);
+  }
+
+  return table;
+}
+
+constexpr std::array<uint64_t, 256> GEAR_TABLE = MakeGearTable();
+
+/*!
+ * \brief Find the end of the chunk starting at data
+ *
+ * \return The size of the chunk, in bytes
+ */
+size_t FindChunkSize(const uint8_t* data, size_t size)
+{
+  if (size <= MIN_CHUNK_SIZE)
+    return size;
+
+  const size_t maxSize = std::min(size, MAX_CHUNK_SIZE);
+  const size_t normalSize = std::min(maxSize, AVG_CHUNK_SIZE);
+
+  uint64_t hash = 0;
+  size_t i = MIN_CHUNK_SIZE;
+
+  for (; i < normalSize; i++)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+    if ((hash & MASK_STRICT) == 0)
+      return i + 1;
+  }
+
+  for (; i < maxSize; i++)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+    if ((hash & MASK_LOOSE) == 0)
+      return i + 1;
+  }
+
+  return maxSize;
+}
+
+std::string MakeChunkName(const SavestateChunk& chunk)
+{
+  return StringUtils::ToHexadecimal(
+      std::string_view(reinterpret_cast<const char*>(chunk.digest.data()), chunk.digest.size()));
+}
+
+SavestateChunk MakeChunk(const uint8_t* data, size_t size)
+{
+  SavestateChunk chunk;
+  chunk.size = static_cast<uint32_t>(size);
+
+  UTILITY::CDigest digest{UTILITY::CDigest::Type::SHA256};
+  digest.Update(data, size);
+  const std::string rawDigest = digest.FinalizeRaw();
+
+  std::memcpy(chunk.digest.data(), rawDigest.data(),
+              std::min(rawDigest.size(), chunk.digest.size()));
+
+  return chunk;
+}
+
+void AppendUint32(std::vector<uint8_t>& data, uint32_t value)
+{
+  for (unsigned int i = 0; i < 4; i++)
+    data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+bool ReadUint32(const std::vector<uint8_t>& data, size_t& offset, uint32_t& value)
+{
+  if (data.size() - offset < 4)
+    return false;
+
+  value = 0;
+  for (unsigned int i = 0; i < 4; i++)
+    value |= static_cast<uint32_t>(data[offset + i]) << (8 * i);
+
+  offset += 4;
+  return true;
+}
+} // namespace
+
+CSavestateChunkStore::CSavestateChunkStore(std::string folderPath)
+  : m_folderPath(std::move(folderPath))
+{
+}
+
+std::string CSavestateChunkStore::MakeFolderPath(const std::string& savestatePath)
+{
+  return URIUtils::AddFileToFolder(URIUtils::GetDirectory(savestatePath), CHUNK_FOLDER);
+}
+
+std::vector<SavestateChunk> CSavestateChunkStore::SplitChunks(const uint8_t* data, size_t size)
+{
+  std::vector<SavestateChunk> chunks;
+
+  if (data == nullptr)
+    return chunks;
+
+  chunks.reserve(size / AVG_CHUNK_SIZE + 1);
+
+  size_t offset = 0;
+  while (offset < size)
+  {
+    const size_t chunkSize = FindChunkSize(data + offset, size - offset);
+    chunks.emplace_back(MakeChunk(data + offset, chunkSize));
+    offset += chunkSize;
+  }
+
+  return chunks;
+}
+
+size_t CSavestateChunkStore::GetTotalSize(const std::vector<SavestateChunk>& chunks)
+{
+  size_t totalSize = 0;
+  for (const SavestateChunk& chunk : chunks)
+    totalSize += chunk.size;
+
+  return totalSize;
+}
+
+bool CSavestateChunkStore::WriteChunks(const std::vector<SavestateChunk>& chunks,
+                                       const uint8_t* data,
+                                       bool compress,
+                                       SavestateChunkWriteStats& stats) const
+{
+  stats = {};
+
+  if (!XFILE::CDirectory::Exists(m_folderPath) && !XFILE::CDirectory::Create(m_folderPath))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to create chunk folder {}",
+              CURL::GetRedacted(m_folderPath));
+    return false;
+  }
+
+  size_t offset = 0;
+  for (const SavestateChunk& chunk : chunks)
+  {
+    const uint8_t* const chunkData = data != nullptr ? data + offset : nullptr;
+    offset += chunk.size;
+
+    // Chunks with the same digest have the same content
+    if (XFILE::CFile::Exists(MakeChunkPath(chunk), false))
+    {
+      stats.sharedChunks++;
+      continue;
+    }
+
+    if (chunkData == nullptr)
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Missing chunk {} in {}", MakeChunkName(chunk),
+                CURL::GetRedacted(m_folderPath));
+      return false;
+    }
+
+    size_t writtenBytes = 0;
+    if (!WriteChunk(chunk, chunkData, compress, writtenBytes))
+      return false;
+
+    stats.writtenChunks++;
+    stats.writtenBytes += writtenBytes;
+  }
+
+  return true;
+}
+
+bool CSavestateChunkStore::ReadChunks(const std::vector<SavestateChunk>& chunks,
+                                      uint8_t* data,
+                                      size_t size) const
+{
+  if (data == nullptr || GetTotalSize(chunks) != size)
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Chunk sizes don't match memory size {}", size);
+    return false;
+  }
+
+  size_t offset = 0;
+  for (const SavestateChunk& chunk : chunks)
+  {
+    if (!ReadChunk(chunk, data + offset))
+      return false;
+
+    offset += chunk.size;
+  }
+
+  return true;
+}
+
+void CSavestateChunkStore::DeleteChunks(const std::vector<SavestateChunk>& chunks) const
+{
+  for (const SavestateChunk& chunk : chunks)
+    XFILE::CFile::Delete(MakeChunkPath(chunk));
+}
+
+bool CSavestateChunkStore::ReadReferences(SavestateChunkReferences& references) const
+{
+  references.clear();
+
+  const std::string referencesPath = MakeReferencesPath();
+
+  XFILE::CFile file;
+  if (!XFILE::CFile::Exists(referencesPath, false) ||
+      !file.Open(referencesPath, XFILE::READ_TRUNCATED))
+    return false;
+
+  const int64_t length = file.GetLength();
+  if (length <= 0)
+    return false;
+
+  std::vector<uint8_t> data(static_cast<size_t>(length));
+  if (file.Read(data.data(), data.size()) != static_cast<ssize_t>(data.size()) ||
+      data[0] != REFERENCES_VERSION)
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to read chunk references {}",
+              CURL::GetRedacted(referencesPath));
+    return false;
+  }
+
+  size_t offset = 1;
+  uint32_t savestateCount = 0;
+  bool bSuccess = ReadUint32(data, offset, savestateCount);
+
+  for (uint32_t i = 0; bSuccess && i < savestateCount; i++)
+  {
+    uint32_t nameLength = 0;
+    if (!ReadUint32(data, offset, nameLength) || data.size() - offset < nameLength)
+    {
+      bSuccess = false;
+      break;
+    }
+
+    std::string name(reinterpret_cast<const char*>(data.data() + offset), nameLength);
+    offset += nameLength;
+
+    uint32_t chunkCount = 0;
+    if (!ReadUint32(data, offset, chunkCount) ||
+        (data.size() - offset) / (SAVESTATE_CHUNK_DIGEST_SIZE + 4) < chunkCount)
+    {
+      bSuccess = false;
+      break;
+    }
+
+    std::vector<SavestateChunk>& chunks = references[std::move(name)];
+    chunks.resize(chunkCount);
+    for (SavestateChunk& chunk : chunks)
+    {
+      std::memcpy(chunk.digest.data(), data.data() + offset, chunk.digest.size());
+      offset += chunk.digest.size();
+      ReadUint32(data, offset, chunk.size);
+    }
+  }
+
+  if (!bSuccess || offset != data.size())
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid chunk references {}",
+              CURL::GetRedacted(referencesPath));
+    references.clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool CSavestateChunkStore::WriteReferences(const SavestateChunkReferences& references) const
+{
+  std::vector<uint8_t> data;
+  data.push_back(REFERENCES_VERSION);
+
+  AppendUint32(data, static_cast<uint32_t>(references.size()));
+  for (const auto& [name, chunks] : references)
+  {
+    AppendUint32(data, static_cast<uint32_t>(name.size()));
+    data.insert(data.end(), name.begin(), name.end());
+
+    AppendUint32(data, static_cast<uint32_t>(chunks.size()));
+    for (const SavestateChunk& chunk : chunks)
+    {
+      data.insert(data.end(), chunk.digest.begin(), chunk.digest.end());
+      AppendUint32(data, chunk.size);
+    }
+  }
+
+  // Replace the index atomically, a truncated index would be rebuilt but an
+  // index missing references could cause referenced chunks to be deleted.
+  // For the same reason, an index that can't be replaced is deleted.
+  const std::string referencesPath = MakeReferencesPath();
+  const std::string tempPath = referencesPath + CHUNK_TEMP_EXTENSION;
+
+  bool bSuccess = false;
+  {
+    XFILE::CFile file;
+    if (!file.OpenForWrite(tempPath, true))
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to open chunk references {} for writing",
+                CURL::GetRedacted(tempPath));
+    else if (file.Write(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to write chunk references {}",
+                CURL::GetRedacted(tempPath));
+    else
+      bSuccess = true;
+  }
+
+  // Rename doesn't replace existing files on all platforms
+  XFILE::CFile::Delete(referencesPath);
+
+  if (bSuccess && !XFILE::CFile::Rename(tempPath, referencesPath))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to rename chunk references {}",
+              CURL::GetRedacted(tempPath));
+    bSuccess = false;
+  }
+
+  if (!bSuccess)
+    XFILE::CFile::Delete(tempPath);
+
+  return bSuccess;
+}
+
+std::string CSavestateChunkStore::MakeChunkPath(const SavestateChunk& chunk) const
+{
+  return URIUtils::AddFileToFolder(m_folderPath, MakeChunkName(chunk) + CHUNK_EXTENSION);
+}
+
+std::string CSavestateChunkStore::MakeReferencesPath() const
+{
+  return URIUtils::AddFileToFolder(m_folderPath, REFERENCES_FILE);
+}
+
+bool CSavestateChunkStore::WriteChunk(const SavestateChunk& chunk,
+                                      const uint8_t* data,
+                                      bool compress,
+                                      size_t& writtenBytes) const
+{
+  std::vector<uint8_t> compressed;
+  if (compress)
+    CSavestateCompression::CompressZstdIfSmaller(data, chunk.size, compressed);
+
+  const uint8_t format = compressed.empty() ? CHUNK_FORMAT_RAW : CHUNK_FORMAT_ZSTD;
+  const uint8_t* const payload = compressed.empty() ? data : compressed.data();
+  const size_t payloadSize = compressed.empty() ? chunk.size : compressed.size();
+
+  // Write to a temporary file first, so that an interrupted write never
+  // leaves a truncated chunk behind under a valid name
+  const std::string chunkPath = MakeChunkPath(chunk);
+  const std::string tempPath = chunkPath + CHUNK_TEMP_EXTENSION;
+
+  {
+    XFILE::CFile file;
+    if (!file.OpenForWrite(tempPath, true))
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to open chunk {} for writing",
+                CURL::GetRedacted(tempPath));
+      return false;
+    }
+
+    if (file.Write(&format, CHUNK_HEADER_SIZE) != static_cast<ssize_t>(CHUNK_HEADER_SIZE) ||
+        file.Write(payload, payloadSize) != static_cast<ssize_t>(payloadSize))
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to write chunk {}",
+                CURL::GetRedacted(tempPath));
+      file.Close();
+      XFILE::CFile::Delete(tempPath);
+      return false;
+    }
+  }
+
+  if (!XFILE::CFile::Rename(tempPath, chunkPath))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to rename chunk {}",
+              CURL::GetRedacted(tempPath));
+    XFILE::CFile::Delete(tempPath);
+    return false;
+  }
+
+  writtenBytes = CHUNK_HEADER_SIZE + payloadSize;
+  return true;
+}
+
+bool CSavestateChunkStore::ReadChunk(const SavestateChunk& chunk, uint8_t* data) const
+{
+  const std::string chunkPath = MakeChunkPath(chunk);
+
+  XFILE::CFile file;
+  if (!file.Open(chunkPath, XFILE::READ_TRUNCATED))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to open chunk {}", CURL::GetRedacted(chunkPath));
+    return false;
+  }
+
+  const int64_t length = file.GetLength();
+  if (length <= static_cast<int64_t>(CHUNK_HEADER_SIZE) ||
+      length > static_cast<int64_t>(CHUNK_HEADER_SIZE + chunk.size))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid chunk size {} for {}", length,
+              CURL::GetRedacted(chunkPath));
+    return false;
+  }
+
+  std::vector<uint8_t> fileData(static_cast<size_t>(length));
+  if (file.Read(fileData.data(), fileData.size()) != static_cast<ssize_t>(fileData.size()))
+  {
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to read chunk {}", CURL::GetRedacted(chunkPath));
+    return false;
+  }
+
+  const uint8_t* const payload = fileData.data() + CHUNK_HEADER_SIZE;
+  const size_t payloadSize = fileData.size() - CHUNK_HEADER_SIZE;
+
+  switch (fileData[0])
+  {
+    case CHUNK_FORMAT_RAW:
+    {
+      if (payloadSize != chunk.size)
+      {
+        CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Invalid raw chunk size {} for {}", payloadSize,
+                  CURL::GetRedacted(chunkPath));
+        return false;
+      }
+
+      std::memcpy(data, payload, payloadSize);
+      break;
+    }
+    case CHUNK_FORMAT_ZSTD:
+    {
+      if (!CSavestateCompression::DecompressZstd(payload, payloadSize, data, chunk.size, "chunk"))
+        return false;
+
+      break;
+    }
+    default:
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Unsupported chunk format {} for {}", fileData[0],
+                CURL::GetRedacted(chunkPath));
+      return false;
+    }
+  }
+
+  return true;
+}
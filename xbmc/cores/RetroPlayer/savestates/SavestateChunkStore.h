@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "SavestateTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Statistics of a chunk store write
+ */
+struct SavestateChunkWriteStats
+{
+  //! \brief Number of chunks that were already in the store
+  unsigned int sharedChunks{0};
+
+  //! \brief Number of chunks written to the store
+  unsigned int writtenChunks{0};
+
+  //! \brief Number of bytes written to the store
+  size_t writtenBytes{0};
+};
+
+/*!
+ * \brief Folder of content-addressed chunks shared by the savestates of a game
+ *
+ * Memory data is split with content-defined chunking, so that a change in
+ * one part of the memory only affects the chunks around it, even if it
+ * shifts the data that follows. Each chunk is stored once, named after its
+ * digest, and may be referenced by any number of savestates.
+ *
+ * Chunks are never modified after being written. The store also keeps an
+ * index of the chunks referenced by each savestate, so that unreferenced
+ * chunks can be found without reading every savestate. Keeping the index up
+ * to date and deleting unreferenced chunks is up to CSavestateDatabase.
+ */
+class CSavestateChunkStore
+{
+public:
+  /*!
+   * \brief Create a chunk store
+   *
+   * \param folderPath The folder containing the chunks, as returned by
+   *                   MakeFolderPath()
+   */
+  explicit CSavestateChunkStore(std::string folderPath);
+
+  /*!
+   * \brief Get the chunk folder shared by a savestate
+   *
+   * \param savestatePath The path of a savestate
+   *
+   * \return The folder of the chunk store, next to the savestate
+   */
+  static std::string MakeFolderPath(const std::string& savestatePath);
+
+  /*!
+   * \brief Split data into content-defined chunks
+   *
+   * \param data The data to split
+   * \param size The size of the data, in bytes
+   *
+   * \return The chunks covering the data, in order
+   */
+  static std::vector<SavestateChunk> SplitChunks(const uint8_t* data, size_t size);
+
+  /*!
+   * \brief Get the sum of the sizes of the given chunks
+   */
+  static size_t GetTotalSize(const std::vector<SavestateChunk>& chunks);
+
+  /*!
+   * \brief Write the chunks that are not in the store yet
+   *
+   * \param chunks The chunks covering the data
+   * \param data The data that was split, or nullptr if all chunks are
+   *             expected to be in the store already
+   * \param compress True to compress chunks where it reduces their size
+   * \param stats Receives the number of shared and written chunks
+   *
+   * \return True if all chunks are in the store, false on error
+   */
+  bool WriteChunks(const std::vector<SavestateChunk>& chunks,
+                   const uint8_t* data,
+                   bool compress,
+                   SavestateChunkWriteStats& stats) const;
+
+  /*!
+   * \brief Read chunks into a contiguous buffer
+   *
+   * \param chunks The chunks to read, in order
+   * \param data The buffer that receives the chunk data
+   * \param size The size of the buffer, which must equal the total size of
+   *             the chunks
+   *
+   * \return True if all chunks were read, false on missing or invalid chunks
+   */
+  bool ReadChunks(const std::vector<SavestateChunk>& chunks, uint8_t* data, size_t size) const;
+
+  /*!
+   * \brief Delete chunks from the store
+   *
+   * \param chunks The chunks to delete, which must no longer be referenced
+   */
+  void DeleteChunks(const std::vector<SavestateChunk>& chunks) const;
+
+  /*!
+   * \brief Read the index of chunks referenced by savestates
+   *
+   * \param references Receives the chunks referenced by each savestate
+   *
+   * \return True if the index was read, false if it is missing or invalid
+   */
+  bool ReadReferences(SavestateChunkReferences& references) const;
+
+  /*!
+   * \brief Replace the index of chunks referenced by savestates
+   *
+   * \param references The chunks referenced by each savestate
+   *
+   * \return True if the index was written, false on error, in which case the
+   *         previous index is deleted so that it gets rebuilt
+   */
+  bool WriteReferences(const SavestateChunkReferences& references) const;
+
+private:
+  std::string MakeChunkPath(const SavestateChunk& chunk) const;
+  std::string MakeReferencesPath() const;
+  bool WriteChunk(const SavestateChunk& chunk,
+                  const uint8_t* data,
+                  bool compress,
+                  size_t& writtenBytes) const;
+  bool ReadChunk(const SavestateChunk& chunk, uint8_t* data) const;
+
+  // Construction parameters
+  const std::string m_folderPath;
+};
+} // namespace RETRO
+} // namespace KODI
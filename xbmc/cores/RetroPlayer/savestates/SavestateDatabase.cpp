@@ -10,6 +10,7 @@
 
 #include "FileItem.h"
 #include "FileItemList.h"
+#include "SavestateChunkStore.h"
 #include "SavestateFlatBuffer.h"
 #include "ServiceBroker.h"
 #include "URL.h"
@@ -23,12 +24,21 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <mutex>
+#include <set>
 
 namespace
 {
 constexpr auto SAVESTATE_EXTENSION = ".sav";
 constexpr auto SAVESTATE_BASE_FOLDER = "special://home/saves/";
+
+// Serializes chunk writes with the deletion of unreferenced chunks, so that a
+// chunk can't be deleted between being found in the store and the new
+// savestate referencing it being written
+std::mutex chunkStoreMutex;
 } // namespace
 
 using namespace KODI;
@@ -47,7 +57,8 @@ std::unique_ptr<ISavestate> CSavestateDatabase::AllocateSavestate()
 
 bool CSavestateDatabase::AddSavestate(const std::string& savestatePath,
                                       const std::string& gamePath,
-                                      const ISavestate& save)
+                                      const ISavestate& save,
+                                      bool compress)
 {
   bool bSuccess = false;
   std::string path;
@@ -59,6 +70,51 @@ bool CSavestateDatabase::AddSavestate(const std::string& savestatePath,
 
   CLog::Log(LOGDEBUG, "Saving savestate to {}", CURL::GetRedacted(path));
 
+  std::unique_lock lock(chunkStoreMutex);
+
+  const std::string chunkFolder = CSavestateChunkStore::MakeFolderPath(path);
+  const CSavestateChunkStore chunkStore(chunkFolder);
+
+  const std::vector<SavestateChunk> chunks = save.GetMemoryChunks();
+  if (!chunks.empty())
+  {
+    // Renamed savestates only reference chunks that are already stored
+    const size_t chunkedSize = CSavestateChunkStore::GetTotalSize(chunks);
+    const uint8_t* memoryData =
+        save.GetMemorySize() == chunkedSize ? save.GetMemoryData() : nullptr;
+
+    SavestateChunkWriteStats stats;
+    if (!chunkStore.WriteChunks(chunks, memoryData, compress, stats))
+    {
+      CLog::Log(LOGERROR, "Failed to write savestate chunks");
+      return false;
+    }
+
+    CLog::Log(LOGDEBUG, "Wrote {} of {} savestate chunks ({} bytes), {} shared",
+              stats.writtenChunks, chunks.size(), stats.writtenBytes, stats.sharedChunks);
+  }
+
+  // Savestates without a chunk store don't reference any chunks
+  const std::string fileName = URIUtils::GetFileName(path);
+
+  SavestateChunkReferences references;
+  const bool hasReferences =
+      XFILE::CDirectory::Exists(chunkFolder) && GetChunkReferences(path, references);
+
+  // Chunks of an overwritten savestate may no longer be referenced
+  std::vector<SavestateChunk> previousChunks;
+  if (hasReferences)
+  {
+    std::vector<SavestateChunk>& savestateChunks = references[fileName];
+    previousChunks = std::move(savestateChunks);
+
+    // Reference both old and new chunks until the savestate is written, so
+    // that an interrupted write can only leave unreferenced chunks behind
+    savestateChunks = previousChunks;
+    savestateChunks.insert(savestateChunks.end(), chunks.begin(), chunks.end());
+    chunkStore.WriteReferences(references);
+  }
+
   const uint8_t* data = nullptr;
   size_t size = 0;
   if (save.Serialize(data, size))
@@ -77,6 +133,17 @@ bool CSavestateDatabase::AddSavestate(const std::string& savestatePath,
       CLog::Log(LOGERROR, "Failed to open savestate for writing");
   }
 
+  if (bSuccess && hasReferences)
+  {
+    references[fileName] = chunks;
+    if (chunkStore.WriteReferences(references))
+    {
+      std::erase_if(previousChunks, [&chunks](const SavestateChunk& chunk)
+                    { return std::ranges::find(chunks, chunk) != chunks.end(); });
+      DeleteUnreferencedChunks(path, references, previousChunks);
+    }
+  }
+
   return bSuccess;
 }
 
@@ -113,6 +180,9 @@ bool CSavestateDatabase::GetSavestate(const std::string& savestatePath, ISavesta
   if (!savestateData.empty())
     bSuccess = save.Deserialize(std::move(savestateData));
 
+  if (bSuccess)
+    save.SetChunkFolder(CSavestateChunkStore::MakeFolderPath(savestatePath));
+
   return bSuccess;
 }
 
@@ -137,6 +207,13 @@ bool CSavestateDatabase::GetSavestatesNav(CFileItemList& items,
   if (!XFILE::CDirectory::GetDirectory(savesFolder, items, hints))
     return false;
 
+  // The mask only applies to files, skip the chunk store
+  for (int i = items.Size() - 1; i >= 0; i--)
+  {
+    if (items[i]->IsFolder())
+      items.Remove(i);
+  }
+
   if (!gameClient.empty())
   {
     for (int i = items.Size() - 1; i >= 0; i--)
@@ -220,10 +297,10 @@ std::unique_ptr<ISavestate> CSavestateDatabase::RenameSavestate(const std::strin
 
   // Metadata-only saved-game rewrites may copy existing compressed payloads
   // without raw data available. Keep compression enabled here so existing
-  // payloads are preserved.
+  // payloads are preserved. Chunks are already stored, none are written.
   newSavestate->Finalize(true);
 
-  if (!AddSavestate(savestatePath, "", *newSavestate))
+  if (!AddSavestate(savestatePath, "", *newSavestate, true))
     return {};
 
   return newSavestate;
@@ -231,6 +308,15 @@ std::unique_ptr<ISavestate> CSavestateDatabase::RenameSavestate(const std::strin
 
 bool CSavestateDatabase::DeleteSavestate(const std::string& savestatePath)
 {
+  std::unique_lock lock(chunkStoreMutex);
+
+  const std::string chunkFolder = CSavestateChunkStore::MakeFolderPath(savestatePath);
+  const CSavestateChunkStore chunkStore(chunkFolder);
+
+  SavestateChunkReferences references;
+  const bool hasReferences =
+      XFILE::CDirectory::Exists(chunkFolder) && GetChunkReferences(savestatePath, references);
+
   if (!XFILE::CFile::Delete(savestatePath))
   {
     CLog::Log(LOGERROR, "Failed to delete savestate file {}", CURL::GetRedacted(savestatePath));
@@ -238,6 +324,19 @@ bool CSavestateDatabase::DeleteSavestate(const std::string& savestatePath)
   }
 
   XFILE::CFile::Delete(MakeThumbnailPath(savestatePath));
+
+  if (hasReferences)
+  {
+    auto it = references.find(URIUtils::GetFileName(savestatePath));
+    if (it != references.end())
+    {
+      const std::vector<SavestateChunk> chunks = std::move(it->second);
+      references.erase(it);
+      if (chunkStore.WriteReferences(references))
+        DeleteUnreferencedChunks(savestatePath, references, chunks);
+    }
+  }
+
   return true;
 }
 
@@ -274,6 +373,87 @@ std::string CSavestateDatabase::MakePath(const std::string& gamePath)
   return folderPath;
 }
 
+bool CSavestateDatabase::GetChunkReferences(const std::string& savestatePath,
+                                            SavestateChunkReferences& references)
+{
+  const CSavestateChunkStore chunkStore(CSavestateChunkStore::MakeFolderPath(savestatePath));
+  if (!chunkStore.ReadReferences(references))
+    CLog::Log(LOGDEBUG, "Rebuilding savestate chunk references");
+
+  // Savestates may have been added or removed outside of Kodi, only list the
+  // folder and read the savestates that are missing from the index
+  CFileItemList items;
+  XFILE::CDirectory::CHints hints;
+  hints.mask = SAVESTATE_EXTENSION;
+
+  if (!XFILE::CDirectory::GetDirectory(URIUtils::GetDirectory(savestatePath), items, hints))
+    return false;
+
+  std::set<std::string> fileNames;
+  for (const auto& item : items)
+  {
+    // The mask only applies to files, skip the chunk store
+    if (item->IsFolder())
+      continue;
+
+    std::string fileName = URIUtils::GetFileName(item->GetPath());
+    if (!references.contains(fileName))
+    {
+      std::unique_ptr<ISavestate> savestate = AllocateSavestate();
+      if (!GetSavestate(item->GetPath(), *savestate))
+      {
+        // Chunks referenced by an unreadable savestate can't be ruled out
+        CLog::Log(LOGDEBUG, "Keeping savestate chunks, failed to read {}",
+                  CURL::GetRedacted(item->GetPath()));
+        return false;
+      }
+
+      references[fileName] = savestate->GetMemoryChunks();
+    }
+
+    fileNames.insert(std::move(fileName));
+  }
+
+  std::erase_if(references, [&fileNames](const auto& savestateChunks)
+                { return !fileNames.contains(savestateChunks.first); });
+
+  return true;
+}
+
+void CSavestateDatabase::DeleteUnreferencedChunks(const std::string& savestatePath,
+                                                  const SavestateChunkReferences& references,
+                                                  const std::vector<SavestateChunk>& candidates)
+{
+  if (candidates.empty())
+    return;
+
+  using Digest = std::array<uint8_t, SAVESTATE_CHUNK_DIGEST_SIZE>;
+
+  std::set<Digest> unreferenced;
+  for (const SavestateChunk& chunk : candidates)
+    unreferenced.insert(chunk.digest);
+
+  // Keep chunks that are referenced by other savestates of the game
+  for (const auto& [fileName, chunks] : references)
+  {
+    for (const SavestateChunk& chunk : chunks)
+      unreferenced.erase(chunk.digest);
+
+    if (unreferenced.empty())
+      return;
+  }
+
+  std::vector<SavestateChunk> chunks;
+  chunks.reserve(unreferenced.size());
+  for (const Digest& digest : unreferenced)
+    chunks.push_back({digest, 0});
+
+  CLog::Log(LOGDEBUG, "Deleting {} unreferenced savestate chunks", chunks.size());
+
+  const CSavestateChunkStore chunkStore(CSavestateChunkStore::MakeFolderPath(savestatePath));
+  chunkStore.DeleteChunks(chunks);
+}
+
 bool CSavestateDatabase::CreateFolderIfNotExists(const std::string& path)
 {
   if (!XFILE::CDirectory::Exists(path))
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include "SavestateTypes.h"
+
 #include <memory>
 #include <string>
+#include <vector>
 
 class CDateTime;
 class CFileItem;
@@ -31,7 +34,8 @@ public:
 
   bool AddSavestate(const std::string& savestatePath,
                     const std::string& gamePath,
-                    const ISavestate& save);
+                    const ISavestate& save,
+                    bool compress);
 
   bool GetSavestate(const std::string& savestatePath, ISavestate& save);
 
@@ -55,6 +59,10 @@ public:
 
 private:
   static std::string MakePath(const std::string& gamePath);
+  bool GetChunkReferences(const std::string& savestatePath, SavestateChunkReferences& references);
+  void DeleteUnreferencedChunks(const std::string& savestatePath,
+                                const SavestateChunkReferences& references,
+                                const std::vector<SavestateChunk>& candidates);
   static bool CreateFolderIfNotExists(const std::string& path);
 };
 } // namespace RETRO
@@ -9,6 +9,7 @@
 #include "SavestateFlatBuffer.h"
 
 #include "SavestateBlob.h"
+#include "SavestateChunkStore.h"
 #include "XBDateTime.h"
 #include "savestate_generated.h"
 #include "utils/log.h"
@@ -23,7 +24,7 @@ using namespace RETRO;
 
 namespace
 {
-const uint8_t SCHEMA_VERSION = 5;
+const uint8_t SCHEMA_VERSION = 6;
 const uint8_t SCHEMA_MIN_VERSION = 1;
 
 constexpr const char* SCHEMA_VIDEO_DATA_FIELD_NAME = "video_data";
@@ -219,7 +220,11 @@ CSavestateFlatBuffer::~CSavestateFlatBuffer() = default;
 
 void CSavestateFlatBuffer::Reset()
 {
-  m_builder = std::make_unique<flatbuffers::FlatBufferBuilder>(INITIAL_FLATBUFFER_SIZE);
+  // Keep the buffer of the builder, so a reused savestate doesn't allocate it again
+  if (m_builder)
+    m_builder->Clear();
+  else
+    m_builder = std::make_unique<flatbuffers::FlatBufferBuilder>(INITIAL_FLATBUFFER_SIZE);
   m_data.clear();
   m_savestate = nullptr;
 
@@ -247,6 +252,8 @@ void CSavestateFlatBuffer::Reset()
   m_rotationCCW = 0;
   m_memoryData.Clear();
   m_memoryDataDecompressed.clear();
+  m_deduplicateMemory = false;
+  m_chunkFolder.clear();
 }
 
 bool CSavestateFlatBuffer::Serialize(const uint8_t*& data, size_t& size) const
@@ -618,9 +625,14 @@ const uint8_t* CSavestateFlatBuffer::GetMemoryData() const
   if (!m_memoryDataDecompressed.empty())
     return m_memoryDataDecompressed.data();
 
-  if (m_savestate != nullptr && m_savestate->memory_data())
+  if (m_savestate != nullptr && m_savestate->memory_data() &&
+      m_savestate->memory_data()->size() > 0)
     return m_savestate->memory_data()->data();
 
+  // Chunked memory data is kept until it's written to the chunk store
+  if (!m_memoryData.raw.empty())
+    return m_memoryData.raw.data();
+
   return nullptr;
 }
 
@@ -645,6 +657,19 @@ bool CSavestateFlatBuffer::PrepareMemoryData(size_t expectedSize)
   if (m_savestate == nullptr)
     return false;
 
+  if (CSavestateBlob::HasMemoryChunks(*m_savestate))
+  {
+    if (m_chunkFolder.empty())
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: No chunk store for chunked memory data");
+      return false;
+    }
+
+    const CSavestateChunkStore chunkStore(m_chunkFolder);
+    return CSavestateBlob::PrepareChunkedMemoryData(*m_savestate, expectedSize, chunkStore,
+                                                    m_memoryDataDecompressed);
+  }
+
   switch (m_savestate->memory_data_compression())
   {
     case SAVESTATE::CompressionType_None:
@@ -679,9 +704,13 @@ size_t CSavestateFlatBuffer::GetMemorySize() const
   if (!m_memoryDataDecompressed.empty())
     return m_memoryDataDecompressed.size();
 
-  if (m_savestate != nullptr && m_savestate->memory_data())
+  if (m_savestate != nullptr && m_savestate->memory_data() &&
+      m_savestate->memory_data()->size() > 0)
     return m_savestate->memory_data()->size();
 
+  if (!m_memoryData.raw.empty())
+    return m_memoryData.raw.size();
+
   return 0;
 }
 
@@ -694,6 +723,10 @@ bool CSavestateFlatBuffer::CopyMemoryDataTo(ISavestate& target) const
   targetFlatBuffer->m_memoryData.Clear();
   targetFlatBuffer->m_memoryDataDecompressed.clear();
 
+  // Chunks are already in the chunk store, so only the references are copied
+  if (CSavestateBlob::HasMemoryChunks(*m_savestate))
+    return CSavestateBlob::GetMemoryChunks(*m_savestate, targetFlatBuffer->m_memoryData.chunks);
+
   switch (m_savestate->memory_data_compression())
   {
     case SAVESTATE::CompressionType_None:
@@ -741,6 +774,21 @@ bool CSavestateFlatBuffer::CopyMemoryDataTo(ISavestate& target) const
   return true;
 }
 
+std::vector<SavestateChunk> CSavestateFlatBuffer::GetMemoryChunks() const
+{
+  std::vector<SavestateChunk> chunks;
+
+  if (m_savestate != nullptr && CSavestateBlob::HasMemoryChunks(*m_savestate))
+    CSavestateBlob::GetMemoryChunks(*m_savestate, chunks);
+
+  return chunks;
+}
+
+void CSavestateFlatBuffer::SetChunkFolder(const std::string& folderPath)
+{
+  m_chunkFolder = folderPath;
+}
+
 uint8_t* CSavestateFlatBuffer::GetMemoryBuffer(size_t size)
 {
   m_memoryData.Clear();
@@ -749,11 +797,22 @@ uint8_t* CSavestateFlatBuffer::GetMemoryBuffer(size_t size)
   return m_memoryData.raw.empty() ? nullptr : m_memoryData.raw.data();
 }
 
+void CSavestateFlatBuffer::SetDeduplicateMemory(bool deduplicate)
+{
+  m_deduplicateMemory = deduplicate;
+}
+
 void CSavestateFlatBuffer::Finalize(bool compress)
 {
   if (m_builder == nullptr)
     return;
 
+  if (m_deduplicateMemory && !m_memoryData.raw.empty())
+  {
+    m_memoryData.chunks =
+        CSavestateChunkStore::SplitChunks(m_memoryData.raw.data(), m_memoryData.raw.size());
+  }
+
   const SavestateBlobOffsets videoBlob =
       CSavestateBlob::CreateWriteOffsets(*m_builder, m_videoData, SCHEMA_VIDEO_DATA_FIELD_NAME, compress);
   const SavestateBlobOffsets memoryBlob =
@@ -838,6 +897,10 @@ void CSavestateFlatBuffer::Finalize(bool compress)
     savestateBuilder.add_memory_data_compressed(memoryBlob.compressed);
   savestateBuilder.add_memory_data_compression(memoryBlob.compressionType);
   savestateBuilder.add_memory_data_uncompressed_size(memoryBlob.uncompressedSize);
+  if (memoryBlob.chunkDigests.o != 0)
+    savestateBuilder.add_memory_chunk_digests(memoryBlob.chunkDigests);
+  if (memoryBlob.chunkSizes.o != 0)
+    savestateBuilder.add_memory_chunk_sizes(memoryBlob.chunkSizes);
 
   auto savestate = savestateBuilder.Finish();
   FinishSavestateBuffer(*m_builder, savestate);
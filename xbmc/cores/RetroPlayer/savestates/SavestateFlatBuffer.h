@@ -12,6 +12,8 @@
 #include "SavestateBlob.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <flatbuffers/flatbuffers.h>
 
@@ -61,6 +63,8 @@ public:
   bool PrepareMemoryData(size_t expectedSize) override;
   size_t GetMemorySize() const override;
   bool CopyMemoryDataTo(ISavestate& target) const override;
+  std::vector<SavestateChunk> GetMemoryChunks() const override;
+  void SetChunkFolder(const std::string& folderPath) override;
   void SetType(SAVE_TYPE type) override;
   void SetSlot(uint8_t slot) override;
   void SetLabel(const std::string& label) override;
@@ -83,6 +87,7 @@ public:
   void SetDisplayAspectRatio(float displayAspectRatio) override;
   void SetRotationDegCCW(unsigned int rotationCCW) override;
   uint8_t* GetMemoryBuffer(size_t size) override;
+  void SetDeduplicateMemory(bool deduplicate) override;
   void Finalize(bool compress) override;
   bool Deserialize(std::vector<uint8_t> data) override;
 
@@ -133,6 +138,8 @@ private:
   unsigned int m_rotationCCW{0};
   PendingSavestateBlob m_memoryData;
   std::vector<uint8_t> m_memoryDataDecompressed;
+  bool m_deduplicateMemory{false};
+  std::string m_chunkFolder;
 };
 } // namespace RETRO
 } // namespace KODI
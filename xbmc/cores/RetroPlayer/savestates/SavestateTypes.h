@@ -8,6 +8,13 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
 namespace KODI
 {
 namespace RETRO
@@ -24,5 +31,27 @@ enum class SAVE_TYPE
   AUTO,
   MANUAL,
 };
+
+//! \brief Size of a savestate chunk digest (SHA-256), in bytes
+constexpr size_t SAVESTATE_CHUNK_DIGEST_SIZE = 32;
+
+/*!
+ * \brief Reference to a content-addressed chunk of savestate memory
+ */
+struct SavestateChunk
+{
+  //! \brief SHA-256 digest of the chunk data
+  std::array<uint8_t, SAVESTATE_CHUNK_DIGEST_SIZE> digest{};
+
+  //! \brief Size of the chunk data, in bytes
+  uint32_t size{0};
+
+  bool operator==(const SavestateChunk& other) const = default;
+};
+
+/*!
+ * \brief Chunks referenced by each savestate of a game, by savestate file name
+ */
+using SavestateChunkReferences = std::map<std::string, std::vector<SavestateChunk>>;
 } // namespace RETRO
 } // namespace KODI
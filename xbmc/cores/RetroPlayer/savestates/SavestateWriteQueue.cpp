@@ -10,19 +10,26 @@
 
 #include "ISavestate.h"
 #include "SavestateDatabase.h"
+#include "SavestateThumbnail.h"
 #include "SavestateWriteRequest.h"
 #include "ServiceBroker.h"
 #include "cores/RetroPlayer/guibridge/GUIGameMessenger.h"
+#include "filesystem/File.h"
 #include "jobs/Job.h"
 #include "jobs/JobQueue.h"
 #include "messaging/ApplicationMessenger.h"
 #include "messaging/ThreadMessage.h"
+#include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
 using namespace KODI;
 using namespace RETRO;
@@ -46,10 +53,29 @@ struct RefreshState
   CGUIGameMessenger* guiMessenger{nullptr};
   bool acceptingRefreshes{true};
 };
+
+// Written savestates are returned here so that the next capture can reuse
+// their video and memory buffers instead of growing new ones
+struct SavestatePool
+{
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ISavestate>> savestates;
+};
+
+struct SavestatePipelineTimings
+{
+  std::mutex mutex;
+  SavestatePipelineStats stats;
+};
 } // namespace KODI::RETRO
 
 namespace
 {
+// Savestates in flight rarely exceed one being encoded and one being written
+constexpr size_t MAX_POOLED_SAVESTATES = 2;
+
+using Clock = std::chrono::steady_clock;
+
 struct SavestateFileWriteRequest
 {
   std::string savePath;
@@ -85,6 +111,49 @@ private:
   std::shared_ptr<WriteTracker> m_tracker;
 };
 
+/*!
+ * \brief Arm a write queued by a pipeline stage that is itself still pending
+ *
+ * The caller's pending write keeps Wait() from returning, so follow-up
+ * stages are armed even after Wait() stopped accepting new writes.
+ */
+void ArmContinuation(WriteTracker& tracker)
+{
+  std::unique_lock lock(tracker.mutex);
+  ++tracker.pendingWrites;
+}
+
+void RecordStageTime(SavestatePipelineTimings& timings,
+                     SavestateStageStats SavestatePipelineStats::*stage,
+                     std::chrono::microseconds duration)
+{
+  const uint64_t durationUs = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+
+  std::unique_lock lock(timings.mutex);
+  SavestateStageStats& stats = timings.stats.*stage;
+  stats.count++;
+  stats.totalUs += durationUs;
+  stats.maxUs = std::max(stats.maxUs, durationUs);
+}
+
+std::chrono::microseconds ElapsedSince(Clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+}
+
+void ReleaseSavestate(SavestatePool& pool, std::unique_ptr<ISavestate> savestate)
+{
+  if (!savestate)
+    return;
+
+  // Reset outside the lock, it keeps the buffer capacity
+  savestate->Reset();
+
+  std::unique_lock lock(pool.mutex);
+  if (pool.savestates.size() < MAX_POOLED_SAVESTATES)
+    pool.savestates.emplace_back(std::move(savestate));
+}
+
 void RefreshSavestatesOnApplicationThread(void* userptr);
 
 struct RefreshSavestatesCallback : KODI::MESSAGING::ThreadMessageCallback
@@ -134,9 +203,13 @@ class CSavestateWriteJob : public CJob
 public:
   CSavestateWriteJob(SavestateFileWriteRequest request,
                      std::shared_ptr<RefreshState> refreshState,
+                     std::shared_ptr<SavestatePool> pool,
+                     std::shared_ptr<SavestatePipelineTimings> timings,
                      std::shared_ptr<WriteTracker> tracker)
     : m_request(std::move(request)),
       m_refreshState(std::move(refreshState)),
+      m_pool(std::move(pool)),
+      m_timings(std::move(timings)),
       m_completionGuard(std::move(tracker))
   {
   }
@@ -146,11 +219,16 @@ public:
     if (m_request.savePath.empty() || m_request.gamePath.empty() || !m_request.savestate)
       return false;
 
-    m_request.savestate->Finalize(m_request.compressSavedGame);
+    const Clock::time_point start = Clock::now();
 
     CSavestateDatabase database;
     const bool success =
-        database.AddSavestate(m_request.savePath, m_request.gamePath, *m_request.savestate);
+        database.AddSavestate(m_request.savePath, m_request.gamePath, *m_request.savestate,
+                              m_request.compressSavedGame);
+
+    RecordStageTime(*m_timings, &SavestatePipelineStats::write, ElapsedSince(start));
+
+    ReleaseSavestate(*m_pool, std::move(m_request.savestate));
 
     if (success)
       PostSavestateRefresh(m_refreshState, m_request.savePath);
@@ -161,6 +239,8 @@ public:
 private:
   SavestateFileWriteRequest m_request;
   std::shared_ptr<RefreshState> m_refreshState;
+  std::shared_ptr<SavestatePool> m_pool;
+  std::shared_ptr<SavestatePipelineTimings> m_timings;
   CWriteCompletionGuard m_completionGuard;
 };
 
@@ -168,26 +248,169 @@ class CSavestateThumbnailWriteJob : public CJob
 {
 public:
   CSavestateThumbnailWriteJob(SavestateThumbnailPayload payload,
+                              std::shared_ptr<SavestatePipelineTimings> timings,
                               std::shared_ptr<WriteTracker> tracker)
     : m_payload(std::move(payload)),
+      m_timings(std::move(timings)),
       m_completionGuard(std::move(tracker))
   {
   }
 
-  bool DoWork() override { return WriteSavestateThumbnailPayload(m_payload); }
+  bool DoWork() override
+  {
+    const Clock::time_point start = Clock::now();
+
+    const bool success = WriteSavestateThumbnailPayload(m_payload);
+
+    RecordStageTime(*m_timings, &SavestatePipelineStats::thumbnail, ElapsedSince(start));
+
+    return success;
+  }
 
 private:
   SavestateThumbnailPayload m_payload;
+  std::shared_ptr<SavestatePipelineTimings> m_timings;
+  CWriteCompletionGuard m_completionGuard;
+};
+
+class CSavestateEncodeJob : public CJob
+{
+public:
+  CSavestateEncodeJob(SavestateWriteRequest request,
+                      CJobQueue& fileWriteQueue,
+                      CJobQueue& thumbnailWriteQueue,
+                      std::shared_ptr<RefreshState> refreshState,
+                      std::shared_ptr<SavestatePool> pool,
+                      std::shared_ptr<SavestatePipelineTimings> timings,
+                      std::shared_ptr<WriteTracker> tracker)
+    : m_request(std::move(request)),
+      m_fileWriteQueue(fileWriteQueue),
+      m_thumbnailWriteQueue(thumbnailWriteQueue),
+      m_refreshState(std::move(refreshState)),
+      m_pool(std::move(pool)),
+      m_timings(std::move(timings)),
+      m_tracker(tracker),
+      m_completionGuard(std::move(tracker))
+  {
+  }
+
+  bool DoWork() override
+  {
+    if (m_request.savePath.empty() || m_request.gamePath.empty() || !m_request.savestate)
+      return false;
+
+    const Clock::time_point start = Clock::now();
+
+    ISavestate& savestate = *m_request.savestate;
+
+    // Preserve the label when overwriting an existing savestate. Writes are
+    // serialized in order, so an earlier write to the same path may still be
+    // in flight, in which case the label from before that write is kept.
+    savestate.SetLabel(GetExistingLabel(m_request.savePath));
+
+    // Copy the thumbnail before the video data is compressed
+    std::optional<SavestateThumbnailPayload> thumbnail;
+    if (!m_request.thumbnailPath.empty())
+    {
+      thumbnail = CreateSavestateThumbnailPayload(m_request.thumbnailPath, savestate);
+      if (!thumbnail)
+        CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: No thumbnail captured for savestate {}",
+                  m_request.savePath);
+    }
+
+    savestate.Finalize(m_request.compressSavedGame);
+
+    const std::chrono::microseconds encodeTime = ElapsedSince(start);
+    RecordStageTime(*m_timings, &SavestatePipelineStats::encode, encodeTime);
+
+    CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Savestate {} captured in {} us, encoded in {} us",
+              URIUtils::GetFileName(m_request.savePath), m_request.captureTime.count(),
+              encodeTime.count());
+
+    if (!QueueFileWrite())
+      return false;
+
+    // Thumbnail writes are best-effort. If queueing or writing the thumbnail
+    // fails, keep the savestate file.
+    if (thumbnail)
+      QueueThumbnailWrite(std::move(*thumbnail));
+
+    return true;
+  }
+
+private:
+  static std::string GetExistingLabel(const std::string& savePath)
+  {
+    if (!XFILE::CFile::Exists(savePath))
+      return "";
+
+    std::unique_ptr<ISavestate> loadedSavestate = CSavestateDatabase::AllocateSavestate();
+
+    CSavestateDatabase database;
+    if (!database.GetSavestate(savePath, *loadedSavestate))
+      return "";
+
+    return loadedSavestate->Label();
+  }
+
+  bool QueueFileWrite()
+  {
+    ArmContinuation(*m_tracker);
+
+    SavestateFileWriteRequest request{
+        std::move(m_request.savePath),
+        std::move(m_request.gamePath),
+        std::move(m_request.savestate),
+        m_request.compressSavedGame,
+    };
+
+    auto* job = new CSavestateWriteJob(std::move(request), m_refreshState, m_pool, m_timings,
+                                       m_tracker);
+
+    if (!m_fileWriteQueue.AddJob(job))
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to queue savestate write job");
+      return false;
+    }
+
+    return true;
+  }
+
+  bool QueueThumbnailWrite(SavestateThumbnailPayload payload)
+  {
+    ArmContinuation(*m_tracker);
+
+    auto* job = new CSavestateThumbnailWriteJob(std::move(payload), m_timings, m_tracker);
+
+    if (!m_thumbnailWriteQueue.AddJob(job))
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to queue savestate thumbnail write job");
+      return false;
+    }
+
+    return true;
+  }
+
+  SavestateWriteRequest m_request;
+  CJobQueue& m_fileWriteQueue;
+  CJobQueue& m_thumbnailWriteQueue;
+  std::shared_ptr<RefreshState> m_refreshState;
+  std::shared_ptr<SavestatePool> m_pool;
+  std::shared_ptr<SavestatePipelineTimings> m_timings;
+  std::shared_ptr<WriteTracker> m_tracker;
   CWriteCompletionGuard m_completionGuard;
 };
 } // namespace
 
 CSavestateWriteQueue::CSavestateWriteQueue(CGUIGameMessenger& guiMessenger)
   : m_guiMessenger(guiMessenger),
+    m_encodeQueue(false, 1, CJob::PRIORITY_LOW),
     m_fileWriteQueue(false, 1, CJob::PRIORITY_LOW),
     m_thumbnailWriteQueue(false, 1, CJob::PRIORITY_LOW),
     m_refreshState(std::make_shared<RefreshState>()),
-    m_tracker(std::make_shared<WriteTracker>())
+    m_tracker(std::make_shared<WriteTracker>()),
+    m_pool(std::make_shared<SavestatePool>()),
+    m_timings(std::make_shared<SavestatePipelineTimings>())
 {
   m_refreshState->guiMessenger = &m_guiMessenger;
 }
@@ -197,20 +420,33 @@ CSavestateWriteQueue::~CSavestateWriteQueue()
   Wait();
 }
 
+std::unique_ptr<ISavestate> CSavestateWriteQueue::AcquireSavestate()
+{
+  {
+    std::unique_lock lock(m_pool->mutex);
+    if (!m_pool->savestates.empty())
+    {
+      std::unique_ptr<ISavestate> savestate = std::move(m_pool->savestates.back());
+      m_pool->savestates.pop_back();
+      return savestate;
+    }
+  }
+
+  return CSavestateDatabase::AllocateSavestate();
+}
+
 void CSavestateWriteQueue::QueueSavestateWrite(SavestateWriteRequest request)
 {
-  std::optional<SavestateThumbnailPayload> thumbnail = std::move(request.thumbnail);
+  RecordStageTime(*m_timings, &SavestatePipelineStats::capture, request.captureTime);
 
-  if (!QueueSavestateFileWrite(std::move(request.savePath), std::move(request.gamePath),
-                               std::move(request.savestate), request.compressSavedGame))
+  if (!ArmWrite())
     return;
 
-  if (thumbnail)
-  {
-    // Thumbnail writes are best-effort. If queueing or writing the thumbnail
-    // fails, keep the savestate file.
-    (void)QueueThumbnailWrite(std::move(*thumbnail));
-  }
+  auto* job = new CSavestateEncodeJob(std::move(request), m_fileWriteQueue, m_thumbnailWriteQueue,
+                                      m_refreshState, m_pool, m_timings, m_tracker);
+
+  if (!m_encodeQueue.AddJob(job))
+    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to queue savestate encode job");
 }
 
 void CSavestateWriteQueue::Wait()
@@ -226,6 +462,12 @@ void CSavestateWriteQueue::Wait()
   m_tracker->condition.wait(lock, [this] { return m_tracker->pendingWrites == 0; });
 }
 
+SavestatePipelineStats CSavestateWriteQueue::GetStats() const
+{
+  std::unique_lock lock(m_timings->mutex);
+  return m_timings->stats;
+}
+
 bool CSavestateWriteQueue::ArmWrite()
 {
   std::unique_lock lock(m_tracker->mutex);
@@ -235,45 +477,3 @@ bool CSavestateWriteQueue::ArmWrite()
   ++m_tracker->pendingWrites;
   return true;
 }
-
-bool CSavestateWriteQueue::QueueSavestateFileWrite(std::string savePath,
-                                                   std::string gamePath,
-                                                   std::unique_ptr<ISavestate> savestate,
-                                                   bool compressSavedGame)
-{
-  if (!ArmWrite())
-    return false;
-
-  SavestateFileWriteRequest request{
-      std::move(savePath),
-      std::move(gamePath),
-      std::move(savestate),
-      compressSavedGame,
-  };
-
-  auto* job = new CSavestateWriteJob(std::move(request), m_refreshState, m_tracker);
-
-  if (!m_fileWriteQueue.AddJob(job))
-  {
-    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to queue savestate write job");
-    return false;
-  }
-
-  return true;
-}
-
-bool CSavestateWriteQueue::QueueThumbnailWrite(SavestateThumbnailPayload payload)
-{
-  if (!ArmWrite())
-    return false;
-
-  auto* job = new CSavestateThumbnailWriteJob(std::move(payload), m_tracker);
-
-  if (!m_thumbnailWriteQueue.AddJob(job))
-  {
-    CLog::Log(LOGERROR, "RetroPlayer[SAVE]: Failed to queue savestate thumbnail write job");
-    return false;
-  }
-
-  return true;
-}
@@ -10,6 +10,7 @@
 
 #include "jobs/JobQueue.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -23,29 +24,87 @@ struct SavestateThumbnailPayload;
 struct SavestateWriteRequest;
 struct RefreshState;
 struct WriteTracker;
+struct SavestatePool;
+struct SavestatePipelineTimings;
 
+/*!
+ * \brief Timing of one stage of the savestate pipeline
+ */
+struct SavestateStageStats
+{
+  //! Number of savestates that went through the stage
+  uint64_t count{0};
+
+  //! Total time spent in the stage, in microseconds
+  uint64_t totalUs{0};
+
+  //! Longest time spent in the stage, in microseconds
+  uint64_t maxUs{0};
+};
+
+/*!
+ * \brief Timing of all stages of the savestate pipeline
+ */
+struct SavestatePipelineStats
+{
+  //! Snapshot copy on the game loop thread
+  SavestateStageStats capture;
+
+  //! Label lookup, compression and FlatBuffer building
+  SavestateStageStats encode;
+
+  //! Writing the savestate file and database entry
+  SavestateStageStats write;
+
+  //! Scaling and writing the thumbnail
+  SavestateStageStats thumbnail;
+};
+
+/*!
+ * \brief Pipeline that turns captured savestates into files off the game loop
+ *
+ * Savestates pass through the following stages:
+ *
+ *   1. Capture: the caller copies the serialized state and video frame into
+ *      a savestate from AcquireSavestate(), which recycles the buffers of
+ *      previously written savestates
+ *   2. Encode: looks up the existing label, prepares the thumbnail and
+ *      compresses and builds the FlatBuffer
+ *   3. Write: writes the savestate to disk, in parallel with the encoding
+ *      of the next savestate
+ *
+ * Thumbnails are scaled and written in a separate queue.
+ */
 class CSavestateWriteQueue
 {
 public:
   explicit CSavestateWriteQueue(CGUIGameMessenger& guiMessenger);
   ~CSavestateWriteQueue();
 
+  /*!
+   * \brief Get an empty savestate for capturing, reusing pooled buffers
+   */
+  std::unique_ptr<ISavestate> AcquireSavestate();
+
   void QueueSavestateWrite(SavestateWriteRequest request);
   void Wait();
 
+  /*!
+   * \brief Get the timing of each pipeline stage since construction
+   */
+  SavestatePipelineStats GetStats() const;
+
 private:
   bool ArmWrite();
-  bool QueueSavestateFileWrite(std::string savePath,
-                               std::string gamePath,
-                               std::unique_ptr<ISavestate> savestate,
-                               bool compressSavedGame);
-  bool QueueThumbnailWrite(SavestateThumbnailPayload payload);
 
   CGUIGameMessenger& m_guiMessenger;
+  CJobQueue m_encodeQueue;
   CJobQueue m_fileWriteQueue;
   CJobQueue m_thumbnailWriteQueue;
   std::shared_ptr<RefreshState> m_refreshState;
   std::shared_ptr<WriteTracker> m_tracker;
+  std::shared_ptr<SavestatePool> m_pool;
+  std::shared_ptr<SavestatePipelineTimings> m_timings;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -8,10 +8,8 @@
 
 #pragma once
 
-#include "SavestateThumbnail.h"
-
+#include <chrono>
 #include <memory>
-#include <optional>
 #include <string>
 
 namespace KODI
@@ -23,9 +21,10 @@ class ISavestate;
 /*!
  * \brief Move-only request for writing a captured savestate off-thread
  *
- * The request owns the finalized savestate data that will be written to disk.
- * Thumbnail data is optional because thumbnail capture is best-effort and can
- * fail independently of the savestate file write.
+ * The request owns a snapshot of the savestate data that will be written to
+ * disk. The snapshot is only copied on the calling thread; looking up the
+ * existing label, compression, FlatBuffer building and thumbnail encoding
+ * happen on the write queue's workers.
  */
 struct SavestateWriteRequest
 {
@@ -38,11 +37,14 @@ struct SavestateWriteRequest
   //! Captured savestate object to finalize and write
   std::unique_ptr<ISavestate> savestate;
 
-  //! Optional pre-copied thumbnail payload for the savestate
-  std::optional<SavestateThumbnailPayload> thumbnail;
+  //! Destination path for the thumbnail, or empty to skip the thumbnail
+  std::string thumbnailPath;
 
   //! Whether to compress savestate payloads while finalizing for disk
   bool compressSavedGame{true};
+
+  //! Time spent capturing the snapshot on the calling thread
+  std::chrono::microseconds captureTime{0};
 };
 } // namespace RETRO
 } // namespace KODI
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/savestates/SavestateChunkStore.h"
+#include "filesystem/Directory.h"
+#include "utils/URIUtils.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+std::vector<uint8_t> MakeMemory(size_t size, unsigned int seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> memory(size);
+  for (uint8_t& byte : memory)
+    byte = static_cast<uint8_t>(rng());
+
+  // Emulator memory often contains large cleared regions
+  std::fill(memory.begin() + size / 4, memory.begin() + size / 2, 0);
+
+  return memory;
+}
+
+size_t CountSharedBytes(const std::vector<SavestateChunk>& before,
+                        const std::vector<SavestateChunk>& after)
+{
+  size_t sharedBytes = 0;
+  for (const SavestateChunk& chunk : after)
+  {
+    if (std::ranges::find(before, chunk) != before.end())
+      sharedBytes += chunk.size;
+  }
+  return sharedBytes;
+}
+
+class TestSavestateChunkStore : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_path = URIUtils::AddFileToFolder("special://temp", "kodi_savestate_chunks_test");
+    if (XFILE::CDirectory::Exists(m_path))
+      XFILE::CDirectory::RemoveRecursive(m_path);
+  }
+
+  void TearDown() override { XFILE::CDirectory::RemoveRecursive(m_path); }
+
+  std::string m_path;
+};
+} // namespace
+
+TEST_F(TestSavestateChunkStore, SplitCoversData)
+{
+  const std::vector<uint8_t> memory = MakeMemory(1024 * 1024 + 13, 1);
+
+  const std::vector<SavestateChunk> chunks =
+      CSavestateChunkStore::SplitChunks(memory.data(), memory.size());
+
+  ASSERT_FALSE(chunks.empty());
+  EXPECT_EQ(CSavestateChunkStore::GetTotalSize(chunks), memory.size());
+
+  // Splitting is deterministic
+  EXPECT_EQ(CSavestateChunkStore::SplitChunks(memory.data(), memory.size()), chunks);
+}
+
+TEST_F(TestSavestateChunkStore, SplitSharesUnchangedData)
+{
+  const std::vector<uint8_t> memory = MakeMemory(1024 * 1024, 2);
+  const std::vector<SavestateChunk> before =
+      CSavestateChunkStore::SplitChunks(memory.data(), memory.size());
+
+  // A few scattered changes only affect the chunks around them
+  std::vector<uint8_t> changed = memory;
+  changed[1000] ^= 0xff;
+  changed[changed.size() / 2 + 7] ^= 0xff;
+  changed[changed.size() - 3] ^= 0xff;
+
+  const std::vector<SavestateChunk> after =
+      CSavestateChunkStore::SplitChunks(changed.data(), changed.size());
+  EXPECT_GT(CountSharedBytes(before, after), changed.size() * 3 / 4);
+
+  // Inserted data shifts the following bytes, but chunk boundaries resync
+  std::vector<uint8_t> shifted = memory;
+  shifted.insert(shifted.begin() + 5000, {1, 2, 3, 4, 5});
+
+  const std::vector<SavestateChunk> afterShift =
+      CSavestateChunkStore::SplitChunks(shifted.data(), shifted.size());
+  EXPECT_GT(CountSharedBytes(before, afterShift), shifted.size() * 3 / 4);
+}
+
+TEST_F(TestSavestateChunkStore, WriteAndRead)
+{
+  const CSavestateChunkStore chunkStore(m_path);
+
+  const std::vector<uint8_t> memory = MakeMemory(256 * 1024, 3);
+  const std::vector<SavestateChunk> chunks =
+      CSavestateChunkStore::SplitChunks(memory.data(), memory.size());
+
+  SavestateChunkWriteStats stats;
+  ASSERT_TRUE(chunkStore.WriteChunks(chunks, memory.data(), true, stats));
+  EXPECT_EQ(stats.sharedChunks, 0u);
+  EXPECT_GT(stats.writtenChunks, 0u);
+
+  // Writing the same data again only references existing chunks
+  ASSERT_TRUE(chunkStore.WriteChunks(chunks, memory.data(), true, stats));
+  EXPECT_EQ(stats.writtenChunks, 0u);
+  EXPECT_EQ(stats.writtenBytes, 0u);
+  EXPECT_EQ(stats.sharedChunks, chunks.size());
+
+  // Existing chunks can be referenced without their data
+  ASSERT_TRUE(chunkStore.WriteChunks(chunks, nullptr, true, stats));
+
+  std::vector<uint8_t> loaded(memory.size());
+  ASSERT_TRUE(chunkStore.ReadChunks(chunks, loaded.data(), loaded.size()));
+  EXPECT_EQ(loaded, memory);
+
+  // Missing chunks fail to read
+  chunkStore.DeleteChunks({chunks.front()});
+  EXPECT_FALSE(chunkStore.ReadChunks(chunks, loaded.data(), loaded.size()));
+  EXPECT_FALSE(chunkStore.WriteChunks(chunks, nullptr, true, stats));
+}
+
+TEST_F(TestSavestateChunkStore, References)
+{
+  const CSavestateChunkStore chunkStore(m_path);
+  ASSERT_TRUE(XFILE::CDirectory::Create(m_path));
+
+  // A missing index must be rebuilt
+  SavestateChunkReferences loaded;
+  EXPECT_FALSE(chunkStore.ReadReferences(loaded));
+
+  const std::vector<uint8_t> memory = MakeMemory(64 * 1024, 4);
+
+  SavestateChunkReferences references;
+  references["first.sav"] = CSavestateChunkStore::SplitChunks(memory.data(), memory.size());
+  references["second.sav"] = {references["first.sav"].back()};
+  references["empty.sav"] = {};
+
+  ASSERT_TRUE(chunkStore.WriteReferences(references));
+  ASSERT_TRUE(chunkStore.ReadReferences(loaded));
+  EXPECT_EQ(loaded, references);
+
+  // Replacing the index drops removed savestates
+  references.erase("first.sav");
+  ASSERT_TRUE(chunkStore.WriteReferences(references));
+  ASSERT_TRUE(chunkStore.ReadReferences(loaded));
+  EXPECT_EQ(loaded, references);
+}
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "cores/RetroPlayer/savestates/ISavestate.h"
+#include "cores/RetroPlayer/savestates/SavestateChunkStore.h"
+#include "cores/RetroPlayer/savestates/SavestateDatabase.h"
+#include "filesystem/Directory.h"
+#include "utils/URIUtils.h"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+constexpr size_t MEMORY_SIZE = 256 * 1024;
+
+std::vector<uint8_t> MakeMemory(unsigned int seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> memory(MEMORY_SIZE);
+  for (uint8_t& byte : memory)
+    byte = static_cast<uint8_t>(rng());
+
+  return memory;
+}
+
+std::unique_ptr<ISavestate> MakeSavestate(const std::vector<uint8_t>& memory)
+{
+  std::unique_ptr<ISavestate> savestate = CSavestateDatabase::AllocateSavestate();
+  std::memcpy(savestate->GetMemoryBuffer(memory.size()), memory.data(), memory.size());
+  savestate->SetDeduplicateMemory(true);
+  savestate->Finalize(false);
+
+  return savestate;
+}
+
+class TestSavestateDatabase : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_path = URIUtils::AddFileToFolder("special://temp", "kodi_savestate_database_test");
+    if (XFILE::CDirectory::Exists(m_path))
+      XFILE::CDirectory::RemoveRecursive(m_path);
+    ASSERT_TRUE(XFILE::CDirectory::Create(m_path));
+  }
+
+  void TearDown() override { XFILE::CDirectory::RemoveRecursive(m_path); }
+
+  std::string MakePath(const std::string& fileName) const
+  {
+    return URIUtils::AddFileToFolder(m_path, fileName);
+  }
+
+  // Chunk files in the store, compared with the chunks of the given memory
+  void ExpectChunks(const std::vector<std::vector<uint8_t>>& memories) const
+  {
+    using Digest = std::array<uint8_t, SAVESTATE_CHUNK_DIGEST_SIZE>;
+
+    std::set<Digest> digests;
+    for (const std::vector<uint8_t>& memory : memories)
+    {
+      for (const SavestateChunk& chunk :
+           CSavestateChunkStore::SplitChunks(memory.data(), memory.size()))
+        digests.insert(chunk.digest);
+    }
+
+    CFileItemList items;
+    XFILE::CDirectory::CHints hints;
+    hints.mask = ".chunk";
+    XFILE::CDirectory::GetDirectory(CSavestateChunkStore::MakeFolderPath(MakePath("x.sav")), items,
+                                    hints);
+
+    EXPECT_EQ(static_cast<size_t>(items.Size()), digests.size());
+  }
+
+  std::string m_path;
+};
+} // namespace
+
+TEST_F(TestSavestateDatabase, DeletesUnreferencedChunks)
+{
+  CSavestateDatabase database;
+
+  const std::vector<uint8_t> first = MakeMemory(1);
+  const std::vector<uint8_t> second = MakeMemory(2);
+
+  ASSERT_TRUE(database.AddSavestate(MakePath("a.sav"), "", *MakeSavestate(first), false));
+  ASSERT_TRUE(database.AddSavestate(MakePath("b.sav"), "", *MakeSavestate(first), false));
+  ExpectChunks({first});
+
+  // Chunks of the overwritten savestate are still referenced by the other one
+  ASSERT_TRUE(database.AddSavestate(MakePath("a.sav"), "", *MakeSavestate(second), false));
+  ExpectChunks({first, second});
+
+  std::unique_ptr<ISavestate> loaded = CSavestateDatabase::AllocateSavestate();
+  ASSERT_TRUE(database.GetSavestate(MakePath("a.sav"), *loaded));
+  ASSERT_TRUE(loaded->PrepareMemoryData(second.size()));
+  ASSERT_EQ(loaded->GetMemorySize(), second.size());
+  EXPECT_EQ(std::memcmp(loaded->GetMemoryData(), second.data(), second.size()), 0);
+
+  // Overwriting with the same memory keeps its chunks
+  ASSERT_TRUE(database.AddSavestate(MakePath("a.sav"), "", *MakeSavestate(second), false));
+  ExpectChunks({first, second});
+
+  ASSERT_TRUE(database.DeleteSavestate(MakePath("b.sav")));
+  ExpectChunks({second});
+
+  ASSERT_TRUE(database.DeleteSavestate(MakePath("a.sav")));
+  ExpectChunks({});
+}
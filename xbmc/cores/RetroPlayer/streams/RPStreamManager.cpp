@@ -29,6 +29,12 @@ void CRPStreamManager::EnableAudio(bool bEnable)
     m_audioStream->Enable(bEnable);
 }
 
+void CRPStreamManager::SuppressAudio(bool bSuppress)
+{
+  if (m_audioStream != nullptr)
+    m_audioStream->Suppress(bSuppress);
+}
+
 StreamPtr CRPStreamManager::CreateStream(StreamType streamType)
 {
   switch (streamType)
@@ -26,6 +26,14 @@ public:
 
   void EnableAudio(bool bEnable);
 
+  /*!
+   * \brief Drop the audio of the frames that follow
+   *
+   * Unlike EnableAudio(), which follows the playback speed, this is set from
+   * the game loop for frames that are emulated but never played.
+   */
+  void SuppressAudio(bool bSuppress);
+
   // Implementation of IStreamManager
   StreamPtr CreateStream(StreamType streamType) override;
   void CloseStream(StreamPtr stream) override;
@@ -50,6 +50,7 @@ public:
   ~CRetroPlayerAudio() override;
 
   void Enable(bool bEnabled) { m_bAudioEnabled = bEnabled; }
+  void Suppress(bool bSuppressed) { m_bAudioSuppressed = bSuppressed; }
 
   // implementation of IRetroPlayerStream
   bool OpenStream(const StreamProperties& properties) override;
@@ -64,6 +65,7 @@ private:
   CRPProcessInfo& m_processInfo;
   IAE::StreamPtr m_pAudioStream;
   bool m_bAudioEnabled = true;
+  bool m_bAudioSuppressed = false;
 };
 } // namespace RETRO
 } // namespace KODI
@@ -18,6 +18,7 @@ void CDeltaPairMemoryStream::Reset()
   CLinearMemoryStream::Reset();
 
   m_rewindBuffer.clear();
+  m_historyBytes = 0;
 }
 
 void CDeltaPairMemoryStream::SubmitFrameInternal()
@@ -40,6 +41,8 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
     }
   }
 
+  m_historyBytes += FrameBytes(frame);
+
   // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
   std::swap(m_currentFrame, m_nextFrame);
 
@@ -47,6 +50,9 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
 
   if (PastFramesAvailable() + 1 > MaxFrameCount())
     CullPastFrames(1);
+
+  while (m_maxHistoryBytes > 0 && m_historyBytes > m_maxHistoryBytes && !m_rewindBuffer.empty())
+    CullPastFrames(1);
 }
 
 uint64_t CDeltaPairMemoryStream::PastFramesAvailable() const
@@ -76,6 +82,7 @@ uint64_t CDeltaPairMemoryStream::RewindFrames(uint64_t frameCount)
     // Restore frame history
     m_currentFrameHistory = frame.frameHistoryCount;
 
+    m_historyBytes -= FrameBytes(frame);
     m_rewindBuffer.pop_back();
   }
 
@@ -93,6 +100,12 @@ void CDeltaPairMemoryStream::CullPastFrames(uint64_t frameCount)
                 frameCount - removedCount);
       break;
     }
+    m_historyBytes -= FrameBytes(m_rewindBuffer.front());
     m_rewindBuffer.pop_front();
   }
 }
+
+size_t CDeltaPairMemoryStream::FrameBytes(const MemoryFrame& frame)
+{
+  return sizeof(MemoryFrame) + frame.buffer.capacity() * sizeof(DeltaPair);
+}
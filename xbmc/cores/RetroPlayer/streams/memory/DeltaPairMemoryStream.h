@@ -31,6 +31,7 @@ public:
   void Reset() override;
   uint64_t PastFramesAvailable() const override;
   uint64_t RewindFrames(uint64_t frameCount) override;
+  size_t HistoryBytes() const override { return m_historyBytes; }
 
 protected:
   // implementation of CLinearMemoryStream
@@ -62,6 +63,10 @@ protected:
   };
 
   std::deque<MemoryFrame> m_rewindBuffer;
+  size_t m_historyBytes = 0;
+
+private:
+  static size_t FrameBytes(const MemoryFrame& frame);
 };
 } // namespace RETRO
 } // namespace KODI
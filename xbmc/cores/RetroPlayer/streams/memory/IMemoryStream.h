@@ -75,6 +75,30 @@ public:
    */
   virtual void SetMaxFrameCount(uint64_t maxFrameCount) = 0;
 
+  /*!
+   * \brief Return the current memory budget for past frames
+   *
+   * \return The budget in bytes, or 0 if history is only limited by the
+   *         max frame count
+   */
+  virtual size_t MaxHistoryBytes() const = 0;
+
+  /*!
+   * \brief Update the memory budget for past frames
+   *
+   * The oldest frames are deleted when the history grows larger than the
+   * budget, so the number of past frames available depends on how well
+   * the game's state compresses.
+   *
+   * \param maxBytes The budget in bytes, or 0 for no limit
+   */
+  virtual void SetMaxHistoryBytes(size_t maxBytes) = 0;
+
+  /*!
+   * \brief Return the number of bytes currently used by past frames
+   */
+  virtual size_t HistoryBytes() const = 0;
+
   /*!
    * \ brief Get a pointer to which FrameSize() bytes can be written
    *
@@ -56,6 +56,14 @@ void CLinearMemoryStream::SetMaxFrameCount(uint64_t maxFrameCount)
   m_maxFrames = maxFrameCount;
 }
 
+void CLinearMemoryStream::SetMaxHistoryBytes(size_t maxBytes)
+{
+  m_maxHistoryBytes = maxBytes;
+
+  while (m_maxHistoryBytes > 0 && HistoryBytes() > m_maxHistoryBytes && PastFramesAvailable() > 0)
+    CullPastFrames(1);
+}
+
 uint8_t* CLinearMemoryStream::BeginFrame()
 {
   if (m_paddedFrameSize == 0)
@@ -30,6 +30,9 @@ public:
   size_t FrameSize() const override { return m_frameSize; }
   uint64_t MaxFrameCount() const override { return m_maxFrames; }
   void SetMaxFrameCount(uint64_t maxFrameCount) override;
+  size_t MaxHistoryBytes() const override { return m_maxHistoryBytes; }
+  void SetMaxHistoryBytes(size_t maxBytes) override;
+  size_t HistoryBytes() const override = 0;
   uint8_t* BeginFrame() override;
   void SubmitFrame() override;
   const uint8_t* CurrentFrame() const override;
@@ -49,6 +52,7 @@ protected:
 
   size_t m_paddedFrameSize;
   uint64_t m_maxFrames;
+  size_t m_maxHistoryBytes = 0;
 
   /**
    * Simple double-buffering. After XORing the two states, the next becomes
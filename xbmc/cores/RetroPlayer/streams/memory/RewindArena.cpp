@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RewindArena.h"
+
+#include <cstring>
+
+using namespace KODI;
+using namespace RETRO;
+
+void CRewindArena::Reset(size_t capacity)
+{
+  m_records.clear();
+  m_usedBytes = 0;
+
+  if (capacity != m_capacity)
+  {
+    m_buffer.reset(capacity > 0 ? new uint8_t[capacity] : nullptr);
+    m_capacity = capacity;
+  }
+}
+
+uint8_t* CRewindArena::PushBack(size_t size)
+{
+  if (size == 0 || size > m_capacity)
+    return nullptr;
+
+  size_t offset = 0;
+
+  if (!m_records.empty())
+  {
+    const size_t head = m_records.back().offset + m_records.back().size;
+    const size_t tail = m_records.front().offset;
+
+    if (head > tail)
+    {
+      // Free space is [head, capacity) followed by [0, tail)
+      if (head + size <= m_capacity)
+        offset = head;
+      else if (size <= tail)
+        offset = 0;
+      else
+        return nullptr;
+    }
+    else
+    {
+      // Wrapped, free space is [head, tail)
+      if (head + size <= tail)
+        offset = head;
+      else
+        return nullptr;
+    }
+  }
+
+  m_records.push_back({offset, size});
+  m_usedBytes += size;
+
+  return m_buffer.get() + offset;
+}
+
+void CRewindArena::PopFront()
+{
+  if (m_records.empty())
+    return;
+
+  m_usedBytes -= m_records.front().size;
+  m_records.pop_front();
+}
+
+void CRewindArena::PopBack()
+{
+  if (m_records.empty())
+    return;
+
+  m_usedBytes -= m_records.back().size;
+  m_records.pop_back();
+}
+
+const uint8_t* CRewindArena::Back() const
+{
+  if (m_records.empty())
+    return nullptr;
+
+  return m_buffer.get() + m_records.back().offset;
+}
+
+size_t CRewindArena::BackSize() const
+{
+  if (m_records.empty())
+    return 0;
+
+  return m_records.back().size;
+}
+
+const uint8_t* CRewindArena::At(size_t index) const
+{
+  if (index >= m_records.size())
+    return nullptr;
+
+  return m_buffer.get() + m_records[index].offset;
+}
+
+size_t CRewindArena::SizeAt(size_t index) const
+{
+  if (index >= m_records.size())
+    return 0;
+
+  return m_records[index].size;
+}
+
+void CRewindArena::Resize(size_t capacity)
+{
+  if (capacity == m_capacity || capacity < m_usedBytes)
+    return;
+
+  std::unique_ptr<uint8_t[]> buffer(capacity > 0 ? new uint8_t[capacity] : nullptr);
+
+  size_t offset = 0;
+  for (Record& record : m_records)
+  {
+    std::memcpy(buffer.get() + offset, m_buffer.get() + record.offset, record.size);
+    record.offset = offset;
+    offset += record.size;
+  }
+
+  m_buffer = std::move(buffer);
+  m_capacity = capacity;
+}
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Contiguous ring of variable-sized records
+ *
+ * Records are appended at the back and removed from either end, in the same
+ * way a std::deque is used by the rewind buffer. Unlike a deque of vectors,
+ * all records share a single allocation, so pushing a frame doesn't touch
+ * the heap once the arena has reached its working size.
+ *
+ * Every record occupies a contiguous range of bytes. If a record doesn't fit
+ * at the end of the buffer, it wraps around to the beginning, and the unused
+ * tail is skipped.
+ */
+class CRewindArena
+{
+public:
+  CRewindArena() = default;
+
+  /*!
+   * \brief Drop all records and set the capacity of the arena
+   */
+  void Reset(size_t capacity);
+
+  /*!
+   * \brief Size of the arena's buffer, in bytes
+   */
+  size_t Capacity() const { return m_capacity; }
+
+  /*!
+   * \brief Bytes occupied by records, not counting unused space when wrapping
+   */
+  size_t UsedBytes() const { return m_usedBytes; }
+
+  /*!
+   * \brief Number of records in the arena
+   */
+  size_t Count() const { return m_records.size(); }
+  bool Empty() const { return m_records.empty(); }
+
+  /*!
+   * \brief Reserve a record of the given size at the back of the arena
+   *
+   * \return A pointer to size writable bytes, or nullptr if the arena
+   *         doesn't have enough contiguous space left. In that case, the
+   *         caller can free old records with PopFront() or Resize() the arena
+   *         and try again.
+   */
+  uint8_t* PushBack(size_t size);
+
+  /*!
+   * \brief Remove the oldest record
+   */
+  void PopFront();
+
+  /*!
+   * \brief Remove the newest record
+   */
+  void PopBack();
+
+  /*!
+   * \brief Access the newest record
+   */
+  const uint8_t* Back() const;
+  size_t BackSize() const;
+
+  /*!
+   * \brief Access a record by index, where 0 is the oldest record
+   */
+  const uint8_t* At(size_t index) const;
+  size_t SizeAt(size_t index) const;
+
+  /*!
+   * \brief Change the capacity, preserving all records
+   *
+   * Records are packed at the start of the new buffer. The new capacity must
+   * be at least UsedBytes(); free records with PopFront() before shrinking.
+   */
+  void Resize(size_t capacity);
+
+private:
+  struct Record
+  {
+    size_t offset;
+    size_t size;
+  };
+
+  std::unique_ptr<uint8_t[]> m_buffer;
+  size_t m_capacity = 0;
+  size_t m_usedBytes = 0;
+  std::deque<Record> m_records;
+};
+} // namespace RETRO
+} // namespace KODI
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// This file is compiled with AVX2 enabled. It must only be entered after
+// checking for CPU_FEATURE_AVX2 at runtime.
+
+#include "XorDeltaKernels.h"
+
+#include <immintrin.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+bool BlockEqual(const uint8_t* a, const uint8_t* b)
+{
+  const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) == 0xFFFF;
+}
+
+// Compare two blocks at once. Bits 0-15 cover the first block, 16-31 the second.
+uint32_t BlockPairEqualMask(const uint8_t* a, const uint8_t* b)
+{
+  const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+  const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+}
+
+size_t FindDifferent(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  size_t i = begin;
+
+  for (; i + 2 <= end; i += 2)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    const uint32_t mask = BlockPairEqualMask(a + offset, b + offset);
+    if (mask != 0xFFFFFFFF)
+      return (mask & 0xFFFF) != 0xFFFF ? i : i + 1;
+  }
+
+  if (i < end && BlockEqual(a + i * XOR_DELTA_BLOCK_SIZE, b + i * XOR_DELTA_BLOCK_SIZE))
+    i++;
+
+  return i;
+}
+
+size_t FindEqual(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  size_t i = begin;
+
+  for (; i + 2 <= end; i += 2)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    const uint32_t mask = BlockPairEqualMask(a + offset, b + offset);
+    if ((mask & 0xFFFF) == 0xFFFF)
+      return i;
+    if ((mask >> 16) == 0xFFFF)
+      return i + 1;
+  }
+
+  if (i < end && !BlockEqual(a + i * XOR_DELTA_BLOCK_SIZE, b + i * XOR_DELTA_BLOCK_SIZE))
+    i++;
+
+  return i;
+}
+
+void XorTo(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t blockCount)
+{
+  size_t i = 0;
+
+  for (; i + 2 <= blockCount; i += 2)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + offset));
+    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + offset));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset), _mm256_xor_si256(va, vb));
+  }
+
+  if (i < blockCount)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + offset));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset), _mm_xor_si128(va, vb));
+  }
+}
+
+void XorInPlace(uint8_t* dst, const uint8_t* src, size_t blockCount)
+{
+  XorTo(dst, dst, src, blockCount);
+}
+
+constexpr XorDeltaKernels AVX2_KERNELS = {
+    "AVX2",
+    FindDifferent,
+    FindEqual,
+    XorTo,
+    XorInPlace,
+};
+} // namespace
+
+const XorDeltaKernels& KODI::RETRO::GetAvx2XorDeltaKernels()
+{
+  return AVX2_KERNELS;
+}
@@ -0,0 +1,265 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XorDeltaKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <cstring>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(HAS_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define XOR_DELTA_NEON
+#endif
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+static_assert(XOR_DELTA_BLOCK_SIZE == 2 * sizeof(uint64_t));
+
+// Portable C++ kernels
+
+bool BlockEqualScalar(const uint8_t* a, const uint8_t* b)
+{
+  uint64_t a0, a1, b0, b1;
+  std::memcpy(&a0, a, sizeof(a0));
+  std::memcpy(&a1, a + sizeof(a0), sizeof(a1));
+  std::memcpy(&b0, b, sizeof(b0));
+  std::memcpy(&b1, b + sizeof(b0), sizeof(b1));
+  return ((a0 ^ b0) | (a1 ^ b1)) == 0;
+}
+
+size_t FindDifferentScalar(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    if (!BlockEqualScalar(a + offset, b + offset))
+      return i;
+  }
+  return end;
+}
+
+size_t FindEqualScalar(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    if (BlockEqualScalar(a + offset, b + offset))
+      return i;
+  }
+  return end;
+}
+
+void XorToScalar(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t blockCount)
+{
+  const size_t wordCount = blockCount * XOR_DELTA_BLOCK_SIZE / sizeof(uint64_t);
+  for (size_t i = 0; i < wordCount; i++)
+  {
+    uint64_t wordA, wordB;
+    std::memcpy(&wordA, a + i * sizeof(uint64_t), sizeof(wordA));
+    std::memcpy(&wordB, b + i * sizeof(uint64_t), sizeof(wordB));
+    const uint64_t result = wordA ^ wordB;
+    std::memcpy(out + i * sizeof(uint64_t), &result, sizeof(result));
+  }
+}
+
+void XorInPlaceScalar(uint8_t* dst, const uint8_t* src, size_t blockCount)
+{
+  XorToScalar(dst, dst, src, blockCount);
+}
+
+constexpr XorDeltaKernels SCALAR_KERNELS = {
+    "C++",
+    FindDifferentScalar,
+    FindEqualScalar,
+    XorToScalar,
+    XorInPlaceScalar,
+};
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+
+// SSE2 kernels
+
+bool BlockEqualSSE2(const uint8_t* a, const uint8_t* b)
+{
+  const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) == 0xFFFF;
+}
+
+size_t FindDifferentSSE2(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    if (!BlockEqualSSE2(a + offset, b + offset))
+      return i;
+  }
+  return end;
+}
+
+size_t FindEqualSSE2(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    if (BlockEqualSSE2(a + offset, b + offset))
+      return i;
+  }
+  return end;
+}
+
+void XorToSSE2(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t blockCount)
+{
+  for (size_t i = 0; i < blockCount; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + offset));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset), _mm_xor_si128(va, vb));
+  }
+}
+
+void XorInPlaceSSE2(uint8_t* dst, const uint8_t* src, size_t blockCount)
+{
+  XorToSSE2(dst, dst, src, blockCount);
+}
+
+constexpr XorDeltaKernels SSE2_KERNELS = {
+    "SSE2",
+    FindDifferentSSE2,
+    FindEqualSSE2,
+    XorToSSE2,
+    XorInPlaceSSE2,
+};
+
+#endif
+
+#if defined(XOR_DELTA_NEON)
+
+// NEON kernels
+
+bool BlockEqualNEON(const uint8_t* a, const uint8_t* b)
+{
+  const uint8x16_t eq = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+#if defined(__aarch64__)
+  return vminvq_u8(eq) == 0xFF;
+#else
+  const uint64x2_t eq64 = vreinterpretq_u64_u8(eq);
+  return (vgetq_lane_u64(eq64, 0) & vgetq_lane_u64(eq64, 1)) == UINT64_MAX;
+#endif
+}
+
+size_t FindDifferentNEON(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    if (!BlockEqualNEON(a + offset, b + offset))
+      return i;
+  }
+  return end;
+}
+
+size_t FindEqualNEON(const uint8_t* a, const uint8_t* b, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    if (BlockEqualNEON(a + offset, b + offset))
+      return i;
+  }
+  return end;
+}
+
+void XorToNEON(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t blockCount)
+{
+  for (size_t i = 0; i < blockCount; i++)
+  {
+    const size_t offset = i * XOR_DELTA_BLOCK_SIZE;
+    vst1q_u8(out + offset, veorq_u8(vld1q_u8(a + offset), vld1q_u8(b + offset)));
+  }
+}
+
+void XorInPlaceNEON(uint8_t* dst, const uint8_t* src, size_t blockCount)
+{
+  XorToNEON(dst, dst, src, blockCount);
+}
+
+constexpr XorDeltaKernels NEON_KERNELS = {
+    "NEON",
+    FindDifferentNEON,
+    FindEqualNEON,
+    XorToNEON,
+    XorInPlaceNEON,
+};
+
+#endif
+
+unsigned int GetCPUFeatures()
+{
+  // CPU info may not be registered yet, e.g. in unit tests
+  const std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  return cpuInfo ? cpuInfo->GetCPUFeatures() : 0;
+}
+} // namespace
+
+const XorDeltaKernels& KODI::RETRO::GetXorDeltaKernels()
+{
+  static const XorDeltaKernels& kernels = []() -> const XorDeltaKernels&
+  {
+    const XorDeltaKernels& selected = *GetSupportedXorDeltaKernels().back();
+    CLog::Log(LOGDEBUG, "RetroPlayer[REWIND]: Using {} kernels for XOR deltas", selected.name);
+    return selected;
+  }();
+
+  return kernels;
+}
+
+const XorDeltaKernels& KODI::RETRO::GetScalarXorDeltaKernels()
+{
+  return SCALAR_KERNELS;
+}
+
+std::vector<const XorDeltaKernels*> KODI::RETRO::GetSupportedXorDeltaKernels()
+{
+  std::vector<const XorDeltaKernels*> kernels{&SCALAR_KERNELS};
+
+  [[maybe_unused]] const unsigned int features = GetCPUFeatures();
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  // SSE2 is part of every x86-64 CPU, so only 32-bit builds need to check
+#if defined(__x86_64__) || defined(_M_X64)
+  kernels.push_back(&SSE2_KERNELS);
+#else
+  if (features & CPU_FEATURE_SSE2)
+    kernels.push_back(&SSE2_KERNELS);
+#endif
+#endif
+
+#if defined(HAVE_AVX2)
+  if (features & CPU_FEATURE_AVX2)
+    kernels.push_back(&GetAvx2XorDeltaKernels());
+#endif
+
+#if defined(XOR_DELTA_NEON)
+  if (features & CPU_FEATURE_NEON)
+    kernels.push_back(&NEON_KERNELS);
+#endif
+
+  return kernels;
+}
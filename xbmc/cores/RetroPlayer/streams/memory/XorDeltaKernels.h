@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace KODI
+{
+namespace RETRO
+{
+/*!
+ * \brief Granularity of XOR deltas, in bytes
+ *
+ * Frames are compared in blocks of this size. The value is fixed so that the
+ * encoded delta format doesn't depend on which kernel produced it.
+ */
+constexpr size_t XOR_DELTA_BLOCK_SIZE = 16;
+
+/*!
+ * \brief Set of kernels used to compute and apply block-wise XOR deltas
+ *
+ * All sizes and positions are expressed in blocks of XOR_DELTA_BLOCK_SIZE
+ * bytes. Buffers don't need to be aligned.
+ */
+struct XorDeltaKernels
+{
+  /*!
+   * \brief Name of the instruction set, for logging
+   */
+  const char* name;
+
+  /*!
+   * \brief Find the first block in [begin, end) that differs between a and b
+   *
+   * \return The index of the block, or end if all blocks are equal
+   */
+  size_t (*findDifferent)(const uint8_t* a, const uint8_t* b, size_t begin, size_t end);
+
+  /*!
+   * \brief Find the first block in [begin, end) that is equal in a and b
+   *
+   * \return The index of the block, or end if all blocks differ
+   */
+  size_t (*findEqual)(const uint8_t* a, const uint8_t* b, size_t begin, size_t end);
+
+  /*!
+   * \brief Write a ^ b to out for the given number of blocks
+   */
+  void (*xorTo)(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t blockCount);
+
+  /*!
+   * \brief Apply dst ^= src for the given number of blocks
+   */
+  void (*xorInPlace)(uint8_t* dst, const uint8_t* src, size_t blockCount);
+};
+
+/*!
+ * \brief Get the fastest kernels supported by the running CPU
+ *
+ * The selection is made once, based on the features reported by CCPUInfo,
+ * and falls back to portable C++ if no vector unit is available.
+ */
+const XorDeltaKernels& GetXorDeltaKernels();
+
+/*!
+ * \brief Get the portable C++ kernels, used as a reference implementation
+ */
+const XorDeltaKernels& GetScalarXorDeltaKernels();
+
+/*!
+ * \brief Get all kernels that can run on this CPU, for tests and benchmarks
+ *
+ * The kernels are ordered from slowest to fastest.
+ */
+std::vector<const XorDeltaKernels*> GetSupportedXorDeltaKernels();
+
+#if defined(HAVE_AVX2)
+/*!
+ * \brief Get the AVX2 kernels, compiled in a separate translation unit
+ */
+const XorDeltaKernels& GetAvx2XorDeltaKernels();
+#endif
+} // namespace RETRO
+} // namespace KODI
@@ -0,0 +1,438 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XorDeltaMemoryStream.h"
+
+#include "XorDeltaKernels.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <zstd.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+// Pad forward to nearest boundary of bytes
+#define PAD_TO_CEIL(x, bytes) ((((x) + (bytes) - 1) / (bytes)) * (bytes))
+
+namespace
+{
+// Initial size of the ring arena. It grows as needed until it holds the
+// maximum number of frames.
+constexpr size_t MIN_ARENA_SIZE = 1024 * 1024;
+
+// Deltas smaller than this aren't worth the cost of calling into zstd
+constexpr size_t MIN_COMPRESS_SIZE = 4 * 1024;
+
+// Favor speed, this runs once per emulated frame
+constexpr int COMPRESSION_LEVEL = 1;
+
+// One keyframe per second at 60 fps
+constexpr uint64_t DEFAULT_KEYFRAME_INTERVAL = 60;
+
+// Worst case size of a varint-encoded size_t
+constexpr size_t MAX_VARINT_SIZE = (sizeof(size_t) * 8 + 6) / 7;
+
+uint8_t* WriteVarint(uint8_t* out, size_t value)
+{
+  while (value >= 0x80)
+  {
+    *out++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(value);
+  return out;
+}
+
+const uint8_t* ReadVarint(const uint8_t* in, const uint8_t* end, size_t& value)
+{
+  value = 0;
+  for (unsigned int shift = 0; in < end && shift < sizeof(size_t) * 8; shift += 7)
+  {
+    const uint8_t byte = *in++;
+    value |= static_cast<size_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return in;
+  }
+  return nullptr;
+}
+} // namespace
+
+CXorDeltaMemoryStream::CXorDeltaMemoryStream() : CXorDeltaMemoryStream(GetXorDeltaKernels())
+{
+}
+
+CXorDeltaMemoryStream::CXorDeltaMemoryStream(const XorDeltaKernels& kernels)
+  : m_kernels(kernels), m_keyframeInterval(DEFAULT_KEYFRAME_INTERVAL)
+{
+}
+
+CXorDeltaMemoryStream::~CXorDeltaMemoryStream()
+{
+  ZSTD_freeCCtx(m_compressContext);
+  ZSTD_freeDCtx(m_decompressContext);
+}
+
+void CXorDeltaMemoryStream::Init(size_t frameSize, uint64_t maxFrameCount)
+{
+  CLinearMemoryStream::Init(frameSize, maxFrameCount);
+
+  // Frames are compared in whole blocks. The frame buffers allocated by
+  // CLinearMemoryStream hold at least m_paddedFrameSize bytes.
+  m_paddedFrameSize = PAD_TO_CEIL(frameSize, XOR_DELTA_BLOCK_SIZE);
+  m_blockCount = m_paddedFrameSize / XOR_DELTA_BLOCK_SIZE;
+
+  // Worst case: every other block changed
+  const size_t maxRuns = (m_blockCount + 1) / 2;
+  m_encodeBuffer.resize(m_paddedFrameSize + maxRuns * 2 * MAX_VARINT_SIZE);
+
+  if (m_compressContext == nullptr)
+    m_compressContext = ZSTD_createCCtx();
+  if (m_decompressContext == nullptr)
+    m_decompressContext = ZSTD_createDCtx();
+}
+
+void CXorDeltaMemoryStream::Reset()
+{
+  CLinearMemoryStream::Reset();
+
+  m_arena.Reset(0);
+  m_frames.clear();
+  m_blockCount = 0;
+  m_encodeBuffer.clear();
+  m_compressBuffer.clear();
+  m_keyframeBuffer.clear();
+}
+
+void CXorDeltaMemoryStream::SetMaxHistoryBytes(size_t maxBytes)
+{
+  CLinearMemoryStream::SetMaxHistoryBytes(maxBytes);
+
+  // Give memory back if the budget was reduced
+  if (maxBytes > 0 && m_arena.Capacity() > maxBytes)
+    m_arena.Resize(std::max(maxBytes, m_arena.UsedBytes()));
+}
+
+void CXorDeltaMemoryStream::SubmitFrameInternal()
+{
+  const uint8_t* currentFrame = reinterpret_cast<const uint8_t*>(m_currentFrame.get());
+  const uint8_t* nextFrame = reinterpret_cast<const uint8_t*>(m_nextFrame.get());
+
+  // Zero the padding so that it never shows up as a change
+  const size_t frameSize = FrameSize();
+  if (m_paddedFrameSize > frameSize)
+  {
+    std::memset(reinterpret_cast<uint8_t*>(m_currentFrame.get()) + frameSize, 0,
+                m_paddedFrameSize - frameSize);
+    std::memset(reinterpret_cast<uint8_t*>(m_nextFrame.get()) + frameSize, 0,
+                m_paddedFrameSize - frameSize);
+  }
+
+  const size_t encodedSize = EncodeDelta(currentFrame, nextFrame);
+
+  const uint8_t* delta = m_encodeBuffer.data();
+  size_t deltaSize = encodedSize;
+  size_t uncompressedSize = 0;
+
+  if (encodedSize >= MIN_COMPRESS_SIZE && m_compressContext != nullptr)
+  {
+    m_compressBuffer.resize(ZSTD_compressBound(encodedSize));
+
+    const size_t result =
+        ZSTD_compressCCtx(m_compressContext, m_compressBuffer.data(), m_compressBuffer.size(),
+                          m_encodeBuffer.data(), encodedSize, COMPRESSION_LEVEL);
+
+    if (!ZSTD_isError(result) && result < encodedSize)
+    {
+      delta = m_compressBuffer.data();
+      deltaSize = result;
+      uncompressedSize = encodedSize;
+    }
+  }
+
+  // Frames without changes still need a record so history stays in sync
+  static const uint8_t emptyDelta = 0;
+  if (deltaSize == 0)
+  {
+    delta = &emptyDelta;
+    deltaSize = 1;
+  }
+
+  // Store a keyframe of the frame being pushed into history
+  size_t keyframeSize = 0;
+  bool keyframeCompressed = false;
+  if (m_keyframeInterval > 0 && m_currentFrameHistory % m_keyframeInterval == 0)
+    keyframeSize = EncodeKeyframe(currentFrame, keyframeCompressed);
+
+  uint8_t* record = AllocateRecord(deltaSize + keyframeSize);
+  std::memcpy(record, delta, deltaSize);
+  if (keyframeSize > 0)
+  {
+    const uint8_t* keyframe = keyframeCompressed ? m_keyframeBuffer.data() : currentFrame;
+    std::memcpy(record + deltaSize, keyframe, keyframeSize);
+  }
+
+  // Record frame history
+  m_frames.push_back(
+      {m_currentFrameHistory++, deltaSize, uncompressedSize, keyframeSize, keyframeCompressed});
+
+  // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
+  std::swap(m_currentFrame, m_nextFrame);
+
+  m_bHasNextFrame = false;
+
+  if (PastFramesAvailable() + 1 > MaxFrameCount())
+    CullPastFrames(PastFramesAvailable() + 1 - MaxFrameCount());
+}
+
+uint64_t CXorDeltaMemoryStream::PastFramesAvailable() const
+{
+  return static_cast<uint64_t>(m_frames.size());
+}
+
+uint64_t CXorDeltaMemoryStream::RewindFrames(uint64_t frameCount)
+{
+  uint8_t* currentFrame = reinterpret_cast<uint8_t*>(m_currentFrame.get());
+
+  const size_t frameTotal = m_frames.size();
+  const size_t rewound = static_cast<size_t>(std::min<uint64_t>(frameCount, frameTotal));
+  if (rewound == 0)
+    return 0;
+
+  // Index of the frame being restored
+  const size_t target = frameTotal - rewound;
+
+  // Find the nearest keyframe at or after the target. Starting from it costs
+  // at most one keyframe interval of deltas, regardless of seek distance.
+  size_t start = target;
+  while (start < frameTotal && m_frames[start].keyframeSize == 0)
+    start++;
+
+  if (start < frameTotal && RestoreFromKeyframe(start, currentFrame))
+  {
+    CLog::Log(LOGDEBUG, "RetroPlayer[REWIND]: Rewinding {} frames from keyframe {} frames back",
+              rewound, frameTotal - start);
+  }
+  else
+  {
+    start = frameTotal;
+  }
+
+  for (size_t index = start; index > target; index--)
+  {
+    if (!RestoreFromDelta(index - 1, currentFrame))
+    {
+      // The state can't be recovered reliably, so drop the unusable history
+      CLog::Log(LOGERROR, "RetroPlayer[REWIND]: Failed to restore frame {}, discarding history",
+                m_frames[index - 1].frameHistoryCount);
+      m_frames.clear();
+      m_arena.Reset(m_arena.Capacity());
+      return 0;
+    }
+  }
+
+  // Restore frame history
+  m_currentFrameHistory = m_frames[target].frameHistoryCount;
+
+  for (size_t i = 0; i < rewound; i++)
+  {
+    m_frames.pop_back();
+    m_arena.PopBack();
+  }
+
+  return rewound;
+}
+
+void CXorDeltaMemoryStream::CullPastFrames(uint64_t frameCount)
+{
+  for (uint64_t removedCount = 0; removedCount < frameCount; removedCount++)
+  {
+    if (m_frames.empty())
+    {
+      CLog::Log(LOGDEBUG,
+                "CXorDeltaMemoryStream: Tried to cull {} frames too many. Check your math!",
+                frameCount - removedCount);
+      break;
+    }
+    m_frames.pop_front();
+    m_arena.PopFront();
+  }
+}
+
+size_t CXorDeltaMemoryStream::EncodeDelta(const uint8_t* currentFrame, const uint8_t* nextFrame)
+{
+  uint8_t* const begin = m_encodeBuffer.data();
+  uint8_t* out = begin;
+
+  size_t position = 0;
+  while (position < m_blockCount)
+  {
+    const size_t changedBegin =
+        m_kernels.findDifferent(currentFrame, nextFrame, position, m_blockCount);
+    if (changedBegin == m_blockCount)
+      break;
+
+    const size_t changedEnd =
+        m_kernels.findEqual(currentFrame, nextFrame, changedBegin, m_blockCount);
+
+    const size_t changedCount = changedEnd - changedBegin;
+    const size_t offset = changedBegin * XOR_DELTA_BLOCK_SIZE;
+
+    out = WriteVarint(out, changedBegin - position);
+    out = WriteVarint(out, changedCount);
+    m_kernels.xorTo(out, currentFrame + offset, nextFrame + offset, changedCount);
+    out += changedCount * XOR_DELTA_BLOCK_SIZE;
+
+    position = changedEnd;
+  }
+
+  return static_cast<size_t>(out - begin);
+}
+
+size_t CXorDeltaMemoryStream::EncodeKeyframe(const uint8_t* currentFrame, bool& compressed)
+{
+  compressed = false;
+
+  if (m_compressContext != nullptr)
+  {
+    m_keyframeBuffer.resize(ZSTD_compressBound(m_paddedFrameSize));
+
+    const size_t result =
+        ZSTD_compressCCtx(m_compressContext, m_keyframeBuffer.data(), m_keyframeBuffer.size(),
+                          currentFrame, m_paddedFrameSize, COMPRESSION_LEVEL);
+
+    if (!ZSTD_isError(result) && result < m_paddedFrameSize)
+    {
+      compressed = true;
+      return result;
+    }
+  }
+
+  return m_paddedFrameSize;
+}
+
+void CXorDeltaMemoryStream::ApplyDelta(const uint8_t* delta, size_t size, uint8_t* currentFrame)
+{
+  const uint8_t* in = delta;
+  const uint8_t* const end = delta + size;
+
+  size_t position = 0;
+  while (in < end)
+  {
+    size_t unchangedCount;
+    size_t changedCount;
+
+    in = ReadVarint(in, end, unchangedCount);
+    if (in == nullptr)
+      break;
+
+    // A single zero byte marks a frame without changes
+    if (in == end && unchangedCount == 0)
+      break;
+
+    in = ReadVarint(in, end, changedCount);
+    if (in == nullptr)
+      break;
+
+    position += unchangedCount;
+
+    const size_t dataSize = changedCount * XOR_DELTA_BLOCK_SIZE;
+    if (position + changedCount > m_blockCount || static_cast<size_t>(end - in) < dataSize)
+    {
+      CLog::Log(LOGERROR, "RetroPlayer[REWIND]: Corrupt delta, block {} exceeds frame",
+                position + changedCount);
+      break;
+    }
+
+    m_kernels.xorInPlace(currentFrame + position * XOR_DELTA_BLOCK_SIZE, in, changedCount);
+
+    in += dataSize;
+    position += changedCount;
+  }
+}
+
+bool CXorDeltaMemoryStream::RestoreFromDelta(size_t index, uint8_t* currentFrame)
+{
+  const MemoryFrame& frame = m_frames[index];
+
+  const uint8_t* delta = m_arena.At(index);
+  size_t deltaSize = frame.deltaSize;
+
+  if (frame.encodedSize > 0)
+  {
+    const size_t result = ZSTD_decompressDCtx(m_decompressContext, m_encodeBuffer.data(),
+                                              frame.encodedSize, delta, deltaSize);
+    if (ZSTD_isError(result) || result != frame.encodedSize)
+      return false;
+
+    delta = m_encodeBuffer.data();
+    deltaSize = result;
+  }
+
+  ApplyDelta(delta, deltaSize, currentFrame);
+
+  return true;
+}
+
+bool CXorDeltaMemoryStream::RestoreFromKeyframe(size_t index, uint8_t* currentFrame)
+{
+  const MemoryFrame& frame = m_frames[index];
+
+  const uint8_t* keyframe = m_arena.At(index) + frame.deltaSize;
+
+  if (!frame.keyframeCompressed)
+  {
+    std::memcpy(currentFrame, keyframe, frame.keyframeSize);
+    return true;
+  }
+
+  const size_t result = ZSTD_decompressDCtx(m_decompressContext, currentFrame, m_paddedFrameSize,
+                                            keyframe, frame.keyframeSize);
+
+  return !ZSTD_isError(result) && result == m_paddedFrameSize;
+}
+
+uint8_t* CXorDeltaMemoryStream::AllocateRecord(size_t size)
+{
+  const size_t maxBytes = MaxHistoryBytes();
+
+  if (m_arena.Capacity() == 0)
+  {
+    size_t capacity = std::max(MIN_ARENA_SIZE, m_paddedFrameSize);
+    if (maxBytes > 0)
+      capacity = std::min(capacity, maxBytes);
+    m_arena.Reset(std::max(capacity, size));
+  }
+
+  uint8_t* dest = m_arena.PushBack(size);
+  while (dest == nullptr)
+  {
+    // Grow until the arena holds a full rewind window or reaches the memory
+    // budget, then recycle the oldest frames
+    const bool bCanGrow = m_frames.size() + 1 < MaxFrameCount() &&
+                          (maxBytes == 0 || m_arena.Capacity() < maxBytes);
+
+    if (bCanGrow || m_arena.Empty())
+    {
+      size_t capacity = m_arena.Capacity() * 2;
+      if (maxBytes > 0)
+        capacity = std::min(capacity, maxBytes);
+      m_arena.Resize(std::max(capacity, m_arena.UsedBytes() + size));
+    }
+    else
+    {
+      CullPastFrames(1);
+    }
+
+    dest = m_arena.PushBack(size);
+  }
+
+  return dest;
+}
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "LinearMemoryStream.h"
+#include "RewindArena.h"
+
+#include <deque>
+#include <vector>
+
+typedef struct ZSTD_CCtx_s ZSTD_CCtx;
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+
+namespace KODI
+{
+namespace RETRO
+{
+struct XorDeltaKernels;
+
+/*!
+ * \brief Implementation of a linear memory stream using block-wise XOR deltas
+ *
+ * This is a faster and more compact alternative to CDeltaPairMemoryStream.
+ * Frames are compared in 16-byte blocks using vector kernels selected at
+ * runtime (see XorDeltaKernels.h). Runs of unchanged blocks are skipped and
+ * runs of changed blocks are stored as literal XOR data, so a typical delta
+ * costs a few bytes per changed block instead of 16 bytes per changed word.
+ *
+ * Large deltas are additionally compressed with zstd if that makes them
+ * smaller. All deltas are stored back to back in a single ring arena, which
+ * is bounded by the memory budget set with SetMaxHistoryBytes().
+ *
+ * Every few frames, a full keyframe of the state is stored alongside the
+ * delta. Rewinding N frames then starts from the nearest keyframe instead of
+ * the current frame, which bounds the cost of a seek to the keyframe
+ * interval instead of N.
+ *
+ * Encoded delta format (before optional compression):
+ *
+ *   repeat {
+ *     varint  unchanged block count
+ *     varint  changed block count (N)
+ *     uint8_t XOR data[N * XOR_DELTA_BLOCK_SIZE]
+ *   }
+ */
+class CXorDeltaMemoryStream : public CLinearMemoryStream
+{
+public:
+  CXorDeltaMemoryStream();
+  explicit CXorDeltaMemoryStream(const XorDeltaKernels& kernels);
+
+  ~CXorDeltaMemoryStream() override;
+
+  // implementation of IMemoryStream via CLinearMemoryStream
+  void Init(size_t frameSize, uint64_t maxFrameCount) override;
+  void Reset() override;
+  void SetMaxHistoryBytes(size_t maxBytes) override;
+  size_t HistoryBytes() const override { return m_arena.UsedBytes(); }
+  uint64_t PastFramesAvailable() const override;
+  uint64_t RewindFrames(uint64_t frameCount) override;
+
+  /*!
+   * \brief Bytes of memory reserved for past frames
+   */
+  size_t ReservedBytes() const { return m_arena.Capacity(); }
+
+  /*!
+   * \brief Set the number of frames between keyframes
+   *
+   * \param frameCount The interval, or 0 to disable keyframes
+   */
+  void SetKeyframeInterval(uint64_t frameCount) { m_keyframeInterval = frameCount; }
+  uint64_t KeyframeInterval() const { return m_keyframeInterval; }
+
+protected:
+  // implementation of CLinearMemoryStream
+  void SubmitFrameInternal() override;
+  void CullPastFrames(uint64_t frameCount) override;
+
+private:
+  /*!
+   * \brief Past frame, stored in the arena as the delta followed by the
+   *        optional keyframe
+   */
+  struct MemoryFrame
+  {
+    uint64_t frameHistoryCount;
+    size_t deltaSize;
+    size_t encodedSize; // Size of the delta before compression, or 0 if not compressed
+    size_t keyframeSize; // 0 if the frame has no keyframe
+    bool keyframeCompressed;
+  };
+
+  /*!
+   * \brief Encode the delta between the current and next frames
+   *
+   * \return The size of the encoded delta in m_encodeBuffer
+   */
+  size_t EncodeDelta(const uint8_t* currentFrame, const uint8_t* nextFrame);
+
+  /*!
+   * \brief Compress the current frame into m_keyframeBuffer
+   *
+   * \return The size of the keyframe
+   */
+  size_t EncodeKeyframe(const uint8_t* currentFrame, bool& compressed);
+
+  /*!
+   * \brief Apply an encoded delta to the current frame
+   */
+  void ApplyDelta(const uint8_t* delta, size_t size, uint8_t* currentFrame);
+
+  /*!
+   * \brief Undo the delta of a past frame, restoring its state in currentFrame
+   */
+  bool RestoreFromDelta(size_t index, uint8_t* currentFrame);
+
+  /*!
+   * \brief Restore the state of a past frame from its keyframe
+   */
+  bool RestoreFromKeyframe(size_t index, uint8_t* currentFrame);
+
+  /*!
+   * \brief Reserve a record at the back of the arena, making room as needed
+   */
+  uint8_t* AllocateRecord(size_t size);
+
+  // Construction parameter
+  const XorDeltaKernels& m_kernels;
+
+  // Stream parameters
+  uint64_t m_keyframeInterval;
+
+  // Stream state
+  CRewindArena m_arena;
+  std::deque<MemoryFrame> m_frames;
+  size_t m_blockCount = 0;
+
+  // Scratch buffers
+  std::vector<uint8_t> m_encodeBuffer;
+  std::vector<uint8_t> m_compressBuffer;
+  std::vector<uint8_t> m_keyframeBuffer;
+  ZSTD_CCtx* m_compressContext = nullptr;
+  ZSTD_DCtx* m_decompressContext = nullptr;
+};
+} // namespace RETRO
+} // namespace KODI
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/streams/memory/RewindArena.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+TEST(TestRewindArena, PushAndPop)
+{
+  CRewindArena arena;
+  arena.Reset(64);
+
+  uint8_t* first = arena.PushBack(16);
+  ASSERT_NE(first, nullptr);
+  std::memset(first, 1, 16);
+
+  uint8_t* second = arena.PushBack(32);
+  ASSERT_NE(second, nullptr);
+  std::memset(second, 2, 32);
+
+  EXPECT_EQ(arena.Count(), 2u);
+  EXPECT_EQ(arena.UsedBytes(), 48u);
+  EXPECT_EQ(arena.BackSize(), 32u);
+  EXPECT_EQ(arena.Back()[0], 2);
+
+  arena.PopBack();
+  EXPECT_EQ(arena.Count(), 1u);
+  EXPECT_EQ(arena.Back()[0], 1);
+
+  arena.PopFront();
+  EXPECT_TRUE(arena.Empty());
+  EXPECT_EQ(arena.UsedBytes(), 0u);
+}
+
+TEST(TestRewindArena, WrapsAround)
+{
+  CRewindArena arena;
+  arena.Reset(64);
+
+  ASSERT_NE(arena.PushBack(24), nullptr);
+  ASSERT_NE(arena.PushBack(24), nullptr);
+
+  // Not enough contiguous space at the end or the start
+  EXPECT_EQ(arena.PushBack(24), nullptr);
+
+  // Freeing the oldest record makes room at the start
+  arena.PopFront();
+  uint8_t* wrapped = arena.PushBack(24);
+  ASSERT_NE(wrapped, nullptr);
+  std::memset(wrapped, 3, 24);
+
+  EXPECT_EQ(arena.Count(), 2u);
+  EXPECT_EQ(arena.Back()[23], 3);
+
+  // The wrapped record may not overlap the oldest record
+  EXPECT_EQ(arena.PushBack(8), nullptr);
+}
+
+TEST(TestRewindArena, ResizePreservesRecords)
+{
+  CRewindArena arena;
+  arena.Reset(32);
+
+  for (uint8_t i = 1; i <= 3; i++)
+  {
+    uint8_t* record = arena.PushBack(10);
+    ASSERT_NE(record, nullptr);
+    std::memset(record, i, 10);
+  }
+  EXPECT_EQ(arena.PushBack(10), nullptr);
+
+  arena.Resize(128);
+  EXPECT_EQ(arena.Capacity(), 128u);
+  EXPECT_NE(arena.PushBack(10), nullptr);
+  EXPECT_EQ(arena.Count(), 4u);
+
+  arena.PopBack();
+  EXPECT_EQ(arena.Back()[9], 3);
+  EXPECT_EQ(arena.At(0)[0], 1);
+
+  // Shrink after dropping the oldest record
+  arena.PopFront();
+  arena.Resize(20);
+  EXPECT_EQ(arena.Capacity(), 20u);
+  EXPECT_EQ(arena.Count(), 2u);
+  EXPECT_EQ(arena.At(0)[0], 2);
+  EXPECT_EQ(arena.At(1)[0], 3);
+}
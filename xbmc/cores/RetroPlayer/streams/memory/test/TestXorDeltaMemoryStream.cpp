@@ -0,0 +1,227 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/RetroPlayer/streams/memory/XorDeltaKernels.h"
+#include "cores/RetroPlayer/streams/memory/XorDeltaMemoryStream.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI;
+using namespace RETRO;
+
+namespace
+{
+using Frame = std::vector<uint8_t>;
+
+// Simulate a game mutating a few scattered regions of its state each frame
+void MutateFrame(Frame& frame, std::mt19937& rng, unsigned int regionCount, size_t regionSize)
+{
+  std::uniform_int_distribution<size_t> position(0, frame.size() - 1);
+  std::uniform_int_distribution<int> value(0, 255);
+
+  for (unsigned int region = 0; region < regionCount; region++)
+  {
+    const size_t begin = position(rng);
+    const size_t end = std::min(frame.size(), begin + regionSize);
+    for (size_t i = begin; i < end; i++)
+      frame[i] = static_cast<uint8_t>(value(rng));
+  }
+}
+
+void SubmitFrame(IMemoryStream& stream, const Frame& frame)
+{
+  std::memcpy(stream.BeginFrame(), frame.data(), frame.size());
+  stream.SubmitFrame();
+}
+
+void RunRewindTest(const XorDeltaKernels& kernels,
+                   size_t frameSize,
+                   unsigned int regionCount,
+                   size_t regionSize)
+{
+  constexpr uint64_t MAX_FRAMES = 20;
+
+  CXorDeltaMemoryStream stream(kernels);
+  stream.Init(frameSize, MAX_FRAMES);
+
+  std::mt19937 rng(1234);
+  Frame frame(frameSize);
+  MutateFrame(frame, rng, 16, frameSize / 16);
+
+  std::vector<Frame> history;
+  for (unsigned int i = 0; i < 30; i++)
+  {
+    SubmitFrame(stream, frame);
+    history.push_back(frame);
+    MutateFrame(frame, rng, regionCount, regionSize);
+  }
+
+  ASSERT_EQ(stream.PastFramesAvailable(), MAX_FRAMES - 1);
+  ASSERT_EQ(std::memcmp(stream.CurrentFrame(), history.back().data(), frameSize), 0);
+
+  // Rewind one frame at a time
+  for (unsigned int i = 1; i <= 5; i++)
+  {
+    ASSERT_EQ(stream.RewindFrames(1), 1u);
+    const Frame& expected = history[history.size() - 1 - i];
+    EXPECT_EQ(std::memcmp(stream.CurrentFrame(), expected.data(), frameSize), 0);
+  }
+
+  // Rewind past the start of history
+  const uint64_t remaining = stream.PastFramesAvailable();
+  EXPECT_EQ(stream.RewindFrames(remaining + 10), remaining);
+  const Frame& oldest = history[history.size() - MAX_FRAMES];
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), oldest.data(), frameSize), 0);
+}
+} // namespace
+
+TEST(TestXorDeltaMemoryStream, RewindSmallChanges)
+{
+  // Frame size that isn't a multiple of the block size
+  for (const XorDeltaKernels* kernels : GetSupportedXorDeltaKernels())
+    RunRewindTest(*kernels, 64 * 1024 + 7, 8, 3);
+}
+
+TEST(TestXorDeltaMemoryStream, RewindLargeChanges)
+{
+  // Deltas large enough to be compressed
+  for (const XorDeltaKernels* kernels : GetSupportedXorDeltaKernels())
+    RunRewindTest(*kernels, 256 * 1024, 4, 8 * 1024);
+}
+
+TEST(TestXorDeltaMemoryStream, RewindScalarKernels)
+{
+  RunRewindTest(GetScalarXorDeltaKernels(), 64 * 1024 + 7, 8, 3);
+}
+
+TEST(TestXorDeltaMemoryStream, UnchangedFrames)
+{
+  CXorDeltaMemoryStream stream;
+  stream.Init(100, 10);
+
+  Frame frame(100, 0x55);
+  for (unsigned int i = 0; i < 5; i++)
+    SubmitFrame(stream, frame);
+
+  EXPECT_EQ(stream.PastFramesAvailable(), 4u);
+  EXPECT_EQ(stream.GetFrameCounter(), 4u);
+
+  EXPECT_EQ(stream.RewindFrames(3), 3u);
+  EXPECT_EQ(stream.GetFrameCounter(), 1u);
+  EXPECT_EQ(std::memcmp(stream.CurrentFrame(), frame.data(), frame.size()), 0);
+}
+
+TEST(TestXorDeltaMemoryStream, SeekFromKeyframe)
+{
+  constexpr size_t FRAME_SIZE = 32 * 1024;
+
+  for (uint64_t keyframeInterval : {0, 1, 7})
+  {
+    CXorDeltaMemoryStream stream;
+    stream.SetKeyframeInterval(keyframeInterval);
+    stream.Init(FRAME_SIZE, 100);
+
+    std::mt19937 rng(42);
+    Frame frame(FRAME_SIZE);
+
+    std::vector<Frame> history;
+    for (unsigned int i = 0; i < 60; i++)
+    {
+      SubmitFrame(stream, frame);
+      history.push_back(frame);
+      MutateFrame(frame, rng, 4, 64);
+    }
+
+    // Seek back by various distances in a single call
+    for (uint64_t distance : {1, 5, 13})
+    {
+      const uint64_t counter = stream.GetFrameCounter();
+      ASSERT_EQ(stream.RewindFrames(distance), distance);
+      EXPECT_EQ(stream.GetFrameCounter(), counter - distance);
+
+      const Frame& expected = history[stream.GetFrameCounter()];
+      EXPECT_EQ(std::memcmp(stream.CurrentFrame(), expected.data(), FRAME_SIZE), 0)
+          << "keyframe interval " << keyframeInterval << ", distance " << distance;
+    }
+  }
+}
+
+TEST(TestXorDeltaMemoryStream, MemoryBudget)
+{
+  constexpr size_t FRAME_SIZE = 64 * 1024;
+  constexpr size_t BUDGET = 256 * 1024;
+
+  CXorDeltaMemoryStream stream;
+  stream.Init(FRAME_SIZE, 1000);
+  stream.SetMaxHistoryBytes(BUDGET);
+
+  // Random data doesn't compress, so every keyframe is a full frame
+  std::mt19937 rng(7);
+  Frame frame(FRAME_SIZE);
+  for (unsigned int i = 0; i < 200; i++)
+  {
+    MutateFrame(frame, rng, 64, 256);
+    SubmitFrame(stream, frame);
+
+    EXPECT_LE(stream.HistoryBytes(), BUDGET);
+    EXPECT_LE(stream.ReservedBytes(), BUDGET);
+  }
+
+  // History is limited by memory, not by frame count
+  EXPECT_GT(stream.PastFramesAvailable(), 0u);
+  EXPECT_LT(stream.PastFramesAvailable(), 199u);
+
+  // Reducing the budget drops old frames
+  const uint64_t pastFrames = stream.PastFramesAvailable();
+  stream.SetMaxHistoryBytes(BUDGET / 4);
+  EXPECT_LE(stream.HistoryBytes(), BUDGET / 4);
+  EXPECT_LE(stream.ReservedBytes(), BUDGET / 4);
+  EXPECT_LT(stream.PastFramesAvailable(), pastFrames);
+
+  // The remaining history is still usable
+  const uint64_t remaining = stream.PastFramesAvailable();
+  EXPECT_EQ(stream.RewindFrames(remaining), remaining);
+}
+
+TEST(TestXorDeltaMemoryStream, KernelsMatchScalar)
+{
+  const XorDeltaKernels& scalar = GetScalarXorDeltaKernels();
+
+  constexpr size_t BLOCK_COUNT = 37;
+  Frame a(BLOCK_COUNT * XOR_DELTA_BLOCK_SIZE, 0);
+  Frame b = a;
+  b[5 * XOR_DELTA_BLOCK_SIZE + 3] = 1;
+  b[6 * XOR_DELTA_BLOCK_SIZE] = 1;
+  b[36 * XOR_DELTA_BLOCK_SIZE + 15] = 1;
+
+  for (const XorDeltaKernels* kernels : GetSupportedXorDeltaKernels())
+  {
+    for (size_t begin = 0; begin < BLOCK_COUNT; begin++)
+    {
+      EXPECT_EQ(kernels->findDifferent(a.data(), b.data(), begin, BLOCK_COUNT),
+                scalar.findDifferent(a.data(), b.data(), begin, BLOCK_COUNT))
+          << kernels->name;
+      EXPECT_EQ(kernels->findEqual(a.data(), b.data(), begin, BLOCK_COUNT),
+                scalar.findEqual(a.data(), b.data(), begin, BLOCK_COUNT))
+          << kernels->name;
+    }
+
+    Frame expected(a.size());
+    Frame actual(a.size());
+    scalar.xorTo(expected.data(), a.data(), b.data(), BLOCK_COUNT);
+    kernels->xorTo(actual.data(), a.data(), b.data(), BLOCK_COUNT);
+    EXPECT_EQ(actual, expected) << kernels->name;
+
+    kernels->xorInPlace(actual.data(), b.data(), BLOCK_COUNT);
+    EXPECT_EQ(actual, a) << kernels->name;
+  }
+}
@@ -38,8 +38,8 @@ public:
   std::shared_ptr<CDVDSubtitlesLibass> GetLibassHandler() const { return m_libass; }
 
   // libass change-since-last-walk-consumed flag. Set non-zero by
-  // OVERLAY::CRenderer::PrepareOverlays when libass detect_change reports
-  // non-zero; consumed and cleared by ConvertLibass when a fresh COverlay
+  // OVERLAY::CRenderer::PrepareOverlays when the rasterized bitmap
+  // changes; consumed and cleared by ConvertLibass when a fresh COverlay
   // is created. Lives on the persistent overlay so it survives the
   // per-frame SElement recycling driven by RenderManager AddOverlay/Release.
   int m_pendingChange{0};
@@ -37,6 +37,7 @@ extern "C"
 
 struct DemuxPacket;
 struct DemuxCryptoSession;
+struct DemuxReadAheadState;
 
 namespace ADDON
 {
@@ -304,6 +305,18 @@ public:
    */
   virtual void FillBuffer(bool mode) {}
 
+  /*
+   * Read packets on a thread of the demuxer, up to duration in DVD_TIME_BASE
+   * units ahead of the player. Returns false if the demuxer can't read ahead
+   * for the opened input.
+   */
+  virtual bool EnableReadAhead(double duration) { return false; }
+
+  /*
+   * Get the fill level of the read-ahead queue, false if not reading ahead
+   */
+  virtual bool GetReadAheadState(DemuxReadAheadState& state) const { return false; }
+
   /*
    * returns the total time in msec
    */
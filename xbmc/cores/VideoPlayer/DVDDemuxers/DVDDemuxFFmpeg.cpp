@@ -106,6 +106,29 @@ bool AttachmentIsFont(const AVDictionaryEntry* dict)
   }
   return false;
 }
+
+// How long Read() waits for the read-ahead thread before the player gets back control
+constexpr auto READ_AHEAD_WAIT = 20ms;
+
+// Stops the read-ahead thread while the state of the demuxer is changed
+class CReadAheadPause
+{
+public:
+  explicit CReadAheadPause(CDemuxReadAhead* readAhead) : m_readAhead(readAhead)
+  {
+    if (m_readAhead)
+      m_readAhead->Pause();
+  }
+
+  ~CReadAheadPause()
+  {
+    if (m_readAhead)
+      m_readAhead->Resume();
+  }
+
+private:
+  CDemuxReadAhead* const m_readAhead;
+};
 } // namespace
 
 std::string CDemuxStreamAudioFFmpeg::GetStreamName()
@@ -518,14 +541,33 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
   m_bAVI = strcmp(m_pFormatContext->iformat->name, "avi") == 0;
   m_bSup = strcmp(m_pFormatContext->iformat->name, "sup") == 0;
 
+  // library items know their streams, only probe what the container header leaves open
+  DemuxProbe probe = DemuxProbe::FULL;
+  if (m_streaminfo && !fileinfo && !m_checkTransportStream)
+    probe = MatchStreamInfoCache();
+
   if (m_streaminfo)
   {
     /* to speed up dvd switches, only analyse very short */
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
-    CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
-    int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    if (probe == DemuxProbe::SHORT)
+    {
+      m_maxAnalyzeDuration = m_pFormatContext->max_analyze_duration;
+      av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
+    }
+
+    int iErr = 0;
+    if (probe == DemuxProbe::NONE)
+    {
+      CLog::Log(LOGDEBUG, "{} - using stream info of the library", __FUNCTION__);
+    }
+    else
+    {
+      CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
+      iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    }
     if (iErr < 0)
     {
       CLog::Log(LOGWARNING, "could not find codec parameters for {}", CURL::GetRedacted(strFile));
@@ -643,11 +685,15 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     m_pFormatContext->duration = duration;
   }
 
+  UpdateStreamLength();
+
   return true;
 }
 
 void CDVDDemuxFFmpeg::Dispose()
 {
+  m_readAhead.reset();
+
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
@@ -669,9 +715,12 @@ void CDVDDemuxFFmpeg::Dispose()
 
   m_ioContext = NULL;
   m_pFormatContext = NULL;
+  m_streamLength = 0;
   m_speed = DVD_PLAYSPEED_NORMAL;
 
   DisposeStreams();
+  FreeRetiredStreams();
+  m_streamInfoCache.reset();
 
   m_pInput = NULL;
 }
@@ -679,11 +728,27 @@ void CDVDDemuxFFmpeg::Dispose()
 bool CDVDDemuxFFmpeg::Reset()
 {
   std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
+  const bool readAhead = m_readAhead != nullptr;
   Dispose();
-  return Open(pInputStream, false);
+  if (!Open(pInputStream, false))
+    return false;
+
+  if (readAhead)
+    EnableReadAhead(m_readAheadDuration);
+
+  return true;
 }
 
 void CDVDDemuxFFmpeg::Flush()
+{
+  CReadAheadPause pause(m_readAhead.get());
+  if (m_readAhead)
+    m_readAhead->Flush();
+
+  FlushInternal();
+}
+
+void CDVDDemuxFFmpeg::FlushInternal()
 {
   if (m_pFormatContext)
   {
@@ -715,6 +780,8 @@ void CDVDDemuxFFmpeg::SetSpeed(int iSpeed)
   if (m_speed == iSpeed)
     return;
 
+  CReadAheadPause pause(m_readAhead.get());
+
   if (m_speed != DVD_PLAYSPEED_PAUSE && iSpeed == DVD_PLAYSPEED_PAUSE)
     av_read_pause(m_pFormatContext);
   else if (m_speed == DVD_PLAYSPEED_PAUSE && iSpeed != DVD_PLAYSPEED_PAUSE)
@@ -1026,6 +1093,8 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
         m_timeout.Set(20s);
         m_pkt.result = av_read_frame(m_pFormatContext, &m_pkt.pkt);
         m_timeout.SetInfinite();
+
+        UpdateStreamLength();
       }
 
       if (m_pkt.result == AVERROR(EINTR) || m_pkt.result == AVERROR(EAGAIN))
@@ -1038,7 +1107,7 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
       }
       else if (m_pkt.result < 0)
       {
-        Flush();
+        FlushInternal();
       }
       // check size and stream index for being in a valid range
       else if (m_pkt.pkt.size < 0 || m_pkt.pkt.stream_index < 0 ||
@@ -1049,7 +1118,7 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
         {
           CLog::Log(LOGERROR, "CDVDDemuxFFmpeg::Read() no valid packet");
           bReturnEmpty = true;
-          Flush();
+          FlushInternal();
         }
         else
           CLog::Log(LOGERROR, "CDVDDemuxFFmpeg::Read() returned invalid packet and eof reached");
@@ -1077,6 +1146,26 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
           return pPacket;
         }
 
+        if (m_streamInfoCache && !ValidateStreamInfoCache(m_pkt.pkt.stream_index))
+        {
+          CLog::Log(LOGINFO, "CDVDDemuxFFmpeg::Read() stream info of the library is outdated");
+
+          // probe as if the library hadn't known the streams, the packet is kept for later
+          av_opt_set_int(m_pFormatContext, "analyzeduration", m_maxAnalyzeDuration, 0);
+          if (avformat_find_stream_info(m_pFormatContext, nullptr) < 0)
+            CLog::Log(LOGWARNING, "CDVDDemuxFFmpeg::Read() could not find codec parameters");
+          av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(m_pInput->GetFileName()).c_str(),
+                         0);
+
+          CreateStreams(m_program);
+
+          pPacket = CDVDDemuxUtils::AllocateDemuxPacket(0);
+          pPacket->iStreamId = DMX_SPECIALID_STREAMCHANGE;
+          pPacket->demuxerId = GetDemuxerId();
+
+          return pPacket;
+        }
+
         AVStream* stream = m_pFormatContext->streams[m_pkt.pkt.stream_index];
 
         if (IsTransportStreamReady())
@@ -1226,9 +1315,141 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
 
 DemuxPacket* CDVDDemuxFFmpeg::Read()
 {
+  FreeRetiredStreams();
+
+  if (m_readAhead)
+    return m_readAhead->Read(READ_AHEAD_WAIT);
+
   return ReadInternal(false);
 }
 
+DemuxPacket* CDVDDemuxFFmpeg::ReadAhead()
+{
+  DemuxPacket* packet = ReadInternal(false);
+
+  // Nonblocking formats had no data yet, don't spin on them
+  if (m_pkt.result == AVERROR(EAGAIN) || m_pkt.result == AVERROR(EINTR))
+    KODI::TIME::Sleep(10ms);
+
+  return packet;
+}
+
+bool CDVDDemuxFFmpeg::EnableReadAhead(double duration)
+{
+  if (!m_pFormatContext || !m_pInput || m_readAhead)
+    return false;
+
+  // Only inputs that the player may query while reading are read ahead:
+  // - file inputs, whose EOF flag is atomic and whose cache status is safe to
+  //   read while the file cache is being filled
+  // - ffmpeg inputs, which only report an abort flag
+  // Neither has chapters of its own, the chapters of the demuxer don't change
+  // after opening and the length is a copy taken when reading. Navigation,
+  // live and transport stream inputs are driven in step with the player, and
+  // can't be read from another thread.
+  if (!(m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) ||
+        m_pInput->IsStreamType(DVDSTREAM_TYPE_FFMPEG)) ||
+      m_pInput->IsRealtime() || m_pInput->GetIDisplayTime() || m_pInput->GetIPosTime() ||
+      m_checkTransportStream)
+    return false;
+
+  m_readAhead = std::make_unique<CDemuxReadAhead>([this] { return ReadAhead(); }, duration);
+  m_readAheadDuration = duration;
+  return true;
+}
+
+bool CDVDDemuxFFmpeg::GetReadAheadState(DemuxReadAheadState& state) const
+{
+  if (!m_readAhead)
+    return false;
+
+  state = m_readAhead->GetState();
+  return true;
+}
+
+DemuxProbe CDVDDemuxFFmpeg::MatchStreamInfoCache()
+{
+  if (!CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
+          CSettings::SETTING_VIDEOPLAYER_FASTOPEN))
+    return DemuxProbe::FULL;
+
+  const CFileItem& item = m_pInput->GetItem();
+  if (!m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) || !item.HasVideoInfoTag() ||
+      m_pFormatContext->nb_streams == 0 || m_pFormatContext->streams == nullptr)
+    return DemuxProbe::FULL;
+
+  std::vector<DemuxProbedStream> streams;
+  for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
+  {
+    DemuxProbedStream stream = GetProbedStream(m_pFormatContext->streams[i]);
+    if (stream.index >= 0)
+      streams.emplace_back(std::move(stream));
+  }
+
+  auto cache = std::make_unique<CDemuxStreamInfoCache>(item.GetVideoInfoTag()->m_streamDetails);
+  const DemuxProbe probe = cache->Match(streams);
+  if (probe == DemuxProbe::FULL)
+    return probe;
+
+  CLog::Log(LOGDEBUG, "{} - stream info of the library matches the header, {}", __FUNCTION__,
+            probe == DemuxProbe::NONE ? "skipping probe" : "probing briefly");
+
+  m_maxAnalyzeDuration = m_pFormatContext->max_analyze_duration;
+  m_streamInfoCache = std::move(cache);
+  return probe;
+}
+
+bool CDVDDemuxFFmpeg::ValidateStreamInfoCache(int streamIdx)
+{
+  const bool valid =
+      m_streamInfoCache->Validate(GetProbedStream(m_pFormatContext->streams[streamIdx]));
+
+  if (!m_streamInfoCache->IsValidating())
+  {
+    if (valid)
+      CLog::Log(LOGDEBUG, "{} - stream info of the library confirmed", __FUNCTION__);
+    m_streamInfoCache.reset();
+  }
+
+  return valid;
+}
+
+DemuxProbedStream CDVDDemuxFFmpeg::GetProbedStream(const AVStream* stream) const
+{
+  DemuxProbedStream probed;
+  const AVCodecParameters* codecpar = stream->codecpar;
+
+  if (codecpar->codec_type == AVMEDIA_TYPE_VIDEO &&
+      !(stream->disposition & AV_DISPOSITION_ATTACHED_PIC))
+  {
+    probed.type = CStreamDetail::VIDEO;
+    probed.width = codecpar->width;
+    probed.height = codecpar->height;
+    probed.complete = probed.width > 0 && probed.height > 0 &&
+                      codecpar->format != AV_PIX_FMT_NONE &&
+                      (stream->avg_frame_rate.num > 0 || stream->r_frame_rate.num > 0);
+  }
+  else if (codecpar->codec_type == AVMEDIA_TYPE_AUDIO)
+  {
+    probed.type = CStreamDetail::AUDIO;
+    probed.channels = codecpar->ch_layout.nb_channels;
+    probed.sampleRate = codecpar->sample_rate;
+    probed.complete = probed.channels > 0 && probed.sampleRate > 0 &&
+                      codecpar->format != AV_SAMPLE_FMT_NONE;
+  }
+  else
+  {
+    // not part of the stream details
+    return probed;
+  }
+
+  probed.index = stream->index;
+  if (codecpar->codec_id != AV_CODEC_ID_NONE)
+    probed.codec = StreamUtils::GetCodecName(codecpar->codec_id, codecpar->profile);
+
+  return probed;
+}
+
 bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 {
   bool hitEnd = false;
@@ -1242,6 +1463,10 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
     hitEnd = true;
   }
 
+  CReadAheadPause pause(m_readAhead.get());
+  if (m_readAhead)
+    m_readAhead->Flush();
+
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
@@ -1254,7 +1479,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
     if (startpts)
       *startpts = DVD_NOPTS_VALUE;
 
-    Flush();
+    FlushInternal();
 
     return true;
   }
@@ -1274,7 +1499,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
     while (!IsTransportStreamReady())
     {
-      DemuxPacket* pkt = Read();
+      DemuxPacket* pkt = ReadInternal(false);
       if (pkt)
         CDVDDemuxUtils::FreeDemuxPacket(pkt);
       else
@@ -1376,6 +1601,10 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
 bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
+  CReadAheadPause pause(m_readAhead.get());
+  if (m_readAhead)
+    m_readAhead->Flush();
+
   std::unique_lock lock(m_critSection);
   int ret = av_seek_frame(m_pFormatContext, -1, pos, AVSEEK_FLAG_BYTE);
 
@@ -1390,14 +1619,16 @@ bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 
 int CDVDDemuxFFmpeg::GetStreamLength()
 {
-  if (!m_pFormatContext)
-    return 0;
+  return m_streamLength;
+}
 
-  if (m_pFormatContext->duration < 0 ||
+void CDVDDemuxFFmpeg::UpdateStreamLength()
+{
+  if (!m_pFormatContext || m_pFormatContext->duration < 0 ||
       m_pFormatContext->duration == AV_NOPTS_VALUE)
-    return 0;
-
-  return (int)(m_pFormatContext->duration / (AV_TIME_BASE / 1000));
+    m_streamLength = 0;
+  else
+    m_streamLength = static_cast<int>(m_pFormatContext->duration / (AV_TIME_BASE / 1000));
 }
 
 /**
@@ -1405,6 +1636,7 @@ int CDVDDemuxFFmpeg::GetStreamLength()
  */
 CDemuxStream* CDVDDemuxFFmpeg::GetStream(int iStreamId) const
 {
+  std::unique_lock lock(m_streamsSection);
   auto it = m_streams.find(iStreamId);
   if (it != m_streams.end())
     return it->second;
@@ -1416,6 +1648,7 @@ std::vector<CDemuxStream*> CDVDDemuxFFmpeg::GetStreams() const
 {
   std::vector<CDemuxStream*> streams;
 
+  std::unique_lock lock(m_streamsSection);
   streams.reserve(m_streams.size());
   for (auto& iter : m_streams)
     streams.push_back(iter.second);
@@ -1425,11 +1658,15 @@ std::vector<CDemuxStream*> CDVDDemuxFFmpeg::GetStreams() const
 
 int CDVDDemuxFFmpeg::GetNrOfStreams() const
 {
+  std::unique_lock lock(m_streamsSection);
   return static_cast<int>(m_streams.size());
 }
 
 int CDVDDemuxFFmpeg::GetPrograms(std::vector<ProgramInfo>& programs)
 {
+  // Programs are added by the demuxer while reading
+  std::unique_lock lock(m_critSection);
+
   programs.clear();
   if (!m_pFormatContext || m_pFormatContext->nb_programs <= 1)
     return 0;
@@ -1461,6 +1698,11 @@ int CDVDDemuxFFmpeg::GetPrograms(std::vector<ProgramInfo>& programs)
 
 void CDVDDemuxFFmpeg::SetProgram(int progId)
 {
+  // Packets of the old program would delay the switch
+  CReadAheadPause pause(m_readAhead.get());
+  if (m_readAhead)
+    m_readAhead->Flush();
+
   m_newProgram = progId;
 }
 
@@ -1580,13 +1822,25 @@ void CDVDDemuxFFmpeg::CreateStreams(unsigned int program)
 
 void CDVDDemuxFFmpeg::DisposeStreams()
 {
-  std::map<int, CDemuxStream*>::iterator it;
-  for(it = m_streams.begin(); it != m_streams.end(); ++it)
-    delete it->second;
+  std::unique_lock lock(m_streamsSection);
+  for (const auto& [streamIdx, stream] : m_streams)
+    m_retiredStreams.emplace_back(stream);
   m_streams.clear();
   m_parsers.clear();
 }
 
+void CDVDDemuxFFmpeg::FreeRetiredStreams()
+{
+  std::vector<CDemuxStream*> streams;
+  {
+    std::unique_lock lock(m_streamsSection);
+    streams.swap(m_retiredStreams);
+  }
+
+  for (CDemuxStream* stream : streams)
+    delete stream;
+}
+
 CDemuxStream* CDVDDemuxFFmpeg::AddStream(int streamIdx)
 {
   AVStream* pStream = m_pFormatContext->streams[streamIdx];
@@ -2030,6 +2284,7 @@ void CDVDDemuxFFmpeg::AddStream(int streamIdx, CDemuxStream* stream)
 {
   std::pair<std::map<int, CDemuxStream*>::iterator, bool> res;
 
+  std::unique_lock lock(m_streamsSection);
   res = m_streams.insert(std::make_pair(streamIdx, stream));
   if (res.second)
   {
@@ -2040,7 +2295,7 @@ void CDVDDemuxFFmpeg::AddStream(int streamIdx, CDemuxStream* stream)
   {
     // changes must keep increasing across replacements; consumers detect them by comparing values
     stream->changes = res.first->second->changes + 1;
-    delete res.first->second;
+    m_retiredStreams.emplace_back(res.first->second);
     res.first->second = stream;
   }
   CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::AddStream ID: {}", streamIdx);
@@ -2070,10 +2325,12 @@ int CDVDDemuxFFmpeg::GetChapter()
   if (ich)
     return ich->GetChapter();
 
-  if (m_chapters.empty() || m_currentPts == DVD_NOPTS_VALUE)
+  // Read once, the read-ahead thread may update it
+  const double pts = m_currentPts;
+  if (m_chapters.empty() || pts == DVD_NOPTS_VALUE)
     return 0;
 
-  const auto currentPts = std::chrono::milliseconds(DVD_TIME_TO_MSEC(m_currentPts));
+  const auto currentPts = std::chrono::milliseconds(DVD_TIME_TO_MSEC(pts));
   const std::size_t end = m_chapters.size() - 1;
 
   for (std::size_t i = 0; i < end; ++i)
@@ -2128,6 +2385,11 @@ bool CDVDDemuxFFmpeg::SeekChapter(int chapter, double* startpts)
   if (ich)
   {
     CLog::Log(LOGDEBUG, "{} - chapter seeking using input stream", __FUNCTION__);
+
+    CReadAheadPause pause(m_readAhead.get());
+    if (m_readAhead)
+      m_readAhead->Flush();
+
     if (!ich->SeekChapter(chapter))
       return false;
 
@@ -2137,7 +2399,7 @@ bool CDVDDemuxFFmpeg::SeekChapter(int chapter, double* startpts)
           DVD_SEC_TO_TIME(std::chrono::duration<double>(ich->GetChapterPos(chapter)).count());
     }
 
-    Flush();
+    FlushInternal();
     return true;
   }
 
@@ -9,8 +9,11 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "DemuxReadAhead.h"
+#include "DemuxStreamInfoCache.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
@@ -112,6 +115,9 @@ public:
   std::chrono::milliseconds GetChapterPos(int chapterIdx = -1) override;
   std::string GetStreamCodecName(int iStreamId) override;
 
+  bool EnableReadAhead(double duration) override;
+  bool GetReadAheadState(DemuxReadAheadState& state) const override;
+
   bool Aborted();
 
   AVFormatContext* m_pFormatContext;
@@ -126,6 +132,13 @@ protected:
   void AddStream(int streamIdx, CDemuxStream* stream);
   void CreateStreams(unsigned int program = UINT_MAX);
   void DisposeStreams();
+  void FreeRetiredStreams();
+  void FlushInternal();
+  DemuxPacket* ReadAhead();
+  void UpdateStreamLength();
+  DemuxProbe MatchStreamInfoCache();
+  bool ValidateStreamInfoCache(int streamIdx);
+  DemuxProbedStream GetProbedStream(const AVStream* stream) const;
   void ParsePacket(AVPacket* pkt);
   TRANSPORT_STREAM_STATE TransportStreamAudioState();
   TRANSPORT_STREAM_STATE TransportStreamVideoState();
@@ -146,11 +159,27 @@ protected:
 
   CCriticalSection m_critSection;
   std::map<int, CDemuxStream*> m_streams;
+
+  // Guards m_streams against the read-ahead thread. Replaced streams are only
+  // freed on the next Read(), as the player may still use them.
+  mutable CCriticalSection m_streamsSection;
+  std::vector<CDemuxStream*> m_retiredStreams;
+  std::unique_ptr<CDemuxReadAhead> m_readAhead;
+  double m_readAheadDuration = 0.0;
+
+  // Length of the stream in ms, updated when reading. The library may update
+  // the duration while reading, which the player must not wait for.
+  std::atomic<int> m_streamLength{0};
+
+  // Stream details of the library, until the first packets confirmed them
+  std::unique_ptr<CDemuxStreamInfoCache> m_streamInfoCache;
+  int64_t m_maxAnalyzeDuration = 0;
+
   std::map<int, std::unique_ptr<CDemuxParserFFmpeg>> m_parsers;
 
   AVIOContext* m_ioContext;
 
-  double   m_currentPts; // used for stream length estimation
+  std::atomic<double> m_currentPts; // used for stream length estimation
   bool     m_bMatroska;
   bool     m_bAVI;
   bool     m_bSup;
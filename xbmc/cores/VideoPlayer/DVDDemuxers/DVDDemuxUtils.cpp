@@ -9,7 +9,6 @@
 #include "DVDDemuxUtils.h"
 
 #include "cores/VideoPlayer/Interface/DemuxCrypto.h"
-#include "utils/MemUtils.h"
 #include "utils/log.h"
 
 extern "C"
@@ -20,12 +19,19 @@ extern "C"
 
 #include <algorithm>
 
+namespace
+{
+CDemuxPacketPool& GetPacketPool()
+{
+  static CDemuxPacketPool pool;
+  return pool;
+}
+} // namespace
+
 void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
-    if (pPacket->pData)
-      KODI::MEMORY::AlignedFree(pPacket->pData);
     if (pPacket->iSideDataElems)
     {
       AVPacket* avPkt = av_packet_alloc();
@@ -49,37 +55,13 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
     }
     if (pPacket->cryptoInfo)
       delete pPacket->cryptoInfo;
-    delete pPacket;
+    GetPacketPool().Release(pPacket);
   }
 }
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
 {
-  DemuxPacket* pPacket = new DemuxPacket();
-
-  if (iDataSize > 0)
-  {
-    // need to allocate a few bytes more.
-    // From avcodec.h (ffmpeg)
-    /**
-     * Required number of additionally allocated bytes at the end of the input bitstream for decoding.
-     * this is mainly needed because some optimized bitstream readers read
-     * 32 or 64 bit at once and could read over the end<br>
-     * Note, if the first 23 bits of the additional bytes are not 0 then damaged
-     * MPEG bitstreams could cause overread and segfault
-     */
-    pPacket->pData = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(iDataSize + AV_INPUT_BUFFER_PADDING_SIZE, 16));
-    if (!pPacket->pData)
-    {
-      FreeDemuxPacket(pPacket);
-      return NULL;
-    }
-
-    // reset the last 8 bytes to 0;
-    memset(pPacket->pData + iDataSize, 0, AV_INPUT_BUFFER_PADDING_SIZE);
-  }
-
-  return pPacket;
+  return GetPacketPool().Allocate(std::max(iDataSize, 0));
 }
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(unsigned int iDataSize, unsigned int encryptedSubsampleCount)
@@ -114,6 +96,30 @@ void CDVDDemuxUtils::StoreSideData(DemuxPacket *pkt, AVPacket *src)
   av_free(avPkt);
 }
 
+void CDVDDemuxUtils::TrimPacketPool()
+{
+  CDemuxPacketPool& pool = GetPacketPool();
+
+  for (const DemuxPacketPoolStats& stats : pool.GetStats())
+  {
+    if (stats.hits + stats.misses == 0)
+      continue;
+
+    CLog::Log(LOGDEBUG,
+              "CDVDDemuxUtils::{} - packets up to {} bytes: {} hits, {} misses, {} in use, "
+              "high-water mark {}, {} bytes held",
+              __FUNCTION__, stats.capacity, stats.hits, stats.misses, stats.inUse,
+              stats.highWaterMark, stats.bytesHeld);
+  }
+
+  pool.Trim();
+}
+
+std::vector<DemuxPacketPoolStats> CDVDDemuxUtils::GetPacketPoolStats()
+{
+  return GetPacketPool().GetStats();
+}
+
 std::vector<ChapterFFmpeg> CDVDDemuxUtils::LoadChapters(std::span<AVChapter*> chapters)
 {
   using namespace std::chrono_literals;
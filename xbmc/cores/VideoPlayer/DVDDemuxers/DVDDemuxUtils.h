@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "DemuxPacketPool.h"
 #include "cores/VideoPlayer/Interface/DemuxPacket.h"
 
 #include <chrono>
@@ -39,5 +40,13 @@ public:
   static DemuxPacket* AllocateDemuxPacket(unsigned int iDataSize,
                                           unsigned int encryptedSubsampleCount);
   static void StoreSideData(DemuxPacket* pkt, AVPacket* src);
+
+  /*!
+   * \brief Log the statistics of the packet pool and free the packets it holds for reuse
+   *
+   * Called when playback ends, so that memory isn't held while idle.
+   */
+  static void TrimPacketPool();
+  static std::vector<DemuxPacketPoolStats> GetPacketPoolStats();
   static std::vector<ChapterFFmpeg> LoadChapters(std::span<AVChapter*> chapters);
 };
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxPacketPool.h"
+
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "utils/MemUtils.h"
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+}
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <mutex>
+
+CDemuxPacketPool::CDemuxPacketPool(size_t maxBytesHeld) : m_maxBytesHeld(maxBytesHeld)
+{
+  for (size_t i = 0; i < CLASS_COUNT; i++)
+    m_classes[i].stats.capacity = GetCapacity(static_cast<int>(i));
+}
+
+CDemuxPacketPool::~CDemuxPacketPool()
+{
+  Trim();
+}
+
+DemuxPacket* CDemuxPacketPool::Allocate(size_t dataSize)
+{
+  const int sizeClass = GetClass(dataSize);
+
+  DemuxPacket* packet = nullptr;
+
+  if (sizeClass >= 0)
+  {
+    SizeClass& pool = m_classes[sizeClass];
+
+    std::unique_lock lock(pool.lock);
+
+    if (!pool.packets.empty())
+    {
+      packet = pool.packets.back();
+      pool.packets.pop_back();
+      pool.stats.bytesHeld -= GetAllocationSize(sizeClass);
+      m_bytesHeld -= GetAllocationSize(sizeClass);
+      pool.stats.hits++;
+    }
+    else
+    {
+      lock.unlock();
+      packet = Create(GetCapacity(sizeClass));
+      if (packet == nullptr)
+        return nullptr;
+      lock.lock();
+      pool.stats.misses++;
+    }
+
+    pool.stats.inUse++;
+    pool.stats.highWaterMark = std::max(pool.stats.highWaterMark, pool.stats.inUse);
+  }
+  else
+  {
+    packet = Create(dataSize);
+    if (packet == nullptr)
+      return nullptr;
+  }
+
+  // Recycled packets keep their payload buffer, reset everything else
+  uint8_t* data = packet->pData;
+  *packet = DemuxPacket();
+  packet->pData = data;
+  packet->m_poolClass = sizeClass;
+
+  if (data != nullptr)
+    std::memset(data + dataSize, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+  return packet;
+}
+
+void CDemuxPacketPool::Release(DemuxPacket* packet)
+{
+  const int sizeClass = packet->m_poolClass;
+  if (sizeClass < 0)
+  {
+    Destroy(packet);
+    return;
+  }
+
+  SizeClass& pool = m_classes[sizeClass];
+  const size_t size = GetAllocationSize(sizeClass);
+
+  {
+    std::unique_lock lock(pool.lock);
+
+    pool.stats.inUse--;
+
+    if (m_bytesHeld + size <= m_maxBytesHeld)
+    {
+      pool.packets.push_back(packet);
+      pool.stats.bytesHeld += size;
+      m_bytesHeld += size;
+      return;
+    }
+  }
+
+  Destroy(packet);
+}
+
+void CDemuxPacketPool::Trim()
+{
+  for (SizeClass& pool : m_classes)
+  {
+    std::vector<DemuxPacket*> packets;
+    {
+      std::unique_lock lock(pool.lock);
+      packets.swap(pool.packets);
+      m_bytesHeld -= pool.stats.bytesHeld;
+      pool.stats.bytesHeld = 0;
+    }
+
+    for (DemuxPacket* packet : packets)
+      Destroy(packet);
+  }
+}
+
+std::vector<DemuxPacketPoolStats> CDemuxPacketPool::GetStats() const
+{
+  std::vector<DemuxPacketPoolStats> stats;
+  stats.reserve(CLASS_COUNT);
+
+  for (const SizeClass& pool : m_classes)
+  {
+    std::unique_lock lock(pool.lock);
+    stats.push_back(pool.stats);
+  }
+
+  return stats;
+}
+
+int CDemuxPacketPool::GetClass(size_t dataSize)
+{
+  if (dataSize == 0)
+    return 0;
+
+  if (dataSize > MAX_CLASS_CAPACITY)
+    return -1;
+
+  const size_t capacity = std::bit_ceil(std::max(dataSize, MIN_CLASS_CAPACITY));
+  return std::countr_zero(capacity / MIN_CLASS_CAPACITY) + 1;
+}
+
+size_t CDemuxPacketPool::GetCapacity(int sizeClass)
+{
+  return sizeClass > 0 ? MIN_CLASS_CAPACITY << (sizeClass - 1) : 0;
+}
+
+size_t CDemuxPacketPool::GetAllocationSize(int sizeClass)
+{
+  const size_t capacity = GetCapacity(sizeClass);
+  return sizeof(DemuxPacket) + (capacity > 0 ? capacity + AV_INPUT_BUFFER_PADDING_SIZE : 0);
+}
+
+DemuxPacket* CDemuxPacketPool::Create(size_t capacity)
+{
+  DemuxPacket* packet = new DemuxPacket();
+
+  if (capacity > 0)
+  {
+    // FFmpeg requires the input to be followed by padding, as some optimized
+    // bitstream readers read 32 or 64 bits at once and could read over the end
+    packet->pData = static_cast<uint8_t*>(
+        KODI::MEMORY::AlignedMalloc(capacity + AV_INPUT_BUFFER_PADDING_SIZE, 16));
+    if (packet->pData == nullptr)
+    {
+      delete packet;
+      return nullptr;
+    }
+  }
+
+  return packet;
+}
+
+void CDemuxPacketPool::Destroy(DemuxPacket* packet)
+{
+  if (packet->pData)
+    KODI::MEMORY::AlignedFree(packet->pData);
+  delete packet;
+}
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Statistics of a size class of the demux packet pool
+ */
+struct DemuxPacketPoolStats
+{
+  size_t capacity{0}; //!< Payload capacity of the packets in the class
+  uint64_t hits{0}; //!< Allocations served by a recycled packet
+  uint64_t misses{0}; //!< Allocations that had to use the heap
+  size_t inUse{0}; //!< Packets currently allocated
+  size_t highWaterMark{0}; //!< Highest number of packets allocated at once
+  size_t bytesHeld{0}; //!< Memory held by recycled packets waiting for reuse
+};
+
+/*!
+ * \brief Recycles demux packets together with their payload buffers
+ *
+ * Packets are sorted in size classes by payload capacity, in powers of two
+ * from MIN_CLASS_CAPACITY to MAX_CLASS_CAPACITY, plus a class for packets
+ * without payload. Released packets are kept for reuse by their class until
+ * the memory held reaches a budget, so that once playback reaches a steady
+ * state, the demuxer doesn't allocate from the heap. Larger packets aren't
+ * pooled.
+ *
+ * Allocation and release may happen on different threads. Each class has its
+ * own lock, so the demux and decoder threads only contend on the same class.
+ */
+class CDemuxPacketPool
+{
+public:
+  explicit CDemuxPacketPool(size_t maxBytesHeld = DEFAULT_MAX_BYTES_HELD);
+  ~CDemuxPacketPool();
+
+  CDemuxPacketPool(const CDemuxPacketPool&) = delete;
+  CDemuxPacketPool& operator=(const CDemuxPacketPool&) = delete;
+
+  /*!
+   * \brief Get a packet with room for a payload
+   *
+   * The payload is 16 byte aligned and followed by zeroed FFmpeg input
+   * padding. All other fields of the packet have their default values.
+   *
+   * \param dataSize The size of the payload, or 0 for no payload
+   *
+   * \return The packet, or nullptr if memory couldn't be allocated
+   */
+  DemuxPacket* Allocate(size_t dataSize);
+
+  /*!
+   * \brief Return a packet obtained from Allocate()
+   *
+   * Side data and crypto info must have been freed by the caller.
+   */
+  void Release(DemuxPacket* packet);
+
+  /*!
+   * \brief Free all packets waiting for reuse
+   */
+  void Trim();
+
+  /*!
+   * \brief Get the statistics of each size class, from the smallest
+   */
+  std::vector<DemuxPacketPoolStats> GetStats() const;
+
+  /*!
+   * \brief Get the memory held by packets waiting for reuse
+   */
+  size_t GetBytesHeld() const { return m_bytesHeld; }
+
+  static constexpr size_t MIN_CLASS_CAPACITY = 1024;
+  static constexpr size_t MAX_CLASS_CAPACITY = 8 * 1024 * 1024;
+  static constexpr size_t DEFAULT_MAX_BYTES_HELD = 64 * 1024 * 1024;
+
+private:
+  // Class 0 holds packets without payload, class n holds payloads up to
+  // MIN_CLASS_CAPACITY << (n - 1)
+  static constexpr size_t CLASS_COUNT = 15;
+  static_assert((MIN_CLASS_CAPACITY << (CLASS_COUNT - 2)) == MAX_CLASS_CAPACITY);
+
+  struct SizeClass
+  {
+    mutable CCriticalSection lock;
+    std::vector<DemuxPacket*> packets; //!< Packets waiting for reuse
+    DemuxPacketPoolStats stats;
+  };
+
+  static int GetClass(size_t dataSize);
+  static size_t GetCapacity(int sizeClass);
+  static size_t GetAllocationSize(int sizeClass);
+  static DemuxPacket* Create(size_t capacity);
+  static void Destroy(DemuxPacket* packet);
+
+  const size_t m_maxBytesHeld;
+  std::atomic<size_t> m_bytesHeld{0};
+  std::array<SizeClass, CLASS_COUNT> m_classes;
+};
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxReadAhead.h"
+
+#include "DVDDemuxUtils.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+CDemuxReadAhead::CDemuxReadAhead(ReadFunc read,
+                                 double maxDuration,
+                                 size_t maxBytes /* = DEFAULT_MAX_BYTES */)
+  : CThread("DemuxReadAhead"),
+    m_read(std::move(read)),
+    m_maxDuration(maxDuration),
+    m_maxBytes(maxBytes),
+    m_newestTime(DVD_NOPTS_VALUE)
+{
+  Create();
+}
+
+CDemuxReadAhead::~CDemuxReadAhead()
+{
+  {
+    std::unique_lock lock(m_section);
+    m_bStop = true;
+    m_readerCondition.notifyAll();
+  }
+  StopThread();
+
+  Flush();
+}
+
+DemuxPacket* CDemuxReadAhead::Read(std::chrono::milliseconds timeout)
+{
+  std::unique_lock lock(m_section);
+  m_packetAdded.wait(lock, timeout, [this] { return !m_queue.empty() || m_endOfStream; });
+
+  if (!m_queue.empty())
+  {
+    DemuxPacket* packet = m_queue.front().packet;
+    m_queue.pop_front();
+    m_bytes -= static_cast<size_t>(packet->iSize);
+    UpdateDuration();
+
+    m_readerCondition.notifyAll();
+    return packet;
+  }
+
+  // Report the end once, then try again like a direct read would
+  if (m_endOfStream)
+  {
+    m_endOfStream = false;
+    m_readerCondition.notifyAll();
+    return nullptr;
+  }
+
+  lock.unlock();
+  return CDVDDemuxUtils::AllocateDemuxPacket(0);
+}
+
+void CDemuxReadAhead::Pause()
+{
+  std::unique_lock lock(m_section);
+  m_pauseCount++;
+  m_readerIdle.wait(lock, [this] { return !m_reading; });
+}
+
+void CDemuxReadAhead::Resume()
+{
+  std::unique_lock lock(m_section);
+  if (m_pauseCount > 0 && --m_pauseCount == 0)
+    m_readerCondition.notifyAll();
+}
+
+void CDemuxReadAhead::Flush()
+{
+  std::deque<Entry> queue;
+  {
+    std::unique_lock lock(m_section);
+    queue.swap(m_queue);
+    m_bytes = 0;
+    m_endOfStream = false;
+    UpdateDuration();
+    m_readerCondition.notifyAll();
+  }
+
+  for (const Entry& entry : queue)
+    CDVDDemuxUtils::FreeDemuxPacket(entry.packet);
+}
+
+DemuxReadAheadState CDemuxReadAhead::GetState() const
+{
+  std::unique_lock lock(m_section);
+
+  DemuxReadAheadState state;
+  state.packets = m_queue.size();
+  state.bytes = m_bytes;
+  state.duration = m_duration;
+  return state;
+}
+
+void CDemuxReadAhead::Process()
+{
+  while (true)
+  {
+    {
+      std::unique_lock lock(m_section);
+      m_readerCondition.wait(lock, [this]
+                             { return m_bStop || (m_pauseCount == 0 && !m_endOfStream && !IsFull()); });
+      if (m_bStop)
+        break;
+
+      m_reading = true;
+    }
+
+    DemuxPacket* packet = m_read();
+
+    std::unique_lock lock(m_section);
+    m_reading = false;
+    m_readerIdle.notifyAll();
+
+    if (!packet)
+    {
+      m_endOfStream = true;
+    }
+    else if (packet->iSize == 0 && packet->iStreamId == -1)
+    {
+      lock.unlock();
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+      continue;
+    }
+    else
+    {
+      const double time = packet->dts != DVD_NOPTS_VALUE ? packet->dts : packet->pts;
+      if (time != DVD_NOPTS_VALUE)
+        m_newestTime = m_newestTime == DVD_NOPTS_VALUE ? time : std::max(m_newestTime, time);
+
+      m_queue.push_back({packet, time});
+      m_bytes += static_cast<size_t>(packet->iSize);
+      UpdateDuration();
+    }
+
+    m_packetAdded.notifyAll();
+  }
+}
+
+bool CDemuxReadAhead::IsFull() const
+{
+  return m_duration >= m_maxDuration || m_bytes >= m_maxBytes || m_queue.size() >= MAX_PACKETS;
+}
+
+void CDemuxReadAhead::UpdateDuration()
+{
+  if (m_queue.empty())
+  {
+    // Start over, the next packets may follow a discontinuity
+    m_newestTime = DVD_NOPTS_VALUE;
+    m_duration = 0.0;
+    return;
+  }
+
+  const auto oldest = std::find_if(m_queue.begin(), m_queue.end(), [](const Entry& entry)
+                                   { return entry.time != DVD_NOPTS_VALUE; });
+  if (oldest == m_queue.end())
+    m_duration = 0.0;
+  else
+    m_duration = std::max(0.0, m_newestTime - oldest->time);
+}
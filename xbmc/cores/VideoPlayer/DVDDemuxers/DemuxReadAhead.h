@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <stddef.h>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Fill level of the read-ahead queue
+ */
+struct DemuxReadAheadState
+{
+  size_t packets{0}; //!< Packets waiting to be read
+  size_t bytes{0}; //!< Payload of the waiting packets
+  double duration{0.0}; //!< Time span of the waiting packets, in DVD_TIME_BASE units
+};
+
+/*!
+ * \brief Reads packets from a demuxer on a thread of its own
+ *
+ * Packets are queued until they span the configured duration, so that I/O
+ * stalls are absorbed before they reach the player. A byte limit bounds the
+ * queue of high bitrate streams and streams without timestamps.
+ *
+ * The demuxer must not be used by other threads while packets are read.
+ * Operations that change its state, such as seeks, wrap themselves in
+ * Pause() and Resume(), which wait for the current read to finish.
+ */
+class CDemuxReadAhead : private CThread
+{
+public:
+  /*!
+   * \brief Read the next packet from the demuxer
+   *
+   * Returns nullptr at the end of the stream or on error. Empty packets,
+   * returned when no data was available, are dropped.
+   */
+  using ReadFunc = std::function<DemuxPacket*()>;
+
+  /*!
+   * \param read Reads from the demuxer, on the read-ahead thread
+   * \param maxDuration The time span to read ahead, in DVD_TIME_BASE units
+   * \param maxBytes The payload limit of the queue
+   */
+  CDemuxReadAhead(ReadFunc read, double maxDuration, size_t maxBytes = DEFAULT_MAX_BYTES);
+  ~CDemuxReadAhead() override;
+
+  CDemuxReadAhead(const CDemuxReadAhead&) = delete;
+  CDemuxReadAhead& operator=(const CDemuxReadAhead&) = delete;
+
+  /*!
+   * \brief Take the next packet from the queue
+   *
+   * Waits up to timeout if the queue is empty, so that the caller doesn't
+   * spin while the read-ahead thread is stalled.
+   *
+   * \return The packet, nullptr at the end of the stream, or an empty packet
+   *         if none arrived in time
+   */
+  DemuxPacket* Read(std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Stop reading and wait for the current read to finish
+   *
+   * Calls may be nested, reading resumes after the last Resume().
+   */
+  void Pause();
+  void Resume();
+
+  /*!
+   * \brief Free all queued packets and forget about the end of the stream
+   */
+  void Flush();
+
+  DemuxReadAheadState GetState() const;
+
+  static constexpr size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+  //! Packets without timestamps don't count towards the duration, so their
+  //! number is limited separately
+  static constexpr size_t MAX_PACKETS = 8192;
+
+protected:
+  void Process() override;
+
+private:
+  struct Entry
+  {
+    DemuxPacket* packet;
+    double time;
+  };
+
+  bool IsFull() const;
+  void UpdateDuration();
+
+  const ReadFunc m_read;
+  const double m_maxDuration;
+  const size_t m_maxBytes;
+
+  mutable CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_readerCondition; //!< Signals the read-ahead thread
+  XbmcThreads::ConditionVariable m_readerIdle; //!< Signals the end of a read
+  XbmcThreads::ConditionVariable m_packetAdded;
+
+  std::deque<Entry> m_queue;
+  size_t m_bytes{0};
+  double m_newestTime;
+  double m_duration{0.0};
+  int m_pauseCount{0};
+  bool m_reading{false};
+  bool m_endOfStream{false};
+};
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxStreamInfoCache.h"
+
+#include <algorithm>
+
+CDemuxStreamInfoCache::CDemuxStreamInfoCache(const CStreamDetails& details)
+{
+  for (int i = 1; i <= details.GetVideoStreamCount(); i++)
+  {
+    const auto* video =
+        static_cast<const CStreamDetailVideo*>(details.GetNthStream(CStreamDetail::VIDEO, i));
+    if (!video)
+      continue;
+
+    DemuxProbedStream stream;
+    stream.type = CStreamDetail::VIDEO;
+    stream.codec = video->m_strCodec;
+    stream.width = video->m_iWidth;
+    stream.height = video->m_iHeight;
+
+    // Skip the copy that the scanner adds for an alternate HDR type
+    if (!m_cachedVideo.empty() && m_cachedVideo.back().codec == stream.codec &&
+        m_cachedVideo.back().width == stream.width && m_cachedVideo.back().height == stream.height)
+      continue;
+
+    m_cachedVideo.emplace_back(std::move(stream));
+  }
+
+  for (int i = 1; i <= details.GetAudioStreamCount(); i++)
+  {
+    const auto* audio =
+        static_cast<const CStreamDetailAudio*>(details.GetNthStream(CStreamDetail::AUDIO, i));
+    if (!audio)
+      continue;
+
+    DemuxProbedStream stream;
+    stream.type = CStreamDetail::AUDIO;
+    stream.codec = audio->m_strCodec;
+    stream.channels = audio->m_iChannels;
+    m_cachedAudio.emplace_back(std::move(stream));
+  }
+}
+
+DemuxProbe CDemuxStreamInfoCache::Match(const std::vector<DemuxProbedStream>& streams)
+{
+  m_expected.clear();
+  m_validated.clear();
+  m_pending = 0;
+
+  if (m_cachedVideo.empty() && m_cachedAudio.empty())
+    return DemuxProbe::FULL;
+
+  std::vector<DemuxProbedStream> expected;
+  size_t video = 0;
+  size_t audio = 0;
+  bool complete = true;
+
+  for (const DemuxProbedStream& stream : streams)
+  {
+    const DemuxProbedStream* cached = nullptr;
+    if (stream.type == CStreamDetail::VIDEO && video < m_cachedVideo.size())
+      cached = &m_cachedVideo[video++];
+    else if (stream.type == CStreamDetail::AUDIO && audio < m_cachedAudio.size())
+      cached = &m_cachedAudio[audio++];
+
+    if (!cached || stream.index < 0 || !Matches(*cached, stream))
+      return DemuxProbe::FULL;
+
+    if (!stream.complete || stream.codec != cached->codec)
+      complete = false;
+
+    DemuxProbedStream entry = *cached;
+    entry.index = stream.index;
+    expected.emplace_back(std::move(entry));
+  }
+
+  // Streams were added or removed since the item was scanned
+  if (video != m_cachedVideo.size() || audio != m_cachedAudio.size())
+    return DemuxProbe::FULL;
+
+  for (DemuxProbedStream& entry : expected)
+  {
+    const size_t index = static_cast<size_t>(entry.index);
+    if (index >= m_expected.size())
+    {
+      m_expected.resize(index + 1);
+      m_validated.resize(index + 1, true);
+    }
+    m_expected[index] = std::move(entry);
+    m_validated[index] = false;
+    m_pending++;
+  }
+
+  return complete ? DemuxProbe::NONE : DemuxProbe::SHORT;
+}
+
+bool CDemuxStreamInfoCache::Validate(const DemuxProbedStream& stream)
+{
+  if (stream.index < 0 || static_cast<size_t>(stream.index) >= m_validated.size() ||
+      m_validated[stream.index])
+    return true;
+
+  m_validated[stream.index] = true;
+  m_pending--;
+
+  const DemuxProbedStream& expected = m_expected[stream.index];
+
+  bool valid = expected.type == stream.type && Matches(expected, stream);
+  if (stream.type == CStreamDetail::VIDEO)
+    valid = valid && stream.width > 0 && stream.height > 0;
+  else
+    valid = valid && stream.channels > 0 && stream.sampleRate > 0;
+
+  // One failure calls for probing all streams
+  if (!valid)
+  {
+    std::fill(m_validated.begin(), m_validated.end(), true);
+    m_pending = 0;
+  }
+
+  return valid;
+}
+
+bool CDemuxStreamInfoCache::Matches(const DemuxProbedStream& cached,
+                                    const DemuxProbedStream& stream)
+{
+  if (stream.codec.empty())
+    return false;
+
+  if (stream.codec != cached.codec &&
+      (cached.codec.size() <= stream.codec.size() ||
+       cached.codec.compare(0, stream.codec.size() + 1, stream.codec + "_") != 0))
+    return false;
+
+  if (stream.type == CStreamDetail::VIDEO)
+  {
+    if (stream.width > 0 && stream.height > 0 && cached.width > 0 && cached.height > 0 &&
+        (stream.width != cached.width || stream.height != cached.height))
+      return false;
+  }
+  else if (stream.channels > 0 && cached.channels > 0 && stream.channels != cached.channels)
+  {
+    return false;
+  }
+
+  return true;
+}
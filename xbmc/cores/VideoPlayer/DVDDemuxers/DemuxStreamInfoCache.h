@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/StreamDetails.h"
+
+#include <string>
+#include <vector>
+
+/*!
+ * \brief A video or audio stream as known from the container header, or
+ *        from its first packets
+ */
+struct DemuxProbedStream
+{
+  int index{-1}; //!< Index of the stream in the container
+  CStreamDetail::StreamType type{CStreamDetail::VIDEO};
+  std::string codec; //!< As returned by StreamUtils::GetCodecName()
+  int width{0};
+  int height{0};
+  int channels{0};
+  int sampleRate{0};
+  bool complete{false}; //!< No parameters are left for probing to find
+};
+
+/*!
+ * \brief How much of the stream info must be probed when opening a file
+ */
+enum class DemuxProbe
+{
+  FULL, //!< Probe as usual
+  SHORT, //!< The cache matches, probe briefly for what the header leaves open
+  NONE, //!< The header is complete and matches the cache
+};
+
+/*!
+ * \brief Lets the demuxer trust the stream details of library items
+ *
+ * Probing stream info reads and decodes up to several seconds of the file,
+ * which can take long on network shares. Items scanned into the library
+ * already know their streams from an earlier probe. If the container header
+ * agrees with them, probing can be shortened or skipped.
+ *
+ * As the cache may be outdated, the streams are checked against it once more
+ * when their first packet arrives. A mismatch calls for a full probe then.
+ */
+class CDemuxStreamInfoCache
+{
+public:
+  explicit CDemuxStreamInfoCache(const CStreamDetails& details);
+
+  /*!
+   * \brief Compare the streams of the container header with the cache
+   *
+   * \param streams The video and audio streams in the container, in order
+   *
+   * \return How much probing is still needed
+   */
+  DemuxProbe Match(const std::vector<DemuxProbedStream>& streams);
+
+  /*!
+   * \brief Check a stream against the cache on its first packet
+   *
+   * Streams that weren't matched, and streams that were validated before,
+   * pass.
+   *
+   * \return False if the stream doesn't match or lacks parameters
+   */
+  bool Validate(const DemuxProbedStream& stream);
+
+  /*!
+   * \brief Whether matched streams are waiting for their first packet
+   */
+  bool IsValidating() const { return m_pending > 0; }
+
+private:
+  /*!
+   * \brief Whether the parameters of a stream agree with the cache
+   *
+   * A codec name may be less specific than the cached one, e.g. "aac" for
+   * "aac_lc", when the profile is only found by probing.
+   */
+  static bool Matches(const DemuxProbedStream& cached, const DemuxProbedStream& stream);
+
+  std::vector<DemuxProbedStream> m_cachedVideo;
+  std::vector<DemuxProbedStream> m_cachedAudio;
+
+  //! Cached streams by container index, for validation
+  std::vector<DemuxProbedStream> m_expected;
+  std::vector<bool> m_validated;
+  int m_pending{0};
+};
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxPacketPool.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+TEST(TestDemuxPacketPool, RecyclePackets)
+{
+  CDemuxPacketPool pool;
+
+  DemuxPacket* packet = pool.Allocate(1500);
+  ASSERT_NE(packet, nullptr);
+  ASSERT_NE(packet->pData, nullptr);
+  uint8_t* data = packet->pData;
+
+  std::memset(data, 0xFF, 2048);
+  packet->iSize = 1500;
+  packet->iStreamId = 3;
+  packet->pts = 1000.0;
+  pool.Release(packet);
+
+  // A payload of the same size class reuses the packet, with its fields reset
+  packet = pool.Allocate(2000);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->pData, data);
+  EXPECT_EQ(packet->iSize, 0);
+  EXPECT_EQ(packet->iStreamId, -1);
+  EXPECT_EQ(packet->pts, DVD_NOPTS_VALUE);
+  EXPECT_EQ(packet->pData[2000], 0);
+  pool.Release(packet);
+
+  const std::vector<DemuxPacketPoolStats> stats = pool.GetStats();
+  ASSERT_GT(stats.size(), 2u);
+  EXPECT_EQ(stats[2].capacity, 2048u);
+  EXPECT_EQ(stats[2].hits, 1u);
+  EXPECT_EQ(stats[2].misses, 1u);
+  EXPECT_EQ(stats[2].inUse, 0u);
+  EXPECT_EQ(stats[2].highWaterMark, 1u);
+  EXPECT_GT(stats[2].bytesHeld, 2048u);
+  EXPECT_EQ(pool.GetBytesHeld(), stats[2].bytesHeld);
+
+  pool.Trim();
+  EXPECT_EQ(pool.GetBytesHeld(), 0u);
+}
+
+TEST(TestDemuxPacketPool, NoPayload)
+{
+  CDemuxPacketPool pool;
+
+  DemuxPacket* packet = pool.Allocate(0);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->pData, nullptr);
+  pool.Release(packet);
+
+  packet = pool.Allocate(0);
+  EXPECT_EQ(packet->pData, nullptr);
+  pool.Release(packet);
+
+  EXPECT_EQ(pool.GetStats()[0].hits, 1u);
+}
+
+TEST(TestDemuxPacketPool, HighWaterMark)
+{
+  CDemuxPacketPool pool;
+
+  DemuxPacket* packets[3];
+  for (DemuxPacket*& packet : packets)
+    packet = pool.Allocate(100);
+  for (DemuxPacket* packet : packets)
+    pool.Release(packet);
+
+  packets[0] = pool.Allocate(100);
+  pool.Release(packets[0]);
+
+  const DemuxPacketPoolStats stats = pool.GetStats()[1];
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.highWaterMark, 3u);
+}
+
+TEST(TestDemuxPacketPool, Budget)
+{
+  // Room for a single recycled packet of 64 KiB
+  CDemuxPacketPool pool(96 * 1024);
+
+  DemuxPacket* first = pool.Allocate(64 * 1024);
+  DemuxPacket* second = pool.Allocate(64 * 1024);
+  pool.Release(first);
+  pool.Release(second);
+
+  const size_t held = pool.GetBytesHeld();
+  EXPECT_GT(held, 64u * 1024);
+  EXPECT_LE(held, 96u * 1024);
+
+  // Packets larger than the largest class aren't pooled
+  DemuxPacket* large = pool.Allocate(CDemuxPacketPool::MAX_CLASS_CAPACITY + 1);
+  ASSERT_NE(large, nullptr);
+  pool.Release(large);
+  EXPECT_EQ(pool.GetBytesHeld(), held);
+}
@@ -0,0 +1,204 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDDemuxers/DemuxReadAhead.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr double FRAME_TIME = DVD_TIME_BASE / 25;
+
+// Produces packets numbered by their stream id, 25 per second
+class CTestSource
+{
+public:
+  explicit CTestSource(int count = -1, int size = 100) : m_count(count), m_size(size) {}
+
+  DemuxPacket* Read()
+  {
+    const int index = m_next++;
+    if (m_count >= 0 && index >= m_count)
+      return nullptr;
+
+    DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(m_size);
+    packet->iSize = m_size;
+    packet->iStreamId = index;
+    if (m_timestamps)
+      packet->dts = index * FRAME_TIME;
+    return packet;
+  }
+
+  int GetReads() const { return m_next; }
+
+  bool m_timestamps{true};
+
+private:
+  const int m_count;
+  const int m_size;
+  std::atomic<int> m_next{0};
+};
+
+// Wait until the read-ahead thread has filled the queue
+DemuxReadAheadState WaitUntilFull(const CDemuxReadAhead& readAhead)
+{
+  DemuxReadAheadState state = readAhead.GetState();
+  for (int i = 0; i < 100; i++)
+  {
+    std::this_thread::sleep_for(10ms);
+    const DemuxReadAheadState next = readAhead.GetState();
+    if (next.packets == state.packets && next.packets > 0)
+      break;
+    state = next;
+  }
+  return readAhead.GetState();
+}
+} // namespace
+
+TEST(TestDemuxReadAhead, PreservesOrder)
+{
+  CTestSource source(100);
+  CDemuxReadAhead readAhead([&source] { return source.Read(); }, 10 * DVD_TIME_BASE);
+
+  for (int i = 0; i < 100; i++)
+  {
+    DemuxPacket* packet = readAhead.Read(1s);
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet->iStreamId, i);
+    CDVDDemuxUtils::FreeDemuxPacket(packet);
+  }
+
+  // The end is reported after the last packet
+  EXPECT_EQ(readAhead.Read(1s), nullptr);
+}
+
+TEST(TestDemuxReadAhead, BoundedByDuration)
+{
+  CTestSource source;
+  CDemuxReadAhead readAhead([&source] { return source.Read(); }, DVD_TIME_BASE);
+
+  const DemuxReadAheadState state = WaitUntilFull(readAhead);
+  EXPECT_GE(state.duration, DVD_TIME_BASE);
+  EXPECT_LT(state.duration, DVD_TIME_BASE + 2 * FRAME_TIME);
+  EXPECT_EQ(state.packets, 26u);
+  EXPECT_EQ(state.bytes, 26u * 100);
+
+  // Taking a packet makes room for the next one
+  DemuxPacket* packet = readAhead.Read(1s);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->iStreamId, 0);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(source.GetReads(), 27);
+}
+
+TEST(TestDemuxReadAhead, BoundedByBytes)
+{
+  // Packets without timestamps are limited by their size
+  CTestSource source(-1, 1000);
+  source.m_timestamps = false;
+  CDemuxReadAhead readAhead([&source] { return source.Read(); }, DVD_TIME_BASE, 10000);
+
+  const DemuxReadAheadState state = WaitUntilFull(readAhead);
+  EXPECT_EQ(state.packets, 10u);
+  EXPECT_EQ(state.bytes, 10000u);
+  EXPECT_EQ(state.duration, 0.0);
+}
+
+TEST(TestDemuxReadAhead, PauseAndFlush)
+{
+  CTestSource source;
+  CDemuxReadAhead readAhead([&source] { return source.Read(); }, DVD_TIME_BASE);
+  WaitUntilFull(readAhead);
+
+  readAhead.Pause();
+  readAhead.Flush();
+  EXPECT_EQ(readAhead.GetState().packets, 0u);
+
+  // Nothing is read while paused
+  const int reads = source.GetReads();
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(source.GetReads(), reads);
+
+  DemuxPacket* packet = readAhead.Read(10ms);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->iSize, 0);
+  EXPECT_EQ(packet->iStreamId, -1);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+  // Reading continues where the demuxer is after the pause
+  readAhead.Resume();
+  packet = readAhead.Read(1s);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->iStreamId, reads);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+}
+
+TEST(TestDemuxReadAhead, DropsEmptyPackets)
+{
+  std::atomic<int> reads{0};
+  CDemuxReadAhead readAhead(
+      [&reads]
+      {
+        const int index = reads++;
+        DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(0);
+        if (index % 2 == 1)
+          packet->iStreamId = index;
+        return packet;
+      },
+      DVD_TIME_BASE);
+
+  for (int i = 1; i < 10; i += 2)
+  {
+    DemuxPacket* packet = readAhead.Read(1s);
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet->iStreamId, i);
+    CDVDDemuxUtils::FreeDemuxPacket(packet);
+  }
+}
+
+TEST(TestDemuxReadAhead, StalledRead)
+{
+  CEvent release;
+  std::atomic<bool> stalled{true};
+  CDemuxReadAhead readAhead(
+      [&]
+      {
+        if (stalled)
+        {
+          release.Wait();
+          stalled = false;
+        }
+        DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(0);
+        packet->iStreamId = 1;
+        return packet;
+      },
+      DVD_TIME_BASE);
+
+  // The reader gets control back while the demuxer is stalled
+  DemuxPacket* packet = readAhead.Read(10ms);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->iStreamId, -1);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+  release.Set();
+  packet = readAhead.Read(1s);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->iStreamId, 1);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+}
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DemuxStreamInfoCache.h"
+#include "utils/StreamDetails.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+void AddVideo(CStreamDetails& details, const std::string& codec, int width, int height)
+{
+  auto* video = new CStreamDetailVideo();
+  video->m_strCodec = codec;
+  video->m_iWidth = width;
+  video->m_iHeight = height;
+  details.AddStream(video);
+}
+
+void AddAudio(CStreamDetails& details, const std::string& codec, int channels)
+{
+  auto* audio = new CStreamDetailAudio();
+  audio->m_strCodec = codec;
+  audio->m_iChannels = channels;
+  details.AddStream(audio);
+}
+
+DemuxProbedStream Video(int index, const std::string& codec, int width, int height, bool complete)
+{
+  DemuxProbedStream stream;
+  stream.index = index;
+  stream.type = CStreamDetail::VIDEO;
+  stream.codec = codec;
+  stream.width = width;
+  stream.height = height;
+  stream.complete = complete;
+  return stream;
+}
+
+DemuxProbedStream Audio(int index, const std::string& codec, int channels, bool complete)
+{
+  DemuxProbedStream stream;
+  stream.index = index;
+  stream.type = CStreamDetail::AUDIO;
+  stream.codec = codec;
+  stream.channels = channels;
+  stream.sampleRate = channels > 0 ? 48000 : 0;
+  stream.complete = complete;
+  return stream;
+}
+
+CStreamDetails MovieDetails()
+{
+  CStreamDetails details;
+  AddVideo(details, "hevc", 3840, 2160);
+  AddAudio(details, "eac3", 6);
+  AddAudio(details, "aac_lc", 2);
+  return details;
+}
+} // namespace
+
+TEST(TestDemuxStreamInfoCache, NoDetails)
+{
+  CDemuxStreamInfoCache cache{CStreamDetails()};
+  EXPECT_EQ(cache.Match({Video(0, "h264", 1920, 1080, true)}), DemuxProbe::FULL);
+  EXPECT_FALSE(cache.IsValidating());
+}
+
+TEST(TestDemuxStreamInfoCache, MatchHeader)
+{
+  CDemuxStreamInfoCache cache(MovieDetails());
+
+  // Streams other than video and audio, e.g. subtitles at index 1, aren't passed
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 3840, 2160, true), Audio(2, "eac3", 6, true),
+                         Audio(3, "aac_lc", 2, true)}),
+            DemuxProbe::NONE);
+  EXPECT_TRUE(cache.IsValidating());
+
+  // Parameters left open by the header are found by a short probe
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 0, 0, false), Audio(2, "eac3", 6, false),
+                         Audio(3, "aac_lc", 0, false)}),
+            DemuxProbe::SHORT);
+
+  // So is a profile that refines the codec
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 3840, 2160, true), Audio(2, "eac3", 6, true),
+                         Audio(3, "aac", 2, true)}),
+            DemuxProbe::SHORT);
+}
+
+TEST(TestDemuxStreamInfoCache, MismatchHeader)
+{
+  CDemuxStreamInfoCache cache(MovieDetails());
+
+  // Different codec
+  EXPECT_EQ(cache.Match({Video(0, "h264", 3840, 2160, true), Audio(1, "eac3", 6, true),
+                         Audio(2, "aac_lc", 2, true)}),
+            DemuxProbe::FULL);
+
+  // Different size
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 1920, 1080, true), Audio(1, "eac3", 6, true),
+                         Audio(2, "aac_lc", 2, true)}),
+            DemuxProbe::FULL);
+
+  // Different channels
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 3840, 2160, true), Audio(1, "eac3", 8, true),
+                         Audio(2, "aac_lc", 2, true)}),
+            DemuxProbe::FULL);
+
+  // Missing and added streams
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 3840, 2160, true), Audio(1, "eac3", 6, true)}),
+            DemuxProbe::FULL);
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 3840, 2160, true), Audio(1, "eac3", 6, true),
+                         Audio(2, "aac_lc", 2, true), Audio(3, "ac3", 6, true)}),
+            DemuxProbe::FULL);
+
+  // A prefix of the cached codec that isn't a profile of it
+  CStreamDetails details;
+  AddAudio(details, "dtshd_ma", 8);
+  CDemuxStreamInfoCache dtsCache(details);
+  EXPECT_EQ(dtsCache.Match({Audio(0, "dts", 8, true)}), DemuxProbe::FULL);
+  EXPECT_FALSE(dtsCache.IsValidating());
+}
+
+TEST(TestDemuxStreamInfoCache, AlternateHdrType)
+{
+  // The scanner adds a copy of the video stream for its alternate HDR type
+  CStreamDetails details;
+  AddVideo(details, "hevc", 3840, 2160);
+  AddVideo(details, "hevc", 3840, 2160);
+  AddAudio(details, "truehd_atmos", 8);
+
+  CDemuxStreamInfoCache cache(details);
+  EXPECT_EQ(cache.Match({Video(0, "hevc", 3840, 2160, true), Audio(1, "truehd", 8, true)}),
+            DemuxProbe::SHORT);
+}
+
+TEST(TestDemuxStreamInfoCache, Validate)
+{
+  CDemuxStreamInfoCache cache(MovieDetails());
+  ASSERT_EQ(cache.Match({Video(0, "hevc", 0, 0, false), Audio(2, "eac3", 6, false),
+                         Audio(3, "aac", 2, false)}),
+            DemuxProbe::SHORT);
+
+  // Unknown streams pass
+  EXPECT_TRUE(cache.Validate(Audio(1, "ac3", 6, true)));
+  EXPECT_TRUE(cache.Validate(Audio(7, "ac3", 6, true)));
+
+  EXPECT_TRUE(cache.Validate(Video(0, "hevc", 3840, 2160, true)));
+  EXPECT_TRUE(cache.IsValidating());
+  EXPECT_TRUE(cache.Validate(Audio(2, "eac3", 6, true)));
+  EXPECT_TRUE(cache.Validate(Audio(3, "aac", 2, true)));
+  EXPECT_FALSE(cache.IsValidating());
+
+  // Streams are only checked on their first packet
+  EXPECT_TRUE(cache.Validate(Video(0, "hevc", 1280, 720, true)));
+}
+
+TEST(TestDemuxStreamInfoCache, ValidateFailure)
+{
+  CDemuxStreamInfoCache cache(MovieDetails());
+  ASSERT_EQ(cache.Match({Video(0, "hevc", 0, 0, false), Audio(1, "eac3", 6, false),
+                         Audio(2, "aac_lc", 2, false)}),
+            DemuxProbe::SHORT);
+
+  // The short probe didn't find the size
+  EXPECT_FALSE(cache.Validate(Video(0, "hevc", 0, 0, false)));
+  EXPECT_FALSE(cache.IsValidating());
+
+  // All streams are probed after a failure
+  EXPECT_TRUE(cache.Validate(Audio(1, "eac3", 2, true)));
+
+  ASSERT_EQ(cache.Match({Video(0, "hevc", 0, 0, false), Audio(1, "eac3", 6, false),
+                         Audio(2, "aac_lc", 2, false)}),
+            DemuxProbe::SHORT);
+  EXPECT_FALSE(cache.Validate(Audio(1, "eac3", 2, true)));
+}
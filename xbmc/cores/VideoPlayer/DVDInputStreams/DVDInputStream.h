@@ -209,6 +209,7 @@ public:
   virtual IChapter* GetIChapter() { return nullptr; }
 
   const CVariant& GetProperty(const std::string& key) { return m_item.GetProperty(key); }
+  const CFileItem& GetItem() const { return m_item; }
 
   enum class UpdateState : uint8_t
   {
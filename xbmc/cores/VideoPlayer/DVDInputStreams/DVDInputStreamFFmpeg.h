@@ -27,8 +27,6 @@ public:
   void  Abort() override { m_aborted = true;  }
   bool Aborted() { return m_aborted;  }
 
-  const CFileItem& GetItem() const { return m_item; }
-
   std::string GetProxyType() const;
   std::string GetProxyHost() const;
   uint16_t GetProxyPort() const;
@@ -10,6 +10,8 @@
 
 #include "DVDInputStream.h"
 
+#include <atomic>
+
 class CDVDInputStreamFile : public CDVDInputStream
 {
 public:
@@ -28,6 +30,6 @@ public:
 
 protected:
   XFILE::CFile* m_pFile = nullptr;
-  bool m_eof = false;
+  std::atomic<bool> m_eof{false}; // the demuxer may read ahead on another thread
   unsigned int m_flags = 0;
 };
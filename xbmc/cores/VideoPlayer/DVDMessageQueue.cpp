@@ -46,15 +46,36 @@ void CDVDMessageQueue::Init()
 
 void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 {
+  std::unique_lock producerLock(m_producerSection);
+  std::unique_lock consumerLock(m_consumerSection);
   std::unique_lock lock(m_section);
 
-  m_messages.remove_if([type](const DVDMessageListItem &item){
-    return type == CDVDMsg::NONE || item.message->IsType(type);
-  });
+  auto matches = [type](const std::shared_ptr<CDVDMsg>& msg)
+  { return type == CDVDMsg::NONE || msg->IsType(type); };
 
-  m_prioMessages.remove_if([type](const DVDMessageListItem &item){
-    return type == CDVDMsg::NONE || item.message->IsType(type);
-  });
+  m_messages.remove_if([&matches](const DVDMessageListItem& item)
+                       { return matches(item.message); });
+
+  m_prioMessages.remove_if([&matches](const DVDMessageListItem& item)
+                           { return matches(item.message); });
+
+  m_overflow.remove_if([&matches](const DVDMessageListItem& item)
+                       { return matches(item.message); });
+
+  m_lockedCount = m_messages.size() + m_prioMessages.size();
+  m_hasOverflow = !m_overflow.empty();
+
+  // Both sides of the ring are held, keep the remaining messages in order
+  const size_t head = m_ringHead;
+  const size_t tail = m_ringTail;
+  size_t kept = head;
+  for (size_t i = head; i != tail; i++)
+  {
+    std::shared_ptr<CDVDMsg> msg = std::move(m_ring[i % RING_SIZE]);
+    if (!matches(msg))
+      m_ring[kept++ % RING_SIZE] = std::move(msg);
+  }
+  m_ringTail = kept;
 
   if (type == CDVDMsg::DEMUXER_PACKET ||  type == CDVDMsg::NONE)
   {
@@ -76,10 +97,10 @@ void CDVDMessageQueue::Abort()
 
 void CDVDMessageQueue::End()
 {
-  std::unique_lock lock(m_section);
-
   Flush(CDVDMsg::NONE);
 
+  std::unique_lock lock(m_section);
+
   m_bInitialized = false;
   m_iDataSize = 0;
   m_bAbortRequest = false;
@@ -99,8 +120,6 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
                                          int priority,
                                          bool front)
 {
-  std::unique_lock lock(m_section);
-
   if (!m_bInitialized)
   {
     CLog::Log(LOGWARNING, "CDVDMessageQueue({})::Put MSGQ_NOT_INITIALIZED", m_owner);
@@ -112,6 +131,36 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
     return MSGQ_INVALID_MSG;
   }
 
+  if (priority == 0 && front)
+  {
+    std::unique_lock producerLock(m_producerSection);
+
+    // Once messages overflowed, keep using the list until the consumer caught
+    // up, so that messages stay in order
+    if (!m_hasOverflow && PushRing(pMsg))
+    {
+      AddPacketSize(*pMsg, true);
+
+      // inform waiter for new packet, if it didn't see it
+      if (m_waiting.exchange(false))
+        m_hEvent.Set();
+
+      return MSGQ_OK;
+    }
+
+    std::unique_lock lock(m_section);
+
+    m_overflow.emplace_front(pMsg, priority);
+    m_hasOverflow = true;
+    AddPacketSize(*pMsg, true);
+
+    m_hEvent.Set();
+
+    return MSGQ_OK;
+  }
+
+  std::unique_lock lock(m_section);
+
   if (priority > 0)
   {
     int prio = priority;
@@ -126,31 +175,11 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
   }
   else
   {
-    if (m_messages.empty())
-    {
-      m_iDataSize = 0;
-      m_TimeBack = DVD_NOPTS_VALUE;
-      m_TimeFront = DVD_NOPTS_VALUE;
-    }
-
-    if (front)
-      m_messages.emplace_front(pMsg, priority);
-    else
-      m_messages.emplace_back(pMsg, priority);
+    m_messages.emplace_back(pMsg, priority);
+    AddPacketSize(*pMsg, false);
   }
 
-  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
-  {
-    DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg.get())->GetPacket();
-    if (packet)
-    {
-      m_iDataSize += packet->iSize;
-      if (front)
-        UpdateTimeFront();
-      else
-        UpdateTimeBack();
-    }
-  }
+  m_lockedCount++;
 
   // inform waiter for new packet
   m_hEvent.Set();
@@ -162,9 +191,7 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
                                          std::chrono::milliseconds timeout,
                                          int& priority)
 {
-  std::unique_lock lock(m_section);
-
-  int ret = 0;
+  std::unique_lock consumerLock(m_consumerSection);
 
   if (!m_bInitialized)
   {
@@ -174,101 +201,192 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
 
   while (!m_bAbortRequest)
   {
-    std::list<DVDMessageListItem> &msgs = (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
+    if (TryGet(pMsg, priority))
+      break;
 
-    if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
-    {
-      DVDMessageListItem& item(msgs.back());
-      priority = item.priority;
+    if (timeout == 0ms)
+      return MSGQ_TIMEOUT;
 
-      if (item.message->IsType(CDVDMsg::DEMUXER_PACKET) && item.priority == 0)
-      {
-        DemuxPacket* packet =
-            std::static_pointer_cast<CDVDMsgDemuxerPacket>(item.message)->GetPacket();
-        if (packet)
-        {
-          m_iDataSize -= packet->iSize;
-        }
-      }
+    // Ask producers to wake us, then check again for messages put before they
+    // could see the request
+    m_hEvent.Reset();
+    m_waiting = true;
 
-      pMsg = std::move(item.message);
-      msgs.pop_back();
-      UpdateTimeBack();
-      ret = MSGQ_OK;
+    if (TryGet(pMsg, priority))
+    {
+      m_waiting = false;
       break;
     }
-    else if (timeout == 0ms)
+
+    // An abort set before the reset above would be lost, check for it again
+    if (m_bAbortRequest)
     {
-      ret = MSGQ_TIMEOUT;
+      m_waiting = false;
       break;
     }
-    else
-    {
-      m_hEvent.Reset();
-      lock.unlock();
 
-      // wait for a new message
-      if (!m_hEvent.Wait(timeout))
-        return MSGQ_TIMEOUT;
+    consumerLock.unlock();
 
-      lock.lock();
-    }
+    // wait for a new message
+    const bool signaled = m_hEvent.Wait(timeout);
+    m_waiting = false;
+    if (!signaled)
+      return MSGQ_TIMEOUT;
+
+    consumerLock.lock();
   }
 
   if (m_bAbortRequest)
     return MSGQ_ABORT;
 
-  return (MsgQueueReturnCode)ret;
+  return MSGQ_OK;
 }
 
-void CDVDMessageQueue::UpdateTimeFront()
+bool CDVDMessageQueue::TryGet(std::shared_ptr<CDVDMsg>& pMsg, int& priority)
 {
-  if (!m_messages.empty())
+  if (priority > 0 || m_lockedCount > 0)
   {
-    auto &item = m_messages.front();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    std::unique_lock lock(m_section);
+
+    std::list<DVDMessageListItem>& msgs =
+        (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
+
+    if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
     {
-      DemuxPacket* packet =
-          std::static_pointer_cast<CDVDMsgDemuxerPacket>(item.message)->GetPacket();
-      if (packet)
-      {
-        if (packet->dts != DVD_NOPTS_VALUE)
-          m_TimeFront = packet->dts;
-        else if (packet->pts != DVD_NOPTS_VALUE)
-          m_TimeFront = packet->pts;
+      DVDMessageListItem& item(msgs.back());
+      priority = item.priority;
 
-        if (m_TimeBack == DVD_NOPTS_VALUE)
-          m_TimeBack = m_TimeFront;
-      }
+      if (item.priority == 0)
+        RemovePacketSize(*item.message);
+
+      pMsg = std::move(item.message);
+      msgs.pop_back();
+      m_lockedCount--;
+      return true;
     }
+
+    if (priority > 0 || !m_prioMessages.empty())
+      return false;
   }
-}
 
-void CDVDMessageQueue::UpdateTimeBack()
-{
-  if (!m_messages.empty())
+  if (PopRing(pMsg))
   {
-    auto &item = m_messages.back();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    priority = 0;
+    RemovePacketSize(*pMsg);
+    return true;
+  }
+
+  if (m_hasOverflow)
+  {
+    std::unique_lock lock(m_section);
+
+    // The producer doesn't add to the ring while there is an overflow, but it
+    // may have filled it before overflowing, after the ring was checked
+    if (!PopRing(pMsg))
     {
-      DemuxPacket* packet =
-          std::static_pointer_cast<CDVDMsgDemuxerPacket>(item.message)->GetPacket();
-      if (packet)
+      if (m_overflow.empty())
       {
-        if (packet->dts != DVD_NOPTS_VALUE)
-          m_TimeBack = packet->dts;
-        else if (packet->pts != DVD_NOPTS_VALUE)
-          m_TimeBack = packet->pts;
-
-        if (m_TimeFront == DVD_NOPTS_VALUE)
-          m_TimeFront = m_TimeBack;
+        m_hasOverflow = false;
+        return false;
       }
+
+      pMsg = std::move(m_overflow.back().message);
+      m_overflow.pop_back();
     }
+
+    m_hasOverflow = !m_overflow.empty();
+
+    priority = 0;
+    RemovePacketSize(*pMsg);
+    return true;
   }
+
+  return false;
+}
+
+bool CDVDMessageQueue::PushRing(const std::shared_ptr<CDVDMsg>& pMsg)
+{
+  const size_t tail = m_ringTail.load(std::memory_order_relaxed);
+  if (tail - m_ringHead.load(std::memory_order_acquire) == RING_SIZE)
+    return false;
+
+  m_ring[tail % RING_SIZE] = pMsg;
+
+  // Sequentially consistent, so that either the consumer sees the message
+  // before waiting, or the producer sees that the consumer is waiting
+  m_ringTail.store(tail + 1);
+  return true;
+}
+
+bool CDVDMessageQueue::PopRing(std::shared_ptr<CDVDMsg>& pMsg)
+{
+  const size_t head = m_ringHead.load(std::memory_order_relaxed);
+  if (head == m_ringTail.load())
+    return false;
+
+  pMsg = std::move(m_ring[head % RING_SIZE]);
+  m_ringHead.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+size_t CDVDMessageQueue::GetRingCount() const
+{
+  return m_ringTail.load(std::memory_order_acquire) - m_ringHead.load(std::memory_order_relaxed);
+}
+
+void CDVDMessageQueue::AddPacketSize(CDVDMsg& msg, bool front)
+{
+  if (!msg.IsType(CDVDMsg::DEMUXER_PACKET))
+    return;
+
+  const DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket&>(msg).m_packet;
+  if (!packet)
+    return;
+
+  m_iDataSize += packet->iSize;
+
+  double time = DVD_NOPTS_VALUE;
+  if (packet->dts != DVD_NOPTS_VALUE)
+    time = packet->dts;
+  else if (packet->pts != DVD_NOPTS_VALUE)
+    time = packet->pts;
+
+  if (time == DVD_NOPTS_VALUE)
+    return;
+
+  // The packet is the newest one if put at the front, the next one to be
+  // consumed otherwise
+  std::atomic<double>& updated = front ? m_TimeFront : m_TimeBack;
+  std::atomic<double>& other = front ? m_TimeBack : m_TimeFront;
+
+  updated = time;
+
+  double expected = DVD_NOPTS_VALUE;
+  other.compare_exchange_strong(expected, time);
+}
+
+void CDVDMessageQueue::RemovePacketSize(CDVDMsg& msg)
+{
+  if (!msg.IsType(CDVDMsg::DEMUXER_PACKET))
+    return;
+
+  const DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket&>(msg).m_packet;
+  if (!packet)
+    return;
+
+  m_iDataSize -= packet->iSize;
+
+  // Track the time of the packet being consumed, the one behind it can't be
+  // peeked at without locking out the producer
+  if (packet->dts != DVD_NOPTS_VALUE)
+    m_TimeBack = packet->dts;
+  else if (packet->pts != DVD_NOPTS_VALUE)
+    m_TimeBack = packet->pts;
 }
 
 unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
 {
+  std::unique_lock consumerLock(m_consumerSection);
   std::unique_lock lock(m_section);
 
   if (!m_bInitialized)
@@ -285,6 +403,20 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
     if(item.message->IsType(type))
       count++;
   }
+  for (const auto& item : m_overflow)
+  {
+    if (item.message->IsType(type))
+      count++;
+  }
+
+  // Messages between head and tail aren't touched by the producer
+  const size_t head = m_ringHead.load(std::memory_order_relaxed);
+  const size_t ringCount = GetRingCount();
+  for (size_t i = 0; i < ringCount; i++)
+  {
+    if (m_ring[(head + i) % RING_SIZE]->IsType(type))
+      count++;
+  }
 
   return count;
 }
@@ -309,22 +441,22 @@ void CDVDMessageQueue::WaitUntilEmpty()
 
 int CDVDMessageQueue::GetLevel(bool dataLevel) const
 {
-  std::unique_lock lock(m_section);
+  const int dataSize = m_iDataSize;
 
-  if (m_iDataSize > m_iMaxDataSize)
+  if (dataSize > m_iMaxDataSize)
     return 100;
-  if (m_iDataSize == 0)
+  if (dataSize == 0)
     return 0;
 
   if (IsDataBased() || dataLevel)
   {
-    return std::min(100, 100 * m_iDataSize / m_iMaxDataSize);
+    return std::min(100, 100 * dataSize / m_iMaxDataSize);
   }
 
   int level = std::min(100.0, ceil(100.0 * m_TimeSize * (m_TimeFront - m_TimeBack) / DVD_TIME_BASE ));
 
   // if we added lots of packets with NOPTS, make sure that the queue is not signalled empty
-  if (level == 0 && m_iDataSize != 0)
+  if (level == 0 && dataSize != 0)
   {
     CLog::Log(LOGDEBUG, "CDVDMessageQueue::GetLevel() - can't determine level");
     return 1;
@@ -335,8 +467,6 @@ int CDVDMessageQueue::GetLevel(bool dataLevel) const
 
 double CDVDMessageQueue::GetTimeSize() const
 {
-  std::unique_lock lock(m_section);
-
   if (IsDataBased())
     return 0.0;
   else
@@ -345,9 +475,10 @@ double CDVDMessageQueue::GetTimeSize() const
 
 bool CDVDMessageQueue::IsDataBased() const
 {
-  std::unique_lock lock(m_section);
+  const double timeBack = m_TimeBack;
+  const double timeFront = m_TimeFront;
 
-  return (m_TimeBack == DVD_NOPTS_VALUE  ||
-          m_TimeFront == DVD_NOPTS_VALUE ||
-          m_TimeFront <= m_TimeBack);
+  return (timeBack == DVD_NOPTS_VALUE  ||
+          timeFront == DVD_NOPTS_VALUE ||
+          timeFront <= timeBack);
 }
@@ -13,6 +13,7 @@
 #include "threads/Event.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <list>
 #include <string>
@@ -45,6 +46,20 @@ enum MsgQueueReturnCode
 
 #define MSGQ_IS_ERROR(c)    (c < 0)
 
+/*!
+ * \brief Message queue between the player and a stream player thread
+ *
+ * Messages with normal priority put at the front of the queue, which carry
+ * the demuxer packets, travel through a bounded lock-free ring from the
+ * producer to the consumer. Producers and the consumer each serialize on
+ * their own lock, so in the common case of one thread putting and one thread
+ * getting, neither waits on the other, and the consumer is only woken when it
+ * is waiting for a message.
+ *
+ * Priority messages, messages put back and messages that don't fit in the
+ * ring go through lists protected by a lock shared by both sides. Operations
+ * on the whole queue, like Flush(), take all locks.
+ */
 class CDVDMessageQueue
 {
 public:
@@ -97,27 +112,53 @@ public:
   bool IsInited() const { return m_bInitialized; }
   bool IsDataBased() const;
 
+  /*!
+   * \brief Number of messages the lock-free ring can hold
+   */
+  static constexpr size_t RING_SIZE = 4096;
+
 private:
   MsgQueueReturnCode Put(const std::shared_ptr<CDVDMsg>& pMsg, int priority, bool front);
-  void UpdateTimeFront();
-  void UpdateTimeBack();
+
+  // Require m_producerSection to be held
+  bool PushRing(const std::shared_ptr<CDVDMsg>& pMsg);
+
+  // Require m_consumerSection to be held
+  bool TryGet(std::shared_ptr<CDVDMsg>& pMsg, int& priority);
+  bool PopRing(std::shared_ptr<CDVDMsg>& pMsg);
+  size_t GetRingCount() const;
+
+  void AddPacketSize(CDVDMsg& msg, bool front);
+  void RemovePacketSize(CDVDMsg& msg);
 
   CEvent m_hEvent;
-  mutable CCriticalSection m_section;
+  mutable CCriticalSection m_section; //!< Protects the lists
+  CCriticalSection m_producerSection; //!< Serializes writers of the ring
+  mutable CCriticalSection m_consumerSection; //!< Serializes readers of the ring
 
   std::atomic<bool> m_bAbortRequest = false;
-  bool m_bInitialized;
+  std::atomic<bool> m_bInitialized;
   bool m_drain = false;
 
-  int m_iDataSize;
-  double m_TimeFront;
-  double m_TimeBack;
-  double m_TimeSize;
+  std::atomic<int> m_iDataSize;
+  std::atomic<double> m_TimeFront; //!< Time of the newest packet put
+  std::atomic<double> m_TimeBack; //!< Time of the packet being consumed
+  std::atomic<double> m_TimeSize;
 
   int m_iMaxDataSize;
   std::string m_owner;
 
-  std::list<DVDMessageListItem> m_messages;
+  // Consumed in this order
   std::list<DVDMessageListItem> m_prioMessages;
+  std::list<DVDMessageListItem> m_messages; //!< Messages put back, consumed before the ring
+  std::array<std::shared_ptr<CDVDMsg>, RING_SIZE> m_ring;
+  std::list<DVDMessageListItem> m_overflow; //!< Messages put while the ring was full
+
+  std::atomic<size_t> m_lockedCount{0}; //!< Number of messages in m_prioMessages and m_messages
+  std::atomic<bool> m_hasOverflow{false};
+
+  alignas(64) std::atomic<size_t> m_ringHead{0}; //!< Next slot to read, written by the consumer
+  alignas(64) std::atomic<size_t> m_ringTail{0}; //!< Next slot to write, written by the producer
+  std::atomic<bool> m_waiting{false}; //!< Whether the consumer needs to be woken by the producer
 };
 
@@ -10,39 +10,43 @@
 
 #include "../DVDCodecs/Overlay/DVDOverlay.h"
 
-typedef struct stListElement
-{
-  std::shared_ptr<CDVDOverlay> pOverlay;
-  struct stListElement* pNext;
-
-} ListElement;
+#include <memory>
+#include <stddef.h>
+#include <vector>
 
+/*!
+ * \brief The subtitle lines of a file, in the order they are added
+ *
+ * Lookups walk a cursor forward to the next line that hasn't stopped yet.
+ */
 class CDVDSubtitleLineCollection
 {
 public:
-  CDVDSubtitleLineCollection();
-  virtual ~CDVDSubtitleLineCollection();
-
-  //void Lock()   { EnterCriticalSection(&m_critSection); }
-  //void Unlock() { LeaveCriticalSection(&m_critSection); }
+  CDVDSubtitleLineCollection() = default;
+  virtual ~CDVDSubtitleLineCollection() = default;
 
   void Add(std::shared_ptr<CDVDOverlay> pSubtitle);
+
+  /*!
+   * \brief Sort the lines by start time, lines that start together keep their order
+   */
   void Sort();
 
-  std::shared_ptr<CDVDOverlay> Get(double iPts = 0LL); // get the first overlay in this fifo
+  /*!
+   * \brief Get the next line after the cursor that stops at or after a time,
+   *        and advance the cursor past it
+   */
+  std::shared_ptr<CDVDOverlay> Get(double iPts = 0LL);
 
+  /*!
+   * \brief Rewind the cursor to the first line
+   */
   void Reset();
 
-  void Remove();
   void Clear();
-  int GetSize() { return m_iSize; }
+  int GetSize() { return static_cast<int>(m_lines.size()); }
 
 private:
-  ListElement* m_pHead;
-  ListElement* m_pCurrent;
-  ListElement* m_pTail;
-
-  int m_iSize;
-  //CRITICAL_SECTION m_critSection;
+  std::vector<std::shared_ptr<CDVDOverlay>> m_lines;
+  size_t m_current{0};
 };
-
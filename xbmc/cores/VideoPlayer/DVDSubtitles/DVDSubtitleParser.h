@@ -11,7 +11,9 @@
 #include "../DVDCodecs/Overlay/DVDOverlay.h"
 #include "DVDSubtitleLineCollection.h"
 #include "DVDSubtitleStream.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
 
+#include <algorithm>
 #include <memory>
 #include <stdio.h>
 #include <string>
@@ -66,10 +68,52 @@ public:
    */
   const std::string& GetName() const override { return m_parserName; }
 
+  std::shared_ptr<CDVDOverlay> Parse(double iPts) override
+  {
+    ParseUntil(iPts + PARSE_LOOKAHEAD);
+    return CDVDSubtitleParserCollection::Parse(iPts);
+  }
+
+  //! The time span parsed ahead of playback, in DVD_TIME_BASE units
+  static constexpr double PARSE_LOOKAHEAD = 60 * DVD_TIME_BASE;
+
+  //! The subtitles parsed ahead on each call, until the whole stream is parsed
+  static constexpr int PARSE_STEP = 200;
+
 protected:
+  /*!
+   * \brief Parse the next subtitle of the stream, for parsers that parse it
+   *        in parts while playing
+   *
+   * \param[out] startTime The start time of the subtitle parsed, if any
+   * \return False at the end of the stream
+   */
+  virtual bool ParseNext(double& startTime) { return false; }
+
+  /*!
+   * \brief Parse the stream up to a time, and PARSE_STEP subtitles more
+   *
+   * Playback can start after the first part of a large file is parsed, the
+   * rest is parsed in steps on the following calls to Parse(). Subtitles are
+   * expected in time order, any out of order show up once they are parsed.
+   */
+  void ParseUntil(double pts)
+  {
+    for (int parsed = 0; !m_parsed && (m_parsedTime <= pts || parsed < PARSE_STEP); parsed++)
+    {
+      double startTime = m_parsedTime;
+      if (!ParseNext(startTime))
+        m_parsed = true;
+      m_parsedTime = std::max(m_parsedTime, startTime);
+    }
+  }
+
   using CDVDSubtitleParserCollection::Open;
   bool Open()
   {
+    m_parsed = false;
+    m_parsedTime = 0.0;
+
     if(m_pStream)
     {
       if (m_pStream->Seek(0))
@@ -83,4 +127,8 @@ protected:
 
   std::unique_ptr<CDVDSubtitleStream> m_pStream;
   std::string m_parserName;
+
+private:
+  bool m_parsed{false}; //!< Whether the end of the stream was reached
+  double m_parsedTime{0.0}; //!< The latest start time parsed
 };
@@ -9,9 +9,7 @@
 #include "DVDSubtitleParserMPL2.h"
 
 #include "DVDStreamInfo.h"
-#include "DVDSubtitleTagMicroDVD.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
-#include "utils/RegExp.h"
 
 #include <cstdlib>
 
@@ -33,30 +31,39 @@ bool CDVDSubtitleParserMPL2::Open(CDVDStreamInfo& hints)
   // MPL2 is time-based, with 0.1s accuracy
   m_framerate = DVD_TIME_BASE / 10.0;
 
-  CRegExp reg;
-  if (!reg.RegComp("\\[([0-9]+)\\]\\[([0-9]+)\\](.+)"))
+  if (!m_reg.RegComp("\\[([0-9]+)\\]\\[([0-9]+)\\](.+)"))
     return false;
-  CDVDSubtitleTagMicroDVD TagConv;
+
+  // The events are added to the track of the overlay while playing
+  m_collection.Add(CreateOverlay());
+  ParseUntil(0.0);
+
+  return true;
+}
+
+bool CDVDSubtitleParserMPL2::ParseNext(double& startTime)
+{
   std::string line;
 
   while (m_pStream->ReadLine(line))
   {
-    int pos = reg.RegFind(line);
+    int pos = m_reg.RegFind(line);
     if (pos > -1)
     {
-      std::string startFrame(reg.GetMatch(1));
-      std::string endFrame(reg.GetMatch(2));
-      std::string text(reg.GetMatch(3));
+      std::string startFrame(m_reg.GetMatch(1));
+      std::string endFrame(m_reg.GetMatch(2));
+      std::string text(m_reg.GetMatch(3));
 
       double iPTSStartTime = m_framerate * std::atoi(startFrame.c_str());
       double iPTSStopTime = m_framerate * std::atoi(endFrame.c_str());
 
-      TagConv.ConvertLine(text);
+      m_tagConv.ConvertLine(text);
       AddSubtitle(text, iPTSStartTime, iPTSStopTime);
+
+      startTime = iPTSStartTime;
+      return true;
     }
   }
 
-  m_collection.Add(CreateOverlay());
-
-  return true;
+  return false;
 }
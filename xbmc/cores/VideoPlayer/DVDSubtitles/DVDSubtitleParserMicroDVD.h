@@ -9,7 +9,9 @@
 #pragma once
 
 #include "DVDSubtitleParser.h"
+#include "DVDSubtitleTagMicroDVD.h"
 #include "SubtitlesAdapter.h"
+#include "utils/RegExp.h"
 
 #include <memory>
 
@@ -22,6 +24,11 @@ public:
 
   bool Open(CDVDStreamInfo& hints) override;
 
+protected:
+  bool ParseNext(double& startTime) override;
+
 private:
   double m_framerate;
+  CRegExp m_reg;
+  CDVDSubtitleTagMicroDVD m_tagConv;
 };
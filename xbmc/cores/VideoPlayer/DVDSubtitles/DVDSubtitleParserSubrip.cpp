@@ -8,7 +8,6 @@
 
 #include "DVDSubtitleParserSubrip.h"
 
-#include "DVDSubtitleTagSami.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "utils/StringUtils.h"
 
@@ -26,10 +25,18 @@ bool CDVDSubtitleParserSubrip::Open(CDVDStreamInfo& hints)
   if (!Initialize())
     return false;
 
-  CDVDSubtitleTagSami TagConv;
-  if (!TagConv.Init())
+  if (!m_tagConv.Init())
     return false;
 
+  // The events are added to the track of the overlay while playing
+  m_collection.Add(CreateOverlay());
+  ParseUntil(0.0);
+
+  return true;
+}
+
+bool CDVDSubtitleParserSubrip::ParseNext(double& startTime)
+{
   std::string line;
 
   while (m_pStream->ReadLine(line))
@@ -65,20 +72,21 @@ bool CDVDSubtitleParserSubrip::Open(CDVDStreamInfo& hints)
 
           if (!convText.empty())
             convText += "\n";
-          TagConv.ConvertLine(line);
+          m_tagConv.ConvertLine(line);
           convText += line;
         }
 
         if (!convText.empty())
         {
-          TagConv.CloseTag(convText);
+          m_tagConv.CloseTag(convText);
           AddSubtitle(convText, iPTSStartTime, iPTSStopTime);
         }
+
+        startTime = iPTSStartTime;
+        return true;
       }
     }
   }
 
-  m_collection.Add(CreateOverlay());
-
-  return true;
+  return false;
 }
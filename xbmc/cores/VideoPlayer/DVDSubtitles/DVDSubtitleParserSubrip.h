@@ -9,6 +9,7 @@
 #pragma once
 
 #include "DVDSubtitleParser.h"
+#include "DVDSubtitleTagSami.h"
 #include "SubtitlesAdapter.h"
 
 #include <memory>
@@ -21,4 +22,10 @@ public:
   ~CDVDSubtitleParserSubrip() = default;
 
   bool Open(CDVDStreamInfo& hints) override;
+
+protected:
+  bool ParseNext(double& startTime) override;
+
+private:
+  CDVDSubtitleTagSami m_tagConv;
 };
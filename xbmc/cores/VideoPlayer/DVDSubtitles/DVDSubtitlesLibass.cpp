@@ -238,6 +238,7 @@ bool CDVDSubtitlesLibass::DecodeHeader(char* data, int size)
   m_track = ass_new_track(m_library);
 
   ass_process_codec_private(m_track, data, size);
+  m_revision++;
   return true;
 }
 
@@ -253,6 +254,7 @@ bool CDVDSubtitlesLibass::DecodeDemuxPkt(const char* data, int size, double star
   //! @bug libass isn't const correct
   ass_process_chunk(m_track, const_cast<char*>(data), size, DVD_TIME_TO_MSEC(start),
                     DVD_TIME_TO_MSEC(duration));
+  m_revision++;
   return true;
 }
 
@@ -284,6 +286,7 @@ bool CDVDSubtitlesLibass::CreateTrack()
   if (ass_track_set_feature(m_track, ASS_FEATURE_BIDI_BRACKETS, 1) != 0)
     CLog::LogF(LOGWARNING, "ASS track ASS_FEATURE_BIDI_BRACKETS feature cannot be set");
 
+  m_revision++;
   return true;
 }
 
@@ -321,6 +324,7 @@ bool CDVDSubtitlesLibass::CreateTrack(char* buf, size_t size)
   if (m_track == NULL)
     return false;
 
+  m_revision++;
   return true;
 }
 
@@ -407,6 +411,16 @@ ASS_Image* CDVDSubtitlesLibass::RenderImage(double pts,
   return ass_render_frame(m_renderer, m_track, DVD_TIME_TO_MSEC(pts), changes);
 }
 
+void CDVDSubtitlesLibass::RenderImage(double pts,
+                                      const renderOpts& opts,
+                                      bool updateStyle,
+                                      const std::shared_ptr<struct style>& subStyle,
+                                      const std::function<void(ASS_Image* images)>& process)
+{
+  std::unique_lock lock(m_section);
+  process(RenderImage(pts, opts, updateStyle, subStyle));
+}
+
 void CDVDSubtitlesLibass::ApplyStyle(const std::shared_ptr<struct style>& subStyle,
                                      const renderOpts& opts)
 {
@@ -734,6 +748,7 @@ int CDVDSubtitlesLibass::AddEvent(const char* text,
       event->MarginR = opts->marginRight;
       event->MarginV = opts->marginVertical;
     }
+    m_revision++;
     return eventId;
   }
   else
@@ -770,6 +785,7 @@ void CDVDSubtitlesLibass::AppendTextToEvent(int eventId, const char* text)
     free(assEvent->Text);
     assEvent->Text = strdup(appendedText);
     delete[] appendedText;
+    m_revision++;
   }
 }
 
@@ -794,7 +810,10 @@ void CDVDSubtitlesLibass::ChangeEventStopTime(int eventId, double stopTime)
 
   ASS_Event* assEvent = (assEvents + eventId);
   if (assEvent)
+  {
     assEvent->Duration = (DVD_TIME_TO_MSEC(stopTime) - assEvent->Start);
+    m_revision++;
+  }
 }
 
 void CDVDSubtitlesLibass::FlushEvents()
@@ -807,6 +826,7 @@ void CDVDSubtitlesLibass::FlushEvents()
   }
 
   ass_flush_events(m_track);
+  m_revision++;
 }
 
 int CDVDSubtitlesLibass::DeleteEvents(int nEvents, int threshold)
@@ -835,5 +855,6 @@ int CDVDSubtitlesLibass::DeleteEvents(int nEvents, int threshold)
   {
     m_track->events[i] = m_track->events[i + n];
   }
+  m_revision++;
   return m_track->n_events - 1;
 }
@@ -12,6 +12,8 @@
 #include "threads/CriticalSection.h"
 #include "utils/ColorUtils.h"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 #include <ass/ass.h>
@@ -45,6 +47,26 @@ public:
                          const std::shared_ptr<struct KODI::SUBTITLES::STYLE::style>& subStyle,
                          int* changes = NULL);
 
+  /*!
+  * \brief Render the subtitles at a time and process the images while they
+  * are valid. The images of RenderImage() are owned by libass and only valid
+  * until the next render, which may happen on another thread
+  * \param process Called with the images, nullptr if none, while the
+  * renderer is locked
+  */
+  void RenderImage(double pts,
+                   const KODI::SUBTITLES::STYLE::renderOpts& opts,
+                   bool updateStyle,
+                   const std::shared_ptr<struct KODI::SUBTITLES::STYLE::style>& subStyle,
+                   const std::function<void(ASS_Image* images)>& process);
+
+  /*!
+  * \brief Get the revision of the ASS track, which changes whenever events
+  * are added, changed or removed. Can be called without blocking a render
+  * \return The revision of the ASS track
+  */
+  unsigned int GetRevision() const { return m_revision; }
+
   ASS_Event* GetEvents();
 
   /*!
@@ -166,4 +188,6 @@ private:
   // default allocated style ID for the kodi user configured subtitle style
   int m_defaultKodiStyleId{ASS_NO_ID};
   std::string m_defaultFontFamilyName;
+
+  std::atomic<unsigned int> m_revision{0};
 };
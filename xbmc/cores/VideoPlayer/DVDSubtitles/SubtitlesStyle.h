@@ -128,6 +128,8 @@ struct renderOpts
   // only for bottom alignment, 0 = bottom (no change), 100 = on top
   double position = 0;
   HorizontalAlign horizontalAlignment = HorizontalAlign::DISABLED;
+
+  bool operator==(const renderOpts& other) const = default;
 };
 
 } // namespace STYLE
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleLineCollection.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::shared_ptr<CDVDOverlay> Line(double start, double stop)
+{
+  auto overlay = std::make_shared<CDVDOverlay>(DVDOVERLAY_TYPE_TEXT);
+  overlay->iPTSStartTime = start;
+  overlay->iPTSStopTime = stop;
+  return overlay;
+}
+
+// One line after the other, as in SubRip files
+std::vector<std::shared_ptr<CDVDOverlay>> SubRipLines(int count)
+{
+  std::vector<std::shared_ptr<CDVDOverlay>> lines;
+  for (int i = 0; i < count; i++)
+    lines.emplace_back(Line(DVD_SEC_TO_TIME(i * 3), DVD_SEC_TO_TIME(i * 3 + 2)));
+  return lines;
+}
+} // namespace
+
+TEST(TestDVDSubtitleLineCollection, Empty)
+{
+  CDVDSubtitleLineCollection collection;
+  EXPECT_EQ(collection.Get(0.0), nullptr);
+  EXPECT_EQ(collection.GetSize(), 0);
+}
+
+TEST(TestDVDSubtitleLineCollection, Walk)
+{
+  CDVDSubtitleLineCollection collection;
+  for (const auto& line : SubRipLines(10))
+    collection.Add(line);
+
+  // Lines that stopped are skipped, the next one is returned once
+  EXPECT_EQ(collection.Get(DVD_SEC_TO_TIME(7))->iPTSStartTime, DVD_SEC_TO_TIME(6));
+  EXPECT_EQ(collection.Get(DVD_SEC_TO_TIME(7))->iPTSStartTime, DVD_SEC_TO_TIME(9));
+  EXPECT_EQ(collection.Get(0.0)->iPTSStartTime, DVD_SEC_TO_TIME(12));
+  EXPECT_EQ(collection.Get(DVD_SEC_TO_TIME(100)), nullptr);
+
+  collection.Reset();
+  EXPECT_EQ(collection.Get(0.0)->iPTSStartTime, 0.0);
+
+  // Lines added later are found
+  collection.Add(Line(DVD_SEC_TO_TIME(100), DVD_NOPTS_VALUE));
+  EXPECT_EQ(collection.Get(DVD_SEC_TO_TIME(100))->iPTSStartTime, DVD_SEC_TO_TIME(100));
+
+  collection.Clear();
+  EXPECT_EQ(collection.Get(0.0), nullptr);
+}
+
+TEST(TestDVDSubtitleLineCollection, Sort)
+{
+  CDVDSubtitleLineCollection collection;
+  collection.Add(Line(DVD_SEC_TO_TIME(2), DVD_SEC_TO_TIME(3)));
+  collection.Add(Line(0.0, DVD_SEC_TO_TIME(1)));
+  collection.Add(Line(DVD_SEC_TO_TIME(2), DVD_SEC_TO_TIME(4)));
+  collection.Sort();
+
+  EXPECT_EQ(collection.Get(0.0)->iPTSStopTime, DVD_SEC_TO_TIME(1));
+  EXPECT_EQ(collection.Get(0.0)->iPTSStopTime, DVD_SEC_TO_TIME(3));
+  EXPECT_EQ(collection.Get(0.0)->iPTSStopTime, DVD_SEC_TO_TIME(4));
+}
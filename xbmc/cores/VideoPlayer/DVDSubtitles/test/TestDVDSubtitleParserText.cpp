@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleParser.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// A stream of one subtitle per second, parsed while playing
+class CTestParser : public CDVDSubtitleParserText
+{
+public:
+  explicit CTestParser(int count)
+    : CDVDSubtitleParserText(nullptr, "test.srt", "Test Subtitle Parser"), m_count(count)
+  {
+  }
+
+  bool Open(CDVDStreamInfo& hints) override { return true; }
+
+  // Parses the first part, as the parsers do in Open()
+  void Start() { ParseUntil(0.0); }
+
+  int m_parsed{0};
+
+protected:
+  bool ParseNext(double& startTime) override
+  {
+    if (m_parsed == m_count)
+      return false;
+
+    startTime = DVD_SEC_TO_TIME(m_parsed);
+    auto overlay = std::make_shared<CDVDOverlay>(DVDOVERLAY_TYPE_TEXT);
+    overlay->iPTSStartTime = startTime;
+    overlay->iPTSStopTime = startTime + DVD_TIME_BASE / 2;
+    m_collection.Add(overlay);
+    m_parsed++;
+    return true;
+  }
+
+private:
+  const int m_count;
+};
+} // namespace
+
+TEST(TestDVDSubtitleParserText, ParsesWhilePlaying)
+{
+  constexpr int STEP = CDVDSubtitleParserText::PARSE_STEP;
+  const int lookahead = static_cast<int>(CDVDSubtitleParserText::PARSE_LOOKAHEAD / DVD_TIME_BASE);
+
+  CTestParser parser(10 * STEP);
+  parser.Start();
+  EXPECT_EQ(parser.m_parsed, STEP);
+
+  // Each lookup parses a step further
+  ASSERT_NE(parser.Parse(0.0), nullptr);
+  EXPECT_EQ(parser.m_parsed, 2 * STEP);
+
+  // A seek beyond the parsed part parses up to the lookahead of it
+  const int seek = 4 * STEP;
+  const auto overlay = parser.Parse(DVD_SEC_TO_TIME(seek));
+  ASSERT_NE(overlay, nullptr);
+  EXPECT_EQ(overlay->iPTSStartTime, DVD_SEC_TO_TIME(seek));
+  EXPECT_EQ(parser.m_parsed, seek + lookahead + 2);
+
+  while (parser.m_parsed < 10 * STEP)
+    parser.Parse(DVD_SEC_TO_TIME(seek));
+
+  // The lines parsed last are found after a seek back
+  parser.Reset();
+  const auto last = parser.Parse(DVD_SEC_TO_TIME(10 * STEP - 1));
+  ASSERT_NE(last, nullptr);
+  EXPECT_EQ(last->iPTSStartTime, DVD_SEC_TO_TIME(10 * STEP - 1));
+}
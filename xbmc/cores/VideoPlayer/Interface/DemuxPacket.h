@@ -43,6 +43,9 @@ extern "C"
 
     //! @brief PTS offset correction applied to the PTS and DTS.
     double m_ptsOffsetCorrection{0};
+
+    //! @brief Size class of the packet in the packet pool, or -1 if it isn't pooled.
+    int m_poolClass{-1};
   };
 
 #ifdef __cplusplus
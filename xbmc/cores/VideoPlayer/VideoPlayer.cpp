@@ -15,6 +15,7 @@
 #include "DVDDemuxers/DVDDemuxUtils.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDDemuxers/DemuxReadAhead.h"
 #include "DVDInputStreams/DVDFactoryInputStream.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "network/NetworkFileItemClassify.h"
@@ -31,6 +32,7 @@
 #include "Util.h"
 #include "VideoPlayerAudio.h"
 #include "VideoPlayerRadioRDS.h"
+#include "VideoPlayerTrace.h"
 #include "VideoPlayerVideo.h"
 #include "application/Application.h"
 #include "cores/DataCacheCore.h"
@@ -1020,6 +1022,11 @@ bool CVideoPlayer::OpenDemuxStream()
   else
     m_pInputStream->SaveCurrentState({});
 
+  const int readAhead = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(
+      CSettings::SETTING_VIDEOPLAYER_DEMUXREADAHEAD);
+  if (readAhead > 0 && m_pDemuxer->EnableReadAhead(DVD_SEC_TO_TIME(readAhead)))
+    CLog::Log(LOGINFO, "{} - Reading up to {}s ahead in the demuxer", __FUNCTION__, readAhead);
+
   return true;
 }
 
@@ -1214,6 +1221,7 @@ void CVideoPlayer::OpenDefaultStreams(bool reset)
 
 bool CVideoPlayer::ReadPacket(DemuxPacket*& packet, CDemuxStream*& stream)
 {
+  CVideoPlayerTraceScope trace(TraceCategory::DEMUX, "ReadPacket");
 
   // check if we should read from subtitle demuxer
   if (m_pSubtitleDemuxer && m_VideoPlayerSubtitle->AcceptsData())
@@ -1403,6 +1411,8 @@ void CVideoPlayer::CheckBetterStream(CCurrentStream& current, CDemuxStream* stre
 
 void CVideoPlayer::Prepare()
 {
+  m_prepareTime = std::chrono::steady_clock::now();
+
   CFFmpegLog::SetLogLevel(1);
   SetPlaySpeed(DVD_PLAYSPEED_NORMAL);
   m_processInfo->SetSpeed(1.0);
@@ -1458,6 +1468,9 @@ void CVideoPlayer::Prepare()
     m_error = true;
     return;
   }
+  m_demuxerOpenTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - m_prepareTime);
+
   // give players a chance to reconsider now codecs are known
   CreatePlayers();
 
@@ -2317,6 +2330,11 @@ void CVideoPlayer::HandlePlaySpeed()
 
       if (!m_State.streamsReady)
       {
+        const auto timeToFirstFrame = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_prepareTime);
+        CLog::Log(LOGINFO, "VideoPlayer: time to first frame {} ms, demuxer opened after {} ms",
+                  timeToFirstFrame.count(), m_demuxerOpenTime.count());
+
         // Activate the fullscreen-video skin now that streams are ready, so
         // video frames will fully paint the swap chain from the first frame
         // the skin is visible.
@@ -2944,6 +2962,9 @@ void CVideoPlayer::OnExit()
 
   m_messenger.End();
 
+  // don't hold recycled packets while idle
+  CDVDDemuxUtils::TrimPacketPool();
+
   CFFmpegLog::ClearLogLevel();
   m_bStop = true;
 
@@ -3862,6 +3883,12 @@ void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
                                     m_State.cache_level * 100.0, m_State.cache_time,
                                     m_State.cache_offset * 100.0);
     }
+    if (m_State.readahead_packets >= 0)
+    {
+      strBuf += StringUtils::Format(", demux: {} pkts / {} / {:6.3f}s", m_State.readahead_packets,
+                                    StringUtils::SizeToString(m_State.readahead_bytes),
+                                    m_State.readahead_time);
+    }
 
     strGeneralInfo = StringUtils::Format("Player: a/v:{: 6.3f}, {}", dDiff, strBuf);
   }
@@ -5787,6 +5814,16 @@ void CVideoPlayer::UpdatePlayState(double timeout)
   else
     state.cache_bytes = 0;
 
+  DemuxReadAheadState readAhead;
+  if (m_pDemuxer && m_pDemuxer->GetReadAheadState(readAhead))
+  {
+    state.readahead_packets = static_cast<int>(readAhead.packets);
+    state.readahead_bytes = static_cast<int64_t>(readAhead.bytes);
+    state.readahead_time = readAhead.duration / DVD_TIME_BASE;
+  }
+  else
+    state.readahead_packets = -1;
+
   state.timestamp = m_clock.GetAbsoluteClock();
 
   if (state.timeMax <= 0)
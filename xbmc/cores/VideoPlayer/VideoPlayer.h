@@ -61,6 +61,9 @@ struct SPlayerState
     cache_level = 0.0;
     cache_offset = 0.0;
     cache_time = 0.0;
+    readahead_packets = -1;
+    readahead_bytes = 0;
+    readahead_time = 0.0;
     lastSeek = 0;
     streamsReady = false;
   }
@@ -101,6 +104,10 @@ struct SPlayerState
   double cache_level; // current cache level
   double cache_offset; // percentage of file ahead of current position
   double cache_time; // estimated playback time of current cached bytes
+
+  int readahead_packets; // packets read ahead by the demuxer, -1 if it doesn't read ahead
+  int64_t readahead_bytes; // size of the packets read ahead
+  double readahead_time; // playback time of the packets read ahead
 };
 
 class CDVDInputStream;
@@ -562,6 +569,10 @@ protected:
   ECacheState  m_caching;
   XbmcThreads::EndTime<> m_cachingTimer;
 
+  // time to first frame, from preparing playback until the streams are in sync
+  std::chrono::steady_clock::time_point m_prepareTime;
+  std::chrono::milliseconds m_demuxerOpenTime{0};
+
   std::unique_ptr<CProcessInfo> m_processInfo;
 
   CCurrentStream m_CurrentAudio;
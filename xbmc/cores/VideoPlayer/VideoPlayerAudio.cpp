@@ -11,6 +11,7 @@
 #include "DVDCodecs/Audio/DVDAudioCodec.h"
 #include "DVDCodecs/DVDFactoryCodec.h"
 #include "ServiceBroker.h"
+#include "VideoPlayerTrace.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/VideoPlayer/Interface/DemuxPacket.h"
@@ -224,8 +225,11 @@ void CVideoPlayerAudio::UpdatePlayerInfo()
     m_info = info;
   }
 
+  const int level = m_messageQueue.GetLevel();
+  CVideoPlayerTrace::Counter(TraceCategory::QUEUE, "AudioQueue", level);
+
   m_processInfo.SetAudioLiveBitRate(m_audioStats.GetBitrate());
-  m_processInfo.SetAudioQueueLevel(std::min(99, m_messageQueue.GetLevel()));
+  m_processInfo.SetAudioQueueLevel(std::min(99, level));
   m_processInfo.SetAudioQueueDataLevel(std::min(99, m_messageQueue.GetLevel(true)));
 }
 
@@ -268,7 +272,11 @@ void CVideoPlayerAudio::Process()
       timeout = 0ms;
     }
 
-    MsgQueueReturnCode ret = m_messageQueue.Get(pMsg, timeout, priority);
+    MsgQueueReturnCode ret;
+    {
+      CVideoPlayerTraceScope trace(TraceCategory::QUEUE, "AudioGetMessage");
+      ret = m_messageQueue.Get(pMsg, timeout, priority);
+    }
 
     onlyPrioMsgs = false;
 
@@ -427,7 +435,13 @@ void CVideoPlayerAudio::Process()
         continue;
       }
 
-      if (!m_pAudioCodec->AddData(*pPacket))
+      bool added;
+      {
+        CVideoPlayerTraceScope trace(TraceCategory::DECODE, "AudioAddData");
+        added = m_pAudioCodec->AddData(*pPacket);
+      }
+
+      if (!added)
       {
         m_messageQueue.PutBack(pMsg);
         onlyPrioMsgs = true;
@@ -455,7 +469,10 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
   {
     audioframe.hasDownmix = false;
 
-    m_pAudioCodec->GetData(audioframe);
+    {
+      CVideoPlayerTraceScope trace(TraceCategory::DECODE, "AudioGetData");
+      m_pAudioCodec->GetData(audioframe);
+    }
 
     if (audioframe.nb_frames == 0)
     {
@@ -557,7 +574,11 @@ bool CVideoPlayerAudio::ProcessDecoderOutput(DVDAudioFrame &audioframe)
     }
   }
 
-  int framesOutput = m_audioSink.AddPackets(audioframe);
+  int framesOutput;
+  {
+    CVideoPlayerTraceScope trace(TraceCategory::PRESENT, "AudioAddPackets");
+    framesOutput = m_audioSink.AddPackets(audioframe);
+  }
 
   // guess next pts
   m_audioClock += audioframe.duration * ((double)framesOutput / audioframe.nb_frames);
@@ -0,0 +1,287 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerTrace.h"
+
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace
+{
+struct TraceEvent
+{
+  uint8_t phase;
+  TraceCategory category;
+  const char* name;
+  int64_t time;
+  int64_t duration;
+  int64_t value;
+};
+
+/*!
+ * \brief The events of one thread
+ *
+ * Only the thread writes, Read() copies the events from any thread. A slot is
+ * overwritten after RING_SIZE events, the events that may have been
+ * overwritten while copying are dropped.
+ */
+class CTraceRing
+{
+public:
+  CTraceRing(int tid, std::string threadName)
+    : m_tid(tid),
+      m_threadName(std::move(threadName)),
+      m_slots(std::make_unique<Slot[]>(RING_SIZE))
+  {
+  }
+
+  void Push(const TraceEvent& event)
+  {
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[head % RING_SIZE];
+
+    // Readers that see any of the new fields see the head of before
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.phase.store(event.phase, std::memory_order_relaxed);
+    slot.category.store(event.category, std::memory_order_relaxed);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.time.store(event.time, std::memory_order_relaxed);
+    slot.duration.store(event.duration, std::memory_order_relaxed);
+    slot.value.store(event.value, std::memory_order_relaxed);
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  void Read(int64_t since, std::vector<TraceEvent>& events) const
+  {
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t begin = head > RING_SIZE ? head - RING_SIZE : 0;
+
+    std::vector<TraceEvent> copy;
+    copy.reserve(head - begin);
+    for (uint64_t i = begin; i < head; i++)
+    {
+      const Slot& slot = m_slots[i % RING_SIZE];
+      copy.push_back({slot.phase.load(std::memory_order_relaxed),
+                      slot.category.load(std::memory_order_relaxed),
+                      slot.name.load(std::memory_order_relaxed),
+                      slot.time.load(std::memory_order_relaxed),
+                      slot.duration.load(std::memory_order_relaxed),
+                      slot.value.load(std::memory_order_relaxed)});
+    }
+
+    // The event at the head may be half written over the oldest one
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = m_head.load(std::memory_order_relaxed);
+    const uint64_t valid = after >= RING_SIZE ? after - RING_SIZE + 1 : 0;
+
+    for (uint64_t i = std::max(begin, valid); i < head; i++)
+    {
+      const TraceEvent& event = copy[i - begin];
+      if (event.time >= since)
+        events.push_back(event);
+    }
+  }
+
+  const int m_tid;
+  const std::string m_threadName;
+
+private:
+  static constexpr uint64_t RING_SIZE = CVideoPlayerTrace::RING_SIZE;
+
+  struct Slot
+  {
+    std::atomic<uint8_t> phase{0};
+    std::atomic<TraceCategory> category{TraceCategory::DEMUX};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> time{0};
+    std::atomic<int64_t> duration{0};
+    std::atomic<int64_t> value{0};
+  };
+
+  const std::unique_ptr<Slot[]> m_slots;
+  std::atomic<uint64_t> m_head{0};
+};
+
+CCriticalSection traceSection;
+std::vector<std::shared_ptr<CTraceRing>> traceRings;
+int traceNextTid{1};
+int64_t traceStart{0};
+
+/*!
+ * \brief Drop the rings of threads that ended, unless they have events since the start
+ *
+ * Must be called with traceSection held.
+ */
+void PruneRings()
+{
+  std::vector<TraceEvent> events;
+  std::erase_if(traceRings,
+                [&events](const std::shared_ptr<CTraceRing>& ring)
+                {
+                  if (ring.use_count() != 1)
+                    return false;
+
+                  events.clear();
+                  ring->Read(traceStart, events);
+                  return events.empty();
+                });
+}
+
+std::shared_ptr<CTraceRing> RegisterThread()
+{
+  std::unique_lock lock(traceSection);
+
+  PruneRings();
+
+  const int tid = traceNextTid++;
+  const CThread* thread = CThread::GetCurrentThread();
+  std::string name = thread ? thread->GetName() : fmt::format("Thread {}", tid);
+
+  auto ring = std::make_shared<CTraceRing>(tid, std::move(name));
+  traceRings.emplace_back(ring);
+  return ring;
+}
+
+const char* GetCategoryName(TraceCategory category)
+{
+  switch (category)
+  {
+    case TraceCategory::DEMUX:
+      return "demux";
+    case TraceCategory::DECODE:
+      return "decode";
+    case TraceCategory::QUEUE:
+      return "queue";
+    case TraceCategory::RENDER_MANAGER:
+      return "rendermanager";
+    case TraceCategory::PRESENT:
+      return "present";
+  }
+  return "";
+}
+
+std::string EscapeJson(const std::string& str)
+{
+  std::string escaped;
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += {'\\', c};
+    else if (static_cast<unsigned char>(c) < 0x20)
+      escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+    else
+      escaped += c;
+  }
+  return escaped;
+}
+} // namespace
+
+std::atomic<bool> CVideoPlayerTrace::m_enabled{false};
+
+void CVideoPlayerTrace::Start()
+{
+  std::unique_lock lock(traceSection);
+
+  // Drop the rings of threads that ended
+  std::erase_if(traceRings, [](const std::shared_ptr<CTraceRing>& ring)
+                { return ring.use_count() == 1; });
+
+  traceStart = Now();
+  m_enabled = true;
+}
+
+void CVideoPlayerTrace::Stop()
+{
+  m_enabled = false;
+}
+
+std::string CVideoPlayerTrace::Serialize()
+{
+  std::unique_lock lock(traceSection);
+
+  PruneRings();
+
+  std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+  json += R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"VideoPlayer"}})";
+  auto out = std::back_inserter(json);
+
+  std::vector<TraceEvent> events;
+  for (const auto& ring : traceRings)
+  {
+    events.clear();
+    ring->Read(traceStart, events);
+    if (events.empty())
+      continue;
+
+    fmt::format_to(out,
+                   R"(,{{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+                   ring->m_tid, EscapeJson(ring->m_threadName));
+
+    for (const TraceEvent& event : events)
+    {
+      const double time = (event.time - traceStart) / 1000.0;
+      fmt::format_to(out, R"(,{{"name":"{}","cat":"{}","pid":1,"tid":{},"ts":{:.3f})", event.name,
+                     GetCategoryName(event.category), ring->m_tid, time);
+
+      switch (static_cast<Phase>(event.phase))
+      {
+        case Phase::COMPLETE:
+          fmt::format_to(out, R"(,"ph":"X","dur":{:.3f}}})", event.duration / 1000.0);
+          break;
+        case Phase::INSTANT:
+          fmt::format_to(out, R"(,"ph":"i","s":"t"}})");
+          break;
+        case Phase::COUNTER:
+          fmt::format_to(out, R"(,"ph":"C","args":{{"value":{}}}}})", event.value);
+          break;
+      }
+    }
+  }
+
+  json += "]}";
+  return json;
+}
+
+bool CVideoPlayerTrace::Dump(const std::string& path)
+{
+  const std::string json = Serialize();
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true))
+    return false;
+
+  return file.Write(json.data(), json.size()) == static_cast<ssize_t>(json.size());
+}
+
+int64_t CVideoPlayerTrace::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void CVideoPlayerTrace::Record(Phase phase,
+                               TraceCategory category,
+                               const char* name,
+                               int64_t time,
+                               int64_t duration,
+                               int64_t value)
+{
+  thread_local std::shared_ptr<CTraceRing> ring = RegisterThread();
+  ring->Push({static_cast<uint8_t>(phase), category, name, time, duration, value});
+}
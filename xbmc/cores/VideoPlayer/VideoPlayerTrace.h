@@ -0,0 +1,128 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+enum class TraceCategory : uint8_t
+{
+  DEMUX,
+  DECODE,
+  QUEUE,
+  RENDER_MANAGER,
+  PRESENT,
+};
+
+/*!
+ * \brief Records a timeline of the playback pipeline, written as Chrome trace
+ *        JSON for chrome://tracing and Perfetto
+ *
+ * Each thread records to a ring of its own without locks, the rings keep the
+ * last RING_SIZE - 1 events of their thread. Recording is off until Start(), and
+ * a trace point costs one relaxed load then, so they stay in release builds.
+ * The trace is written with PlayerControl(DumpTrace).
+ *
+ * Event names must be string literals, they are kept by pointer.
+ */
+class CVideoPlayerTrace
+{
+public:
+  static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+  /*!
+   * \brief Start recording, the events recorded before are dropped
+   */
+  static void Start();
+  static void Stop();
+
+  /*!
+   * \brief Record a point in time, e.g. a dropped frame
+   */
+  static void Instant(TraceCategory category, const char* name)
+  {
+    if (IsEnabled())
+      Record(Phase::INSTANT, category, name, Now(), 0, 0);
+  }
+
+  /*!
+   * \brief Record the value of a counter, e.g. a queue level
+   */
+  static void Counter(TraceCategory category, const char* name, int64_t value)
+  {
+    if (IsEnabled())
+      Record(Phase::COUNTER, category, name, Now(), 0, value);
+  }
+
+  /*!
+   * \brief Get the events recorded since Start() as Chrome trace JSON
+   */
+  static std::string Serialize();
+
+  /*!
+   * \brief Write the events recorded since Start() to a file
+   */
+  static bool Dump(const std::string& path);
+
+  static constexpr unsigned int RING_SIZE = 16384;
+
+private:
+  friend class CVideoPlayerTraceScope;
+
+  enum class Phase : uint8_t
+  {
+    COMPLETE,
+    INSTANT,
+    COUNTER,
+  };
+
+  //! In ns
+  static int64_t Now();
+  static void Record(Phase phase,
+                     TraceCategory category,
+                     const char* name,
+                     int64_t time,
+                     int64_t duration,
+                     int64_t value);
+
+  static std::atomic<bool> m_enabled;
+};
+
+/*!
+ * \brief Records the time spent in a scope
+ */
+class CVideoPlayerTraceScope
+{
+public:
+  CVideoPlayerTraceScope(TraceCategory category, const char* name)
+  {
+    if (CVideoPlayerTrace::IsEnabled())
+    {
+      m_name = name;
+      m_category = category;
+      m_start = CVideoPlayerTrace::Now();
+    }
+  }
+
+  ~CVideoPlayerTraceScope()
+  {
+    if (m_name)
+      CVideoPlayerTrace::Record(CVideoPlayerTrace::Phase::COMPLETE, m_category, m_name, m_start,
+                                CVideoPlayerTrace::Now() - m_start, 0);
+  }
+
+  CVideoPlayerTraceScope(const CVideoPlayerTraceScope&) = delete;
+  CVideoPlayerTraceScope& operator=(const CVideoPlayerTraceScope&) = delete;
+
+private:
+  const char* m_name{nullptr};
+  TraceCategory m_category{TraceCategory::DEMUX};
+  int64_t m_start{0};
+};
@@ -13,6 +13,7 @@
 #include "DVDCodecs/Overlay/DVDOverlay.h"
 #include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
 #include "ServiceBroker.h"
+#include "VideoPlayerTrace.h"
 #include "cores/VideoPlayer/Interface/DemuxPacket.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "settings/AdvancedSettings.h"
@@ -306,6 +307,7 @@ inline MsgQueueReturnCode CVideoPlayerVideo::GetMessage(std::shared_ptr<CDVDMsg>
                                                         std::chrono::milliseconds timeout,
                                                         int& priority)
 {
+  CVideoPlayerTraceScope trace(TraceCategory::QUEUE, "VideoGetMessage");
   MsgQueueReturnCode ret = m_messageQueue.Get(pMsg, timeout, priority);
   m_processInfo.SetLevelVQ(m_messageQueue.GetLevel());
   return ret;
@@ -585,7 +587,13 @@ void CVideoPlayerVideo::Process()
         codecControl |= DVD_CODEC_CTRL_ROTATE;
       m_pVideoCodec->SetCodecControl(codecControl);
 
-      if (m_pVideoCodec->AddData(*pPacket))
+      bool added;
+      {
+        CVideoPlayerTraceScope trace(TraceCategory::DECODE, "VideoAddData");
+        added = m_pVideoCodec->AddData(*pPacket);
+      }
+
+      if (added)
       {
         // buffer packets so we can recover should decoder flush for some reason
         if (m_pVideoCodec->GetConvergeCount() > 0)
@@ -615,14 +623,21 @@ void CVideoPlayerVideo::Process()
 
 void CVideoPlayerVideo::UpdatePlayerInfo()
 {
+  const int level = m_messageQueue.GetLevel();
+  CVideoPlayerTrace::Counter(TraceCategory::QUEUE, "VideoQueue", level);
+
   m_processInfo.SetVideoLiveBitRate(GetVideoBitrate());
-  m_processInfo.SetVideoQueueLevel(std::min(99, m_messageQueue.GetLevel()));
+  m_processInfo.SetVideoQueueLevel(std::min(99, level));
   m_processInfo.SetVideoQueueDataLevel(std::min(99, m_messageQueue.GetLevel(true)));
 }
 
 bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
 {
-  CDVDVideoCodec::VCReturn decoderState = m_pVideoCodec->GetPicture(&m_picture);
+  CDVDVideoCodec::VCReturn decoderState;
+  {
+    CVideoPlayerTraceScope trace(TraceCategory::DECODE, "VideoGetPicture");
+    decoderState = m_pVideoCodec->GetPicture(&m_picture);
+  }
 
   if (decoderState == CDVDVideoCodec::VC_BUFFER)
   {
@@ -969,6 +984,7 @@ CVideoPlayerVideo::EOutputState CVideoPlayerVideo::OutputPicture(const VideoPict
   if (!m_renderManager.AddVideoPicture(*pPicture, m_bAbortOutput, deintMethod, (m_syncState == ESyncState::SYNC_STARTING)))
   {
     m_droppingStats.AddOutputDropGain(pPicture->pts, 1);
+    CVideoPlayerTrace::Instant(TraceCategory::RENDER_MANAGER, "VideoOutputDrop");
     return OUTPUT_DROPPED;
   }
 
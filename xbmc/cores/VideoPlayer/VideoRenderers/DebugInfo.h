@@ -25,6 +25,7 @@ struct DEBUG_INFO_VIDEO
   std::string metaLight;
   std::string shader;
   std::string render;
+  std::string subtitles;
 };
 
 struct DEBUG_INFO_RENDER
@@ -11,6 +11,7 @@
 
 #include "OverlayRendererUtil.h"
 #include "ServiceBroker.h"
+#include "SubtitleRasterizer.h"
 #include "application/ApplicationComponents.h"
 #include "application/ApplicationPlayer.h"
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlay.h"
@@ -22,6 +23,7 @@
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
@@ -97,6 +99,10 @@ void CRenderer::Flush()
   for(std::vector<SElement>& buffer : m_buffers)
     Release(buffer);
 
+  m_rasterizer.reset();
+  m_rasterizerSource.reset();
+  m_rasterizedId = 0;
+
   ReleaseCache();
   Reset();
 }
@@ -273,12 +279,12 @@ bool CRenderer::HasVisibleOverlay(int idx) const
       return true;
 
     // libass (TEXT/SSA): the container stays in m_buffers for the whole
-    // video (iPTSStopTime=DVD_NOPTS_VALUE). Visibility means
-    // ass_render_frame returned images for the current PTS, cached by
-    // PrepareOverlays in e.renderedImages.
+    // video (iPTSStopTime=DVD_NOPTS_VALUE). Visibility means the bitmap
+    // rasterized for the current PTS, cached by PrepareOverlays in
+    // e.rasterized, isn't empty.
     if (o.IsOverlayType(DVDOVERLAY_TYPE_TEXT) || o.IsOverlayType(DVDOVERLAY_TYPE_SSA))
     {
-      if (e.renderedImages != nullptr)
+      if (e.rasterized && !e.rasterized->IsEmpty())
         return true;
     }
   }
@@ -432,10 +438,9 @@ void CRenderer::PrepareOverlays(int idx)
   bool hasImageSpu = false;
   for (auto& e : m_buffers[idx])
   {
-    // Clear last frame's cached output; libass may have invalidated the
-    // pointer on its next ass_render_frame call.
-    // (assDetectChange is consumed by ConvertLibass, not here.)
-    e.renderedImages = nullptr;
+    // Clear last frame's cached output.
+    // (m_pendingChange is consumed by ConvertLibass, not here.)
+    e.rasterized.reset();
 
     if (!e.overlay_dvd)
       continue;
@@ -576,15 +581,42 @@ void CRenderer::PrepareOverlays(int idx)
     e.renderedFrameWidth = rOpts.frameWidth;
     e.renderedFrameHeight = rOpts.frameHeight;
 
-    // Pull the libass output for this PTS. Cached on the SElement until
-    // ConvertLibass consumes it later in this frame's GUI walk.
-    int currentChange = 0;
-    e.renderedImages = ovAss.GetLibassHandler()->RenderImage(e.pts, rOpts, updateStyle,
-                                                             m_overlayStyle, &currentChange);
-    if (currentChange > 0)
+    // libass runs ahead of the clock on the rasterizer thread, which is
+    // restarted for another handler and told about new render options.
+    std::shared_ptr<CDVDSubtitlesLibass> libass = ovAss.GetLibassHandler();
+    bool newSource = false;
+    if (!m_rasterizer || m_rasterizerSource != libass)
+    {
+      m_rasterizer.reset();
+      m_rasterizer =
+          std::make_unique<CSubtitleRasterizer>([libass] { return libass->GetRevision(); });
+      m_rasterizerSource = libass;
+      newSource = true;
+    }
+
+    if (newSource || updateStyle || !(rOpts == m_rasterizerOpts))
     {
+      m_rasterizerOpts = rOpts;
+      m_rasterizer->SetSource(
+          [libass, rOpts, style = m_overlayStyle](double pts, bool applyStyle, SQuads& quads)
+          {
+            const int maxX = static_cast<int>(rOpts.frameWidth);
+            libass->RenderImage(pts, rOpts, applyStyle, style, [&quads, maxX](ASS_Image* images)
+                                { convert_quad(images, quads, maxX); });
+          },
+          updateStyle);
+    }
+
+    // Pull the bitmap for this PTS, rasterized here only if the thread is
+    // behind. Cached on the SElement until ConvertLibass consumes it later
+    // in this frame's GUI walk.
+    e.rasterized = m_rasterizer->Get(e.pts);
+    const unsigned int rasterizedId = e.rasterized ? e.rasterized->id : 0;
+    if (rasterizedId != m_rasterizedId)
+    {
+      m_rasterizedId = rasterizedId;
       // Persist on the overlay so a skipped GUI render does not drop the change.
-      ovAss.m_pendingChange = currentChange;
+      ovAss.m_pendingChange = 1;
       doMarkDirty = true;
     }
   }
@@ -603,7 +635,7 @@ void CRenderer::PrepareOverlays(int idx)
 std::shared_ptr<COverlay> CRenderer::ConvertLibass(SElement& e)
 {
   // If no images not execute the renderer
-  if (!e.renderedImages)
+  if (!e.rasterized || e.rasterized->IsEmpty())
     return nullptr;
 
   CDVDOverlayLibass& o = static_cast<CDVDOverlayLibass&>(*e.overlay_dvd);
@@ -620,7 +652,7 @@ std::shared_ptr<COverlay> CRenderer::ConvertLibass(SElement& e)
   }
 
   std::shared_ptr<COverlay> overlay =
-      COverlay::Create(e.renderedImages, e.renderedFrameWidth, e.renderedFrameHeight);
+      COverlay::Create(e.rasterized->quads, e.renderedFrameWidth, e.renderedFrameHeight);
 
   m_textureCache[m_textureid] = overlay;
   o.m_textureid = m_textureid;
@@ -643,7 +675,7 @@ std::shared_ptr<COverlay> CRenderer::Convert(SElement& e)
     if (!ovAss.GetLibassHandler())
       return nullptr;
 
-    // Build the COverlay from libass output PrepareOverlays cached on e
+    // Build the COverlay from the bitmap PrepareOverlays cached on e
     // earlier this frame; avoids re-entering libass during render.
     r = ConvertLibass(e);
 
@@ -675,6 +707,20 @@ std::shared_ptr<COverlay> CRenderer::Convert(SElement& e)
   return r;
 }
 
+std::string CRenderer::GetDebugInfo() const
+{
+  std::unique_lock lock(m_section);
+  if (!m_rasterizer)
+    return "";
+
+  const SubtitleRasterizerStats stats = m_rasterizer->GetStats();
+  const double hitRate =
+      stats.lookups > 0 ? static_cast<double>(stats.hits) * 100 / stats.lookups : 0.0;
+  return StringUtils::Format("Subtitles: raster:{:.2f} ms hits:{:.1f}% cached:{} ({:.1f} MiB)",
+                             stats.rasterizeTime, hitRate, stats.entries,
+                             static_cast<double>(stats.bytes) / (1024 * 1024));
+}
+
 void CRenderer::Notify(const Observable& obs, const ObservableMessage msg)
 {
   switch (msg)
@@ -19,12 +19,14 @@
 #include <atomic>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 typedef struct ass_image ASS_Image;
 
 class CDVDOverlay;
 class CDVDOverlayLibass;
+class CDVDSubtitlesLibass;
 class CDVDOverlayImage;
 class CDVDOverlaySpu;
 class CDVDOverlaySSA;
@@ -32,6 +34,10 @@ class CDVDOverlayText;
 
 namespace OVERLAY {
 
+  class CSubtitleRasterizer;
+  struct SQuads;
+  struct SRasterizedSubtitle;
+
   struct SRenderState
   {
     float x;
@@ -55,6 +61,7 @@ namespace OVERLAY {
     static std::shared_ptr<COverlay> Create(const CDVDOverlayImage& o, CRect& rSource);
     static std::shared_ptr<COverlay> Create(const CDVDOverlaySpu& o);
     static std::shared_ptr<COverlay> Create(ASS_Image* images, float width, float height);
+    static std::shared_ptr<COverlay> Create(const SQuads& quads, float width, float height);
 
     COverlay();
     virtual ~COverlay();
@@ -111,15 +118,21 @@ namespace OVERLAY {
     virtual void Render(int idx, float depth = 0.0f);
 
     /*!
-     * \brief Pre-walk hook: render libass output for the present slot.
+     * \brief Pre-walk hook: fetch the libass output for the present slot.
      *  Called once per frame on the GUI/main thread before the GUI walk-skip
-     *  decision. Caches the ASS_Image* and detect_change flag on each
-     *  SElement so ConvertLibass can consume them during the walk without
-     *  re-entering libass. Calls MarkDirty internally when libass reports
-     *  a visible or changed subtitle.
+     *  decision. Caches the bitmap from the subtitle rasterizer on each
+     *  SElement so ConvertLibass can consume it during the walk without
+     *  re-entering libass. Calls MarkDirty internally when the bitmap
+     *  changes.
      */
     void PrepareOverlays(int idx);
 
+    /*!
+     * \brief Get the rasterization cost and cache hit rate of libass
+     *  subtitles for the debug overlay, empty if none are shown
+     */
+    std::string GetDebugInfo() const;
+
     /*!
      * \brief Release resources
      */
@@ -141,12 +154,12 @@ namespace OVERLAY {
      *  so any entry in m_buffers means visible.
      *
      *  libass (TEXT/SSA): the container is added once with no stop PTS and
-     *  stays in m_buffers for the whole video. Visibility means
-     *  ass_render_frame returned images for the current PTS, cached on
-     *  e.renderedImages by PrepareOverlays.
+     *  stays in m_buffers for the whole video. Visibility means the bitmap
+     *  rasterized for the current PTS isn't empty, cached on e.rasterized by
+     *  PrepareOverlays.
      *
      *  Must be called after PrepareOverlays has run this frame; before that
-     *  e.renderedImages reflects the previous frame's state.
+     *  e.rasterized reflects the previous frame's state.
      */
     bool HasVisibleOverlay(int idx) const;
     void SetVideoRect(CRect &source, CRect &dest, CRect &view);
@@ -177,9 +190,8 @@ namespace OVERLAY {
       double pts;
       std::shared_ptr<CDVDOverlay> overlay_dvd;
       // libass output cached by PrepareOverlays; read by ConvertLibass during
-      // render. libass owns the pointer; valid only until the next
-      // ass_render_frame call.
-      ASS_Image* renderedImages{nullptr};
+      // render. Shared with the rasterizer cache.
+      std::shared_ptr<const SRasterizedSubtitle> rasterized;
       float renderedFrameWidth{0.0f};
       float renderedFrameHeight{0.0f};
     };
@@ -228,6 +240,13 @@ namespace OVERLAY {
 
     std::shared_ptr<struct KODI::SUBTITLES::STYLE::style> m_overlayStyle;
     std::atomic<bool> m_isSettingsChanged{false};
+
+    // Rasterizes libass output ahead of the clock, for m_rasterizerSource
+    std::unique_ptr<CSubtitleRasterizer> m_rasterizer;
+    std::shared_ptr<CDVDSubtitlesLibass> m_rasterizerSource;
+    KODI::SUBTITLES::STYLE::renderOpts m_rasterizerOpts;
+    // Bitmap of the last PrepareOverlays, to detect changes
+    unsigned int m_rasterizedId{0};
     // Whether last frame had any image/SPU overlay. Used by PrepareOverlays
     // to detect arrival/disappearance transitions (image/SPU have no
     // per-frame change signal of their own, unlike libass detect_change).
@@ -186,10 +186,17 @@ COverlayTextureGL::COverlayTextureGL(const CDVDOverlaySpu& o)
 
 std::shared_ptr<COverlay> COverlay::Create(ASS_Image* images, float width, float height)
 {
-  return std::make_shared<COverlayGlyphGL>(images, width, height);
+  SQuads quads;
+  convert_quad(images, quads, static_cast<int>(width));
+  return std::make_shared<COverlayGlyphGL>(quads, width, height);
 }
 
-COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, float width, float height)
+std::shared_ptr<COverlay> COverlay::Create(const SQuads& quads, float width, float height)
+{
+  return std::make_shared<COverlayGlyphGL>(quads, width, height);
+}
+
+COverlayGlyphGL::COverlayGlyphGL(const SQuads& quads, float width, float height)
 {
   m_width  = 1.0;
   m_height = 1.0;
@@ -198,8 +205,7 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, float width, float height)
   m_x      = 0.0f;
   m_y      = 0.0f;
 
-  SQuads quads;
-  if (!convert_quad(images, quads, static_cast<int>(width)))
+  if (quads.quad.empty())
     return;
 
   glGenTextures(1, &m_texture);
@@ -218,7 +224,7 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, float width, float height)
   m_vertex.resize(quads.quad.size() * 4);
 
   VERTEX* vt = m_vertex.data();
-  SQuad* vs = quads.quad.data();
+  const SQuad* vs = quads.quad.data();
 
   for (size_t i = 0; i < quads.quad.size(); i++)
   {
@@ -26,6 +26,8 @@ struct SQuad
   unsigned char r, g, b, a;
   int x, y;
   int w, h;
+
+  bool operator==(const SQuad& other) const = default;
 };
 
 struct SQuads
@@ -34,6 +36,8 @@ struct SQuads
   int size_y{0};
   std::vector<uint8_t> texture;
   std::vector<SQuad> quad;
+
+  bool operator==(const SQuads& other) const = default;
 };
 
 void convert_rgba(const CDVDOverlayImage& o, bool mergealpha, std::vector<uint32_t>& rgba);
@@ -15,6 +15,7 @@
 #include "ServiceBroker.h"
 #include "application/Application.h"
 #include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "cores/VideoPlayer/VideoPlayerTrace.h"
 #include "messaging/ApplicationMessenger.h"
 #include "rendering/capture/CaptureBlit.h"
 #include "rendering/capture/CaptureMetadata.h"
@@ -289,6 +290,7 @@ bool CRenderManager::IsPresenting()
 
 void CRenderManager::FrameMove()
 {
+  CVideoPlayerTraceScope trace(TraceCategory::RENDER_MANAGER, "FrameMove");
   bool firstFrame = false;
   UpdateResolution();
 
@@ -620,6 +622,7 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
   bool presented = false;
   if (!gui || m_pRenderer->IsGuiLayer())
   {
+    CVideoPlayerTraceScope trace(TraceCategory::PRESENT, "Present");
     SPresent& m = m_Queue[m_presentsource];
 
     if( m.presentmethod == PRESENT_METHOD_BOB )
@@ -651,6 +654,7 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
       if (m_renderDebugVideo)
       {
         DEBUG_INFO_VIDEO video = m_pRenderer->GetDebugInfo(m_presentsource);
+        video.subtitles = m_overlays.GetDebugInfo();
         DEBUG_INFO_RENDER render = CServiceBroker::GetWinSystem()->GetDebugInfo();
 
         m_debugRenderer.SetInfo(video, render);
@@ -855,6 +859,7 @@ void CRenderManager::SetSubtitleVerticalPosition(int value, bool save)
 
 bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::atomic_bool& bStop, EINTERLACEMETHOD deintMethod, bool wait)
 {
+  CVideoPlayerTraceScope trace(TraceCategory::RENDER_MANAGER, "AddVideoPicture");
   std::unique_lock lock(m_presentlock);
 
   if (m_free.empty())
@@ -982,6 +987,7 @@ bool CRenderManager::Supports(ESCALINGMETHOD method) const
 int CRenderManager::WaitForBuffer(volatile std::atomic_bool& bStop,
                                   std::chrono::milliseconds timeout)
 {
+  CVideoPlayerTraceScope trace(TraceCategory::RENDER_MANAGER, "WaitForBuffer");
   std::unique_lock lock(m_presentlock);
 
   // check if gui is active and discard buffer if not
@@ -1027,6 +1033,7 @@ int CRenderManager::WaitForBuffer(volatile std::atomic_bool& bStop,
 
 void CRenderManager::PrepareNextRender()
 {
+  CVideoPlayerTraceScope trace(TraceCategory::RENDER_MANAGER, "PrepareNextRender");
   if (m_queued.empty())
   {
     CLog::Log(LOGERROR, "CRenderManager::PrepareNextRender - asked to prepare with nothing available");
@@ -1119,6 +1126,7 @@ void CRenderManager::PrepareNextRender()
       {
         m_discard.push_back(m_presentsourcePast);
         m_QueueSkip++;
+        CVideoPlayerTrace::Instant(TraceCategory::RENDER_MANAGER, "SkipLateFrame");
       }
       m_presentsourcePast = m_queued.front();
       m_queued.pop_front();
@@ -0,0 +1,253 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SliceConverter.h"
+
+#include "ServiceBroker.h"
+#include "threads/Thread.h"
+#include "utils/CPUInfo.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+// Enough slices per thread to balance cores of different speed
+constexpr unsigned int SLICES_PER_THREAD = 4;
+constexpr unsigned int MIN_SLICE_HEIGHT = 16;
+constexpr unsigned int MAX_THREADS = 16;
+
+unsigned int GetDefaultThreadCount()
+{
+  const std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  const int count =
+      cpuInfo ? cpuInfo->GetCPUCount() : static_cast<int>(std::thread::hardware_concurrency());
+  return std::clamp(count, 1, static_cast<int>(MAX_THREADS));
+}
+} // namespace
+
+class CSliceConverter::CWorker : public CThread
+{
+public:
+  CWorker(CSliceConverter& converter, unsigned int participant)
+    : CThread("SliceConverter"), m_converter(converter), m_participant(participant)
+  {
+    Create();
+  }
+
+  ~CWorker() override
+  {
+    m_bStop = true;
+    m_start.Set();
+    StopThread();
+  }
+
+  void Start() { m_start.Set(); }
+
+protected:
+  void Process() override
+  {
+    while (true)
+    {
+      m_start.Wait();
+      if (m_bStop)
+        break;
+
+      m_converter.RunSlices(m_participant);
+
+      if (--m_converter.m_pendingWorkers == 0)
+        m_converter.m_done.Set();
+    }
+  }
+
+private:
+  CSliceConverter& m_converter;
+  const unsigned int m_participant;
+  CEvent m_start;
+};
+
+CSliceConverter::CSliceConverter(unsigned int threadCount /* = 0 */)
+  : m_kernels(&GetYUVToRGBKernels())
+{
+  if (threadCount == 0)
+    threadCount = GetDefaultThreadCount();
+
+  // The calling thread is participant 0
+  for (unsigned int participant = 1; participant < threadCount; participant++)
+    m_workers.emplace_back(std::make_unique<CWorker>(*this, participant));
+  m_scratch.resize(threadCount);
+}
+
+CSliceConverter::~CSliceConverter()
+{
+  // Stop the workers before the state they share is destroyed
+  m_workers.clear();
+}
+
+bool CSliceConverter::Supports(AVPixelFormat format)
+{
+  switch (format)
+  {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P:
+    case AV_PIX_FMT_NV12:
+    case AV_PIX_FMT_YUV420P10LE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CSliceConverter::Configure(AVPixelFormat format,
+                                unsigned int width,
+                                unsigned int height,
+                                AVColorSpace colorSpace,
+                                bool fullRange)
+{
+  if (!Supports(format) || width == 0 || height == 0)
+    return false;
+
+  m_highBitDepth = format == AV_PIX_FMT_YUV420P10LE;
+  if (format == AV_PIX_FMT_YUVJ420P)
+    fullRange = true;
+
+  m_coefficients = GetYUVToRGBCoefficients(colorSpace, fullRange, m_highBitDepth ? 10 : 8);
+
+  if (format != m_format || width != m_width || height != m_height)
+  {
+    m_format = format;
+    m_width = width;
+    m_height = height;
+    m_chromaWidth = (width + 1) / 2;
+    m_chromaHeight = (height + 1) / 2;
+
+    // U and V rows, each with one sample past the end for interpolation
+    for (std::vector<int16_t>& scratch : m_scratch)
+      scratch.assign(2 * (m_chromaWidth + 1), 0);
+  }
+
+  return true;
+}
+
+void CSliceConverter::Convert(const uint8_t* const planes[3],
+                              const int strides[3],
+                              uint8_t* target,
+                              int targetStride,
+                              unsigned int rows)
+{
+  if (m_format == AV_PIX_FMT_NONE)
+    return;
+
+  std::copy(planes, planes + 3, m_planes);
+  std::copy(strides, strides + 3, m_strides);
+  m_target = target;
+  m_targetStride = targetStride;
+  m_rows = std::min(rows, m_height);
+
+  // Slices start on even rows, so that their chroma rows don't overlap
+  const unsigned int participants = GetThreadCount();
+  unsigned int sliceHeight = (m_rows + participants * SLICES_PER_THREAD - 1) /
+                             (participants * SLICES_PER_THREAD);
+  sliceHeight = std::max(MIN_SLICE_HEIGHT, (sliceHeight + 1) & ~1U);
+  m_sliceHeight = sliceHeight;
+  m_sliceCount = (m_rows + sliceHeight - 1) / sliceHeight;
+  m_nextSlice = 0;
+
+  // Small frames aren't worth waking the workers
+  if (m_sliceCount <= 1 || m_workers.empty())
+  {
+    RunSlices(0);
+    return;
+  }
+
+  m_done.Reset();
+  m_pendingWorkers = static_cast<unsigned int>(m_workers.size());
+  for (const auto& worker : m_workers)
+    worker->Start();
+
+  RunSlices(0);
+
+  m_done.Wait();
+}
+
+void CSliceConverter::RunSlices(unsigned int participant)
+{
+  unsigned int slice;
+  while ((slice = m_nextSlice++) < m_sliceCount)
+  {
+    const unsigned int begin = slice * m_sliceHeight;
+    ConvertRows(participant, begin, std::min(begin + m_sliceHeight, m_rows));
+  }
+}
+
+void CSliceConverter::ConvertRows(unsigned int participant, unsigned int begin, unsigned int end)
+{
+  int16_t* u = m_scratch[participant].data();
+  int16_t* v = u + m_chromaWidth + 1;
+
+  for (unsigned int row = begin; row < end; row++)
+  {
+    if (m_format == AV_PIX_FMT_NV12)
+    {
+      PrepareChroma(u, m_planes[1], m_strides[1], row, 0, 2);
+      PrepareChroma(v, m_planes[1], m_strides[1], row, 1, 2);
+    }
+    else
+    {
+      PrepareChroma(u, m_planes[1], m_strides[1], row, 0, 1);
+      PrepareChroma(v, m_planes[2], m_strides[2], row, 0, 1);
+    }
+
+    uint8_t* target = m_target + static_cast<ptrdiff_t>(row) * m_targetStride;
+    const uint8_t* luma = m_planes[0] + static_cast<ptrdiff_t>(row) * m_strides[0];
+
+    if (m_highBitDepth)
+      m_kernels->convertRow16(target, reinterpret_cast<const uint16_t*>(luma), u, v, m_width,
+                              m_coefficients);
+    else
+      m_kernels->convertRow8(target, luma, u, v, m_width, m_coefficients);
+  }
+}
+
+void CSliceConverter::PrepareChroma(int16_t* target,
+                                    const uint8_t* plane,
+                                    int stride,
+                                    unsigned int row,
+                                    unsigned int offset,
+                                    unsigned int step) const
+{
+  // Chroma is sited between two luma rows. Weigh the nearest chroma row 3:1
+  // against the one on the other side of the luma row.
+  const unsigned int nearest = row / 2;
+  unsigned int other;
+  if (row & 1)
+    other = std::min(nearest + 1, m_chromaHeight - 1);
+  else
+    other = nearest > 0 ? nearest - 1 : 0;
+
+  const uint8_t* nearRow = plane + static_cast<ptrdiff_t>(nearest) * stride;
+  const uint8_t* otherRow = plane + static_cast<ptrdiff_t>(other) * stride;
+
+  if (m_highBitDepth)
+  {
+    const uint16_t* near16 = reinterpret_cast<const uint16_t*>(nearRow);
+    const uint16_t* other16 = reinterpret_cast<const uint16_t*>(otherRow);
+    for (unsigned int i = 0; i < m_chromaWidth; i++)
+      target[i] = static_cast<int16_t>((3 * near16[i] + other16[i] + 2) >> 2);
+  }
+  else
+  {
+    for (unsigned int i = 0; i < m_chromaWidth; i++)
+    {
+      const unsigned int index = i * step + offset;
+      target[i] = static_cast<int16_t>((3 * nearRow[index] + otherRow[index] + 2) >> 2);
+    }
+  }
+
+  target[m_chromaWidth] = target[m_chromaWidth - 1];
+}
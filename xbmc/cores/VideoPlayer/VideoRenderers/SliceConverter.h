@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "YUVToRGBKernels.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+extern "C"
+{
+#include <libavutil/pixfmt.h>
+}
+
+/*!
+ * \brief Converts YUV frames to BGRA on all cores for software rendering
+ *
+ * Frames are split into horizontal slices which are claimed by a pool of
+ * worker threads and the calling thread. Each participant converts its rows
+ * through a scratch buffer of upsampled chroma that stays in its L1 cache.
+ * Chroma is interpolated from the neighboring source rows, so slices have no
+ * seams.
+ *
+ * Formats that aren't supported are left to swscale by the caller.
+ *
+ * Only the software renderer of Windows converts on the CPU. The GL and GLES
+ * renderers upload the YUV planes and convert them in their shaders.
+ */
+class CSliceConverter
+{
+public:
+  /*!
+   * \param threadCount The number of threads, or 0 to use all cores reported by CCPUInfo
+   */
+  explicit CSliceConverter(unsigned int threadCount = 0);
+  ~CSliceConverter();
+
+  static bool Supports(AVPixelFormat format);
+
+  /*!
+   * \brief Prepare for frames of a format, size and color space
+   *
+   * \return False if the format isn't supported
+   */
+  bool Configure(AVPixelFormat format,
+                 unsigned int width,
+                 unsigned int height,
+                 AVColorSpace colorSpace,
+                 bool fullRange);
+
+  /*!
+   * \brief Convert the first rows of a frame
+   *
+   * \param planes The planes of the source, as returned by the decoder
+   * \param strides The strides of the source planes in bytes
+   * \param target The BGRA target
+   * \param targetStride The stride of the target in bytes
+   * \param rows The number of rows to convert, at most the configured height
+   */
+  void Convert(const uint8_t* const planes[3],
+               const int strides[3],
+               uint8_t* target,
+               int targetStride,
+               unsigned int rows);
+
+  unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
+
+  /*!
+   * \brief Override the kernels, for tests and benchmarks
+   */
+  void SetKernels(const YUVToRGBKernels& kernels) { m_kernels = &kernels; }
+
+private:
+  class CWorker;
+
+  void RunSlices(unsigned int participant);
+  void ConvertRows(unsigned int participant, unsigned int begin, unsigned int end);
+  void PrepareChroma(int16_t* target,
+                     const uint8_t* plane,
+                     int stride,
+                     unsigned int row,
+                     unsigned int offset,
+                     unsigned int step) const;
+
+  const YUVToRGBKernels* m_kernels;
+  std::vector<std::unique_ptr<CWorker>> m_workers;
+
+  // Format
+  AVPixelFormat m_format = AV_PIX_FMT_NONE;
+  unsigned int m_width = 0;
+  unsigned int m_height = 0;
+  unsigned int m_chromaWidth = 0;
+  unsigned int m_chromaHeight = 0;
+  bool m_highBitDepth = false;
+  YUVToRGBCoefficients m_coefficients{};
+  std::vector<std::vector<int16_t>> m_scratch; // Chroma rows of each participant
+
+  // Current frame
+  const uint8_t* m_planes[3] = {};
+  int m_strides[3] = {};
+  uint8_t* m_target = nullptr;
+  int m_targetStride = 0;
+  unsigned int m_rows = 0;
+  unsigned int m_sliceHeight = 0;
+  unsigned int m_sliceCount = 0;
+  std::atomic<unsigned int> m_nextSlice{0};
+  std::atomic<unsigned int> m_pendingWorkers{0};
+  CEvent m_done;
+};
@@ -0,0 +1,266 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SubtitleRasterizer.h"
+
+#include <chrono>
+#include <mutex>
+#include <utility>
+
+using namespace OVERLAY;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Clock advances beyond this are seeks or stalls, not frames
+constexpr double MAX_STEP = DVD_TIME_BASE / 5;
+} // namespace
+
+size_t SRasterizedSubtitle::GetBytes() const
+{
+  return quads.texture.size() + quads.quad.size() * sizeof(SQuad);
+}
+
+CSubtitleRasterizer::CSubtitleRasterizer(RevisionFunc revision,
+                                         double lookahead /* = DEFAULT_LOOKAHEAD */,
+                                         size_t maxBytes /* = DEFAULT_MAX_BYTES */)
+  : CThread("SubtitleRasterizer"),
+    m_revision(std::move(revision)),
+    m_lookahead(lookahead),
+    m_maxBytes(maxBytes)
+{
+  m_cachedRevision = m_revision();
+  Create();
+}
+
+CSubtitleRasterizer::~CSubtitleRasterizer()
+{
+  {
+    std::unique_lock lock(m_section);
+    m_bStop = true;
+    m_clockChanged.notifyAll();
+  }
+  StopThread();
+}
+
+void CSubtitleRasterizer::SetSource(RasterizeFunc rasterize, bool updateStyle)
+{
+  std::unique_lock lock(m_section);
+  m_rasterize = std::move(rasterize);
+  m_updateStyle = m_updateStyle || updateStyle;
+  m_generation++;
+  Purge();
+  m_clockChanged.notifyAll();
+}
+
+std::shared_ptr<const SRasterizedSubtitle> CSubtitleRasterizer::Get(double pts)
+{
+  double step;
+  {
+    std::unique_lock lock(m_section);
+    if (!m_rasterize)
+      return nullptr;
+
+    if (pts != m_clock)
+    {
+      if (m_clock != DVD_NOPTS_VALUE && pts > m_clock && pts - m_clock <= MAX_STEP)
+        m_step = pts - m_clock;
+      m_clock = pts;
+      m_clockChanged.notifyAll();
+    }
+
+    CheckRevision();
+    m_lookups++;
+    if (auto subtitle = Find(pts))
+    {
+      m_hits++;
+      return subtitle;
+    }
+  }
+
+  std::unique_lock renderLock(m_renderSection);
+  {
+    std::unique_lock lock(m_section);
+
+    // The frame may have been rasterized while waiting for the thread
+    CheckRevision();
+    if (auto subtitle = Find(pts))
+    {
+      m_hits++;
+      return subtitle;
+    }
+    step = m_step;
+  }
+
+  return Rasterize(pts, pts - step / 2);
+}
+
+SubtitleRasterizerStats CSubtitleRasterizer::GetStats() const
+{
+  std::unique_lock lock(m_section);
+
+  SubtitleRasterizerStats stats;
+  stats.rasterizeTime = m_rasterized > 0 ? m_rasterizeTime / m_rasterized : 0.0;
+  stats.rasterized = m_rasterized;
+  stats.lookups = m_lookups;
+  stats.hits = m_hits;
+  stats.entries = m_cache.size();
+  stats.bytes = m_bytes;
+  return stats;
+}
+
+void CSubtitleRasterizer::Process()
+{
+  while (!m_bStop)
+  {
+    double pts;
+    double start;
+
+    std::unique_lock renderLock(m_renderSection);
+    {
+      std::unique_lock lock(m_section);
+      CheckRevision();
+      if (!FindNext(pts, start))
+      {
+        renderLock.unlock();
+
+        // Revisions aren't signalled, so look for them now and then
+        m_clockChanged.wait(lock, 100ms,
+                            [this, &pts, &start]
+                            {
+                              return m_bStop || m_revision() != m_cachedRevision ||
+                                     FindNext(pts, start);
+                            });
+        continue;
+      }
+    }
+
+    Rasterize(pts, start);
+  }
+}
+
+std::shared_ptr<const SRasterizedSubtitle> CSubtitleRasterizer::Rasterize(double pts, double start)
+{
+  RasterizeFunc rasterize;
+  bool updateStyle;
+  unsigned int generation;
+  double end;
+  {
+    std::unique_lock lock(m_section);
+    if (!m_rasterize)
+      return nullptr;
+
+    rasterize = m_rasterize;
+    updateStyle = std::exchange(m_updateStyle, false);
+    generation = m_generation;
+    end = pts + m_step / 2;
+  }
+
+  const unsigned int revision = m_revision();
+  auto subtitle = std::make_shared<SRasterizedSubtitle>();
+
+  const auto begin = std::chrono::steady_clock::now();
+  rasterize(pts, updateStyle, subtitle->quads);
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - begin;
+
+  std::unique_lock lock(m_section);
+  m_rasterizeTime += elapsed.count();
+  m_rasterized++;
+
+  // Don't cache a frame of an outdated source or track, it's still good to
+  // show once though
+  if (generation != m_generation || revision != m_cachedRevision || revision != m_revision())
+  {
+    subtitle->id = m_nextId++;
+    return subtitle;
+  }
+
+  return Insert(start, end, std::move(subtitle));
+}
+
+std::shared_ptr<const SRasterizedSubtitle> CSubtitleRasterizer::Find(double pts)
+{
+  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+  {
+    if (it->start <= pts && pts < it->end)
+    {
+      m_cache.splice(m_cache.begin(), m_cache, it);
+      return m_cache.front().subtitle;
+    }
+  }
+  return nullptr;
+}
+
+bool CSubtitleRasterizer::FindNext(double& pts, double& start) const
+{
+  if (!m_rasterize || m_clock == DVD_NOPTS_VALUE)
+    return false;
+
+  pts = m_clock;
+  start = m_clock - m_step / 2;
+
+  // Skip the frames covered by the cache, each range ends where the next
+  // frame starts
+  for (auto it = m_cache.begin(); it != m_cache.end();)
+  {
+    if (it->start <= pts && pts < it->end)
+    {
+      start = it->end;
+      pts = it->end + m_step / 2;
+      it = m_cache.begin();
+    }
+    else
+      ++it;
+  }
+
+  return pts <= m_clock + m_lookahead;
+}
+
+std::shared_ptr<const SRasterizedSubtitle> CSubtitleRasterizer::Insert(
+    double start, double end, std::shared_ptr<SRasterizedSubtitle> subtitle)
+{
+  // Extend the range of the previous frame if the bitmap didn't change
+  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+  {
+    if (it->end == start && it->subtitle->quads == subtitle->quads)
+    {
+      it->end = end;
+      m_cache.splice(m_cache.begin(), m_cache, it);
+      return m_cache.front().subtitle;
+    }
+  }
+
+  subtitle->id = m_nextId++;
+  m_bytes += subtitle->GetBytes();
+  m_cache.push_front({start, end, subtitle});
+
+  while (m_cache.size() > 1 && (m_bytes > m_maxBytes || m_cache.size() > MAX_ENTRIES))
+  {
+    m_bytes -= m_cache.back().subtitle->GetBytes();
+    m_cache.pop_back();
+  }
+
+  return subtitle;
+}
+
+void CSubtitleRasterizer::CheckRevision()
+{
+  const unsigned int revision = m_revision();
+  if (revision != m_cachedRevision)
+  {
+    m_cachedRevision = revision;
+    Purge();
+  }
+}
+
+void CSubtitleRasterizer::Purge()
+{
+  m_cache.clear();
+  m_bytes = 0;
+}
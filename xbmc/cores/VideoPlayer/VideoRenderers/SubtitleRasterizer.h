@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "OverlayRendererUtil.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <stddef.h>
+
+namespace OVERLAY
+{
+
+/*!
+ * \brief A composited subtitle bitmap, shared by all frames that show it
+ */
+struct SRasterizedSubtitle
+{
+  unsigned int id{0}; //!< Differs between bitmaps that differ
+  SQuads quads; //!< Empty if no subtitle is shown
+
+  bool IsEmpty() const { return quads.quad.empty(); }
+  size_t GetBytes() const;
+};
+
+struct SubtitleRasterizerStats
+{
+  double rasterizeTime{0.0}; //!< Average time to rasterize a frame, in ms
+  unsigned int rasterized{0}; //!< Frames rasterized
+  unsigned int lookups{0};
+  unsigned int hits{0}; //!< Lookups served from the cache
+  size_t entries{0};
+  size_t bytes{0};
+};
+
+/*!
+ * \brief Rasterizes subtitles ahead of the video clock on a thread of its own
+ *
+ * Frames are rasterized one after the other until the lookahead is
+ * covered. The bitmaps are kept in an LRU cache keyed by the time range they
+ * are shown in. Consecutive frames with the same bitmap extend one entry, so
+ * an unchanged subtitle is composited and uploaded once.
+ *
+ * A lookup that misses, e.g. after a seek, rasterizes on the calling thread.
+ * The cache is dropped when the source or the revision of the track changes.
+ */
+class CSubtitleRasterizer : private CThread
+{
+public:
+  /*!
+   * \brief Rasterize the subtitles at a time
+   *
+   * \param pts The time, in DVD_TIME_BASE units
+   * \param updateStyle Whether the style must be applied first
+   * \param quads Receives the bitmap, left empty if no subtitle is shown
+   */
+  using RasterizeFunc = std::function<void(double pts, bool updateStyle, SQuads& quads)>;
+
+  /*!
+   * \brief Get the revision of the track, called on any thread
+   */
+  using RevisionFunc = std::function<unsigned int()>;
+
+  /*!
+   * \param revision Gets the revision of the track
+   * \param lookahead The time span to rasterize ahead, in DVD_TIME_BASE units
+   * \param maxBytes The size limit of the cache
+   */
+  explicit CSubtitleRasterizer(RevisionFunc revision,
+                               double lookahead = DEFAULT_LOOKAHEAD,
+                               size_t maxBytes = DEFAULT_MAX_BYTES);
+  ~CSubtitleRasterizer() override;
+
+  CSubtitleRasterizer(const CSubtitleRasterizer&) = delete;
+  CSubtitleRasterizer& operator=(const CSubtitleRasterizer&) = delete;
+
+  /*!
+   * \brief Set the function to rasterize with, e.g. after the render options
+   *        changed, and drop the cache
+   *
+   * \param updateStyle Whether the style must be applied on the next call
+   */
+  void SetSource(RasterizeFunc rasterize, bool updateStyle);
+
+  /*!
+   * \brief Get the bitmap shown at a time, and advance the clock to it
+   *
+   * \return The bitmap, or nullptr if no source is set
+   */
+  std::shared_ptr<const SRasterizedSubtitle> Get(double pts);
+
+  SubtitleRasterizerStats GetStats() const;
+
+  static constexpr double DEFAULT_LOOKAHEAD = DVD_TIME_BASE;
+  static constexpr size_t DEFAULT_MAX_BYTES = 32 * 1024 * 1024;
+  static constexpr size_t MAX_ENTRIES = 256;
+
+  //! The step between frames until the clock has advanced twice
+  static constexpr double DEFAULT_STEP = DVD_TIME_BASE / 25;
+
+protected:
+  void Process() override;
+
+private:
+  struct Entry
+  {
+    double start; //!< In DVD_TIME_BASE units
+    double end; //!< Exclusive
+    std::shared_ptr<const SRasterizedSubtitle> subtitle;
+  };
+
+  /*!
+   * \brief Rasterize a frame and add it to the cache
+   *
+   * Must be called with m_renderSection held.
+   *
+   * \param pts The time to rasterize
+   * \param start The start of the time range, the end is half a step after
+   *        pts
+   */
+  std::shared_ptr<const SRasterizedSubtitle> Rasterize(double pts, double start);
+
+  /*!
+   * \brief Find the entry shown at a time and mark it as recently used
+   */
+  std::shared_ptr<const SRasterizedSubtitle> Find(double pts);
+
+  /*!
+   * \brief Find the first frame after the clock that isn't rasterized yet
+   *
+   * \return False if the lookahead is covered
+   */
+  bool FindNext(double& pts, double& start) const;
+
+  std::shared_ptr<const SRasterizedSubtitle> Insert(double start,
+                                                    double end,
+                                                    std::shared_ptr<SRasterizedSubtitle> subtitle);
+  void CheckRevision();
+  void Purge();
+
+  const RevisionFunc m_revision;
+  const double m_lookahead;
+  const size_t m_maxBytes;
+
+  //! Serializes rasterizing, taken before m_section
+  CCriticalSection m_renderSection;
+
+  mutable CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_clockChanged;
+
+  RasterizeFunc m_rasterize;
+  bool m_updateStyle{false};
+  unsigned int m_generation{0}; //!< Changes with the source
+  unsigned int m_cachedRevision{0}; //!< The track revision of the cache
+  double m_clock{DVD_NOPTS_VALUE};
+  double m_step{DEFAULT_STEP};
+
+  std::list<Entry> m_cache; //!< Most recently used first
+  size_t m_bytes{0};
+  unsigned int m_nextId{1};
+
+  double m_rasterizeTime{0.0}; //!< Total, in ms
+  unsigned int m_rasterized{0};
+  unsigned int m_lookups{0};
+  unsigned int m_hits{0};
+};
+
+} // namespace OVERLAY
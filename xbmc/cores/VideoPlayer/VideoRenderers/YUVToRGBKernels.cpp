@@ -0,0 +1,265 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "YUVToRGBKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+int16_t ToFixed(double value)
+{
+  return static_cast<int16_t>(std::lround(value * 8192.0));
+}
+
+uint8_t Clamp(int value)
+{
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+// Portable C++ kernels
+
+template<typename T>
+void ConvertRowScalar(uint8_t* target,
+                      const T* luma,
+                      const int16_t* u,
+                      const int16_t* v,
+                      size_t width,
+                      const YUVToRGBCoefficients& c)
+{
+  for (size_t x = 0; x < width; x++)
+  {
+    const size_t i = x / 2;
+    int cu = u[i];
+    int cv = v[i];
+    if (x & 1)
+    {
+      cu = (cu + u[i + 1] + 1) >> 1;
+      cv = (cv + v[i + 1] + 1) >> 1;
+    }
+    cu -= c.chromaOffset;
+    cv -= c.chromaOffset;
+
+    const int y = c.cy * (static_cast<int>(luma[x]) - c.yOffset) + c.round;
+
+    target[x * 4 + 0] = Clamp((y + c.cbu * cu) >> c.shift);
+    target[x * 4 + 1] = Clamp((y - c.cgu * cu - c.cgv * cv) >> c.shift);
+    target[x * 4 + 2] = Clamp((y + c.crv * cv) >> c.shift);
+    target[x * 4 + 3] = 0xFF;
+  }
+}
+
+constexpr YUVToRGBKernels SCALAR_KERNELS = {
+    "C++",
+    ConvertRowScalar<uint8_t>,
+    ConvertRowScalar<uint16_t>,
+};
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+
+// SSE2 kernels
+
+// Upsample 4 chroma samples to 8 pixels and remove the offset
+__m128i UpsampleChroma(const int16_t* chroma, __m128i offset)
+{
+  const __m128i even = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma));
+  const __m128i next = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma + 1));
+  const __m128i odd = _mm_avg_epu16(even, next);
+  return _mm_sub_epi16(_mm_unpacklo_epi16(even, odd), offset);
+}
+
+// Convert 8 pixels given as 16-bit luma without offset
+void Convert8(uint8_t* target,
+              __m128i y,
+              const int16_t* u,
+              const int16_t* v,
+              const YUVToRGBCoefficients& c)
+{
+  const __m128i chromaOffset = _mm_set1_epi16(c.chromaOffset);
+  const __m128i cu = UpsampleChroma(u, chromaOffset);
+  const __m128i cv = UpsampleChroma(v, chromaOffset);
+
+  // Luma term and rounding, from pairs of (y, 1)
+  const __m128i one = _mm_set1_epi16(1);
+  const __m128i ky = _mm_set_epi16(c.round, c.cy, c.round, c.cy, c.round, c.cy, c.round, c.cy);
+  const __m128i yLo = _mm_madd_epi16(_mm_unpacklo_epi16(y, one), ky);
+  const __m128i yHi = _mm_madd_epi16(_mm_unpackhi_epi16(y, one), ky);
+
+  // Chroma terms, from pairs of (u, v)
+  const __m128i uvLo = _mm_unpacklo_epi16(cu, cv);
+  const __m128i uvHi = _mm_unpackhi_epi16(cu, cv);
+  const __m128i kb = _mm_set_epi16(0, c.cbu, 0, c.cbu, 0, c.cbu, 0, c.cbu);
+  const int16_t gu = static_cast<int16_t>(-c.cgu);
+  const int16_t gv = static_cast<int16_t>(-c.cgv);
+  const __m128i kg = _mm_set_epi16(gv, gu, gv, gu, gv, gu, gv, gu);
+  const __m128i kr = _mm_set_epi16(c.crv, 0, c.crv, 0, c.crv, 0, c.crv, 0);
+
+  const __m128i shift = _mm_cvtsi32_si128(c.shift);
+  const auto color = [&](__m128i k)
+  {
+    const __m128i lo = _mm_sra_epi32(_mm_add_epi32(yLo, _mm_madd_epi16(uvLo, k)), shift);
+    const __m128i hi = _mm_sra_epi32(_mm_add_epi32(yHi, _mm_madd_epi16(uvHi, k)), shift);
+    return _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+  };
+
+  const __m128i b = color(kb);
+  const __m128i g = color(kg);
+  const __m128i r = color(kr);
+
+  const __m128i bg = _mm_unpacklo_epi8(b, g);
+  const __m128i ra = _mm_unpacklo_epi8(r, _mm_set1_epi8(-1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_unpacklo_epi16(bg, ra));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 16), _mm_unpackhi_epi16(bg, ra));
+}
+
+void ConvertRow8SSE2(uint8_t* target,
+                     const uint8_t* luma,
+                     const int16_t* u,
+                     const int16_t* v,
+                     size_t width,
+                     const YUVToRGBCoefficients& c)
+{
+  const __m128i yOffset = _mm_set1_epi16(c.yOffset);
+
+  size_t x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i y = _mm_unpacklo_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(luma + x)), _mm_setzero_si128());
+    Convert8(target + x * 4, _mm_sub_epi16(y, yOffset), u + x / 2, v + x / 2, c);
+  }
+
+  // Remainder starts at an even pixel
+  ConvertRowScalar(target + x * 4, luma + x, u + x / 2, v + x / 2, width - x, c);
+}
+
+void ConvertRow16SSE2(uint8_t* target,
+                      const uint16_t* luma,
+                      const int16_t* u,
+                      const int16_t* v,
+                      size_t width,
+                      const YUVToRGBCoefficients& c)
+{
+  const __m128i yOffset = _mm_set1_epi16(c.yOffset);
+
+  size_t x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luma + x));
+    Convert8(target + x * 4, _mm_sub_epi16(y, yOffset), u + x / 2, v + x / 2, c);
+  }
+
+  ConvertRowScalar(target + x * 4, luma + x, u + x / 2, v + x / 2, width - x, c);
+}
+
+constexpr YUVToRGBKernels SSE2_KERNELS = {
+    "SSE2",
+    ConvertRow8SSE2,
+    ConvertRow16SSE2,
+};
+
+#endif
+
+unsigned int GetCPUFeatures()
+{
+  // CPU info may not be registered yet, e.g. in unit tests
+  const std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  return cpuInfo ? cpuInfo->GetCPUFeatures() : 0;
+}
+} // namespace
+
+YUVToRGBCoefficients GetYUVToRGBCoefficients(AVColorSpace colorSpace,
+                                             bool fullRange,
+                                             int bitDepth)
+{
+  double kr;
+  double kb;
+  switch (colorSpace)
+  {
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_SMPTE170M:
+    case AVCOL_SPC_FCC:
+      kr = 0.299;
+      kb = 0.114;
+      break;
+    case AVCOL_SPC_BT2020_NCL:
+    case AVCOL_SPC_BT2020_CL:
+      kr = 0.2627;
+      kb = 0.0593;
+      break;
+    default:
+      kr = 0.2126;
+      kb = 0.0722;
+      break;
+  }
+  const double kg = 1.0 - kr - kb;
+
+  const double yScale = fullRange ? 1.0 : 255.0 / 219.0;
+  const double cScale = fullRange ? 1.0 : 255.0 / 224.0;
+
+  // Samples of higher bit depths are scaled down by the shift
+  const int extraBits = bitDepth - 8;
+
+  YUVToRGBCoefficients coefficients;
+  coefficients.cy = ToFixed(yScale);
+  coefficients.crv = ToFixed(2.0 * (1.0 - kr) * cScale);
+  coefficients.cgu = ToFixed(2.0 * kb * (1.0 - kb) / kg * cScale);
+  coefficients.cgv = ToFixed(2.0 * kr * (1.0 - kr) / kg * cScale);
+  coefficients.cbu = ToFixed(2.0 * (1.0 - kb) * cScale);
+  coefficients.yOffset = static_cast<int16_t>(fullRange ? 0 : 16 << extraBits);
+  coefficients.chromaOffset = static_cast<int16_t>(128 << extraBits);
+  coefficients.shift = 13 + extraBits;
+  coefficients.round = static_cast<int16_t>(1 << (coefficients.shift - 1));
+  return coefficients;
+}
+
+const YUVToRGBKernels& GetYUVToRGBKernels()
+{
+  static const YUVToRGBKernels& kernels = []() -> const YUVToRGBKernels&
+  {
+    const YUVToRGBKernels& selected = *GetSupportedYUVToRGBKernels().back();
+    CLog::Log(LOGDEBUG, "VideoPlayer: Using {} kernels for software YUV conversion",
+              selected.name);
+    return selected;
+  }();
+
+  return kernels;
+}
+
+const YUVToRGBKernels& GetScalarYUVToRGBKernels()
+{
+  return SCALAR_KERNELS;
+}
+
+std::vector<const YUVToRGBKernels*> GetSupportedYUVToRGBKernels()
+{
+  std::vector<const YUVToRGBKernels*> kernels{&SCALAR_KERNELS};
+
+  [[maybe_unused]] const unsigned int features = GetCPUFeatures();
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  // SSE2 is part of every x86-64 CPU, so only 32-bit builds need to check
+#if defined(__x86_64__) || defined(_M_X64)
+  kernels.push_back(&SSE2_KERNELS);
+#else
+  if (features & CPU_FEATURE_SSE2)
+    kernels.push_back(&SSE2_KERNELS);
+#endif
+#endif
+
+  return kernels;
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+extern "C"
+{
+#include <libavutil/pixfmt.h>
+}
+
+/*!
+ * \brief Fixed point coefficients of a YUV to RGB conversion
+ *
+ * A color is computed as (cy * (Y - yOffset) + round + k * (C - chromaOffset)) >> shift,
+ * which is exact in 32-bit integers for up to 10-bit input.
+ */
+struct YUVToRGBCoefficients
+{
+  int16_t cy;
+  int16_t crv;
+  int16_t cgu;
+  int16_t cgv;
+  int16_t cbu;
+  int16_t yOffset;
+  int16_t chromaOffset;
+  int16_t round;
+  int shift;
+};
+
+/*!
+ * \brief Get the coefficients of a color space
+ *
+ * \param colorSpace The matrix of the source, BT.709 if unspecified
+ * \param fullRange True if the source uses the full range of its bit depth
+ * \param bitDepth The bit depth of the source, 8 or 10
+ */
+YUVToRGBCoefficients GetYUVToRGBCoefficients(AVColorSpace colorSpace,
+                                             bool fullRange,
+                                             int bitDepth);
+
+/*!
+ * \brief Convert a row of 4:2:0 or 4:2:2 pixels to BGRA
+ *
+ * \param target The BGRA pixels
+ * \param luma The luma samples of the row
+ * \param u The blue difference samples, one per two pixels
+ * \param v The red difference samples, one per two pixels
+ * \param width The number of pixels in the row
+ *
+ * Chroma is sited left and interpolated linearly for odd pixels, so u and v
+ * need one sample past the end of the row. Chroma samples are not offset.
+ * Buffers don't need to be aligned.
+ */
+template<typename T>
+using YUVToRGBRowFunc = void (*)(uint8_t* target,
+                                 const T* luma,
+                                 const int16_t* u,
+                                 const int16_t* v,
+                                 size_t width,
+                                 const YUVToRGBCoefficients& coefficients);
+
+/*!
+ * \brief Set of kernels that convert video frames for software rendering
+ */
+struct YUVToRGBKernels
+{
+  /*!
+   * \brief Name of the instruction set, for logging
+   */
+  const char* name;
+
+  YUVToRGBRowFunc<uint8_t> convertRow8;
+  YUVToRGBRowFunc<uint16_t> convertRow16;
+};
+
+/*!
+ * \brief Get the fastest kernels supported by the running CPU
+ *
+ * The selection is made once, based on the features reported by CCPUInfo,
+ * and falls back to portable C++ if no vector unit is available.
+ */
+const YUVToRGBKernels& GetYUVToRGBKernels();
+
+/*!
+ * \brief Get the portable C++ kernels, used as a reference implementation
+ */
+const YUVToRGBKernels& GetScalarYUVToRGBKernels();
+
+/*!
+ * \brief Get all kernels that can run on this CPU, for tests and benchmarks
+ */
+std::vector<const YUVToRGBKernels*> GetSupportedYUVToRGBKernels();
@@ -0,0 +1,287 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/VideoRenderers/SliceConverter.h"
+#include "cores/VideoPlayer/VideoRenderers/YUVToRGBKernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// A frame in one of the supported formats, with padded strides like decoders use
+struct TestFrame
+{
+  TestFrame(AVPixelFormat format, unsigned int width, unsigned int height, uint32_t seed)
+    : format(format), width(width), height(height)
+  {
+    const unsigned int chromaWidth = (width + 1) / 2;
+    const unsigned int chromaHeight = (height + 1) / 2;
+    const int sampleSize = format == AV_PIX_FMT_YUV420P10LE ? 2 : 1;
+
+    strides[0] = width * sampleSize + 32;
+    strides[1] = (format == AV_PIX_FMT_NV12 ? 2 * chromaWidth : chromaWidth) * sampleSize + 32;
+    strides[2] = format == AV_PIX_FMT_NV12 ? 0 : strides[1];
+
+    planes[0].resize(strides[0] * height);
+    planes[1].resize(strides[1] * chromaHeight);
+    planes[2].resize(strides[2] * chromaHeight);
+
+    std::mt19937 rng(seed);
+    for (std::vector<uint8_t>& plane : planes)
+    {
+      if (sampleSize == 2)
+      {
+        std::uniform_int_distribution<int> value(0, 1023);
+        for (size_t i = 0; i + 1 < plane.size(); i += 2)
+        {
+          const uint16_t sample = static_cast<uint16_t>(value(rng));
+          std::memcpy(plane.data() + i, &sample, sizeof(sample));
+        }
+      }
+      else
+      {
+        std::uniform_int_distribution<int> value(0, 255);
+        for (uint8_t& sample : plane)
+          sample = static_cast<uint8_t>(value(rng));
+      }
+    }
+  }
+
+  std::vector<uint8_t> Convert(CSliceConverter& converter) const
+  {
+    std::vector<uint8_t> target(width * 4 * height);
+    const uint8_t* const data[3] = {planes[0].data(), planes[1].data(), planes[2].data()};
+    EXPECT_TRUE(converter.Configure(format, width, height, AVCOL_SPC_BT709, false));
+    converter.Convert(data, strides, target.data(), width * 4, height);
+    return target;
+  }
+
+  AVPixelFormat format;
+  unsigned int width;
+  unsigned int height;
+  std::vector<uint8_t> planes[3];
+  int strides[3];
+};
+
+const AVPixelFormat FORMATS[] = {AV_PIX_FMT_YUV420P, AV_PIX_FMT_NV12, AV_PIX_FMT_YUV420P10LE};
+
+const char* FormatName(AVPixelFormat format)
+{
+  switch (format)
+  {
+    case AV_PIX_FMT_YUV420P:
+      return "yuv420p";
+    case AV_PIX_FMT_NV12:
+      return "nv12";
+    case AV_PIX_FMT_YUV420P10LE:
+      return "yuv420p10le";
+    default:
+      return "unknown";
+  }
+}
+} // namespace
+
+TEST(TestYUVToRGBKernels, Coefficients)
+{
+  struct Sample
+  {
+    int bitDepth;
+    bool fullRange;
+    uint16_t y;
+    uint8_t expected;
+  };
+
+  const Sample samples[] = {
+      {8, false, 16, 0}, {8, false, 235, 255}, {8, true, 0, 0},     {8, true, 255, 255},
+      {10, false, 64, 0}, {10, false, 940, 255}, {10, true, 1023, 255},
+  };
+
+  for (const Sample& sample : samples)
+  {
+    const YUVToRGBCoefficients coefficients =
+        GetYUVToRGBCoefficients(AVCOL_SPC_BT709, sample.fullRange, sample.bitDepth);
+
+    // Gray has no color difference
+    const int16_t chroma[2] = {coefficients.chromaOffset, coefficients.chromaOffset};
+    uint8_t pixel[4];
+    if (sample.bitDepth == 8)
+    {
+      const uint8_t luma = static_cast<uint8_t>(sample.y);
+      GetScalarYUVToRGBKernels().convertRow8(pixel, &luma, chroma, chroma, 1, coefficients);
+    }
+    else
+    {
+      GetScalarYUVToRGBKernels().convertRow16(pixel, &sample.y, chroma, chroma, 1, coefficients);
+    }
+
+    for (int channel = 0; channel < 3; channel++)
+      EXPECT_EQ(pixel[channel], sample.expected) << "luma " << sample.y;
+    EXPECT_EQ(pixel[3], 0xFF);
+  }
+}
+
+TEST(TestYUVToRGBKernels, KernelsMatchScalar)
+{
+  const YUVToRGBKernels& scalar = GetScalarYUVToRGBKernels();
+  std::mt19937 rng(1234);
+
+  for (const YUVToRGBKernels* kernels : GetSupportedYUVToRGBKernels())
+  {
+    for (int bitDepth : {8, 10})
+    {
+      const int maxValue = (1 << bitDepth) - 1;
+      std::uniform_int_distribution<int> value(0, maxValue);
+      const YUVToRGBCoefficients coefficients =
+          GetYUVToRGBCoefficients(AVCOL_SPC_BT2020_NCL, false, bitDepth);
+
+      for (size_t width : {1, 2, 7, 8, 9, 16, 33, 1921})
+      {
+        std::vector<uint16_t> luma16(width);
+        std::vector<uint8_t> luma8(width);
+        std::vector<int16_t> u(width / 2 + 2);
+        std::vector<int16_t> v(width / 2 + 2);
+        for (size_t i = 0; i < width; i++)
+        {
+          luma16[i] = static_cast<uint16_t>(value(rng));
+          luma8[i] = static_cast<uint8_t>(luma16[i] & 0xFF);
+        }
+        for (size_t i = 0; i < u.size(); i++)
+        {
+          u[i] = static_cast<int16_t>(value(rng));
+          v[i] = static_cast<int16_t>(value(rng));
+        }
+
+        std::vector<uint8_t> expected(width * 4);
+        std::vector<uint8_t> actual(width * 4);
+        if (bitDepth == 8)
+        {
+          scalar.convertRow8(expected.data(), luma8.data(), u.data(), v.data(), width,
+                             coefficients);
+          kernels->convertRow8(actual.data(), luma8.data(), u.data(), v.data(), width,
+                               coefficients);
+        }
+        else
+        {
+          scalar.convertRow16(expected.data(), luma16.data(), u.data(), v.data(), width,
+                              coefficients);
+          kernels->convertRow16(actual.data(), luma16.data(), u.data(), v.data(), width,
+                                coefficients);
+        }
+
+        EXPECT_EQ(expected, actual)
+            << kernels->name << " bit depth " << bitDepth << " width " << width;
+      }
+    }
+  }
+}
+
+TEST(TestSliceConverter, SlicesMatchSingleThread)
+{
+  CSliceConverter single(1);
+  single.SetKernels(GetScalarYUVToRGBKernels());
+  CSliceConverter sliced(4);
+
+  for (AVPixelFormat format : FORMATS)
+  {
+    // Odd sizes exercise the last chroma row and column
+    const TestFrame frame(format, 323, 181, 42);
+    EXPECT_EQ(frame.Convert(single), frame.Convert(sliced)) << FormatName(format);
+  }
+}
+
+TEST(TestSliceConverter, NV12MatchesPlanar)
+{
+  const TestFrame planar(AV_PIX_FMT_YUV420P, 64, 48, 7);
+
+  // Interleave the chroma planes of the same frame
+  TestFrame nv12(AV_PIX_FMT_NV12, 64, 48, 7);
+  nv12.planes[0] = planar.planes[0];
+  for (unsigned int row = 0; row < 24; row++)
+  {
+    for (unsigned int i = 0; i < 32; i++)
+    {
+      nv12.planes[1][row * nv12.strides[1] + 2 * i] = planar.planes[1][row * planar.strides[1] + i];
+      nv12.planes[1][row * nv12.strides[1] + 2 * i + 1] =
+          planar.planes[2][row * planar.strides[2] + i];
+    }
+  }
+
+  CSliceConverter converter(2);
+  EXPECT_EQ(planar.Convert(converter), nv12.Convert(converter));
+}
+
+TEST(TestSliceConverter, PartialRows)
+{
+  CSliceConverter converter(3);
+  const TestFrame frame(AV_PIX_FMT_YUV420P, 100, 100, 3);
+  const std::vector<uint8_t> full = frame.Convert(converter);
+
+  // Rows past the requested ones are left untouched
+  std::vector<uint8_t> target(100 * 4 * 100, 0);
+  const uint8_t* const data[3] = {frame.planes[0].data(), frame.planes[1].data(),
+                                  frame.planes[2].data()};
+  converter.Convert(data, frame.strides, target.data(), 100 * 4, 50);
+
+  EXPECT_TRUE(std::equal(target.begin(), target.begin() + 100 * 4 * 50, full.begin()));
+  EXPECT_TRUE(std::all_of(target.begin() + 100 * 4 * 50, target.end(),
+                          [](uint8_t value) { return value == 0; }));
+}
+
+// Compares the kernels and thread counts on 1080p and 4K frames. Disabled by
+// default, run with --gtest_also_run_disabled_tests.
+TEST(TestSliceConverter, DISABLED_Benchmark)
+{
+  struct Size
+  {
+    const char* name;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  const Size sizes[] = {{"1080p", 1920, 1080}, {"4K", 3840, 2160}};
+  constexpr int ITERATIONS = 20;
+
+  for (const Size& size : sizes)
+  {
+    for (AVPixelFormat format : FORMATS)
+    {
+      const TestFrame frame(format, size.width, size.height, 1);
+      std::vector<uint8_t> target(size.width * 4 * size.height);
+      const uint8_t* const data[3] = {frame.planes[0].data(), frame.planes[1].data(),
+                                      frame.planes[2].data()};
+
+      for (const YUVToRGBKernels* kernels : GetSupportedYUVToRGBKernels())
+      {
+        for (unsigned int threads : {1u, 0u})
+        {
+          CSliceConverter converter(threads);
+          converter.SetKernels(*kernels);
+          converter.Configure(format, size.width, size.height, AVCOL_SPC_BT709, false);
+
+          const auto start = std::chrono::steady_clock::now();
+          for (int i = 0; i < ITERATIONS; i++)
+            converter.Convert(data, frame.strides, target.data(), size.width * 4, size.height);
+
+          const std::chrono::duration<double, std::milli> elapsed =
+              std::chrono::steady_clock::now() - start;
+
+          std::cout << size.name << " " << FormatName(format) << " " << kernels->name << " "
+                    << converter.GetThreadCount() << " threads: " << elapsed.count() / ITERATIONS
+                    << " ms per frame" << std::endl;
+        }
+      }
+    }
+  }
+}
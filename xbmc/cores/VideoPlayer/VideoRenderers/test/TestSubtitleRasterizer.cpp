@@ -0,0 +1,206 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "cores/VideoPlayer/VideoRenderers/SubtitleRasterizer.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace OVERLAY;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr double FRAME_TIME = DVD_TIME_BASE / 25;
+
+// Shows one line per second, numbered from the second it starts at, plus
+// the revision of the track
+class CTestTrack
+{
+public:
+  CSubtitleRasterizer::RevisionFunc Revision()
+  {
+    return [this] { return m_revision.load(); };
+  }
+
+  CSubtitleRasterizer::RasterizeFunc Source()
+  {
+    return [this](double pts, bool updateStyle, SQuads& quads)
+    {
+      m_calls++;
+      if (updateStyle)
+        m_styleUpdates++;
+
+      const int line = static_cast<int>(pts / DVD_TIME_BASE);
+      if (line % 2 == 1)
+        return;
+
+      quads.size_x = 16;
+      quads.size_y = 8;
+      quads.texture.assign(16 * 8, static_cast<uint8_t>(line));
+      quads.quad.push_back({0, 0, 255, 255, 255, 255, line, static_cast<int>(m_revision), 16, 8});
+    };
+  }
+
+  std::atomic<unsigned int> m_revision{0};
+  std::atomic<int> m_calls{0};
+  std::atomic<int> m_styleUpdates{0};
+};
+
+int LineOf(const SRasterizedSubtitle& subtitle)
+{
+  return subtitle.IsEmpty() ? -1 : subtitle.quads.quad[0].x;
+}
+
+// Wait until the rasterizer thread has covered the lookahead
+void WaitUntilIdle(const CSubtitleRasterizer& rasterizer)
+{
+  unsigned int rasterized = rasterizer.GetStats().rasterized;
+  for (int i = 0; i < 100; i++)
+  {
+    std::this_thread::sleep_for(20ms);
+    const unsigned int next = rasterizer.GetStats().rasterized;
+    if (next == rasterized)
+      break;
+    rasterized = next;
+  }
+}
+} // namespace
+
+TEST(TestSubtitleRasterizer, NoSource)
+{
+  CTestTrack track;
+  CSubtitleRasterizer rasterizer(track.Revision());
+  EXPECT_EQ(rasterizer.Get(0.0), nullptr);
+}
+
+TEST(TestSubtitleRasterizer, SharesUnchangedFrames)
+{
+  CTestTrack track;
+  CSubtitleRasterizer rasterizer(track.Revision());
+  rasterizer.SetSource(track.Source(), false);
+
+  std::set<unsigned int> ids;
+  for (int frame = 0; frame < 75; frame++)
+  {
+    const double pts = frame * FRAME_TIME;
+    const auto subtitle = rasterizer.Get(pts);
+    ASSERT_NE(subtitle, nullptr);
+
+    const int line = static_cast<int>(pts / DVD_TIME_BASE);
+    EXPECT_EQ(LineOf(*subtitle), line % 2 == 1 ? -1 : line) << "at frame " << frame;
+    ids.insert(subtitle->id);
+  }
+
+  // One bitmap for each second of frames
+  EXPECT_EQ(ids.size(), 3u);
+}
+
+TEST(TestSubtitleRasterizer, RasterizesAhead)
+{
+  CTestTrack track;
+  CSubtitleRasterizer rasterizer(track.Revision(), DVD_TIME_BASE);
+  rasterizer.SetSource(track.Source(), false);
+
+  ASSERT_NE(rasterizer.Get(0.0), nullptr);
+  WaitUntilIdle(rasterizer);
+
+  // The thread stops at the lookahead
+  const int calls = track.m_calls;
+  EXPECT_GE(calls, 25);
+  EXPECT_LE(calls, 27);
+
+  for (int frame = 1; frame < 25; frame++)
+    EXPECT_EQ(LineOf(*rasterizer.Get(frame * FRAME_TIME)), 0);
+
+  const SubtitleRasterizerStats stats = rasterizer.GetStats();
+  EXPECT_EQ(stats.lookups, 25u);
+  EXPECT_EQ(stats.hits, 24u);
+  // The first line, and the empty frame at the end of the lookahead
+  EXPECT_EQ(stats.entries, 2u);
+  EXPECT_EQ(stats.bytes, 16u * 8 + sizeof(SQuad));
+}
+
+TEST(TestSubtitleRasterizer, MissAfterSeek)
+{
+  CTestTrack track;
+  CSubtitleRasterizer rasterizer(track.Revision());
+  rasterizer.SetSource(track.Source(), false);
+  rasterizer.Get(0.0);
+
+  // Rasterized on the calling thread
+  const auto subtitle = rasterizer.Get(10 * DVD_TIME_BASE);
+  ASSERT_NE(subtitle, nullptr);
+  EXPECT_EQ(LineOf(*subtitle), 10);
+
+  // Back to a frame that is still cached
+  WaitUntilIdle(rasterizer);
+  const unsigned int hits = rasterizer.GetStats().hits;
+  EXPECT_EQ(LineOf(*rasterizer.Get(0.0)), 0);
+  EXPECT_EQ(rasterizer.GetStats().hits, hits + 1);
+}
+
+TEST(TestSubtitleRasterizer, RevisionDropsCache)
+{
+  CTestTrack track;
+  CSubtitleRasterizer rasterizer(track.Revision());
+  rasterizer.SetSource(track.Source(), false);
+
+  const auto before = rasterizer.Get(0.0);
+  WaitUntilIdle(rasterizer);
+
+  // Events were added to the track
+  track.m_revision++;
+  const auto after = rasterizer.Get(0.0);
+  ASSERT_NE(after, nullptr);
+  EXPECT_NE(after->id, before->id);
+  EXPECT_EQ(after->quads.quad[0].y, 1);
+}
+
+TEST(TestSubtitleRasterizer, SetSourceAppliesStyleOnce)
+{
+  CTestTrack track;
+  CSubtitleRasterizer rasterizer(track.Revision());
+  rasterizer.SetSource(track.Source(), true);
+
+  const auto before = rasterizer.Get(0.0);
+  WaitUntilIdle(rasterizer);
+  EXPECT_EQ(track.m_styleUpdates, 1);
+
+  rasterizer.SetSource(track.Source(), true);
+  const auto after = rasterizer.Get(0.0);
+  WaitUntilIdle(rasterizer);
+  EXPECT_EQ(track.m_styleUpdates, 2);
+  EXPECT_NE(after->id, before->id);
+}
+
+TEST(TestSubtitleRasterizer, BoundedByBytes)
+{
+  CTestTrack track;
+  const size_t entryBytes = 16 * 8 + sizeof(SQuad);
+  CSubtitleRasterizer rasterizer(track.Revision(), DVD_TIME_BASE, 3 * entryBytes);
+  rasterizer.SetSource(track.Source(), false);
+
+  for (int second = 0; second < 20; second += 2)
+  {
+    rasterizer.Get(second * DVD_TIME_BASE);
+    const SubtitleRasterizerStats stats = rasterizer.GetStats();
+    EXPECT_LE(stats.bytes, 3 * entryBytes);
+  }
+
+  // The least recently used lines were evicted
+  WaitUntilIdle(rasterizer);
+  const unsigned int rasterized = rasterizer.GetStats().rasterized;
+  EXPECT_EQ(LineOf(*rasterizer.Get(0.0)), 0);
+  EXPECT_GT(rasterizer.GetStats().rasterized, rasterized);
+}
@@ -9,6 +9,7 @@
 #include "RendererSoftware.h"
 
 #include "DVDCodecs/Video/DVDVideoCodec.h"
+#include "VideoRenderers/SliceConverter.h"
 #include "rendering/dx/DeviceResources.h"
 #include "rendering/dx/RenderContext.h"
 #include "utils/log.h"
@@ -97,6 +98,39 @@ void CRendererSoftware::RenderImpl(CD3DTexture& target, CRect& sourceRect, CPoin
                                       ? AV_PIX_FMT_X2BGR10LE
                                       : AV_PIX_FMT_BGRA;
 
+  uint8_t* src[YuvImage::MAX_PLANES];
+  int srcStride[YuvImage::MAX_PLANES];
+  buf->GetDataPlanes(src, srcStride);
+
+  // Common 8 and 10 bit 4:2:0 formats are converted on all cores, with linear
+  // chroma interpolation. Everything else is left to swscale.
+  if (dstFormat == AV_PIX_FMT_BGRA && CSliceConverter::Supports(buf->av_format))
+  {
+    if (!m_sliceConverter)
+      m_sliceConverter = std::make_unique<CSliceConverter>();
+
+    if (m_sliceConverter->Configure(buf->av_format, buf->GetWidth(), buf->GetHeight(),
+                                    buf->color_space, buf->full_range))
+    {
+      D3D11_MAPPED_SUBRESOURCE mapping;
+      if (target.LockRect(0, &mapping, D3D11_MAP_WRITE_DISCARD))
+      {
+        m_sliceConverter->Convert(src, srcStride, static_cast<uint8_t*>(mapping.pData),
+                                  static_cast<int>(mapping.RowPitch),
+                                  std::min(target.GetHeight(), buf->GetHeight()));
+
+        if (!target.UnlockRect(0))
+          CLog::LogF(LOGERROR, "failed to unlock swtarget texture.");
+      }
+      else
+        CLog::LogF(LOGERROR, "failed to lock swtarget texture into memory.");
+
+      // rotate initial rect
+      ReorderDrawPoints(CRect(destPoints[0], destPoints[2]), destPoints);
+      return;
+    }
+  }
+
   const int swsFlags = SWS_BILINEAR | SWS_FULL_CHR_H_INT | SWS_PRINT_INFO;
 
   // Known chroma interpolation problems of libswscale as of 7.1.100 / ffmpeg 6.0.1:
@@ -134,10 +168,6 @@ void CRendererSoftware::RenderImpl(CD3DTexture& target, CRect& sourceRect, CPoin
     sws_getCoefficients(AVCOL_SPC_BT709),  buf->full_range,
     0, 1 << 16, 1 << 16);
 
-  uint8_t* src[YuvImage::MAX_PLANES];
-  int srcStride[YuvImage::MAX_PLANES];
-  buf->GetDataPlanes(src, srcStride);
-
   D3D11_MAPPED_SUBRESOURCE mapping;
   if (target.LockRect(0, &mapping, D3D11_MAP_WRITE_DISCARD))
   {
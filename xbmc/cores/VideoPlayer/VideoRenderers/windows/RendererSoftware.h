@@ -10,11 +10,15 @@
 #include "RendererBase.h"
 
 #include <map>
+#include <memory>
+
 extern "C" {
 #include <libavutil/pixfmt.h>
 #include <libswscale/swscale.h>
 }
 
+class CSliceConverter;
+
 class CRendererSoftware : public CRendererBase
 {
   class CRenderBufferImpl;
@@ -36,6 +40,7 @@ protected:
 private:
   SwsContext* m_sw_scale_ctx = nullptr;
   SwsFilter* m_srcFilter = nullptr;
+  std::unique_ptr<CSliceConverter> m_sliceConverter;
   bool m_restoreMultithreadProtectedOff = false;
 };
 
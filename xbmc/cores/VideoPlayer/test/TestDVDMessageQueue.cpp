@@ -0,0 +1,186 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::shared_ptr<CDVDMsg> MakePacket(int size, double dts)
+{
+  DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(size);
+  packet->iSize = size;
+  packet->dts = dts;
+  return std::make_shared<CDVDMsgDemuxerPacket>(packet);
+}
+
+double GetDts(const std::shared_ptr<CDVDMsg>& msg)
+{
+  EXPECT_TRUE(msg->IsType(CDVDMsg::DEMUXER_PACKET));
+  return std::static_pointer_cast<CDVDMsgDemuxerPacket>(msg)->GetPacket()->dts;
+}
+} // namespace
+
+TEST(TestDVDMessageQueue, Order)
+{
+  CDVDMessageQueue queue("test");
+  queue.Init();
+
+  // Overflow the ring, so that messages are spread over the ring and the list
+  const int count = static_cast<int>(CDVDMessageQueue::RING_SIZE) + 100;
+  for (int i = 0; i < count; i++)
+    ASSERT_EQ(queue.Put(MakePacket(10, i * 1000.0)), MSGQ_OK);
+
+  EXPECT_EQ(queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET), static_cast<unsigned>(count));
+  EXPECT_EQ(queue.GetDataSize(), count * 10);
+
+  // Messages put back and priority messages are received first
+  ASSERT_EQ(queue.PutBack(MakePacket(10, -1000.0)), MSGQ_OK);
+  ASSERT_EQ(queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_RESYNC), 1), MSGQ_OK);
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_TRUE(msg->IsType(CDVDMsg::GENERAL_RESYNC));
+
+  ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(GetDts(msg), -1000.0);
+
+  for (int i = 0; i < count; i++)
+  {
+    ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+    ASSERT_EQ(GetDts(msg), i * 1000.0);
+
+    // Keep putting while the list is being consumed
+    if (i < 10)
+      ASSERT_EQ(queue.Put(MakePacket(10, (count + i) * 1000.0)), MSGQ_OK);
+  }
+
+  for (int i = 0; i < 10; i++)
+  {
+    ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+    EXPECT_EQ(GetDts(msg), (count + i) * 1000.0);
+  }
+
+  EXPECT_EQ(queue.Get(msg, 0ms), MSGQ_TIMEOUT);
+  EXPECT_EQ(queue.GetDataSize(), 0);
+
+  queue.End();
+}
+
+TEST(TestDVDMessageQueue, Level)
+{
+  CDVDMessageQueue queue("test");
+  queue.Init();
+  queue.SetMaxDataSize(1000);
+  queue.SetMaxTimeSize(4.0);
+
+  EXPECT_EQ(queue.GetLevel(), 0);
+
+  // One second of packets
+  for (int i = 0; i <= 10; i++)
+    queue.Put(MakePacket(10, i * DVD_TIME_BASE / 10));
+
+  EXPECT_DOUBLE_EQ(queue.GetTimeSize(), 1.0);
+  EXPECT_EQ(queue.GetLevel(), 25);
+  EXPECT_EQ(queue.GetLevel(true), 11);
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+  ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_DOUBLE_EQ(queue.GetTimeSize(), 0.9);
+  EXPECT_EQ(queue.GetDataSize(), 90);
+
+  queue.End();
+}
+
+TEST(TestDVDMessageQueue, Flush)
+{
+  CDVDMessageQueue queue("test");
+  queue.Init();
+
+  queue.Put(MakePacket(10, 0.0));
+  queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_EOF));
+  queue.Put(MakePacket(10, 1000.0));
+
+  queue.Flush();
+
+  EXPECT_EQ(queue.GetDataSize(), 0);
+  EXPECT_EQ(queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET), 0u);
+
+  std::shared_ptr<CDVDMsg> msg;
+  ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_TRUE(msg->IsType(CDVDMsg::GENERAL_EOF));
+
+  // The ring keeps working after its messages were compacted
+  queue.Put(MakePacket(10, 2000.0));
+  ASSERT_EQ(queue.Get(msg, 0ms), MSGQ_OK);
+  EXPECT_EQ(GetDts(msg), 2000.0);
+
+  queue.End();
+}
+
+TEST(TestDVDMessageQueue, ProducerConsumer)
+{
+  CDVDMessageQueue queue("test");
+  queue.Init();
+
+  const int count = 100000;
+
+  std::thread producer(
+      [&queue]()
+      {
+        for (int i = 0; i < count; i++)
+        {
+          queue.Put(MakePacket(1, i));
+
+          // Let the consumer catch up and wait from time to time
+          if (i % 5000 == 0)
+            std::this_thread::sleep_for(1ms);
+        }
+      });
+
+  int received = 0;
+  std::shared_ptr<CDVDMsg> msg;
+  while (received < count && queue.Get(msg, 5s) == MSGQ_OK)
+  {
+    ASSERT_EQ(GetDts(msg), received);
+    received++;
+  }
+
+  producer.join();
+
+  EXPECT_EQ(received, count);
+  EXPECT_EQ(queue.GetDataSize(), 0);
+
+  queue.End();
+}
+
+TEST(TestDVDMessageQueue, Abort)
+{
+  CDVDMessageQueue queue("test");
+  queue.Init();
+
+  std::thread aborter(
+      [&queue]()
+      {
+        std::this_thread::sleep_for(10ms);
+        queue.Abort();
+      });
+
+  std::shared_ptr<CDVDMsg> msg;
+  EXPECT_EQ(queue.Get(msg, 5s), MSGQ_ABORT);
+
+  aborter.join();
+  queue.End();
+}
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/VideoPlayerTrace.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+size_t Count(const std::string& str, const std::string& pattern)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + pattern.size()))
+    count++;
+  return count;
+}
+} // namespace
+
+TEST(TestVideoPlayerTrace, Disabled)
+{
+  CVideoPlayerTrace::Start();
+  CVideoPlayerTrace::Stop();
+
+  {
+    CVideoPlayerTraceScope scope(TraceCategory::DECODE, "TestDisabled");
+    CVideoPlayerTrace::Instant(TraceCategory::PRESENT, "TestDisabled");
+    CVideoPlayerTrace::Counter(TraceCategory::QUEUE, "TestDisabled", 1);
+  }
+
+  EXPECT_EQ(CVideoPlayerTrace::Serialize().find("TestDisabled"), std::string::npos);
+}
+
+TEST(TestVideoPlayerTrace, Events)
+{
+  CVideoPlayerTrace::Start();
+  {
+    CVideoPlayerTraceScope scope(TraceCategory::DEMUX, "TestRead");
+    CVideoPlayerTrace::Instant(TraceCategory::PRESENT, "TestDrop");
+    CVideoPlayerTrace::Counter(TraceCategory::QUEUE, "TestLevel", 42);
+  }
+  CVideoPlayerTrace::Stop();
+
+  const std::string json = CVideoPlayerTrace::Serialize();
+  EXPECT_EQ(json.rfind(R"({"displayTimeUnit":"ms","traceEvents":[)", 0), 0u);
+  EXPECT_EQ(json.substr(json.size() - 2), "]}");
+
+  EXPECT_NE(json.find(R"({"name":"TestRead","cat":"demux","pid":1,"tid":)"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"X","dur":)"), std::string::npos);
+  EXPECT_NE(json.find(R"({"name":"TestDrop","cat":"present")"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"i","s":"t"})"), std::string::npos);
+  EXPECT_NE(json.find(R"({"name":"TestLevel","cat":"queue")"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"C","args":{"value":42}})"), std::string::npos);
+
+  // Events of before the start are dropped
+  CVideoPlayerTrace::Start();
+  CVideoPlayerTrace::Stop();
+  EXPECT_EQ(CVideoPlayerTrace::Serialize().find("TestRead"), std::string::npos);
+}
+
+TEST(TestVideoPlayerTrace, Threads)
+{
+  CVideoPlayerTrace::Start();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+    threads.emplace_back(
+        []
+        {
+          for (int event = 0; event < 100; event++)
+            CVideoPlayerTrace::Instant(TraceCategory::DECODE, "TestThreads");
+        });
+
+  // Serialize while the threads record
+  CVideoPlayerTrace::Serialize();
+
+  for (auto& thread : threads)
+    thread.join();
+  CVideoPlayerTrace::Stop();
+
+  const std::string json = CVideoPlayerTrace::Serialize();
+  EXPECT_EQ(Count(json, R"("name":"TestThreads")"), 400u);
+  EXPECT_GE(Count(json, R"("name":"thread_name")"), 4u);
+}
+
+TEST(TestVideoPlayerTrace, EndedThreads)
+{
+  CVideoPlayerTrace::Start();
+  std::thread([] { CVideoPlayerTrace::Instant(TraceCategory::DECODE, "TestEnded"); }).join();
+
+  // Rings of ended threads are kept while they have events since the start
+  EXPECT_EQ(Count(CVideoPlayerTrace::Serialize(), R"("name":"TestEnded")"), 1u);
+  std::thread([] { CVideoPlayerTrace::Instant(TraceCategory::DECODE, "TestNew"); }).join();
+  CVideoPlayerTrace::Stop();
+
+  const std::string json = CVideoPlayerTrace::Serialize();
+  EXPECT_EQ(Count(json, R"("name":"TestEnded")"), 1u);
+  EXPECT_EQ(Count(json, R"("name":"TestNew")"), 1u);
+
+  CVideoPlayerTrace::Start();
+  CVideoPlayerTrace::Stop();
+  EXPECT_EQ(CVideoPlayerTrace::Serialize().find("TestEnded"), std::string::npos);
+}
+
+TEST(TestVideoPlayerTrace, KeepsLastEvents)
+{
+  CVideoPlayerTrace::Start();
+  for (unsigned int i = 0; i < CVideoPlayerTrace::RING_SIZE; i++)
+    CVideoPlayerTrace::Instant(TraceCategory::RENDER_MANAGER, "TestFirst");
+  for (unsigned int i = 0; i < CVideoPlayerTrace::RING_SIZE / 2; i++)
+    CVideoPlayerTrace::Instant(TraceCategory::RENDER_MANAGER, "TestLast");
+  CVideoPlayerTrace::Stop();
+
+  // The oldest slot may be written to while reading, it's skipped
+  const std::string json = CVideoPlayerTrace::Serialize();
+  EXPECT_EQ(Count(json, R"("name":"TestFirst")"), CVideoPlayerTrace::RING_SIZE / 2 - 1);
+  EXPECT_EQ(Count(json, R"("name":"TestLast")"), CVideoPlayerTrace::RING_SIZE / 2);
+}
@@ -10,6 +10,7 @@
 
 #include "DatabaseManager.h"
 #include "DbUrl.h"
+#include "LangInfo.h"
 #include "ServiceBroker.h"
 #include "filesystem/SpecialProtocol.h"
 #if defined(HAS_MYSQL) || defined(HAS_MARIADB)
@@ -695,6 +696,11 @@ bool CDatabase::IsOpen() const
   return m_openCount > 0;
 }
 
+std::string CDatabase::GetDatabaseName() const
+{
+  return m_pDB ? m_pDB->getDatabase() : "";
+}
+
 void CDatabase::Close()
 {
   if (m_openCount == 0)
@@ -865,6 +871,63 @@ bool CDatabase::BuildSQL(std::string_view strQuery, const Filter& filter, std::s
   return true;
 }
 
+std::string CDatabase::GetIgnoreArticleSQL(const std::string& strField) const
+{
+  /*
+  Make SQL clause from ignore article list.
+  Group tokens the same length together, for example :
+    WHEN strArtist LIKE 'the %' OR strArtist LIKE 'the.%' OR strArtist LIKE 'the!_%' ESCAPE '!'
+    THEN SUBSTR(strArtist, 5)
+    WHEN strArtist LIKE 'an %' OR strArtist LIKE 'an.%' OR strArtist LIKE 'an!_%' ESCAPE '!'
+    THEN SUBSTR(strArtist, 4)
+  */
+  const CLangInfo::Tokens sortTokens = g_langInfo.GetSortTokens();
+  std::string sortclause;
+  size_t tokenlength = 0;
+  std::string strWhen;
+  for (const auto& token : sortTokens)
+  {
+    if (token.length() != tokenlength)
+    {
+      if (!strWhen.empty())
+      {
+        if (!sortclause.empty())
+          sortclause += " ";
+        std::string strThen = PrepareSQL(" THEN SUBSTR(%s, %i)", strField.c_str(), tokenlength + 1);
+        sortclause += "WHEN " + strWhen + strThen;
+        strWhen.clear();
+      }
+      tokenlength = token.length();
+    }
+    std::string tokenclause = token;
+    //Escape any ' or % in the token
+    StringUtils::Replace(tokenclause, "'", "''");
+    StringUtils::Replace(tokenclause, "%", "%%");
+    // Match a _ separator literally rather than as any character
+    const bool escape = tokenclause.find_first_of("_!") != std::string::npos;
+    if (escape)
+    {
+      StringUtils::Replace(tokenclause, "!", "!!");
+      StringUtils::Replace(tokenclause, "_", "!_");
+    }
+    // Single %, _ and ' so avoid using PrepareSQL
+    tokenclause = strField + " LIKE '" + tokenclause + "%'";
+    if (escape)
+      tokenclause += " ESCAPE '!'";
+    if (!strWhen.empty())
+      strWhen += " OR ";
+    strWhen += tokenclause;
+  }
+  if (!strWhen.empty())
+  {
+    if (!sortclause.empty())
+      sortclause += " ";
+    std::string strThen = PrepareSQL(" THEN SUBSTR(%s, %i)", strField.c_str(), tokenlength + 1);
+    sortclause += "WHEN " + strWhen + strThen;
+  }
+  return sortclause;
+}
+
 bool CDatabase::BuildSQL(const std::string& strBaseDir,
                          const std::string& strQuery,
                          Filter& filter,
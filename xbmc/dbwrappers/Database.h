@@ -105,6 +105,9 @@ public:
 
   const std::string& GetType() const { return m_type; }
 
+  //! The name of the open database, which is versioned and may differ between profiles
+  std::string GetDatabaseName() const;
+
   bool Compress(bool bForce = true);
   void Interrupt();
 
@@ -310,6 +313,12 @@ protected:
 
   bool BuildSQL(std::string_view strQuery, const Filter& filter, std::string& strSQL) const;
 
+  /*! \brief Build SQL  for sort subquery from ignore article token list
+  \param strField original name or title field that articles could be removed from
+  \return SQL string e.g.  WHEN strField LIKE 'the_' ESCAPE '_' THEN SUBSTR(strArtist, 5)
+  */
+  std::string GetIgnoreArticleSQL(const std::string& strField) const;
+
   bool m_sqlite{true}; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
@@ -87,6 +87,119 @@ void Database::EscapeStringConversions(std::string& format)
   }
 }
 
+std::shared_ptr<Statement> Database::prepareStatement(const std::string& sql)
+{
+  std::shared_ptr<Statement> statement;
+  if (const auto it = statement_index.find(sql); it != statement_index.end())
+  {
+    statements.splice(statements.begin(), statements, it->second);
+    statement = it->second->second;
+
+    // Held by the cache, here and by the caller that still reads its rows
+    if (statement.use_count() > 2)
+      statement = createStatement(sql);
+  }
+  else
+  {
+    statement = createStatement(sql);
+    statements.emplace_front(sql, statement);
+    statement_index.emplace(statements.front().first, statements.begin());
+
+    if (statements.size() > STATEMENT_CACHE_SIZE)
+    {
+      statement_index.erase(statements.back().first);
+      statements.pop_back();
+    }
+  }
+
+  // Reset on release so that no read is left open, the cache may have dropped it by then
+  return {statement.get(), [statement](Statement* released) { released->reset(); }};
+}
+
+std::unique_ptr<Statement> Database::prepareUncachedStatement(const std::string& sql)
+{
+  return createStatement(sql);
+}
+
+std::unique_ptr<Statement> Database::createStatement(const std::string& sql)
+{
+  throw DbErrors("Prepared statements are not supported: %s", sql.c_str());
+}
+
+void Database::clearStatements()
+{
+  statement_index.clear();
+  statements.clear();
+}
+
+//************* field_view implementation ***************
+
+bool field_view::get_isNull() const
+{
+  return m_statement.isNull(m_column);
+}
+
+std::string field_view::get_asString() const
+{
+  switch (m_statement.getType(m_column))
+  {
+    using enum fType;
+    case ft_Int:
+    case ft_Int64:
+      return std::to_string(m_statement.getInt64(m_column));
+    case ft_Double:
+      return std::to_string(m_statement.getDouble(m_column));
+    default:
+      return std::string(m_statement.getStringView(m_column));
+  }
+}
+
+std::string_view field_view::get_asStringView() const
+{
+  return m_statement.getStringView(m_column);
+}
+
+bool field_view::get_asBool() const
+{
+  switch (m_statement.getType(m_column))
+  {
+    using enum fType;
+    case ft_String:
+    {
+      const std::string_view value = m_statement.getStringView(m_column);
+      return value == "True" || value == "true" || value == "1";
+    }
+    case ft_Double:
+      return static_cast<bool>(m_statement.getDouble(m_column));
+    default:
+      return static_cast<bool>(m_statement.getInt64(m_column));
+  }
+}
+
+int field_view::get_asInt() const
+{
+  if (m_statement.getType(m_column) == fType::ft_Double)
+    return static_cast<int>(m_statement.getDouble(m_column));
+  return static_cast<int>(m_statement.getInt64(m_column));
+}
+
+float field_view::get_asFloat() const
+{
+  return static_cast<float>(m_statement.getDouble(m_column));
+}
+
+double field_view::get_asDouble() const
+{
+  return m_statement.getDouble(m_column);
+}
+
+int64_t field_view::get_asInt64() const
+{
+  if (m_statement.getType(m_column) == fType::ft_Double)
+    return static_cast<int64_t>(m_statement.getDouble(m_column));
+  return m_statement.getInt64(m_column);
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset() = default;
@@ -42,6 +42,73 @@ constexpr int DB_BAD_RESPONSE = 6;
 constexpr int DB_UNEXPECTED = 7; // This shouldn't ever happen
 constexpr int DB_UNEXPECTED_RESULT = -1; //For integer functions
 
+class Statement;
+
+/******************* Class field_view definition ******************
+
+   a column of the current row of a statement, converted as
+   field_value does without copying the row
+
+******************************************************************/
+class field_view
+{
+public:
+  field_view(const Statement& statement, int column) : m_statement(statement), m_column(column) {}
+
+  bool get_isNull() const;
+  std::string get_asString() const;
+  /* valid until the statement steps to the next row */
+  std::string_view get_asStringView() const;
+  bool get_asBool() const;
+  int get_asInt() const;
+  float get_asFloat() const;
+  double get_asDouble() const;
+  int64_t get_asInt64() const;
+
+private:
+  const Statement& m_statement;
+  const int m_column;
+};
+
+/******************* Class Statement definition *******************
+
+   a prepared statement, see Database::prepareStatement()
+
+******************************************************************/
+class Statement
+{
+public:
+  virtual ~Statement() = default;
+
+  /* bind a value to the parameter at index, starting with 1 */
+  virtual void bindInt64(int index, int64_t value) = 0;
+  virtual void bindDouble(int index, double value) = 0;
+  /* the value is copied */
+  virtual void bindString(int index, std::string_view value) = 0;
+  virtual void bindNull(int index) = 0;
+
+  /*! \brief Execute the statement on the first call, go to the next row after
+   \return false after the last row
+   */
+  virtual bool step() = 0;
+  /* ready the statement for another execution, the bound values are cleared */
+  virtual void reset() = 0;
+
+  /* the columns of the current row, starting with 0 */
+  virtual int columnCount() const = 0;
+  virtual std::string_view columnName(int column) const = 0;
+  /* the type field_value has for the column in a Dataset */
+  virtual fType getType(int column) const = 0;
+  virtual bool isNull(int column) const = 0;
+  virtual int64_t getInt64(int column) const = 0;
+  virtual double getDouble(int column) const = 0;
+  /* valid until the statement steps to the next row */
+  virtual std::string_view getStringView(int column) const = 0;
+
+  /* the current row reads as a sql_record does, record->at(column).get_asInt() */
+  field_view at(int column) const { return {*this, column}; }
+};
+
 /******************* Class Database definition ********************
 
    represents  connection with database server;
@@ -174,6 +241,26 @@ public:
 
   virtual bool in_transaction() { return false; }
 
+  /* methods for prepared statements */
+
+  /*! \brief Get a prepared statement from the statement cache of the connection.
+   The statement is reset when released, it must not be used after the connection is closed.
+   A statement that is in use is prepared again, uncached.
+   \param sql - SQL statement with "?" as the placeholders of the parameters to bind
+   \return prepared statement, throws DbErrors when it can't be prepared
+   */
+  std::shared_ptr<Statement> prepareStatement(const std::string& sql);
+
+  /*! \brief Prepare a statement outside of the statement cache, for statements run only once.
+   Ad-hoc queries would otherwise evict the statements that are reused.
+   \param sql - SQL statement with "?" as the placeholders of the parameters to bind
+   \return prepared statement, finalized when destroyed, throws DbErrors when it can't be prepared
+   */
+  std::unique_ptr<Statement> prepareUncachedStatement(const std::string& sql);
+
+  /* number of statements kept prepared per connection */
+  static constexpr size_t STATEMENT_CACHE_SIZE = 64;
+
 protected:
   /*! \brief Rewrite each "%s" conversion sequence to "%q", the quote-escaping form.
    \param format - C printf compliant format string, rewritten in place
@@ -181,6 +268,16 @@ protected:
    Scanning is left to right so that %% is consumed as the literal percent it is.
    */
   static void EscapeStringConversions(std::string& format);
+
+  /* prepares a statement for prepareStatement(), throws DbErrors on failure */
+  virtual std::unique_ptr<Statement> createStatement(const std::string& sql);
+  /* drops the cached statements, before the connection is closed */
+  void clearStatements();
+
+private:
+  /* most recently used first */
+  std::list<std::pair<std::string, std::shared_ptr<Statement>>> statements;
+  std::unordered_map<std::string_view, decltype(statements)::iterator> statement_index;
 };
 
 /******************* Class Dataset definition *********************
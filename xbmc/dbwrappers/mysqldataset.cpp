@@ -22,6 +22,7 @@
 #include <charconv>
 #include <chrono>
 #include <cstdlib>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -374,6 +375,7 @@ int MysqlDatabase::connect(bool create_new)
 
 void MysqlDatabase::disconnect()
 {
+  clearStatements();
   if (conn)
   {
     mysql_close(conn);
@@ -1792,6 +1794,184 @@ size_t ci_find(std::string_view where, std::string_view what)
     return std::distance(where.cbegin(), found.begin());
 }
 
+/*!
+ * \brief A statement of the text protocol. The values are bound as escaped
+ *        literals, the rows are read in place from the stored result.
+ */
+class MysqlStatement : public dbiplus::Statement
+{
+public:
+  MysqlStatement(dbiplus::MysqlDatabase& db, std::string sql) : m_db(db)
+  {
+    // mysql doesn't understand CAST(foo as integer) => change to CAST(foo as signed integer)
+    size_t loc;
+    while ((loc = ci_find(sql, "as integer)")) != std::string::npos)
+      sql.insert(loc + 3, "signed ");
+
+    // Split at the placeholders that are not quoted
+    char quote = 0;
+    size_t begin = 0;
+    for (size_t i = 0; i < sql.size(); i++)
+    {
+      const char c = sql[i];
+      if (quote)
+      {
+        if (c == '\\')
+          i++;
+        else if (c == quote)
+          quote = 0;
+      }
+      else if (c == '\'' || c == '"' || c == '`')
+        quote = c;
+      else if (c == '?')
+      {
+        m_parts.emplace_back(sql, begin, i - begin);
+        begin = i + 1;
+      }
+    }
+    m_parts.emplace_back(sql, begin);
+    m_values.assign(m_parts.size() - 1, "NULL");
+  }
+
+  ~MysqlStatement() override { FreeResult(); }
+
+  void bindInt64(int index, int64_t value) override { Bind(index, std::to_string(value)); }
+
+  void bindDouble(int index, double value) override
+  {
+    Bind(index, StringUtils::Format("{}", value));
+  }
+
+  void bindString(int index, std::string_view value) override
+  {
+    MYSQL* conn = m_db.getHandle();
+    if (!conn)
+      throw dbiplus::DbErrors("No Database Connection");
+
+    std::string escaped(value.size() * 2 + 1, '\0');
+    escaped.resize(mysql_real_escape_string(conn, escaped.data(), value.data(),
+                                            static_cast<unsigned long>(value.size())));
+    Bind(index, "'" + escaped + "'");
+  }
+
+  void bindNull(int index) override { Bind(index, "NULL"); }
+
+  bool step() override
+  {
+    if (!m_executed)
+    {
+      std::string query = m_parts.front();
+      for (size_t i = 0; i < m_values.size(); i++)
+      {
+        query += m_values[i];
+        query += m_parts[i + 1];
+      }
+
+      if (m_db.setErr(m_db.query_with_reconnect(query), query.c_str()) != MYSQL_OK)
+        throw dbiplus::DbErrors("%s", m_db.getErrorMsg());
+      m_executed = true;
+
+      // Stored, so that other queries can run while the rows are read
+      m_result = mysql_store_result(m_db.getHandle());
+      if (!m_result)
+      {
+        if (mysql_field_count(m_db.getHandle()) != 0)
+          throw dbiplus::DbErrors("Missing result set!");
+        return false;
+      }
+      m_fields = mysql_fetch_fields(m_result);
+    }
+
+    if (!m_result || !(m_row = mysql_fetch_row(m_result)))
+      return false;
+
+    m_lengths = mysql_fetch_lengths(m_result);
+    return true;
+  }
+
+  void reset() override
+  {
+    FreeResult();
+    m_values.assign(m_values.size(), "NULL");
+  }
+
+  int columnCount() const override
+  {
+    return m_result ? static_cast<int>(mysql_num_fields(m_result)) : 0;
+  }
+
+  std::string_view columnName(int column) const override { return m_fields[column].name; }
+
+  dbiplus::fType getType(int column) const override
+  {
+    switch (m_fields[column].type)
+    {
+      using enum dbiplus::fType;
+      case MYSQL_TYPE_LONGLONG:
+        return ft_Int64;
+      case MYSQL_TYPE_DECIMAL:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+        return ft_Int;
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+        return ft_Double;
+      default:
+        return ft_String;
+    }
+  }
+
+  bool isNull(int column) const override { return !m_row[column]; }
+
+  int64_t getInt64(int column) const override
+  {
+    return m_row[column] ? strtoll(m_row[column], nullptr, 10) : 0;
+  }
+
+  double getDouble(int column) const override
+  {
+    return m_row[column] ? atof(m_row[column]) : 0.0;
+  }
+
+  std::string_view getStringView(int column) const override
+  {
+    if (!m_row[column])
+      return {};
+    return {m_row[column], m_lengths[column]};
+  }
+
+private:
+  void Bind(int index, std::string value)
+  {
+    if (index < 1 || static_cast<size_t>(index) > m_values.size())
+      throw dbiplus::DbErrors("Bind index %d out of range: %s", index, m_parts.front().c_str());
+    m_values[index - 1] = std::move(value);
+  }
+
+  void FreeResult()
+  {
+    if (m_result)
+      mysql_free_result(m_result);
+    m_result = nullptr;
+    m_fields = nullptr;
+    m_row = nullptr;
+    m_lengths = nullptr;
+    m_executed = false;
+  }
+
+  dbiplus::MysqlDatabase& m_db;
+  std::vector<std::string> m_parts;
+  std::vector<std::string> m_values;
+  bool m_executed{false};
+  MYSQL_RES* m_result{nullptr};
+  MYSQL_FIELD* m_fields{nullptr};
+  MYSQL_ROW m_row{nullptr};
+  unsigned long* m_lengths{nullptr};
+};
+
 } // unnamed namespace
 
 //************* MysqlDataset implementation ***************
@@ -1808,6 +1988,14 @@ std::string MysqlDatabase::mysql_vmprintf(const char* zFormat, va_list ap)
   return acc.Finish();
 }
 
+std::unique_ptr<Statement> MysqlDatabase::createStatement(const std::string& sql)
+{
+  if (!active || !conn)
+    throw DbErrors("No Database Connection");
+
+  return std::make_unique<MysqlStatement>(*this, sql);
+}
+
 MysqlDataset::~MysqlDataset() = default;
 
 void MysqlDataset::set_autorefresh(bool val)
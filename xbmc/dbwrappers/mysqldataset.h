@@ -79,6 +79,9 @@ public:
   int query_with_reconnect(std::string_view query);
   void configure_connection();
 
+protected:
+  std::unique_ptr<Statement> createStatement(const std::string& sql) override;
+
 private:
   char et_getdigit(double* val, int* cnt) const;
   std::string mysql_vmprintf(const char* zFormat, va_list ap);
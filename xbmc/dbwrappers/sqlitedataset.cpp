@@ -207,6 +207,95 @@ int busy_callback(void*, int /*busyCount*/)
   KODI::TIME::Sleep(100ms);
   return 1;
 }
+
+class SqliteStatement : public dbiplus::Statement
+{
+public:
+  SqliteStatement(dbiplus::SqliteDatabase& db, sqlite3_stmt* stmt) : m_db(db), m_stmt(stmt) {}
+  ~SqliteStatement() override { sqlite3_finalize(m_stmt); }
+
+  void bindInt64(int index, int64_t value) override
+  {
+    Check(sqlite3_bind_int64(m_stmt, index, value));
+  }
+
+  void bindDouble(int index, double value) override
+  {
+    Check(sqlite3_bind_double(m_stmt, index, value));
+  }
+
+  void bindString(int index, std::string_view value) override
+  {
+    Check(sqlite3_bind_text(m_stmt, index, value.data(), static_cast<int>(value.size()),
+                            SQLITE_TRANSIENT));
+  }
+
+  void bindNull(int index) override { Check(sqlite3_bind_null(m_stmt, index)); }
+
+  bool step() override
+  {
+    const int result = sqlite3_step(m_stmt);
+    if (result == SQLITE_ROW)
+      return true;
+    if (result != SQLITE_DONE)
+      Check(result);
+    return false;
+  }
+
+  void reset() override
+  {
+    sqlite3_reset(m_stmt);
+    sqlite3_clear_bindings(m_stmt);
+  }
+
+  int columnCount() const override { return sqlite3_column_count(m_stmt); }
+
+  std::string_view columnName(int column) const override
+  {
+    return sqlite3_column_name(m_stmt, column);
+  }
+
+  dbiplus::fType getType(int column) const override
+  {
+    switch (sqlite3_column_type(m_stmt, column))
+    {
+      using enum dbiplus::fType;
+      case SQLITE_INTEGER:
+        return ft_Int64;
+      case SQLITE_FLOAT:
+        return ft_Double;
+      default:
+        return ft_String;
+    }
+  }
+
+  bool isNull(int column) const override
+  {
+    return sqlite3_column_type(m_stmt, column) == SQLITE_NULL;
+  }
+
+  int64_t getInt64(int column) const override { return sqlite3_column_int64(m_stmt, column); }
+
+  double getDouble(int column) const override { return sqlite3_column_double(m_stmt, column); }
+
+  std::string_view getStringView(int column) const override
+  {
+    const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(m_stmt, column));
+    if (!text)
+      return {};
+    return {text, static_cast<size_t>(sqlite3_column_bytes(m_stmt, column))};
+  }
+
+private:
+  void Check(int result) const
+  {
+    if (m_db.setErr(result, sqlite3_sql(m_stmt)) != SQLITE_OK)
+      throw dbiplus::DbErrors("%s", m_db.getErrorMsg());
+  }
+
+  dbiplus::SqliteDatabase& m_db;
+  sqlite3_stmt* const m_stmt;
+};
 } // unnamed namespace
 
 namespace dbiplus
@@ -407,7 +496,9 @@ void SqliteDatabase::disconnect()
 {
   if (!active)
     return;
-  sqlite3_close(conn);
+  clearStatements();
+  // Closed once the statements that are still held are finalized
+  sqlite3_close_v2(conn);
   active = false;
   conn = nullptr; // Reset handle to avoid stale pointer usage after database is closed
 }
@@ -591,6 +682,19 @@ long SqliteDatabase::nextid(const char* sname)
 
 // methods for transactions
 // ---------------------------------------------
+std::unique_ptr<Statement> SqliteDatabase::createStatement(const std::string& sql)
+{
+  if (!active)
+    throw DbErrors("No Database Connection");
+
+  sqlite3_stmt* stmt = nullptr;
+  if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), static_cast<int>(sql.size()), &stmt, nullptr),
+             sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", getErrorMsg());
+
+  return std::make_unique<SqliteStatement>(*this, stmt);
+}
+
 void SqliteDatabase::start_transaction()
 {
   if (active)
@@ -943,61 +1047,52 @@ bool SqliteDataset::query(const std::string& query)
 
   close();
 
-  sqlite3_stmt* stmt = nullptr;
-  if (db->setErr(sqlite3_prepare_v2(handle(), query.c_str(), -1, &stmt, nullptr), query.c_str()) !=
-      SQLITE_OK)
-    throw DbErrors("%s", db->getErrorMsg());
+  // Generic queries are mostly run once, keep them out of the statement cache
+  const auto stmt = db->prepareUncachedStatement(query);
+  bool hasRow = stmt->step();
 
   // column headers
-  const unsigned int numColumns = sqlite3_column_count(stmt);
+  const unsigned int numColumns = stmt->columnCount();
   result.record_header.resize(numColumns);
   for (unsigned int i = 0; i < numColumns; i++)
-    result.record_header[i].name = sqlite3_column_name(stmt, i);
+    result.record_header[i].name = stmt->columnName(i);
 
   // returned rows
-  while (sqlite3_step(stmt) == SQLITE_ROW)
+  for (; hasRow; hasRow = stmt->step())
   { // have a row of data
     auto* res = new sql_record;
     res->resize(numColumns);
     for (unsigned int i = 0; i < numColumns; i++)
     {
       field_value& v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
+      if (stmt->isNull(i))
       {
-        case SQLITE_INTEGER:
-          v.set_asInt64(sqlite3_column_int64(stmt, i));
-          break;
-        case SQLITE_FLOAT:
-          v.set_asDouble(sqlite3_column_double(stmt, i));
-          break;
-        case SQLITE_TEXT:
-          v.set_asString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)),
-                         sqlite3_column_bytes(stmt, i));
+        v.set_asString("", 0);
+        v.set_isNull();
+        continue;
+      }
+
+      switch (stmt->getType(i))
+      {
+        using enum fType;
+        case ft_Int64:
+          v.set_asInt64(stmt->getInt64(i));
           break;
-        case SQLITE_BLOB:
-          v.set_asString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)),
-                         sqlite3_column_bytes(stmt, i));
+        case ft_Double:
+          v.set_asDouble(stmt->getDouble(i));
           break;
-        case SQLITE_NULL:
         default:
-          v.set_asString("", 0);
-          v.set_isNull();
+          v.set_asString(stmt->getStringView(i));
           break;
       }
     }
     result.records.push_back(res);
   }
-  if (db->setErr(sqlite3_finalize(stmt), query.c_str()) == SQLITE_OK)
-  {
-    active = true;
-    ds_state = dsSelect;
-    this->first();
-    return true;
-  }
-  else
-  {
-    throw DbErrors("%s", db->getErrorMsg());
-  }
+
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
 }
 
 void SqliteDataset::open(const std::string& sql)
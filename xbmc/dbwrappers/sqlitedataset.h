@@ -81,6 +81,9 @@ public:
   std::string vprepare(std::string_view format, va_list args) override;
 
   bool in_transaction() override { return _in_transaction; }
+
+protected:
+  std::unique_ptr<Statement> createStatement(const std::string& sql) override;
 };
 
 /***************** Class SqliteDataset definition *******************
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/sqlitedataset.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class CTestDatabase : public dbiplus::SqliteDatabase
+{
+public:
+  int m_prepared{0};
+
+protected:
+  std::unique_ptr<dbiplus::Statement> createStatement(const std::string& sql) override
+  {
+    m_prepared++;
+    return SqliteDatabase::createStatement(sql);
+  }
+};
+
+class TestStatement : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_path = std::filesystem::temp_directory_path() /
+             (std::string("kodi-") +
+              testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::create_directories(m_path);
+
+    m_db.setHostName(m_path.string().c_str());
+    m_db.setDatabase("test");
+    ASSERT_EQ(m_db.connect(true), static_cast<int>(dbiplus::DB_CONNECTION_OK));
+    m_ds.reset(m_db.CreateDataset());
+
+    m_ds->exec("CREATE TABLE movie (idMovie INTEGER PRIMARY KEY, title TEXT, rating REAL, "
+               "playCount INTEGER, watched TEXT)");
+  }
+
+  void TearDown() override
+  {
+    m_ds.reset();
+    m_db.disconnect();
+    std::filesystem::remove_all(m_path);
+  }
+
+  void AddMovies(int count)
+  {
+    m_db.start_transaction();
+    for (int i = 1; i <= count; i++)
+      m_ds->exec(m_db.prepare("INSERT INTO movie VALUES (%i, 'Movie %i', %f, %i, '%s')", i, i,
+                              i / 2.0, i % 3, i % 2 ? "true" : "false"));
+    m_db.commit_transaction();
+  }
+
+  std::filesystem::path m_path;
+  CTestDatabase m_db;
+  std::unique_ptr<dbiplus::Dataset> m_ds;
+};
+} // namespace
+
+TEST_F(TestStatement, BindAndRead)
+{
+  AddMovies(10);
+  m_ds->exec("INSERT INTO movie (idMovie, title) VALUES (11, NULL)");
+
+  const auto statement =
+      m_db.prepareStatement("SELECT idMovie, title, rating, playCount FROM movie "
+                            "WHERE playCount = ? AND title LIKE ? ORDER BY idMovie");
+  statement->bindInt64(1, 2);
+  statement->bindString(2, "Movie %");
+
+  ASSERT_TRUE(statement->step());
+  EXPECT_EQ(statement->columnCount(), 4);
+  EXPECT_EQ(statement->columnName(1), "title");
+  EXPECT_EQ(statement->getInt64(0), 2);
+  EXPECT_EQ(statement->getStringView(1), "Movie 2");
+  EXPECT_EQ(statement->getDouble(2), 1.0);
+  EXPECT_EQ(statement->getType(0), dbiplus::fType::ft_Int64);
+  EXPECT_EQ(statement->getType(1), dbiplus::fType::ft_String);
+
+  ASSERT_TRUE(statement->step());
+  EXPECT_EQ(statement->at(0).get_asInt(), 5);
+  EXPECT_EQ(statement->at(1).get_asString(), "Movie 5");
+  EXPECT_FLOAT_EQ(statement->at(2).get_asFloat(), 2.5f);
+
+  ASSERT_TRUE(statement->step());
+  EXPECT_EQ(statement->at(0).get_asInt(), 8);
+  EXPECT_FALSE(statement->step());
+
+  statement->reset();
+  EXPECT_THROW(statement->bindInt64(3, 1), dbiplus::DbErrors);
+  EXPECT_THROW(m_db.prepareStatement("SELECT nothing FROM movie"), dbiplus::DbErrors);
+
+  const auto nulls = m_db.prepareStatement("SELECT title FROM movie WHERE idMovie = 11");
+  ASSERT_TRUE(nulls->step());
+  EXPECT_TRUE(nulls->isNull(0));
+  EXPECT_TRUE(nulls->getStringView(0).empty());
+  EXPECT_EQ(nulls->at(0).get_asInt(), 0);
+}
+
+TEST_F(TestStatement, ReadsAsDataset)
+{
+  AddMovies(20);
+  m_ds->exec("INSERT INTO movie (idMovie) VALUES (21)");
+
+  const std::string sql = "SELECT *, rating * 2, idMovie = 3 FROM movie";
+  ASSERT_TRUE(m_ds->query(sql));
+  const auto statement = m_db.prepareStatement(sql);
+
+  for (const dbiplus::sql_record* record : m_ds->get_result_set().records)
+  {
+    ASSERT_TRUE(statement->step());
+    for (int i = 0; i < statement->columnCount(); i++)
+    {
+      const dbiplus::field_value& value = record->at(i);
+      const dbiplus::field_view view = statement->at(i);
+      EXPECT_EQ(view.get_asString(), value.get_asString()) << "column " << i;
+      EXPECT_EQ(view.get_asInt(), value.get_asInt()) << "column " << i;
+      EXPECT_EQ(view.get_asInt64(), value.get_asInt64()) << "column " << i;
+      EXPECT_EQ(view.get_asBool(), value.get_asBool()) << "column " << i;
+      EXPECT_FLOAT_EQ(view.get_asFloat(), value.get_asFloat()) << "column " << i;
+      EXPECT_EQ(view.get_isNull(), value.get_isNull()) << "column " << i;
+    }
+  }
+  EXPECT_FALSE(statement->step());
+}
+
+TEST_F(TestStatement, Cache)
+{
+  AddMovies(3);
+
+  const std::string sql = "SELECT idMovie FROM movie WHERE idMovie >= ? ORDER BY idMovie";
+  const int prepared = m_db.m_prepared;
+  {
+    const auto statement = m_db.prepareStatement(sql);
+    statement->bindInt64(1, 2);
+    ASSERT_TRUE(statement->step());
+    EXPECT_EQ(statement->getInt64(0), 2);
+
+    // In use, so it's prepared again
+    const auto inUse = m_db.prepareStatement(sql);
+    EXPECT_NE(inUse.get(), statement.get());
+    EXPECT_EQ(m_db.m_prepared, prepared + 2);
+  }
+
+  // Reused, released with its bound values and the rows that were not read
+  {
+    const auto statement = m_db.prepareStatement(sql);
+    EXPECT_EQ(m_db.m_prepared, prepared + 2);
+    EXPECT_FALSE(statement->step());
+  }
+
+  // The least recently used statements are dropped, the ones that are held stay readable
+  auto held = m_db.prepareStatement(sql);
+  held->bindInt64(1, 3);
+  for (size_t i = 0; i < dbiplus::Database::STATEMENT_CACHE_SIZE; i++)
+    m_db.prepareStatement("SELECT " + std::to_string(i));
+
+  ASSERT_TRUE(held->step());
+  EXPECT_EQ(held->getInt64(0), 3);
+  held.reset();
+
+  const int evicted = m_db.m_prepared;
+  m_db.prepareStatement(sql);
+  EXPECT_EQ(m_db.m_prepared, evicted + 1);
+
+  // Queries of a dataset are prepared each time, without evicting cached statements
+  for (int i = 0; i < 2; i++)
+  {
+    ASSERT_TRUE(m_ds->query("SELECT idMovie FROM movie"));
+    m_ds->close();
+  }
+  m_db.prepareStatement(sql);
+  EXPECT_EQ(m_db.m_prepared, evicted + 3);
+}
+
+TEST_F(TestStatement, DISABLED_Benchmark)
+{
+  constexpr int MOVIES = 30000;
+  constexpr int QUERIES = 5;
+  constexpr int COLUMNS = 60;
+
+  // As wide as movie_view
+  std::string columns;
+  for (int i = 0; i < COLUMNS; i++)
+    columns += ", title AS c" + std::to_string(i);
+  const std::string sql = "SELECT *" + columns + " FROM movie";
+
+  AddMovies(MOVIES);
+
+  size_t length = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int query = 0; query < QUERIES; query++)
+  {
+    m_ds->query(sql);
+    for (const dbiplus::sql_record* record : m_ds->get_result_set().records)
+      for (const dbiplus::field_value& value : *record)
+        length += value.get_asString().size();
+    m_ds->close();
+  }
+  const std::chrono::duration<double, std::milli> dataset =
+      std::chrono::steady_clock::now() - begin;
+
+  begin = std::chrono::steady_clock::now();
+  for (int query = 0; query < QUERIES; query++)
+  {
+    const auto statement = m_db.prepareStatement(sql);
+    while (statement->step())
+      for (int i = 0; i < statement->columnCount(); i++)
+        length -= statement->at(i).get_asString().size();
+  }
+  const std::chrono::duration<double, std::milli> prepared =
+      std::chrono::steady_clock::now() - begin;
+
+  EXPECT_EQ(length, 0u);
+  std::cout << MOVIES << " rows of " << COLUMNS + 5 << " columns: "
+            << dataset.count() / QUERIES << " ms per query through the dataset, "
+            << prepared.count() / QUERIES << " ms per query from the statement" << std::endl;
+}
@@ -44,6 +44,15 @@ public:
    */
   virtual bool Reset(int64_t iSourcePosition) = 0;
 
+  /*!
+   \brief Continue writing at another position of the cached data
+   Used to skip over data that was cached ahead of the write position, e.g. by prefetching.
+   \param iFilePosition new write position, inside or at the end of the data cached after the
+   read position
+   \return Whether the write position was changed
+   */
+  virtual bool SetWritePosition(int64_t iFilePosition) { return false; }
+
   virtual void EndOfInput(); // mark the end of the input stream so that Read will know when to return EOF
   virtual bool IsEndOfInput();
   virtual void ClearEndOfInput();
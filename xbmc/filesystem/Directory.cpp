@@ -10,6 +10,7 @@
 
 #include "DirectoryCache.h"
 #include "DirectoryFactory.h"
+#include "File.h"
 #include "FileDirectoryFactory.h"
 #include "FileItem.h"
 #include "FileItemList.h"
@@ -112,6 +113,39 @@ public:
   unsigned int               m_id;
 };
 
+namespace
+{
+/*!
+ * \brief Get the value used to check that a persisted listing is up to date
+ *
+ * Only remote listings are persisted, as they are slow to get again after a
+ * restart. Their directory must report a modification time, which changes
+ * when entries are added, removed or renamed.
+ *
+ * \return The modification time of the directory, or 0 if the listing can't be persisted
+ */
+int64_t GetPersistentValidator(const CURL& url,
+                               const IDirectory& directory,
+                               const CDirectory::CHints& hints)
+{
+  if ((hints.flags & DIR_FLAG_BYPASS_CACHE) || directory.GetCacheType(url) == CacheType::NEVER)
+    return 0;
+
+  if (!URIUtils::IsRemote(url.Get()))
+    return 0;
+
+  if (!CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
+          CSettings::SETTING_FILELISTS_PERSISTENTCACHE))
+    return 0;
+
+  struct __stat64 buffer = {};
+  if (CFile::Stat(url, &buffer) != 0)
+    return 0;
+
+  return static_cast<int64_t>(buffer.st_mtime);
+}
+} // namespace
+
 
 CDirectory::CDirectory() = default;
 
@@ -172,8 +206,22 @@ bool CDirectory::GetDirectory(const CURL& url,
       return false;
 
     // check our cache for this path
-    if (g_directoryCache.GetDirectory(realURL, items,
-                                      (hints.flags & DIR_FLAG_READ_CACHE) == DIR_FLAG_READ_CACHE))
+    bool cached = g_directoryCache.GetDirectory(
+        realURL, items, (hints.flags & DIR_FLAG_READ_CACHE) == DIR_FLAG_READ_CACHE);
+
+    // then the listing persisted on disk, if it's still up to date
+    int64_t validator = 0;
+    if (!cached)
+    {
+      validator = GetPersistentValidator(realURL, *pDirectory, hints);
+      if (validator != 0 && g_directoryCache.GetPersistentDirectory(realURL, validator, items))
+      {
+        g_directoryCache.SetDirectory(realURL, items, pDirectory->GetCacheType(url));
+        cached = true;
+      }
+    }
+
+    if (cached)
       items.SetURL(url);
     else
     {
@@ -252,6 +300,9 @@ bool CDirectory::GetDirectory(const CURL& url,
       // cache the directory, if necessary
       if (!(hints.flags & DIR_FLAG_BYPASS_CACHE))
         g_directoryCache.SetDirectory(realURL, items, pDirectory->GetCacheType(url));
+
+      if (validator != 0)
+        g_directoryCache.SetPersistentDirectory(realURL, validator, items);
     }
 
     // now filter for allowed files
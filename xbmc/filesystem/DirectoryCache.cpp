@@ -11,23 +11,37 @@
 #include "Directory.h"
 #include "FileItem.h"
 #include "FileItemList.h"
+#include "File.h"
 #include "URL.h"
+#include "XBDateTime.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
 #include <climits>
+#include <cstdio>
 #include <mutex>
+#include <stdexcept>
 
 // Maximum number of directories to keep in our cache
 #define MAX_CACHED_DIRS 50
 
+// Persisted listings that weren't stored again for this long are removed
+#define MAX_PERSISTENT_DAYS 30
+
 using namespace XFILE;
 
 namespace
 {
 
+constexpr auto PERSISTENT_CACHE_PATH = "special://profile/directory_cache/";
+
+// Version of the persistent cache files, increase when their format changes
+constexpr int PERSISTENT_CACHE_VERSION = 1;
+
 std::string getKey(const CURL& url)
 {
   // Get rid of any URL options, else the compare may be wrong
@@ -61,7 +75,12 @@ void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
   m_lastAccess = accessCounter++;
 }
 
-CDirectoryCache::CDirectoryCache(void)
+CDirectoryCache::CDirectoryCache(void) : CDirectoryCache(PERSISTENT_CACHE_PATH)
+{
+}
+
+CDirectoryCache::CDirectoryCache(std::string persistentPath)
+  : m_persistentPath(std::move(persistentPath))
 {
   m_accessCounter = 0;
 #ifdef _DEBUG
@@ -124,18 +143,182 @@ void CDirectoryCache::SetDirectory(const CURL& url, const CFileItemList& items,
   m_cache.emplace(storedPath, std::move(dir));
 }
 
+bool CDirectoryCache::GetPersistentDirectory(const CURL& url,
+                                             int64_t validator,
+                                             CFileItemList& items)
+{
+  const std::string storedPath = getKey(url);
+  const uint32_t hash = Crc32::Compute(storedPath);
+
+  std::unique_lock lock(m_persistentLock);
+
+  if (!OpenPersistentCache() || !m_persistentFiles.contains(hash))
+    return false;
+
+  const std::string cacheFile = GetPersistentFile(hash);
+
+  CFile file;
+  if (!file.Open(cacheFile))
+    return false;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+
+    int version;
+    ar >> version;
+    if (version != PERSISTENT_CACHE_VERSION)
+      return false;
+
+    // The hash of different paths may collide
+    std::string path;
+    int64_t storedValidator;
+    ar >> path;
+    ar >> storedValidator;
+    if (path != storedPath)
+      return false;
+
+    if (storedValidator != validator)
+    {
+      CLog::Log(LOGDEBUG, "CDirectoryCache::{} - {} changed since it was cached", __FUNCTION__,
+                CURL::GetRedacted(storedPath));
+      return false;
+    }
+
+    ar >> items;
+    ar.Close();
+
+    items.SetIgnoreURLOptions(true);
+    items.SetFastLookup(true);
+
+    CLog::Log(LOGDEBUG, "CDirectoryCache::{} - loaded {} items of {}", __FUNCTION__, items.Size(),
+              CURL::GetRedacted(storedPath));
+    return true;
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "CDirectoryCache::{} - corrupt cache file {}", __FUNCTION__, cacheFile);
+    items.Clear();
+  }
+
+  return false;
+}
+
+void CDirectoryCache::SetPersistentDirectory(const CURL& url,
+                                             int64_t validator,
+                                             const CFileItemList& items)
+{
+  const std::string storedPath = getKey(url);
+  const uint32_t hash = Crc32::Compute(storedPath);
+
+  std::unique_lock lock(m_persistentLock);
+
+  if (!OpenPersistentCache())
+    return;
+
+  CFile file;
+  if (!file.OpenForWrite(GetPersistentFile(hash), true))
+    return;
+
+  CArchive ar(&file, CArchive::store);
+  ar << PERSISTENT_CACHE_VERSION;
+  ar << storedPath;
+  ar << validator;
+  // Archive() doesn't modify the list when storing
+  ar << const_cast<CFileItemList&>(items);
+  ar.Close();
+
+  m_persistentFiles.insert(hash);
+}
+
+bool CDirectoryCache::OpenPersistentCache()
+{
+  if (m_persistentOpened)
+    return !m_persistentPath.empty();
+
+  m_persistentOpened = true;
+
+  if (m_persistentPath.empty())
+    return false;
+
+  if (!CDirectory::Create(m_persistentPath))
+  {
+    CLog::Log(LOGERROR, "CDirectoryCache::{} - failed to create {}", __FUNCTION__,
+              m_persistentPath);
+    return false;
+  }
+
+  CFileItemList files;
+  CDirectory::GetDirectory(m_persistentPath, files, ".fi",
+                           DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE);
+
+  const CDateTime expiry =
+      CDateTime::GetCurrentDateTime() - CDateTimeSpan(MAX_PERSISTENT_DAYS, 0, 0, 0);
+
+  for (const auto& item : files)
+  {
+    if (item->IsFolder())
+      continue;
+
+    const std::string fileName = URIUtils::GetFileName(item->GetPath());
+
+    uint32_t hash = 0;
+    if (std::sscanf(fileName.c_str(), "%08x.fi", &hash) != 1 || !item->GetDateTime().IsValid() ||
+        item->GetDateTime() < expiry)
+    {
+      CFile::Delete(item->GetPath());
+      continue;
+    }
+
+    m_persistentFiles.insert(hash);
+  }
+
+  CLog::Log(LOGDEBUG, "CDirectoryCache::{} - {} persistent listings in {}", __FUNCTION__,
+            m_persistentFiles.size(), m_persistentPath);
+
+  return true;
+}
+
+std::string CDirectoryCache::GetPersistentFile(uint32_t hash) const
+{
+  return URIUtils::AddFileToFolder(m_persistentPath, StringUtils::Format("{:08x}.fi", hash));
+}
+
+void CDirectoryCache::RemovePersistentDirectory(const std::string& key)
+{
+  const uint32_t hash = Crc32::Compute(key);
+
+  std::unique_lock lock(m_persistentLock);
+
+  // Only files that were found on disk or stored since are removed, to avoid a
+  // file system access for every directory that is listed. Files of a cache
+  // that wasn't opened yet are left, they are checked by their validator.
+  auto it = m_persistentFiles.find(hash);
+  if (it == m_persistentFiles.end())
+    return;
+
+  CFile::Delete(GetPersistentFile(hash));
+  m_persistentFiles.erase(it);
+}
+
 void CDirectoryCache::ClearFile(const CURL& url)
 {
   const std::string dirPath = getDirKey(url);
   m_cache.erase(dirPath);
+
+  RemovePersistentDirectory(dirPath);
 }
 
 void CDirectoryCache::ClearDirectory(const CURL& url)
 {
-  std::unique_lock lock(m_cs);
-
   const std::string storedPath = getKey(url);
-  m_cache.erase(storedPath);
+
+  {
+    std::unique_lock lock(m_cs);
+    m_cache.erase(storedPath);
+  }
+
+  RemovePersistentDirectory(storedPath);
 }
 
 void CDirectoryCache::ClearSubPaths(const CURL& url)
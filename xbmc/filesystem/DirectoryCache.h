@@ -14,6 +14,8 @@
 #include <functional>
 #include <memory>
 #include <set>
+#include <stdint.h>
+#include <string>
 #include <unordered_map>
 
 class CURL;
@@ -43,9 +45,31 @@ namespace XFILE
     };
   public:
     CDirectoryCache(void);
+    explicit CDirectoryCache(std::string persistentPath);
     virtual ~CDirectoryCache(void);
     bool GetDirectory(const CURL& url, CFileItemList& items, bool retrieveAll = false);
     void SetDirectory(const CURL& url, const CFileItemList& items, CacheType cacheType);
+
+    /*!
+     * \brief Get a listing from the persistent cache, which survives restarts
+     *
+     * \param url The directory
+     * \param validator A value that changes when the directory changes, usually
+     *                  its modification time
+     * \param[out] items The cached listing
+     *
+     * \return True if a listing was stored with the same validator, false otherwise
+     */
+    bool GetPersistentDirectory(const CURL& url, int64_t validator, CFileItemList& items);
+
+    /*!
+     * \brief Store a listing in the persistent cache
+     *
+     * Stored listings are removed by ClearDirectory() and ClearFile(), but not by
+     * Clear(), as they are checked against the validator before being served.
+     */
+    void SetPersistentDirectory(const CURL& url, int64_t validator, const CFileItemList& items);
+
     void ClearDirectory(const CURL& url);
     void ClearFile(const CURL& url);
     void ClearSubPaths(const CURL& url);
@@ -59,6 +83,11 @@ namespace XFILE
     void InitCache(const std::set<std::string>& dirs);
     void ClearCache(std::set<std::string>& dirs);
     void CheckIfFull();
+    void RemovePersistentDirectory(const std::string& key);
+
+    // Functions below require m_persistentLock to be held
+    bool OpenPersistentCache();
+    std::string GetPersistentFile(uint32_t hash) const;
 
     struct StringHash
     {
@@ -76,6 +105,11 @@ namespace XFILE
 
     unsigned int m_accessCounter;
 
+    const std::string m_persistentPath;
+    bool m_persistentOpened{false};
+    std::set<uint32_t> m_persistentFiles; //!< Hashes of the keys stored on disk
+    CCriticalSection m_persistentLock;
+
 #ifdef _DEBUG
     unsigned int m_cacheHits;
     unsigned int m_cacheMisses;
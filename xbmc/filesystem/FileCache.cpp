@@ -9,11 +9,13 @@
 #include "FileCache.h"
 
 #include "CircularCache.h"
+#include "SegmentedCache.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/Thread.h"
+#include "utils/URIUtils.h"
 #include "utils/log.h"
 
 #include <mutex>
@@ -76,6 +78,100 @@ private:
   int64_t  m_size;
 };
 
+/*!
+ * \brief Fetches segments ahead of the cache writer with range requests on its own source handle
+ */
+class CFileCache::CRangePrefetcher : public CThread
+{
+public:
+  CRangePrefetcher(CSegmentedCache& cache,
+                   const CURL& url,
+                   unsigned int chunkSize,
+                   const std::atomic<int64_t>& fileSize)
+    : CThread("FileCachePrefetch"),
+      m_cache(cache),
+      m_url(url),
+      m_chunkSize(chunkSize),
+      m_fileSize(fileSize)
+  {
+    Create();
+  }
+
+  ~CRangePrefetcher() override { StopThread(); }
+
+protected:
+  void Process() override
+  {
+    if (!m_source.Open(m_url, READ_NO_CACHE | READ_TRUNCATED | READ_NO_BUFFER))
+    {
+      CLog::Log(LOGERROR, "CFileCache::{} - <{}> failed to open source for prefetching",
+                __FUNCTION__, m_url.GetRedacted());
+      return;
+    }
+
+    bool retry = false;
+    m_source.IoControl(IOControl::SET_RETRY, &retry); // Failed ranges are fetched again later
+
+    std::unique_ptr<char[]> buffer(new char[m_chunkSize]);
+
+    while (!m_bStop)
+    {
+      int64_t start;
+      int64_t end;
+      if (!m_cache.ClaimPrefetchRange(m_fileSize, start, end))
+      {
+        // Read-ahead window is full
+        Sleep(100ms);
+        continue;
+      }
+
+      const bool success = FetchRange(start, end, buffer.get());
+      m_cache.ReleasePrefetchRange(start);
+
+      if (!success)
+        Sleep(100ms);
+    }
+
+    m_source.Close();
+  }
+
+private:
+  bool FetchRange(int64_t start, int64_t end, char* buffer)
+  {
+    if (m_source.GetPosition() != start && m_source.Seek(start, SEEK_SET) != start)
+      return false;
+
+    int64_t pos = start;
+    while (!m_bStop && pos < end)
+    {
+      const ssize_t read =
+          m_source.Read(buffer, static_cast<size_t>(std::min<int64_t>(m_chunkSize, end - pos)));
+      if (read <= 0)
+        return false;
+
+      for (ssize_t written = 0; written < read;)
+      {
+        // Fails once the read position moves away from the range
+        const int ret = m_cache.WriteToCacheAt(pos + written, buffer + written, read - written);
+        if (ret <= 0)
+          return false;
+
+        written += ret;
+      }
+
+      pos += read;
+    }
+
+    return true;
+  }
+
+  CSegmentedCache& m_cache;
+  const CURL m_url;
+  const unsigned int m_chunkSize;
+  const std::atomic<int64_t>& m_fileSize;
+  CFile m_source;
+};
+
 CFileCache::CFileCache(const unsigned int flags)
   : CThread("FileCache"), m_fileSize(0), m_flags(flags)
 {
@@ -118,6 +214,11 @@ bool CFileCache::Open(const CURL& url)
   const unsigned int cacheMemSize =
       settings->GetInt(CSettings::SETTING_FILECACHE_MEMORYSIZE) * 1024 * 1024;
 
+  // Parallel range requests only help with network sources
+  const int rangeRequests = URIUtils::IsRemote(url.Get())
+                                ? settings->GetInt(CSettings::SETTING_FILECACHE_RANGEREQUESTS)
+                                : 0;
+
   m_source.IoControl(IOControl::SET_CACHE, this);
 
   bool retry = false;
@@ -183,7 +284,20 @@ bool CFileCache::Open(const CURL& url)
       const size_t back = cacheSize / 4;
       const size_t front = cacheSize - back;
 
-      m_pCache = std::make_unique<CCircularCache>(front, back);
+      // Range requests fill seekable audio/video out of order, keeping cached
+      // ranges also allows seeking back to them. Double buffering already
+      // keeps two ranges of multi-stream files.
+      if (rangeRequests > 0 && m_fileSize > 0 && (m_flags & READ_AUDIO_VIDEO) &&
+          !(m_flags & READ_MULTI_STREAM) && m_seekPossible > 0)
+      {
+        CLog::Log(LOGDEBUG, "CFileCache::{} - <{}> using segmented memory cache", __FUNCTION__,
+                  m_sourcePath);
+        m_pCache = std::make_unique<CSegmentedCache>(front, back);
+      }
+      else
+      {
+        m_pCache = std::make_unique<CCircularCache>(front, back);
+      }
       m_forwardCacheSize = front;
       m_maxForward = m_forwardCacheSize;
     }
@@ -214,9 +328,25 @@ bool CFileCache::Open(const CURL& url)
 
   CThread::Create(false);
 
+  StartPrefetchers(url, rangeRequests);
+
   return true;
 }
 
+void CFileCache::StartPrefetchers(const CURL& url, int count)
+{
+  auto* segmentedCache = dynamic_cast<CSegmentedCache*>(m_pCache.get());
+  if (segmentedCache == nullptr || count <= 0)
+    return;
+
+  CLog::Log(LOGDEBUG, "CFileCache::{} - <{}> prefetching with {} parallel range requests",
+            __FUNCTION__, m_sourcePath, count);
+
+  for (int i = 0; i < count; i++)
+    m_prefetchers.emplace_back(
+        std::make_unique<CRangePrefetcher>(*segmentedCache, url, m_chunkSize, m_fileSize));
+}
+
 void CFileCache::Process()
 {
   if (!m_pCache)
@@ -276,6 +406,9 @@ void CFileCache::Process()
         const bool bCompleteReset = m_pCache->Reset(m_seekPos);
         m_readPos = m_seekPos;
         m_writePos = m_pCache->CachedDataEndPos();
+        // More data may have been prefetched while the source was seeking
+        if (m_writePos != cacheMaxPos && m_pCache->SetWritePosition(cacheMaxPos))
+          m_writePos = cacheMaxPos;
         assert(m_writePos == cacheMaxPos);
         average.Reset(m_writePos, bCompleteReset); // Can only recalculate new average from scratch after a full reset (empty cache)
         limiter.Reset(m_writePos);
@@ -293,6 +426,23 @@ void CFileCache::Process()
       m_seekEnded.Set();
     }
 
+    // Skip data that was prefetched ahead of the write position
+    const int64_t cachedEnd = m_pCache->CachedDataEndPos();
+    if (cachedEnd > m_writePos && m_seekPossible > 0)
+    {
+      if (m_source.Seek(cachedEnd, SEEK_SET) == cachedEnd &&
+          m_pCache->SetWritePosition(cachedEnd))
+      {
+        m_writePos = cachedEnd;
+      }
+      else if (m_source.Seek(m_writePos, SEEK_SET) != m_writePos)
+      {
+        CLog::Log(LOGERROR, "CFileCache::{} - <{}> error {} skipping prefetched data",
+                  __FUNCTION__, m_sourcePath, GetLastError());
+        m_seekPossible = m_source.IoControl(IOControl::SEEK_POSSIBLE, NULL);
+      }
+    }
+
     // variable read factor based on cache level
     if (useAdaptativeReadFactor)
     {
@@ -578,6 +728,7 @@ int64_t CFileCache::Seek(int64_t iFilePosition, int iWhence)
 void CFileCache::Close()
 {
   StopThread();
+  m_prefetchers.clear();
 
   std::unique_lock lock(m_sync);
   if (m_pCache)
@@ -17,6 +17,7 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -58,7 +59,12 @@ namespace XFILE
     }
 
   private:
+    class CRangePrefetcher;
+
+    void StartPrefetchers(const CURL& url, int count);
+
     std::unique_ptr<CCacheStrategy> m_pCache;
+    std::vector<std::unique_ptr<CRangePrefetcher>> m_prefetchers;
     int m_seekPossible = 0;
     CFile m_source;
     std::string m_sourcePath;
@@ -0,0 +1,513 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SegmentedCache.h"
+
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <string.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Largest segment fetched by a single range request
+constexpr size_t MAX_SEGMENT_SIZE = 4 * 1024 * 1024;
+
+size_t GetSegmentSize(size_t front)
+{
+  // Several segments should fit in the read-ahead window
+  const size_t blocks = std::min(front / 4, MAX_SEGMENT_SIZE) / CSegmentedCache::BLOCK_SIZE;
+  return std::max(blocks, size_t{1}) * CSegmentedCache::BLOCK_SIZE;
+}
+} // namespace
+
+CSegmentedCache::CSegmentedCache(size_t front, size_t back)
+  : m_front(front),
+    m_back(back),
+    m_segmentSize(GetSegmentSize(front))
+{
+}
+
+CSegmentedCache::~CSegmentedCache()
+{
+  Close();
+}
+
+int CSegmentedCache::Open()
+{
+  std::unique_lock lock(m_sync);
+
+  // The read-ahead window must fit, with a partial block on both sides and a
+  // block that can be reused
+  const size_t blockCount = std::max((m_front + m_back) / BLOCK_SIZE, m_front / BLOCK_SIZE + 3);
+
+  m_buf.reset(new (std::nothrow) uint8_t[blockCount * BLOCK_SIZE]);
+  if (!m_buf)
+    return CACHE_RC_ERROR;
+
+  m_blocks.assign(blockCount, Block{});
+  m_blockIndex.clear();
+  m_blockIndex.reserve(blockCount);
+  m_useCounter = 0;
+  m_claims.clear();
+  m_stats = {};
+  m_cur = 0;
+  m_end = 0;
+
+  return CACHE_RC_OK;
+}
+
+void CSegmentedCache::Close()
+{
+  std::unique_lock lock(m_sync);
+
+  if (m_buf)
+  {
+    CLog::Log(LOGDEBUG,
+              "CSegmentedCache::{} - ({}) {} seek hits, {} segment hits, {} misses, {} bytes read "
+              "ahead, {} bytes prefetched, {} blocks evicted",
+              __FUNCTION__, fmt::ptr(this), m_stats.seekHits, m_stats.segmentHits, m_stats.misses,
+              m_stats.readAheadBytes, m_stats.prefetchedBytes, m_stats.evictedBlocks);
+  }
+
+  m_buf.reset();
+  m_blocks.clear();
+  m_blockIndex.clear();
+  m_claims.clear();
+}
+
+size_t CSegmentedCache::GetMaxWriteSize(const size_t& iRequestSize)
+{
+  std::unique_lock lock(m_sync);
+
+  // Wait for segments that are being prefetched instead of fetching them twice
+  if (IsClaimed(m_end))
+    return 0;
+
+  const size_t front = static_cast<size_t>(std::max<int64_t>(m_end - m_cur, 0));
+  if (front >= m_front)
+    return 0;
+
+  return std::min(iRequestSize, m_front - front);
+}
+
+int CSegmentedCache::WriteToCache(const char* buf, size_t len)
+{
+  std::unique_lock lock(m_sync);
+
+  if (!m_buf)
+    return 0;
+
+  const size_t front = static_cast<size_t>(std::max<int64_t>(m_end - m_cur, 0));
+  if (front >= m_front)
+    return 0;
+
+  const size_t written = WriteBlock(m_end, buf, std::min(len, m_front - front));
+  if (written == 0)
+    return 0;
+
+  m_end += written;
+  m_stats.readAheadBytes += written;
+  m_written.Set();
+
+  return static_cast<int>(written);
+}
+
+int CSegmentedCache::WriteToCacheAt(int64_t pos, const char* buf, size_t len)
+{
+  std::unique_lock lock(m_sync);
+
+  if (!m_buf)
+    return CACHE_RC_ERROR;
+
+  // Data outside of the read-ahead window wouldn't be kept
+  const int64_t windowEnd = m_cur + static_cast<int64_t>(m_front);
+  if (pos < m_cur || pos >= windowEnd)
+    return CACHE_RC_ERROR;
+
+  len = std::min(len, static_cast<size_t>(windowEnd - pos));
+
+  const size_t written = WriteBlock(pos, buf, len);
+  if (written == 0)
+    return CACHE_RC_ERROR;
+
+  m_stats.prefetchedBytes += written;
+  m_written.Set();
+
+  return static_cast<int>(written);
+}
+
+/**
+ * Reads data from cache. Will only read up till the end
+ * of a block, so multiple calls may be needed to read
+ * all cached data.
+ */
+int CSegmentedCache::ReadFromCache(char* buf, size_t len)
+{
+  std::unique_lock lock(m_sync);
+
+  Block* block = FindBlock(m_cur);
+  const size_t offset = static_cast<size_t>(m_cur % BLOCK_SIZE);
+
+  if (block == nullptr || offset < block->begin || offset >= block->end)
+  {
+    if (IsEndOfInput())
+      return 0;
+    else
+      return CACHE_RC_WOULD_BLOCK;
+  }
+
+  len = std::min(len, block->end - offset);
+  if (len == 0)
+    return 0;
+
+  const size_t slot = static_cast<size_t>(block - m_blocks.data());
+  memcpy(buf, m_buf.get() + slot * BLOCK_SIZE + offset, len);
+
+  block->lastUse = ++m_useCounter;
+  m_cur += len;
+
+  m_space.Set();
+
+  return static_cast<int>(len);
+}
+
+int64_t CSegmentedCache::WaitForData(uint32_t minimum, std::chrono::milliseconds timeout)
+{
+  std::unique_lock lock(m_sync);
+  int64_t avail = GetRunEnd(m_cur) - m_cur;
+
+  if (timeout == 0ms || IsEndOfInput())
+    return avail;
+
+  if (minimum > m_front)
+    minimum = static_cast<uint32_t>(m_front);
+
+  XbmcThreads::EndTime<> endtime{timeout};
+  while (!IsEndOfInput() && avail < minimum && !endtime.IsTimePast())
+  {
+    lock.unlock();
+    m_written.Wait(50ms); // may miss the deadline. shouldn't be a problem.
+    lock.lock();
+    avail = GetRunEnd(m_cur) - m_cur;
+  }
+
+  return avail;
+}
+
+int64_t CSegmentedCache::Seek(int64_t pos)
+{
+  std::unique_lock lock(m_sync);
+
+  // Only positions in the data that continues at the write position can be
+  // read without moving the source
+  const auto isReadAhead = [this](int64_t position)
+  {
+    if (position <= m_end)
+      return position == m_end || GetRunEnd(position) >= m_end;
+    return position <= GetRunEnd(m_end);
+  };
+
+  // if seek is a bit over what we have, try to wait a few seconds for the data to be available.
+  // we try to avoid a (heavy) seek on the source
+  if (!isReadAhead(pos) && pos > m_end && pos < m_end + 100000)
+  {
+    // Make sure there's sufficient forward space
+    m_cur = std::max(m_cur, m_end);
+
+    lock.unlock();
+    WaitForData(static_cast<uint32_t>(pos - m_cur), 5s);
+    lock.lock();
+
+    if (!isReadAhead(pos))
+      CLog::Log(LOGDEBUG,
+                "CSegmentedCache::{} - ({}) Wait for data failed for pos {}, ended up at {}",
+                __FUNCTION__, fmt::ptr(this), pos, m_end);
+  }
+
+  if (isReadAhead(pos))
+  {
+    m_cur = pos;
+    m_stats.seekHits++;
+    return pos;
+  }
+
+  return CACHE_RC_ERROR;
+}
+
+bool CSegmentedCache::Reset(int64_t pos)
+{
+  std::unique_lock lock(m_sync);
+
+  m_cur = pos;
+
+  // Reuse a segment that is still cached, and only refill after it
+  if (IsCached(pos))
+  {
+    m_end = GetRunEnd(pos);
+    m_stats.segmentHits++;
+    return false;
+  }
+
+  if (pos == m_end)
+    return false;
+
+  m_end = pos;
+  m_stats.misses++;
+
+  return true;
+}
+
+bool CSegmentedCache::SetWritePosition(int64_t pos)
+{
+  std::unique_lock lock(m_sync);
+
+  const bool afterRead = pos >= m_cur && pos <= GetRunEnd(m_cur);
+  const bool afterWrite = pos >= m_end && pos <= GetRunEnd(m_end);
+  if (!afterRead && !afterWrite)
+    return false;
+
+  m_end = pos;
+  return true;
+}
+
+int64_t CSegmentedCache::CachedDataEndPosIfSeekTo(int64_t iFilePosition)
+{
+  std::unique_lock lock(m_sync);
+  return GetRunEnd(iFilePosition);
+}
+
+int64_t CSegmentedCache::CachedDataStartPos()
+{
+  std::unique_lock lock(m_sync);
+  return GetRunStart(m_cur);
+}
+
+int64_t CSegmentedCache::CachedDataEndPos()
+{
+  std::unique_lock lock(m_sync);
+
+  // Include data cached after the write position, except for segments that
+  // are still being prefetched
+  int64_t end = m_end;
+  while (!IsClaimed(end))
+  {
+    const int64_t runEnd =
+        std::min(GetRunEnd(end), GetSegmentStart(end) + static_cast<int64_t>(m_segmentSize));
+    if (runEnd == end)
+      break;
+    end = runEnd;
+  }
+
+  return end;
+}
+
+bool CSegmentedCache::IsCachedPosition(int64_t iFilePosition)
+{
+  std::unique_lock lock(m_sync);
+  return iFilePosition == m_end || IsCached(iFilePosition);
+}
+
+CCacheStrategy* CSegmentedCache::CreateNew()
+{
+  return new CSegmentedCache(m_front, m_back);
+}
+
+bool CSegmentedCache::ClaimPrefetchRange(int64_t fileSize, int64_t& start, int64_t& end)
+{
+  std::unique_lock lock(m_sync);
+
+  if (!m_buf)
+    return false;
+
+  const int64_t windowEnd = m_cur + static_cast<int64_t>(m_front);
+
+  // The segment of the write position is left to the sequential writer
+  for (int64_t segment = GetSegmentStart(std::max(m_cur, m_end)) + m_segmentSize;
+       segment < fileSize; segment += m_segmentSize)
+  {
+    const int64_t segmentEnd = std::min(segment + static_cast<int64_t>(m_segmentSize), fileSize);
+    if (segmentEnd > windowEnd)
+      break;
+
+    if (m_claims.contains(segment))
+      continue;
+
+    int64_t first = segment;
+    while (first < segmentEnd && IsCached(first))
+      first = GetRunEnd(first);
+
+    if (first >= segmentEnd)
+      continue;
+
+    m_claims.insert(segment);
+    start = first;
+    end = segmentEnd;
+    return true;
+  }
+
+  return false;
+}
+
+void CSegmentedCache::ReleasePrefetchRange(int64_t start)
+{
+  std::unique_lock lock(m_sync);
+  m_claims.erase(GetSegmentStart(start));
+}
+
+SegmentedCacheStats CSegmentedCache::GetStats() const
+{
+  std::unique_lock lock(m_sync);
+  return m_stats;
+}
+
+CSegmentedCache::Block* CSegmentedCache::FindBlock(int64_t pos)
+{
+  const auto it = m_blockIndex.find(pos / static_cast<int64_t>(BLOCK_SIZE));
+  if (it == m_blockIndex.end())
+    return nullptr;
+
+  return &m_blocks[it->second];
+}
+
+const CSegmentedCache::Block* CSegmentedCache::FindBlock(int64_t pos) const
+{
+  const auto it = m_blockIndex.find(pos / static_cast<int64_t>(BLOCK_SIZE));
+  if (it == m_blockIndex.end())
+    return nullptr;
+
+  return &m_blocks[it->second];
+}
+
+CSegmentedCache::Block* CSegmentedCache::AllocateBlock(int64_t index)
+{
+  // Keep the blocks from the read position to the end of the read-ahead window
+  const int64_t windowEnd = std::max(m_end, m_cur + static_cast<int64_t>(m_front));
+  const int64_t firstKept = m_cur / static_cast<int64_t>(BLOCK_SIZE);
+  const int64_t lastKept = (windowEnd - 1) / static_cast<int64_t>(BLOCK_SIZE);
+
+  Block* victim = nullptr;
+  for (Block& block : m_blocks)
+  {
+    if (block.index < 0)
+    {
+      victim = &block;
+      break;
+    }
+
+    if (block.index >= firstKept && block.index <= lastKept)
+      continue;
+
+    if (victim == nullptr || block.lastUse < victim->lastUse)
+      victim = &block;
+  }
+
+  if (victim == nullptr)
+    return nullptr;
+
+  if (victim->index >= 0)
+  {
+    m_blockIndex.erase(victim->index);
+    m_stats.evictedBlocks++;
+  }
+
+  victim->index = index;
+  victim->begin = 0;
+  victim->end = 0;
+  m_blockIndex[index] = static_cast<size_t>(victim - m_blocks.data());
+
+  return victim;
+}
+
+bool CSegmentedCache::IsCached(int64_t pos) const
+{
+  const Block* block = FindBlock(pos);
+  const size_t offset = static_cast<size_t>(pos % BLOCK_SIZE);
+
+  return block != nullptr && offset >= block->begin && offset < block->end;
+}
+
+int64_t CSegmentedCache::GetRunStart(int64_t pos) const
+{
+  int64_t start = pos;
+  while (IsCached(start))
+  {
+    const Block* block = FindBlock(start);
+    start -= static_cast<int64_t>(start % BLOCK_SIZE - block->begin);
+
+    if (start == 0 || !IsCached(start - 1))
+      break;
+
+    start--;
+  }
+
+  return start;
+}
+
+int64_t CSegmentedCache::GetRunEnd(int64_t pos) const
+{
+  int64_t end = pos;
+  while (const Block* block = FindBlock(end))
+  {
+    const size_t offset = static_cast<size_t>(end % BLOCK_SIZE);
+    if (offset < block->begin || offset >= block->end)
+      break;
+
+    end += static_cast<int64_t>(block->end - offset);
+
+    if (block->end < BLOCK_SIZE)
+      break;
+  }
+
+  return end;
+}
+
+int64_t CSegmentedCache::GetSegmentStart(int64_t pos) const
+{
+  return pos - pos % static_cast<int64_t>(m_segmentSize);
+}
+
+bool CSegmentedCache::IsClaimed(int64_t pos) const
+{
+  return m_claims.contains(GetSegmentStart(pos));
+}
+
+size_t CSegmentedCache::WriteBlock(int64_t pos, const char* buf, size_t len)
+{
+  const size_t offset = static_cast<size_t>(pos % BLOCK_SIZE);
+  len = std::min(len, BLOCK_SIZE - offset);
+
+  Block* block = FindBlock(pos);
+  if (block == nullptr)
+    block = AllocateBlock(pos / static_cast<int64_t>(BLOCK_SIZE));
+
+  if (block == nullptr)
+    return 0;
+
+  // A block only holds contiguous data, anything else is dropped
+  if (block->begin == block->end || offset > block->end || offset + len < block->begin)
+  {
+    block->begin = offset;
+    block->end = offset;
+  }
+
+  const size_t slot = static_cast<size_t>(block - m_blocks.data());
+  memcpy(m_buf.get() + slot * BLOCK_SIZE + offset, buf, len);
+
+  block->begin = std::min(block->begin, offset);
+  block->end = std::max(block->end, offset + len);
+  block->lastUse = ++m_useCounter;
+
+  return len;
+}
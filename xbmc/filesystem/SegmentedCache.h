@@ -0,0 +1,150 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "CacheStrategy.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <memory>
+#include <set>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Statistics of a segmented cache since it was opened
+ */
+struct SegmentedCacheStats
+{
+  uint64_t seekHits{0}; //!< Seeks inside the data being read ahead
+  uint64_t segmentHits{0}; //!< Seeks to data cached before, which only refill after it
+  uint64_t misses{0}; //!< Seeks to uncached data, which refill from the seek position
+  uint64_t readAheadBytes{0}; //!< Bytes written by the sequential reader of the source
+  uint64_t prefetchedBytes{0}; //!< Bytes written by range prefetching
+  uint64_t evictedBlocks{0}; //!< Blocks reused for other data
+};
+
+/*!
+ * \brief Memory cache that keeps several cached byte ranges of the source
+ *
+ * Unlike CCircularCache, a seek outside of the data being read ahead doesn't
+ * discard the cache. Memory is split in fixed-size blocks, and blocks that are
+ * neither behind nor ahead of the read position are reused in least recently
+ * used order. Seeking back to a range that is still cached only needs the
+ * source to refill after its end.
+ *
+ * Ahead of the sequential writer, aligned segments can be fetched in parallel
+ * with WriteToCacheAt() by range requests on other source handles. Segments
+ * are claimed with ClaimPrefetchRange(), so concurrent fetchers never overlap,
+ * and the sequential writer skips over them once they are complete.
+ */
+class CSegmentedCache : public CCacheStrategy
+{
+public:
+  CSegmentedCache(size_t front, size_t back);
+  ~CSegmentedCache() override;
+
+  int Open() override;
+  void Close() override;
+
+  size_t GetMaxWriteSize(const size_t& iRequestSize) override;
+  int WriteToCache(const char* buf, size_t len) override;
+  int ReadFromCache(char* buf, size_t len) override;
+  int64_t WaitForData(uint32_t minimum, std::chrono::milliseconds timeout) override;
+
+  int64_t Seek(int64_t pos) override;
+  bool Reset(int64_t pos) override;
+  bool SetWritePosition(int64_t pos) override;
+
+  int64_t CachedDataEndPosIfSeekTo(int64_t iFilePosition) override;
+  int64_t CachedDataStartPos() override;
+  int64_t CachedDataEndPos() override;
+  bool IsCachedPosition(int64_t iFilePosition) override;
+
+  CCacheStrategy* CreateNew() override;
+
+  /*!
+   * \brief Claim the next segment to prefetch
+   *
+   * \param fileSize The size of the source, segments aren't claimed past it
+   * \param[out] start The first uncached position in the segment
+   * \param[out] end The end of the segment
+   *
+   * \return True if a segment was claimed, false if the read-ahead window is
+   *         already cached or claimed
+   */
+  bool ClaimPrefetchRange(int64_t fileSize, int64_t& start, int64_t& end);
+
+  /*!
+   * \brief Release a segment claimed by ClaimPrefetchRange()
+   *
+   * \param start The start position returned by ClaimPrefetchRange()
+   */
+  void ReleasePrefetchRange(int64_t start);
+
+  /*!
+   * \brief Write prefetched data at a position ahead of the read position
+   *
+   * \return The number of bytes written, which may be less than len, or
+   *         CACHE_RC_ERROR if the position left the read-ahead window
+   */
+  int WriteToCacheAt(int64_t pos, const char* buf, size_t len);
+
+  SegmentedCacheStats GetStats() const;
+
+  /*!
+   * \brief Size of the blocks that memory is split in
+   */
+  static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+private:
+  struct Block
+  {
+    int64_t index{-1}; //!< Index of the block in the file, or -1 if unused
+    size_t begin{0}; //!< Offset of the first valid byte in the block
+    size_t end{0}; //!< Offset after the last valid byte in the block
+    uint64_t lastUse{0}; //!< Value of the use counter when the block was last accessed
+  };
+
+  // Functions below require m_sync to be held
+  Block* FindBlock(int64_t pos);
+  const Block* FindBlock(int64_t pos) const;
+  Block* AllocateBlock(int64_t index);
+  bool IsCached(int64_t pos) const;
+  int64_t GetRunStart(int64_t pos) const;
+  int64_t GetRunEnd(int64_t pos) const;
+  int64_t GetSegmentStart(int64_t pos) const;
+  bool IsClaimed(int64_t pos) const;
+  size_t WriteBlock(int64_t pos, const char* buf, size_t len);
+
+  const size_t m_front; //!< Size of the read-ahead window
+  const size_t m_back; //!< Size of the back buffer
+  const size_t m_segmentSize; //!< Size of prefetched segments, a multiple of BLOCK_SIZE
+
+  int64_t m_cur{0}; //!< Current read position in the file
+  int64_t m_end{0}; //!< Position of the next sequential write in the file
+
+  std::unique_ptr<uint8_t[]> m_buf;
+  std::vector<Block> m_blocks;
+  std::unordered_map<int64_t, size_t> m_blockIndex; //!< Block index in file -> block slot
+  uint64_t m_useCounter{0};
+
+  std::set<int64_t> m_claims; //!< Start of the segments being prefetched
+
+  SegmentedCacheStats m_stats;
+
+  mutable CCriticalSection m_sync;
+  CEvent m_written;
+};
+
+} // namespace XFILE
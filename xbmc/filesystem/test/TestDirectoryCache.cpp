@@ -9,6 +9,7 @@
 #include "FileItem.h"
 #include "FileItemList.h"
 #include "URL.h"
+#include "filesystem/Directory.h"
 #include "filesystem/DirectoryCache.h"
 #include "filesystem/IDirectory.h"
 
@@ -512,3 +513,39 @@ TEST_F(TestDirectoryCache, GetDirectoryReturnValue)
   EXPECT_FALSE(notFound);
   EXPECT_EQ(0, emptyRetrieved.Size());
 }
+
+// Persistent cache tests
+TEST_F(TestDirectoryCache, PersistentDirectory)
+{
+  const std::string persistentPath = "special://temp/test_directory_cache/";
+  CURL url("ftp://test/directory/");
+  CFileItemList items;
+  AddFile(items, CURL("ftp://test/directory/file1.txt"));
+  AddDir(items, CURL("ftp://test/directory/subdir/"));
+
+  CDirectoryCache(persistentPath).SetPersistentDirectory(url, 1234, items);
+
+  // A new cache, as after a restart, only serves the listing with the same validator
+  CDirectoryCache persistentCache(persistentPath);
+
+  CFileItemList retrieved;
+  EXPECT_FALSE(persistentCache.GetPersistentDirectory(url, 1235, retrieved));
+  EXPECT_FALSE(persistentCache.GetPersistentDirectory(CURL("ftp://test/other/"), 1234, retrieved));
+
+  ASSERT_TRUE(persistentCache.GetPersistentDirectory(url, 1234, retrieved));
+  ASSERT_EQ(2, retrieved.Size());
+  EXPECT_EQ("ftp://test/directory/file1.txt", retrieved.Get(0)->GetPath());
+  EXPECT_TRUE(retrieved.Get(1)->IsFolder());
+
+  // Clearing the directory removes it from disk
+  persistentCache.ClearDirectory(url);
+  EXPECT_FALSE(persistentCache.GetPersistentDirectory(url, 1234, retrieved));
+  EXPECT_FALSE(CDirectoryCache(persistentPath).GetPersistentDirectory(url, 1234, retrieved));
+
+  // Clearing the memory cache doesn't
+  persistentCache.SetPersistentDirectory(url, 1234, items);
+  persistentCache.Clear();
+  EXPECT_TRUE(persistentCache.GetPersistentDirectory(url, 1234, retrieved));
+
+  CDirectory::RemoveRecursive(persistentPath);
+}
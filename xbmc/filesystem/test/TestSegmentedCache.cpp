@@ -0,0 +1,197 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/SegmentedCache.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr size_t BLOCK_SIZE = CSegmentedCache::BLOCK_SIZE;
+
+// Front of 16 blocks, which makes segments of 4 blocks
+constexpr size_t FRONT = 16 * BLOCK_SIZE;
+constexpr size_t BACK = 8 * BLOCK_SIZE;
+
+char ByteAt(int64_t pos)
+{
+  return static_cast<char>((pos * 7) ^ (pos >> 11));
+}
+
+std::vector<char> MakeData(int64_t pos, size_t size)
+{
+  std::vector<char> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = ByteAt(pos + static_cast<int64_t>(i));
+  return data;
+}
+
+// Write like CFileCache does, from the current write position
+void Fill(CSegmentedCache& cache, int64_t pos, size_t size)
+{
+  const std::vector<char> data = MakeData(pos, size);
+
+  size_t written = 0;
+  while (written < size)
+  {
+    const int ret = cache.WriteToCache(data.data() + written, size - written);
+    ASSERT_GT(ret, 0);
+    written += static_cast<size_t>(ret);
+  }
+}
+
+void ExpectRead(CSegmentedCache& cache, int64_t pos, size_t size)
+{
+  std::vector<char> data(size);
+
+  size_t read = 0;
+  while (read < size)
+  {
+    const int ret = cache.ReadFromCache(data.data() + read, size - read);
+    ASSERT_GT(ret, 0);
+    read += static_cast<size_t>(ret);
+  }
+
+  EXPECT_EQ(data, MakeData(pos, size));
+}
+} // namespace
+
+TEST(TestSegmentedCache, ReadAhead)
+{
+  CSegmentedCache cache(FRONT, BACK);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  EXPECT_EQ(cache.GetMaxWriteSize(FRONT * 2), FRONT);
+
+  Fill(cache, 0, 3 * BLOCK_SIZE + 100);
+  EXPECT_EQ(cache.WaitForData(0, std::chrono::milliseconds(0)), 3 * BLOCK_SIZE + 100);
+  EXPECT_EQ(cache.CachedDataEndPos(), 3 * BLOCK_SIZE + 100);
+
+  ExpectRead(cache, 0, 2 * BLOCK_SIZE);
+
+  // Seeks inside the read-ahead data don't move the source
+  EXPECT_EQ(cache.Seek(1000), 1000);
+  ExpectRead(cache, 1000, 5000);
+
+  // No more data until it's written
+  char byte;
+  EXPECT_EQ(cache.Seek(3 * BLOCK_SIZE + 100), 3 * BLOCK_SIZE + 100);
+  EXPECT_EQ(cache.ReadFromCache(&byte, 1), CACHE_RC_WOULD_BLOCK);
+  cache.EndOfInput();
+  EXPECT_EQ(cache.ReadFromCache(&byte, 1), 0);
+
+  EXPECT_EQ(cache.GetStats().seekHits, 2u);
+  EXPECT_EQ(cache.GetStats().readAheadBytes, 3 * BLOCK_SIZE + 100);
+}
+
+TEST(TestSegmentedCache, ReuseSegmentAfterSeek)
+{
+  CSegmentedCache cache(FRONT, BACK);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  Fill(cache, 0, 4 * BLOCK_SIZE);
+  ExpectRead(cache, 0, 4 * BLOCK_SIZE);
+
+  // Seek far ahead, which needs the source to refill from there
+  const int64_t farPos = 100 * BLOCK_SIZE + 10;
+  EXPECT_EQ(cache.Seek(farPos), CACHE_RC_ERROR);
+  EXPECT_EQ(cache.CachedDataEndPosIfSeekTo(farPos), farPos);
+  EXPECT_TRUE(cache.Reset(farPos));
+  Fill(cache, farPos, 2 * BLOCK_SIZE);
+  ExpectRead(cache, farPos, BLOCK_SIZE);
+
+  // Seeking back reuses the first segment, and only refills after it
+  EXPECT_EQ(cache.Seek(1000), CACHE_RC_ERROR);
+  EXPECT_EQ(cache.CachedDataEndPosIfSeekTo(1000), 4 * BLOCK_SIZE);
+  EXPECT_FALSE(cache.Reset(1000));
+  EXPECT_EQ(cache.CachedDataEndPos(), 4 * BLOCK_SIZE);
+  ExpectRead(cache, 1000, BLOCK_SIZE);
+
+  const SegmentedCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.segmentHits, 1u);
+}
+
+TEST(TestSegmentedCache, EvictOldSegments)
+{
+  CSegmentedCache cache(FRONT, BACK);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  Fill(cache, 0, 2 * BLOCK_SIZE);
+  ExpectRead(cache, 0, 2 * BLOCK_SIZE);
+
+  // Stream through more data than the cache holds
+  const int64_t start = 1000 * BLOCK_SIZE;
+  EXPECT_TRUE(cache.Reset(start));
+  for (int64_t pos = start; pos < start + static_cast<int64_t>(4 * (FRONT + BACK));
+       pos += BLOCK_SIZE)
+  {
+    Fill(cache, pos, BLOCK_SIZE);
+    ExpectRead(cache, pos, BLOCK_SIZE);
+  }
+
+  EXPECT_GT(cache.GetStats().evictedBlocks, 0u);
+  EXPECT_FALSE(cache.IsCachedPosition(0));
+}
+
+TEST(TestSegmentedCache, Prefetch)
+{
+  CSegmentedCache cache(FRONT, BACK);
+  ASSERT_EQ(cache.Open(), CACHE_RC_OK);
+
+  const int64_t fileSize = 1000 * BLOCK_SIZE;
+  const int64_t segmentSize = 4 * BLOCK_SIZE;
+
+  // The segment of the write position is left to the writer
+  int64_t start;
+  int64_t end;
+  ASSERT_TRUE(cache.ClaimPrefetchRange(fileSize, start, end));
+  EXPECT_EQ(start, segmentSize);
+  EXPECT_EQ(end, 2 * segmentSize);
+
+  // Segments are only claimed once
+  int64_t start2;
+  int64_t end2;
+  ASSERT_TRUE(cache.ClaimPrefetchRange(fileSize, start2, end2));
+  EXPECT_EQ(start2, 2 * segmentSize);
+
+  // The writer waits for claimed segments
+  Fill(cache, 0, segmentSize);
+  EXPECT_EQ(cache.GetMaxWriteSize(BLOCK_SIZE), 0u);
+  EXPECT_EQ(cache.CachedDataEndPos(), segmentSize);
+
+  const std::vector<char> data = MakeData(start, static_cast<size_t>(end - start));
+  for (size_t written = 0; written < data.size();)
+  {
+    const int ret = cache.WriteToCacheAt(start + written, data.data() + written,
+                                         data.size() - written);
+    ASSERT_GT(ret, 0);
+    written += static_cast<size_t>(ret);
+  }
+  cache.ReleasePrefetchRange(start);
+
+  // Prefetched data can be read, and the writer skips over it up to the next claimed segment
+  EXPECT_EQ(cache.WaitForData(0, std::chrono::milliseconds(0)), 2 * segmentSize);
+  EXPECT_EQ(cache.CachedDataEndPos(), 2 * segmentSize);
+  EXPECT_TRUE(cache.SetWritePosition(2 * segmentSize));
+  EXPECT_EQ(cache.GetMaxWriteSize(BLOCK_SIZE), 0u);
+
+  ExpectRead(cache, 0, static_cast<size_t>(2 * segmentSize));
+
+  // Prefetched data outside of the read-ahead window isn't kept
+  EXPECT_EQ(cache.WriteToCacheAt(100 * segmentSize, data.data(), data.size()), CACHE_RC_ERROR);
+
+  cache.ReleasePrefetchRange(start2);
+  EXPECT_EQ(cache.GetMaxWriteSize(BLOCK_SIZE), BLOCK_SIZE);
+
+  EXPECT_EQ(cache.GetStats().prefetchedBytes, static_cast<uint64_t>(segmentSize));
+}
@@ -38,6 +38,9 @@ public:
   bool AutosaveEnabled();
   bool RewindEnabled();
   unsigned int MaxRewindTimeSec();
+  unsigned int MaxRewindMemoryMB();
+  bool LatencyReductionEnabled();
+  unsigned int RunAheadFrames();
   std::string GetRAUsername() const;
   std::string GetRAToken() const;
 
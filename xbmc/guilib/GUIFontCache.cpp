@@ -13,35 +13,56 @@
 #include <stdint.h>
 #include <vector>
 
-using namespace std::chrono_literals;
-
 namespace
 {
-constexpr auto FONT_CACHE_TIME_LIMIT = 1000ms;
-}
+// Memory budget of the vertices of each cache, at 4 vertices per character
+constexpr size_t FONT_CACHE_MEMORY_LIMIT = 2 * 1024 * 1024;
+
+// Maximum number of cached texts, to bound lookups of short texts
+constexpr size_t FONT_CACHE_MAX_ENTRIES = 4096;
+} // namespace
 
 template<class Position, class Value>
 class CGUIFontCacheImpl
 {
+  using Entry = CGUIFontCacheEntry<Position, Value>;
+
   struct EntryList
   {
-    using HashMap = std::multimap<size_t, std::unique_ptr<CGUIFontCacheEntry<Position, Value>>>;
+    using HashMap = std::multimap<size_t, std::unique_ptr<Entry>>;
     using HashIter = typename HashMap::iterator;
-    using AgeMap = std::multimap<std::chrono::steady_clock::time_point, HashIter>;
+    using LruList = std::list<Entry*>;
 
     ~EntryList() { Flush(); }
 
-    HashIter Insert(size_t hash, std::unique_ptr<CGUIFontCacheEntry<Position, Value>> v)
+    HashIter Insert(size_t hash, std::unique_ptr<Entry> v)
     {
       auto r(hashMap.insert(typename HashMap::value_type(hash, std::move(v))));
-      if (r->second)
-        ageMap.insert(typename AgeMap::value_type(r->second->m_lastUsed, r));
+      lruList.push_front(r->second.get());
+      r->second->m_lruPosition = lruList.begin();
 
       return r;
     }
+    std::unique_ptr<Entry> Remove(Entry* entry)
+    {
+      CGUIFontCacheHash<Position> hashGen;
+      auto range = hashMap.equal_range(hashGen(entry->m_key));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second.get() == entry)
+        {
+          std::unique_ptr<Entry> removed = std::move(it->second);
+          hashMap.erase(it);
+          lruList.erase(removed->m_lruPosition);
+          return removed;
+        }
+      }
+
+      return {};
+    }
     void Flush()
     {
-      ageMap.clear();
+      lruList.clear();
       hashMap.clear();
     }
     typename HashMap::iterator FindKey(CGUIFontCacheKey<Position> key)
@@ -61,28 +82,28 @@ class CGUIFontCacheImpl
     }
     void UpdateAge(HashIter it, std::chrono::steady_clock::time_point now)
     {
-      auto range = ageMap.equal_range(it->second->m_lastUsed);
-      for (auto ageit = range.first; ageit != range.second; ++ageit)
-      {
-        if (ageit->second == it)
-        {
-          auto node = ageMap.extract(ageit);
-          node.key() = now;
-          node.mapped() = it;
-          ageMap.insert(std::move(node));
-          it->second->m_lastUsed = now;
-          return;
-        }
-      }
+      Entry* entry = it->second.get();
+      lruList.splice(lruList.begin(), lruList, entry->m_lruPosition);
+      entry->m_lastUsed = now;
     }
 
     HashMap hashMap;
-    AgeMap ageMap;
+    LruList lruList; //!< Most recently used entry first
   };
 
+  /*!
+   * \brief Account the value of the last returned entry, which callers fill after the lookup
+   */
+  void UpdateSize();
+  std::unique_ptr<Entry> Evict();
+
   EntryList m_list;
   CGUIFontCache<Position, Value>* m_parent;
 
+  Entry* m_lastEntry{nullptr};
+  std::chrono::steady_clock::time_point m_batchStart;
+  CGUIFontCacheStats m_stats;
+
 public:
   explicit CGUIFontCacheImpl(CGUIFontCache<Position, Value>* parent) : m_parent(parent) {}
   Value& Lookup(const CGraphicContext& context,
@@ -95,6 +116,8 @@ public:
                 std::chrono::steady_clock::time_point now,
                 bool& dirtyCache);
   void Flush();
+  void BeginBatch(std::chrono::steady_clock::time_point now) { m_batchStart = now; }
+  CGUIFontCacheStats GetStats();
 };
 
 template<class Position, class Value>
@@ -164,49 +187,99 @@ Value& CGUIFontCacheImpl<Position, Value>::Lookup(const CGraphicContext& context
                                        context.GetGUIMatrix(), context.GetGUIScaleX(),
                                        context.GetGUIScaleY());
 
+  UpdateSize();
+
   auto i = m_list.FindKey(key);
   if (i == m_list.hashMap.end())
   {
     // Cache miss
     dirtyCache = true;
-    std::unique_ptr<CGUIFontCacheEntry<Position, Value>> entry;
+    m_stats.misses++;
 
-    if (!m_list.ageMap.empty())
+    // Make room for the new entry, reusing the last evicted one
+    std::unique_ptr<Entry> entry;
+    while (m_stats.bytes > FONT_CACHE_MEMORY_LIMIT ||
+           m_list.hashMap.size() >= FONT_CACHE_MAX_ENTRIES)
     {
-      const auto duration =
-          std::chrono::duration_cast<std::chrono::milliseconds>(now - m_list.ageMap.begin()->first);
-      if (duration > FONT_CACHE_TIME_LIMIT)
-      {
-        entry = std::move(m_list.ageMap.begin()->second->second);
-        m_list.hashMap.erase(m_list.ageMap.begin()->second);
-        m_list.ageMap.erase(m_list.ageMap.begin());
-      }
+      std::unique_ptr<Entry> evicted = Evict();
+      if (!evicted)
+        break;
+      entry = std::move(evicted);
     }
 
     // add new entry
     CGUIFontCacheHash<Position> hashgen;
     if (!entry)
-      entry = std::make_unique<CGUIFontCacheEntry<Position, Value>>(*m_parent, key, now);
+      entry = std::make_unique<Entry>(*m_parent, key, now);
     else
       entry->Assign(key, now);
+
+    m_lastEntry = entry.get();
     return m_list.Insert(hashgen(key), std::move(entry))->second->m_value;
   }
   else
   {
     // Cache hit
+    m_stats.hits++;
+
     // Update the translation arguments so that they hold the offset to apply
     // to the cached values (but only in the dynamic case)
     pos.UpdateWithOffsets(i->second->m_key.m_pos, scrolling);
 
-    // Update time in entry and move to the back of the list
+    // Update time in entry and move to the front of the list
     m_list.UpdateAge(i, now);
 
     dirtyCache = false;
 
+    m_lastEntry = i->second.get();
     return i->second->m_value;
   }
 }
 
+template<class Position, class Value>
+void CGUIFontCacheImpl<Position, Value>::UpdateSize()
+{
+  if (!m_lastEntry)
+    return;
+
+  const size_t size = GetFontCacheSize(m_lastEntry->m_value);
+  m_stats.bytes = m_stats.bytes - m_lastEntry->m_size + size;
+  m_lastEntry->m_size = size;
+  m_lastEntry = nullptr;
+}
+
+template<class Position, class Value>
+std::unique_ptr<CGUIFontCacheEntry<Position, Value>> CGUIFontCacheImpl<Position, Value>::Evict()
+{
+  if (m_list.lruList.empty())
+    return {};
+
+  // Text drawn since the start of the batch refers to its entries until it's flushed
+  Entry* oldest = m_list.lruList.back();
+  if (oldest->m_lastUsed >= m_batchStart)
+    return {};
+
+  std::unique_ptr<Entry> entry = m_list.Remove(oldest);
+  if (entry)
+  {
+    m_stats.bytes -= entry->m_size;
+    entry->m_size = 0;
+    m_stats.evictions++;
+  }
+
+  return entry;
+}
+
+template<class Position, class Value>
+CGUIFontCacheStats CGUIFontCacheImpl<Position, Value>::GetStats()
+{
+  UpdateSize();
+
+  CGUIFontCacheStats stats = m_stats;
+  stats.entries = m_list.hashMap.size();
+  return stats;
+}
+
 template<class Position, class Value>
 void CGUIFontCache<Position, Value>::Flush()
 {
@@ -217,6 +290,20 @@ template<class Position, class Value>
 void CGUIFontCacheImpl<Position, Value>::Flush()
 {
   m_list.Flush();
+  m_lastEntry = nullptr;
+  m_stats.bytes = 0;
+}
+
+template<class Position, class Value>
+void CGUIFontCache<Position, Value>::BeginBatch(std::chrono::steady_clock::time_point now)
+{
+  m_impl->BeginBatch(now);
+}
+
+template<class Position, class Value>
+CGUIFontCacheStats CGUIFontCache<Position, Value>::GetStats() const
+{
+  return m_impl->GetStats();
 }
 
 template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::CGUIFontCache(
@@ -236,6 +323,10 @@ template CGUIFontCacheStaticValue& CGUIFontCache<
                                       std::chrono::steady_clock::time_point,
                                       bool&);
 template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Flush();
+template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::BeginBatch(
+    std::chrono::steady_clock::time_point);
+template CGUIFontCacheStats
+CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::GetStats() const;
 
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::CGUIFontCache(
     CGUIFontTTF& font);
@@ -254,9 +345,14 @@ template CGUIFontCacheDynamicValue& CGUIFontCache<
                                        std::chrono::steady_clock::time_point,
                                        bool&);
 template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Flush();
+template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::BeginBatch(
+    std::chrono::steady_clock::time_point);
+template CGUIFontCacheStats
+CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::GetStats() const;
 
 void CVertexBuffer::clear()
 {
   if (m_font)
     m_font->DestroyVertexBuffer(*this);
+  vertices.reset();
 }
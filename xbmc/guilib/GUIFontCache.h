@@ -21,6 +21,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstring>
+#include <list>
 #include <memory>
 #include <span>
 #include <stdint.h>
@@ -81,6 +82,8 @@ struct CGUIFontCacheEntry
   TransformMatrix m_matrix;
   CGUIFontCacheKey<Position> m_key;
   std::chrono::steady_clock::time_point m_lastUsed;
+  size_t m_size{0}; //!< Size of the value accounted in the memory budget of the cache
+  typename std::list<CGUIFontCacheEntry*>::iterator m_lruPosition;
   Value m_value;
 
   CGUIFontCacheEntry(const CGUIFontCache<Position, Value>& cache,
@@ -143,6 +146,26 @@ struct CGUIFontCacheKeysMatch
 };
 
 
+/*!
+ * \brief Statistics of a font cache since it was created
+ */
+struct CGUIFontCacheStats
+{
+  size_t entries{0}; //!< Number of cached texts
+  size_t bytes{0}; //!< Memory used by the cached vertices
+  uint64_t hits{0};
+  uint64_t misses{0};
+  uint64_t evictions{0}; //!< Entries removed to stay within the memory budget
+};
+
+/*!
+ * \brief Cache of the vertices of rendered texts
+ *
+ * Entries are evicted in least recently used order once the cache exceeds
+ * its memory budget. Entries used since the last call to BeginBatch() are
+ * never evicted, as text that was drawn but not flushed yet still refers to
+ * them.
+ */
 template<class Position, class Value>
 class CGUIFontCache
 {
@@ -168,6 +191,13 @@ public:
                 std::chrono::steady_clock::time_point now,
                 bool& dirtyCache);
   void Flush();
+
+  /*!
+   * \brief Start a batch of texts, whose entries must stay valid until the batch is drawn
+   */
+  void BeginBatch(std::chrono::steady_clock::time_point now);
+
+  CGUIFontCacheStats GetStats() const;
 };
 
 struct CGUIFontCacheStaticPosition
@@ -187,6 +217,11 @@ struct CGUIFontCacheStaticValue : public std::shared_ptr<std::vector<SVertex>>
   }
 };
 
+inline size_t GetFontCacheSize(const CGUIFontCacheStaticValue& value)
+{
+  return value ? value->size() * sizeof(SVertex) : 0;
+}
+
 inline bool Match(const CGUIFontCacheStaticPosition& a,
                   const TransformMatrix& a_m,
                   const CGUIFontCacheStaticPosition& b,
@@ -231,13 +266,22 @@ struct CVertexBuffer
 #endif
   BufferHandleType bufferHandle = BUFFER_HANDLE_INIT; // this is really a GLuint
   size_t size = 0;
+  // Vertices kept in system memory by renderers that merge texts before drawing them
+  std::shared_ptr<const std::vector<SVertex>> vertices;
   CVertexBuffer() : m_font(nullptr) {}
   CVertexBuffer(BufferHandleType bufferHandle, size_t size, const CGUIFontTTF* font)
     : bufferHandle(bufferHandle), size(size), m_font(font)
   {
   }
+  CVertexBuffer(std::shared_ptr<const std::vector<SVertex>> vertices, const CGUIFontTTF* font)
+    : size(vertices->size() / 4), vertices(std::move(vertices)), m_font(font)
+  {
+  }
   CVertexBuffer(const CVertexBuffer& other)
-    : bufferHandle(other.bufferHandle), size(other.size), m_font(other.m_font)
+    : bufferHandle(other.bufferHandle),
+      size(other.size),
+      vertices(other.vertices),
+      m_font(other.m_font)
   {
     /* In practice, the copy constructor is only called before a vertex buffer
      * has been attached. If this should ever change, we'll need another support
@@ -251,6 +295,7 @@ struct CVertexBuffer
     bufferHandle = other.bufferHandle;
     other.bufferHandle = 0;
     size = other.size;
+    vertices = std::move(other.vertices);
     m_font = other.m_font;
     return *this;
   }
@@ -262,6 +307,12 @@ private:
 
 typedef CVertexBuffer CGUIFontCacheDynamicValue;
 
+inline size_t GetFontCacheSize(const CVertexBuffer& value)
+{
+  // 4 vertices per character, in video or system memory
+  return value.size * 4 * sizeof(SVertex);
+}
+
 inline bool Match(const CGUIFontCacheDynamicPosition& a,
                   const TransformMatrix& a_m,
                   const CGUIFontCacheDynamicPosition& b,
@@ -331,6 +331,15 @@ void GUIFontManager::FreeFontFile(CGUIFontTTF* pFont)
   {
     if (pFont == it->get())
     {
+      const CGUIFontTTF::Stats stats = pFont->GetStats();
+      CLog::Log(LOGDEBUG,
+                "GUIFontManager::{} - {}: atlas {}x{} {:.0f}% used by {} glyphs, cache {} texts "
+                "in {} KiB ({} hits, {} misses, {} evictions), {} texts in {} draw calls",
+                __FUNCTION__, pFont->GetFontIdent(), stats.atlasWidth, stats.atlasHeight,
+                stats.atlasOccupancy * 100.0f, stats.glyphs, stats.cache.entries,
+                stats.cache.bytes / 1024, stats.cache.hits, stats.cache.misses,
+                stats.cache.evictions, stats.texts, stats.drawCalls);
+
       m_vecFontFiles.erase(it);
       return;
     }
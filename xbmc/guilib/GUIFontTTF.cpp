@@ -21,6 +21,7 @@
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -342,10 +343,18 @@ bool CGUIFontTTF::Load(
 
 void CGUIFontTTF::Begin()
 {
-  if (m_nestedBeginCount == 0 && m_texture && FirstBegin())
+  if (m_nestedBeginCount == 0)
   {
-    m_vertexTrans.clear();
-    m_vertex.clear();
+    // Texts drawn from now on refer to their cache entries until LastEnd()
+    const auto now = std::chrono::steady_clock::now();
+    m_staticCache.BeginBatch(now);
+    m_dynamicCache.BeginBatch(now);
+
+    if (m_texture && FirstBegin())
+    {
+      m_vertexTrans.clear();
+      m_vertex.clear();
+    }
   }
   // Keep track of the nested begin/end calls.
   m_nestedBeginCount++;
@@ -359,9 +368,76 @@ void CGUIFontTTF::End()
   if (--m_nestedBeginCount > 0)
     return;
 
+  m_textCount += m_vertexTrans.size();
+
   LastEnd();
 }
 
+void CGUIFontTTF::BatchTranslatedVertices(CGraphicContext& context)
+{
+  m_batches.clear();
+  m_batchVertices.clear();
+
+  const float scaleX = context.GetGUIScaleX();
+  const float scaleY = context.GetGUIScaleY();
+
+  for (const CTranslatedVertices& text : m_vertexTrans)
+  {
+    const CVertexBuffer& buffer = *text.m_vertexBuffer;
+    if (!buffer.vertices || buffer.vertices->empty())
+      continue;
+
+    // calculate the fractional offset to the ideal position
+    float fractX = context.ScaleFinalXCoord(text.m_translateX, text.m_translateY);
+    float fractY = context.ScaleFinalYCoord(text.m_translateX, text.m_translateY);
+    fractX = -fractX + std::round(fractX);
+    fractY = -fractY + std::round(fractY);
+
+    // scroll * translation * scaling * correction factor, which unbatched
+    // texts apply with their matrix
+    const float translateX = text.m_offsetX + text.m_translateX + scaleX * fractX;
+    const float translateY = text.m_offsetY + text.m_translateY + scaleY * fractY;
+
+    const size_t start = m_batchVertices.size() / 4;
+    for (SVertex vertex : *buffer.vertices)
+    {
+      vertex.x = translateX + scaleX * vertex.x;
+      vertex.y = translateY + scaleY * vertex.y;
+      m_batchVertices.emplace_back(vertex);
+    }
+
+    if (!m_batches.empty() && m_batches.back().m_clip == text.m_clip)
+      m_batches.back().m_count += buffer.size;
+    else
+      m_batches.push_back({start, buffer.size, text.m_clip});
+  }
+}
+
+CGUIFontTTF::Stats CGUIFontTTF::GetStats() const
+{
+  Stats stats;
+
+  if (m_texture)
+  {
+    stats.atlasWidth = m_textureWidth;
+    stats.atlasHeight = m_textureHeight;
+
+    // Glyphs are packed in lines, the last one is filled up to m_posX
+    const double used = static_cast<double>(m_posY) * m_textureWidth +
+                        static_cast<double>(m_posX) * GetTextureLineHeight();
+    const double size = static_cast<double>(m_textureWidth) * m_textureHeight;
+    if (size > 0)
+      stats.atlasOccupancy = static_cast<float>(std::clamp(used / size, 0.0, 1.0));
+  }
+
+  stats.glyphs = m_char.size();
+  stats.cache = m_dynamicCache.GetStats();
+  stats.texts = m_textCount;
+  stats.drawCalls = m_drawCallCount;
+
+  return stats;
+}
+
 void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
                                    float x,
                                    float y,
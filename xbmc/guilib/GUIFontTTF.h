@@ -107,6 +107,22 @@ public:
 
   const std::string& GetFontIdent() const { return m_fontIdent; }
 
+  /*!
+   * \brief Statistics of a font since it was loaded
+   */
+  struct Stats
+  {
+    unsigned int atlasWidth{0}; //!< Size of the texture holding the rendered glyphs
+    unsigned int atlasHeight{0};
+    float atlasOccupancy{0.0f}; //!< Fraction of the texture in use, from 0 to 1
+    size_t glyphs{0}; //!< Number of rendered glyphs
+    CGUIFontCacheStats cache; //!< Statistics of the cache of text vertices
+    uint64_t texts{0}; //!< Number of texts drawn
+    uint64_t drawCalls{0};
+  };
+
+  Stats GetStats() const;
+
 protected:
   explicit CGUIFontTTF(const std::string& fontIdent);
 
@@ -265,6 +281,31 @@ protected:
   std::vector<CTranslatedVertices> m_vertexTrans;
   std::vector<SVertex> m_vertex;
 
+  /*!
+   * \brief Consecutive texts drawn since the first Begin() that share a clip rectangle
+   */
+  struct CTextBatch
+  {
+    size_t m_start; // first character in m_batchVertices
+    size_t m_count; // number of characters
+    CRect m_clip;
+  };
+
+  /*!
+   * \brief Merge the texts drawn since the first Begin() into m_batchVertices
+   *
+   * The vertices are translated and scaled to GUI coordinates, so that each
+   * batch can be drawn with a single draw call. Only texts whose vertex buffer
+   * keeps its vertices in system memory are merged.
+   */
+  void BatchTranslatedVertices(CGraphicContext& context);
+
+  std::vector<CTextBatch> m_batches;
+  std::vector<SVertex> m_batchVertices;
+
+  uint64_t m_textCount{0};
+  uint64_t m_drawCallCount{0};
+
   float m_textureScaleX{0.0f};
   float m_textureScaleY{0.0f};
 
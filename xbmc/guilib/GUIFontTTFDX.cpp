@@ -239,6 +239,7 @@ void CGUIFontTTFDX::LastEnd()
         break;
       }
       pGUIShader->DrawIndexed(count * 6, 0, character * 4);
+      m_drawCallCount++;
     }
     pGUIShader->SetWorld(world);
   }
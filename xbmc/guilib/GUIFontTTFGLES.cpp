@@ -54,6 +54,9 @@ CGUIFontTTFGLES::~CGUIFontTTFGLES(void)
   // our virtual methods won't be accessible after this point
   m_dynamicCache.Flush();
   DeleteHardwareTexture();
+
+  if (m_batchBufferHandle != 0)
+    glDeleteBuffers(1, &m_batchBufferHandle);
 }
 
 bool CGUIFontTTFGLES::FirstBegin()
@@ -173,25 +176,40 @@ void CGUIFontTTFGLES::LastEnd()
   glEnableVertexAttribArray(colLoc);
   glEnableVertexAttribArray(tex0Loc);
 
-  if (!m_vertexTrans.empty())
+  CGraphicContext& context = winSystem->GetGfxContext();
+
+  // Merge the texts drawn since FirstBegin(), so that texts sharing a clip
+  // rectangle are drawn together
+  BatchTranslatedVertices(context);
+
+  if (!m_batchVertices.empty())
   {
-    // Deal with the vertices that can be hardware clipped and therefore translated
+    // Stream the merged vertices to our buffer, orphaning the previous data store
+    if (m_batchBufferHandle == 0)
+      glGenBuffers(1, &m_batchBufferHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, m_batchBufferHandle);
+    glBufferData(GL_ARRAY_BUFFER, m_batchVertices.size() * sizeof(SVertex), m_batchVertices.data(),
+                 GL_STREAM_DRAW);
 
     // Bind our pre-calculated array to GL_ELEMENT_ARRAY_BUFFER
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
     // Store current scissor
-    CGraphicContext& context = winSystem->GetGfxContext();
     CRect scissor = context.StereoCorrection(context.GetScissors());
 
-    for (size_t i = 0; i < m_vertexTrans.size(); i++)
-    {
-      if (m_vertexTrans[i].m_vertexBuffer->bufferHandle == 0)
-      {
-        continue;
-      }
+    // proj * model * gui, the vertices are already translated and scaled
+    CMatrixGL matrix = glMatrixProject.Get();
+    matrix.MultMatrixf(glMatrixModview.Get());
+    matrix.MultMatrixf(CMatrixGL(context.GetGUIMatrix()));
+    glUniformMatrix4fv(matrixUniformLoc, 1, GL_FALSE, matrix);
+
+    // Apply the depth value of the layer
+    float depth = context.GetTransformDepth();
+    glUniform1f(depthLoc, depth);
 
+    for (const CTextBatch& batch : m_batches)
+    {
       // Apply the clip rectangle
-      CRect clip = renderSystem->ClipRectToScissorRect(m_vertexTrans[i].m_clip);
+      CRect clip = renderSystem->ClipRectToScissorRect(batch.m_clip);
       if (!clip.IsEmpty())
       {
         // intersect with current scissor
@@ -210,81 +228,42 @@ void CGUIFontTTFGLES::LastEnd()
         // clip using vertex shader
         renderSystem->ResetScissors();
 
-        const float clipBoundaries[4] = {
-            (m_vertexTrans[i].m_clip.x1 - m_vertexTrans[i].m_translateX -
-             m_vertexTrans[i].m_offsetX) /
-                context.GetGUIScaleX(),
-            (m_vertexTrans[i].m_clip.y1 - m_vertexTrans[i].m_translateY -
-             m_vertexTrans[i].m_offsetY) /
-                context.GetGUIScaleY(),
-            (m_vertexTrans[i].m_clip.x2 - m_vertexTrans[i].m_translateX -
-             m_vertexTrans[i].m_offsetX) /
-                context.GetGUIScaleX(),
-            (m_vertexTrans[i].m_clip.y2 - m_vertexTrans[i].m_translateY -
-             m_vertexTrans[i].m_offsetY) /
-                context.GetGUIScaleY()};
+        const float clipBoundaries[4] = {batch.m_clip.x1, batch.m_clip.y1, batch.m_clip.x2,
+                                         batch.m_clip.y2};
 
         glUniform4fv(clipUniformLoc, 1, clipBoundaries);
 
-        const float textureSteps[4] = {1.f / static_cast<float>(m_textureWidth),
-                                       1.f / static_cast<float>(m_textureHeight), 1.f, 1.f};
+        // the vertices are scaled, so one texel spans more than one unit
+        const float textureSteps[4] = {
+            1.f / (static_cast<float>(m_textureWidth) * context.GetGUIScaleX()),
+            1.f / (static_cast<float>(m_textureHeight) * context.GetGUIScaleY()), 1.f, 1.f};
 
         glUniform4fv(coordStepUniformLoc, 1, textureSteps);
       }
 
-      // calculate the fractional offset to the ideal position
-      float fractX =
-          context.ScaleFinalXCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
-      float fractY =
-          context.ScaleFinalYCoord(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY);
-      fractX = -fractX + std::round(fractX);
-      fractY = -fractY + std::round(fractY);
-
-      // proj * model * gui * scroll * translation * scaling * correction factor
-      CMatrixGL matrix = glMatrixProject.Get();
-      matrix.MultMatrixf(glMatrixModview.Get());
-      matrix.MultMatrixf(CMatrixGL(context.GetGUIMatrix()));
-      matrix.Translatef(m_vertexTrans[i].m_offsetX, m_vertexTrans[i].m_offsetY, 0.0f);
-      matrix.Translatef(m_vertexTrans[i].m_translateX, m_vertexTrans[i].m_translateY, 0.0f);
-      // the gui matrix messes with the scale. correct it here for now.
-      matrix.Scalef(context.GetGUIScaleX(), context.GetGUIScaleY(), 1.0f);
-      // the gui matrix doesn't align to exact pixel coords atm. correct it here for now.
-      matrix.Translatef(fractX, fractY, 0.0f);
-
-      // Apply the depth value of the layer
-      float depth = CServiceBroker::GetWinSystem()->GetGfxContext().GetTransformDepth();
-      glUniform1f(depthLoc, depth);
-
-      glUniformMatrix4fv(matrixUniformLoc, 1, GL_FALSE, matrix);
-
-      // Bind the buffer to the OpenGL context's GL_ARRAY_BUFFER binding point
-      glBindBuffer(GL_ARRAY_BUFFER, m_vertexTrans[i].m_vertexBuffer->bufferHandle);
-
       // Do the actual drawing operation, split into groups of characters no
       // larger than the pre-determined size of the element array
-      for (size_t character = 0; m_vertexTrans[i].m_vertexBuffer->size > character;
+      for (size_t character = 0; batch.m_count > character;
            character += ELEMENT_ARRAY_MAX_CHAR_INDEX)
       {
-        size_t count = m_vertexTrans[i].m_vertexBuffer->size - character;
+        size_t count = batch.m_count - character;
         count = std::min<size_t>(count, ELEMENT_ARRAY_MAX_CHAR_INDEX);
 
+        const size_t offset = (batch.m_start + character) * sizeof(SVertex) * 4;
+
         // Set up the offsets of the various vertex attributes within the buffer
         // object bound to GL_ARRAY_BUFFER
-        glVertexAttribPointer(
-            posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, x)));
-        glVertexAttribPointer(
-            colLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, r)));
-        glVertexAttribPointer(
-            tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex),
-            reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
+        glVertexAttribPointer(posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(SVertex),
+                              reinterpret_cast<GLvoid*>(offset + offsetof(SVertex, x)));
+        glVertexAttribPointer(colLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SVertex),
+                              reinterpret_cast<GLvoid*>(offset + offsetof(SVertex, r)));
+        glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex),
+                              reinterpret_cast<GLvoid*>(offset + offsetof(SVertex, u)));
 
         glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
         CRenderSystemBase::m_GUIElementCount++;
+        m_drawCallCount++;
       }
-
-      glMatrixModview.Pop();
     }
     // Restore the original scissor rectangle
     if (m_scissorClip)
@@ -305,35 +284,10 @@ void CGUIFontTTFGLES::LastEnd()
 CVertexBuffer CGUIFontTTFGLES::CreateVertexBuffer(const std::vector<SVertex>& vertices) const
 {
   assert(vertices.size() % 4 == 0);
-  GLuint bufferHandle = 0;
-
-  // Do not create empty buffers, leave buffer as 0, it will be ignored in drawing stage
-  if (!vertices.empty())
-  {
-    // Generate a unique buffer object name and put it in bufferHandle
-    glGenBuffers(1, &bufferHandle);
-    // Bind the buffer to the OpenGL context's GL_ARRAY_BUFFER binding point
-    glBindBuffer(GL_ARRAY_BUFFER, bufferHandle);
-    // Create a data store for the buffer object bound to the GL_ARRAY_BUFFER
-    // binding point (i.e. our buffer object) and initialise it from the
-    // specified client-side pointer
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(SVertex), vertices.data(),
-                 GL_STATIC_DRAW);
-    // Unbind GL_ARRAY_BUFFER
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-  }
 
-  return CVertexBuffer(bufferHandle, vertices.size() / 4, this);
-}
-
-void CGUIFontTTFGLES::DestroyVertexBuffer(CVertexBuffer& buffer) const
-{
-  if (buffer.bufferHandle != 0)
-  {
-    // Release the buffer name for reuse
-    glDeleteBuffers(1, static_cast<GLuint*>(&buffer.bufferHandle));
-    buffer.bufferHandle = 0;
-  }
+  // Keep the vertices in system memory, they are merged with the other texts
+  // drawn in the same batch and streamed to the GPU in LastEnd()
+  return CVertexBuffer(std::make_shared<const std::vector<SVertex>>(vertices), this);
 }
 
 std::unique_ptr<CTexture> CGUIFontTTFGLES::ReallocTexture(unsigned int& newHeight)
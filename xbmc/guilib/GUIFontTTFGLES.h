@@ -25,7 +25,6 @@ public:
   void LastEnd() override;
 
   CVertexBuffer CreateVertexBuffer(const std::vector<SVertex>& vertices) const override;
-  void DestroyVertexBuffer(CVertexBuffer& bufferHandle) const override;
   static void CreateStaticVertexBuffers(void);
   static void DestroyStaticVertexBuffers(void);
 
@@ -41,6 +40,8 @@ protected:
   static GLuint m_elementArrayHandle;
 
 private:
+  GLuint m_batchBufferHandle{0}; // buffer that the vertices of each batch are streamed to
+
   unsigned int m_updateY1{0};
   unsigned int m_updateY2{0};
 
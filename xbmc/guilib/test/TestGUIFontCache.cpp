@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIFontTTF.h"
+#include "guilib/Texture.h"
+#include "windowing/GraphicContext.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+class CTestFont : public CGUIFontTTF
+{
+public:
+  CTestFont() : CGUIFontTTF("test") {}
+
+protected:
+  std::unique_ptr<CTexture> ReallocTexture(unsigned int& newHeight) override { return nullptr; }
+  bool CopyCharToTexture(FT_BitmapGlyph bitGlyph,
+                         unsigned int x1,
+                         unsigned int y1,
+                         unsigned int x2,
+                         unsigned int y2) override
+  {
+    return false;
+  }
+  void DeleteHardwareTexture() override {}
+
+private:
+  bool FirstBegin() override { return false; }
+  void LastEnd() override {}
+};
+
+using DynamicCache = CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>;
+
+// Vertices of a text of 1000 characters
+constexpr size_t TEXT_VERTICES = 4000;
+
+class TestGUIFontCache : public ::testing::Test
+{
+protected:
+  // Draw a text of its own, filling the cache entry on a miss like CGUIFontTTF does
+  bool Draw(DynamicCache& cache, character_t id, std::chrono::steady_clock::time_point now)
+  {
+    const std::vector<KODI::UTILS::COLOR::Color> colors{0xFFFFFFFF};
+    const std::vector<character_t> text{id, 'a', 'b', 'c'};
+
+    CGUIFontCacheDynamicPosition pos(0.0f, 0.0f, 0.0f);
+    bool dirtyCache = false;
+    CVertexBuffer& buffer =
+        cache.Lookup(m_context, pos, colors, text, 0, 0.0f, false, now, dirtyCache);
+
+    if (dirtyCache)
+    {
+      CVertexBuffer newBuffer(std::make_shared<const std::vector<SVertex>>(TEXT_VERTICES), &m_font);
+      buffer = newBuffer;
+    }
+
+    return !dirtyCache;
+  }
+
+  CGraphicContext m_context;
+  CTestFont m_font;
+};
+} // namespace
+
+TEST_F(TestGUIFontCache, EvictLeastRecentlyUsed)
+{
+  DynamicCache cache(m_font);
+  auto now = std::chrono::steady_clock::now();
+
+  // Draw each text in a batch of its own, so that older texts can be evicted
+  for (character_t id = 0; id < 100; id++)
+  {
+    now += 1ms;
+    cache.BeginBatch(now);
+    EXPECT_FALSE(Draw(cache, id, now));
+
+    // Keep the first text in use
+    EXPECT_TRUE(Draw(cache, 0, now));
+  }
+
+  const CGUIFontCacheStats stats = cache.GetStats();
+  EXPECT_GT(stats.evictions, 0u);
+  EXPECT_LT(stats.entries, 100u);
+  EXPECT_LE(stats.bytes, 2 * 1024 * 1024 + TEXT_VERTICES * sizeof(SVertex));
+
+  now += 1ms;
+  cache.BeginBatch(now);
+  EXPECT_TRUE(Draw(cache, 0, now));
+  EXPECT_TRUE(Draw(cache, 99, now));
+  EXPECT_FALSE(Draw(cache, 1, now));
+}
+
+TEST_F(TestGUIFontCache, KeepTextsOfCurrentBatch)
+{
+  DynamicCache cache(m_font);
+  auto now = std::chrono::steady_clock::now();
+
+  // Texts that weren't drawn yet must stay valid, even over the memory budget
+  cache.BeginBatch(now);
+  for (character_t id = 0; id < 100; id++)
+    EXPECT_FALSE(Draw(cache, id, now));
+
+  const CGUIFontCacheStats stats = cache.GetStats();
+  EXPECT_EQ(stats.entries, 100u);
+  EXPECT_EQ(stats.evictions, 0u);
+  EXPECT_EQ(stats.misses, 100u);
+  EXPECT_EQ(stats.bytes, 100 * TEXT_VERTICES * sizeof(SVertex));
+}
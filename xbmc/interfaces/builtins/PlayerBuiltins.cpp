@@ -17,9 +17,11 @@
 #include "SeekHandler.h"
 #include "ServiceBroker.h"
 #include "Util.h"
+#include "XBDateTime.h"
 #include "application/Application.h"
 #include "application/ApplicationPlayer.h"
 #include "application/ApplicationPowerHandling.h"
+#include "cores/VideoPlayer/VideoPlayerTrace.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "input/actions/Action.h"
@@ -273,6 +275,24 @@ static int PlayerControl(const std::vector<std::string>& params)
     if (appPlayer->IsPlaying())
       appPlayer->OnAction(CAction(ACTION_SHOW_VIDEOMENU));
   }
+  else if (paramlow == "starttrace")
+  {
+    CVideoPlayerTrace::Start();
+  }
+  else if (paramlow == "stoptrace")
+  {
+    CVideoPlayerTrace::Stop();
+  }
+  else if (paramlow == "dumptrace")
+  {
+    const std::string path =
+        StringUtils::Format("special://temp/videoplayer-trace-{}.json",
+                            CDateTime::GetCurrentDateTime().GetAsSaveString());
+    if (CVideoPlayerTrace::Dump(path))
+      CLog::Log(LOGINFO, "PlayerControl(dumptrace) wrote the trace to {}", path);
+    else
+      CLog::Log(LOGERROR, "PlayerControl(dumptrace) failed to write {}", path);
+  }
   else if (StringUtils::StartsWithNoCase(params[0], "partymode"))
   {
     std::string strXspPath;
@@ -828,6 +848,9 @@ static int SubtitleShiftDown(const std::vector<std::string>& params)
 ///     | Partymode(path to .xsp) | Partymode for *.xsp-file               | Partymode for *.xsp-file    |             |
 ///     | ShowVideoMenu           | Shows the DVD/BR menu if available     | none                        |             |
 ///     | FrameAdvance(n) ***     | Advance video by _n_ frames            | none                        | Kodi v18    |
+///     | StartTrace              | Starts recording a playback timeline   | Starts recording a timeline | Kodi v22    |
+///     | StopTrace               | Stops recording the timeline           | Stops recording the timeline| Kodi v22    |
+///     | DumpTrace ****          | Writes the recorded timeline           | Writes the recorded timeline| Kodi v22    |
 ///     <br>
 ///     '*' = For these controls\, the PlayerControl built-in function can make use of the 'notify'-parameter. For example: PlayerControl(random\, notify)
 ///     <br>
@@ -835,6 +858,8 @@ static int SubtitleShiftDown(const std::vector<std::string>& params)
 ///     <br>
 ///     '***' = This only works if the player is paused.
 ///     <br>
+///     '****' = The timeline is written to special://temp/ as Chrome trace JSON\, for chrome://tracing or Perfetto. Recording goes on.
+///     <br>
 ///     @param[in] control               Control to execute.
 ///     @param[in] param                 "notify" to notify user (optional\, certain controls).
 ///
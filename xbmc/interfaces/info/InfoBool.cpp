@@ -8,13 +8,22 @@
 
 #include "InfoBool.h"
 
+#include "GUIInfoManager.h"
 #include "utils/StringUtils.h"
 
 namespace INFO
 {
-InfoBool::InfoBool(const std::string& expression, int context, unsigned int& refreshCounter)
-  : m_context(context), m_expression(expression), m_parentRefreshCounter(refreshCounter)
+InfoBool::InfoBool(const std::string& expression,
+                   int context,
+                   const std::atomic<unsigned int>& refreshCounter)
+  : m_context(context), m_expression(expression), m_parentRefreshCounter(&refreshCounter)
 {
   StringUtils::ToLower(m_expression);
 }
+
+void InfoBool::SetDependency(InfoDependency dependency)
+{
+  m_dependency = dependency;
+  m_parentRefreshCounter = &m_infoMgr->GetRefreshCounter(dependency);
+}
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -16,6 +17,17 @@ class CGUIInfoManager;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief What the value of an info bool depends on, so it's only updated when that changes
+ */
+enum class InfoDependency
+{
+  NONE, ///< never changes, e.g. the platform
+  SKIN_SETTINGS, ///< changes with the settings of the skin
+  FRAME, ///< may change at any time, updated once per frame
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -23,7 +35,9 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string& expression,
+           int context,
+           const std::atomic<unsigned int>& refreshCounter);
   virtual ~InfoBool() = default;
 
   virtual void Initialize(CGUIInfoManager* infoMgr) { m_infoMgr = infoMgr; }
@@ -37,10 +51,15 @@ public:
   {
     if (item && m_listItemDependent)
       Update(contextWindow, item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+    else
     {
-      Update(contextWindow, nullptr);
-      m_refreshCounter = m_parentRefreshCounter;
+      // Bumped from other threads, a stale value is only picked up on the next call
+      const unsigned int refreshCounter = m_parentRefreshCounter->load(std::memory_order_relaxed);
+      if (m_refreshCounter != refreshCounter || m_refreshCounter == 0)
+      {
+        Update(contextWindow, nullptr);
+        m_refreshCounter = refreshCounter;
+      }
     }
     return m_value;
   }
@@ -68,7 +87,15 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  InfoDependency GetDependency() const { return m_dependency; }
+
 protected:
+  /*! \brief Set what the value of this info bool depends on
+   The value is then only updated when the refresh counter of the info manager for the dependency
+   changes. Called from Initialize() once the condition is known.
+   */
+  void SetDependency(InfoDependency dependency);
+
   bool m_value = false; ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent = false; ///< do not cache if a listitem pointer is given
@@ -76,8 +103,9 @@ protected:
   CGUIInfoManager* m_infoMgr;
 
 private:
+  InfoDependency m_dependency = InfoDependency::FRAME;
   unsigned int m_refreshCounter = 0;
-  unsigned int &m_parentRefreshCounter;
+  const std::atomic<unsigned int>* m_parentRefreshCounter;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -11,9 +11,12 @@
 #include "GUIInfoManager.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <stack>
+#include <string>
+#include <vector>
 
 using namespace INFO;
 
@@ -21,6 +24,8 @@ void InfoSingle::Initialize(CGUIInfoManager* infoMgr)
 {
   InfoBool::Initialize(infoMgr);
   m_condition = m_infoMgr->TranslateSingleString(m_expression, m_listItemDependent);
+  if (!m_listItemDependent)
+    SetDependency(m_infoMgr->GetBoolDependency(m_condition));
 }
 
 void InfoSingle::Update(int contextWindow, const CGUIListItem* item)
@@ -29,16 +34,19 @@ void InfoSingle::Update(int contextWindow, const CGUIListItem* item)
   // its value might depend on the context in which the evaluation was called
   int context = m_context == DEFAULT_CONTEXT ? contextWindow : m_context;
   m_value = m_infoMgr->GetBool(m_condition, context, item);
+  m_infoMgr->CountBoolUpdate();
 }
 
 void InfoExpression::Initialize(CGUIInfoManager* infoMgr)
 {
   InfoBool::Initialize(infoMgr);
-  if (!Parse(m_expression))
+  InfoSubexpressionPtr tree;
+  if (!Parse(m_expression, tree))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression {}", m_expression);
-    m_expression_tree = std::make_shared<InfoLeaf>(m_infoMgr->Register("false", 0), false);
+    tree = std::make_shared<InfoLeaf>(m_infoMgr->Register("false", 0), false);
   }
+  Compile(tree);
 }
 
 void InfoExpression::Update(int contextWindow, const CGUIListItem* item)
@@ -46,7 +54,31 @@ void InfoExpression::Update(int contextWindow, const CGUIListItem* item)
   // use propagated context in case this info expression has the default context (i.e. if not tied to a specific window)
   // its value might depend on the context in which the evaluation was called
   int context = m_context == DEFAULT_CONTEXT ? contextWindow : m_context;
-  m_value = m_expression_tree->Evaluate(context, item);
+  m_infoMgr->CountBoolUpdate();
+
+  if (m_type == NODE_LEAF)
+  {
+    const Operand& operand = m_operands.front();
+    m_value = operand.invert ^ operand.info->Get(context, item);
+    return;
+  }
+
+  /* Handle either AND or OR by using the relation
+   * A AND B == !(!A OR !B)
+   * to convert ANDs into ORs
+   */
+  const bool use_and = (m_type == NODE_AND);
+  for (auto it = m_operands.begin(); it != m_operands.end(); ++it)
+  {
+    if (use_and ^ it->invert ^ it->info->Get(context, item))
+    {
+      /* Move this operand to the front so we evaluate faster next time */
+      std::rotate(m_operands.begin(), it, it + 1);
+      m_value = !use_and;
+      return;
+    }
+  }
+  m_value = use_and;
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
@@ -65,13 +97,15 @@ void InfoExpression::Update(int contextWindow, const CGUIListItem* item)
  * 2) Combining adjacent AND or OR operations such that each path from the root
  *    to a leaf encounters a strictly alternating pattern of AND and OR
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
+ *
+ * The tree is then compiled into a flat list of the operands of the root. Each
+ * group below the root is registered with the info manager as an expression of
+ * its own, under a canonical text with its operands sorted, so A|B|C|[D+[E|F|G]]
+ * becomes A|B|C|X with X registered as d+[e|f|g]. Equal groups of different
+ * expressions thus share one info bool, and are evaluated at most once per
+ * refresh however many expressions contain them.
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(int contextWindow, const CGUIListItem* item)
-{
-  return m_invert ^ m_info->Get(contextWindow, item);
-}
-
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
     node_type_t type,
     const InfoSubexpressionPtr &left,
@@ -92,27 +126,59 @@ void InfoExpression::InfoAssociativeGroup::Merge(const std::shared_ptr<InfoAssoc
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(int contextWindow, const CGUIListItem* item)
+void InfoExpression::Compile(const InfoSubexpressionPtr& tree)
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
-   */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(contextWindow, item);
-  while (!result && ++it != last)
+  m_type = tree->Type();
+  m_operands.clear();
+  if (m_type == NODE_LEAF)
+    m_operands.emplace_back(GetOperand(tree));
+  else
   {
-    result = use_and ^ (*it)->Evaluate(contextWindow, item);
-    if (result)
-    {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
-    }
+    for (const auto& child : std::static_pointer_cast<InfoAssociativeGroup>(tree)->Children())
+      m_operands.emplace_back(GetOperand(child));
+  }
+
+  // the expression only has to be evaluated again when one of its operands may have changed
+  InfoDependency dependency = InfoDependency::NONE;
+  for (const auto& operand : m_operands)
+    dependency = std::max(dependency, operand.info->GetDependency());
+  if (!m_listItemDependent)
+    SetDependency(dependency);
+}
+
+InfoExpression::Operand InfoExpression::GetOperand(const InfoSubexpressionPtr& node)
+{
+  if (node->Type() == NODE_LEAF)
+  {
+    const auto leaf = std::static_pointer_cast<InfoLeaf>(node);
+    return {leaf->Info(), leaf->Invert()};
   }
-  return use_and ^ result;
+  return {m_infoMgr->Register(GetText(node), m_context), false};
+}
+
+std::string InfoExpression::GetText(const InfoSubexpressionPtr& node)
+{
+  if (node->Type() == NODE_LEAF)
+  {
+    const auto leaf = std::static_pointer_cast<InfoLeaf>(node);
+    return (leaf->Invert() ? "!" : "") + leaf->Info()->GetExpression();
+  }
+
+  std::vector<std::string> operands;
+  for (const auto& child : std::static_pointer_cast<InfoAssociativeGroup>(node)->Children())
+  {
+    if (child->Type() == NODE_LEAF)
+      operands.emplace_back(GetText(child));
+    else
+      operands.emplace_back("[" + GetText(child) + "]");
+  }
+  std::ranges::sort(operands);
+
+  const char* separator = node->Type() == NODE_AND ? "+" : "|";
+  std::string text = operands.front();
+  for (auto it = operands.begin() + 1; it != operands.end(); ++it)
+    text += separator + *it;
+  return text;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -203,7 +269,7 @@ void InfoExpression::OperatorPop(std::stack<operator_t> &operator_stack, bool &i
   }
 }
 
-bool InfoExpression::Parse(const std::string &expression)
+bool InfoExpression::Parse(const std::string& expression, InfoSubexpressionPtr& tree)
 {
   const char *s = expression.c_str();
   std::string operand;
@@ -303,6 +369,6 @@ bool InfoExpression::Parse(const std::string &expression)
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  tree = nodes.top();
   return true;
 }
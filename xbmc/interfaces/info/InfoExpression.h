@@ -12,6 +12,7 @@
 
 #include <list>
 #include <stack>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -24,7 +25,7 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string& expression, int context, unsigned int& refreshCounter)
+  InfoSingle(const std::string& expression, int context, const std::atomic<unsigned int>& refreshCounter)
     : InfoBool(expression, context, refreshCounter)
   {
   }
@@ -41,7 +42,7 @@ private:
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string& expression, int context, unsigned int& refreshCounter)
+  InfoExpression(const std::string& expression, int context, const std::atomic<unsigned int>& refreshCounter)
     : InfoBool(expression, context, refreshCounter)
   {
   }
@@ -69,12 +70,11 @@ private:
     NODE_OR,
   } node_type_t;
 
-  // An abstract base class for nodes in the expression tree
+  // An abstract base class for nodes in the expression tree, as parsed
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(int contextWindow, const CGUIListItem* item) = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -85,8 +85,9 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(std::move(info)), m_invert(invert) {}
-    bool Evaluate(int contextWindow, const CGUIListItem* item) override;
     node_type_t Type() const override { return NODE_LEAF; }
+    const InfoPtr& Info() const { return m_info; }
+    bool Invert() const { return m_invert; }
 
   private:
     InfoPtr m_info;
@@ -100,18 +101,31 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(const std::shared_ptr<InfoAssociativeGroup>& other);
-    bool Evaluate(int contextWindow, const CGUIListItem* item) override;
     node_type_t Type() const override { return m_type; }
+    const std::list<InfoSubexpressionPtr>& Children() const { return m_children; }
 
   private:
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
   };
 
+  // An operand of the compiled expression, either a condition or a group of the expression
+  // registered as an expression of its own
+  struct Operand
+  {
+    InfoPtr info;
+    bool invert;
+  };
+
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
-  bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  bool Parse(const std::string &expression, InfoSubexpressionPtr& tree);
+  void Compile(const InfoSubexpressionPtr& tree);
+  Operand GetOperand(const InfoSubexpressionPtr& node);
+  static std::string GetText(const InfoSubexpressionPtr& node);
+
+  node_type_t m_type = NODE_LEAF;
+  std::vector<Operand> m_operands;
 };
 
 };
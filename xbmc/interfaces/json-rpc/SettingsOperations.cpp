@@ -8,10 +8,12 @@
 
 #include "SettingsOperations.h"
 
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "addons/Addon.h"
 #include "addons/Skin.h"
 #include "addons/addoninfo/AddonInfo.h"
+#include "guilib/GUIComponent.h"
 #include "resources/LocalizeStrings.h"
 #include "resources/ResourcesComponent.h"
 #include "settings/SettingAddon.h"
@@ -919,5 +921,9 @@ JSONRPC_STATUS CSettingsOperations::SetSkinSettingValue(const std::string& metho
     return InvalidParams;
   }
 
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().ResetSkinSettingsCache();
+
   return OK;
 }
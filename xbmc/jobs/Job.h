@@ -87,7 +87,8 @@ public:
 
    CJob subclasses may optionally implement this to provide customized comparison functionality.
    This is useful for the CJobManager::AddJob() routine, which preempts similar jobs
-   with the new job.
+   with the new job. Jobs of a different type never compare equal, and are not passed
+   to this function by the CJobManager.
 
    \param job the job to compared with this CJob instance.
    \return if true, the two jobs are equal.
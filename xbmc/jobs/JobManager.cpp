@@ -111,13 +111,26 @@ void CJobManager::CancelJobs()
        ++priority)
   {
     std::ranges::for_each(m_jobQueue[priority],
-                          [](CWorkItem& wi)
+                          [](auto& entry)
                           {
+                            CWorkItem& wi = entry.second;
                             for (auto* callback : wi.GetCallbacks())
                               callback->OnJobAbort(wi.GetId(), wi.GetJob());
                             wi.FreeJob();
                           });
     m_jobQueue[priority].clear();
+    m_queuedJobTypes[priority].clear();
+  }
+  m_queuedJobs.clear();
+
+  for (auto& [type, stats] : m_jobTypeStats)
+  {
+    stats.queued = 0;
+    if (stats.started > 0)
+      CLog::Log(LOGDEBUG,
+                "CJobManager: Job type \"{}\": {} started, {} ms average wait, {} ms max wait",
+                type, stats.started, stats.totalWaitTime.count() / 1000 / stats.started,
+                stats.maxWaitTime.count() / 1000);
   }
 
   // cancel any callbacks on jobs still processing
@@ -149,14 +162,24 @@ unsigned int CJobManager::AddJob(CJob* job, IJobCallback* callback, CJob::PRIORI
     return 0;
   }
 
-  // Check if we have this job already in the queue - if so, add callback to existing job
-  auto it = std::ranges::find_if(m_jobQueue[priority],
-                                 [job](const CWorkItem& wi) { return wi.GetJob()->Equals(job); });
-  if (it != m_jobQueue[priority].end())
+  const std::string type = job->GetType();
+  JobQueue& queue = m_jobQueue[priority];
+
+  // Check if we have this job already in the queue - if so, add callback to existing job.
+  // Only jobs of the same type can be equal, so the others aren't compared.
+  const auto typeIt = m_queuedJobTypes[priority].find(type);
+  if (typeIt != m_queuedJobTypes[priority].end())
   {
-    it->AddCallback(callback);
-    delete job;
-    return it->GetId();
+    for (uint64_t position : typeIt->second)
+    {
+      CWorkItem& wi = queue.at(position);
+      if (wi.GetJob()->Equals(job))
+      {
+        wi.AddCallback(callback);
+        delete job;
+        return wi.GetId();
+      }
+    }
   }
 
   // Check if an equal job is already processing - if so, add callback to it.
@@ -179,7 +202,12 @@ unsigned int CJobManager::AddJob(CJob* job, IJobCallback* callback, CJob::PRIORI
 
   // create a work item for this job
   CWorkItem work(job, m_jobCounter, priority, callback);
-  m_jobQueue[priority].emplace_back(work);
+  const uint64_t position = m_queuePosition++;
+  const auto it = queue.emplace(position, work).first;
+
+  m_queuedJobs[work.GetId()] = it;
+  m_queuedJobTypes[priority][type].insert(position);
+  m_jobTypeStats[type].queued++;
 
   StartWorkers(priority);
   return work.GetId();
@@ -190,18 +218,12 @@ void CJobManager::CancelJob(unsigned int jobID)
   std::unique_lock lock(m_section);
 
   // check whether we have this job in the queue
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED;
-       ++priority)
+  const auto i = m_queuedJobs.find(jobID);
+  if (i != m_queuedJobs.end())
   {
-    const auto i = std::ranges::find_if(m_jobQueue[priority],
-                                        [jobID](const auto& wi) { return wi.GetId() == jobID; });
-    if (i != m_jobQueue[priority].cend())
-    {
-      CWorkItem item(std::move(*i));
-      m_jobQueue[priority].erase(i);
-      item.FreeJob();
-      return;
-    }
+    CWorkItem item = TakeQueuedJob(i->second);
+    item.FreeJob();
+    return;
   }
   // or if we're processing it
   const auto it =
@@ -242,8 +264,16 @@ CJob* CJobManager::PopJob()
         m_processing.size() < GetMaxWorkers(CJob::PRIORITY(priority)))
     {
       // pop the job off the queue
-      const CWorkItem job{m_jobQueue[priority].front()};
-      m_jobQueue[priority].pop_front();
+      const CWorkItem job = TakeQueuedJob(m_jobQueue[priority].begin());
+
+      const auto waitTime = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - job.GetQueuedTime());
+
+      JobTypeStats& stats = m_jobTypeStats[job.GetJob()->GetType()];
+      stats.processing++;
+      stats.started++;
+      stats.totalWaitTime += waitTime;
+      stats.maxWaitTime = std::max(stats.maxWaitTime, waitTime);
 
       // add to the processing vector
       m_processing.emplace_back(job);
@@ -343,6 +373,8 @@ void CJobManager::OnJobComplete(bool success, CJob* job)
       // when another thread modifies m_processing during callback execution
       item.emplace(std::move(*i));
       m_processing.erase(i);
+
+      m_jobTypeStats[job->GetType()].processing--;
     }
     return item;
   }();
@@ -395,6 +427,36 @@ size_t CJobManager::GetPendingCallbackCount(const CJob* job) const
   return it != m_pendingCallbacks.end() ? static_cast<size_t>(it->second) : 0;
 }
 
+std::map<std::string, JobTypeStats> CJobManager::GetJobTypeStats() const
+{
+  std::unique_lock lock(m_section);
+  return m_jobTypeStats;
+}
+
+CJobManager::CWorkItem CJobManager::TakeQueuedJob(JobQueue::iterator it)
+{
+  const uint64_t position = it->first;
+  CWorkItem item(std::move(it->second));
+
+  const CJob::PRIORITY priority = item.GetPriority();
+  m_jobQueue[priority].erase(it);
+  m_queuedJobs.erase(item.GetId());
+
+  const std::string type = item.GetJob()->GetType();
+  JobTypeIndex& typeIndex = m_queuedJobTypes[priority];
+  const auto typeIt = typeIndex.find(type);
+  if (typeIt != typeIndex.end())
+  {
+    typeIt->second.erase(position);
+    if (typeIt->second.empty())
+      typeIndex.erase(typeIt);
+  }
+
+  m_jobTypeStats[type].queued--;
+
+  return item;
+}
+
 void CJobManager::RemoveWorker(const CJobWorker* worker)
 {
   std::unique_lock lock(m_section);
@@ -406,7 +468,9 @@ void CJobManager::RemoveWorker(const CJobWorker* worker)
 
 unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority)
 {
-  static const unsigned int max_workers = 5;
+  // Scale with the number of cores, but keep enough workers for jobs that wait on I/O
+  static const unsigned int max_workers =
+      std::clamp(std::thread::hardware_concurrency(), 5U, 16U);
   if (priority == CJob::PRIORITY_DEDICATED)
     return 10000; // A large number..
   return max_workers - (CJob::PRIORITY_HIGH - priority);
@@ -16,13 +16,31 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <map>
 #include <queue>
+#include <set>
+#include <stdint.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 class IJobCallback;
 
+/*!
+ \ingroup jobs
+ \brief Scheduling statistics for one type of job
+ \sa CJobManager::GetJobTypeStats()
+ */
+struct JobTypeStats
+{
+  size_t queued{0}; //!< Number of jobs waiting to be processed
+  size_t processing{0}; //!< Number of jobs being processed
+  uint64_t started{0}; //!< Number of jobs that have left the queue
+  std::chrono::microseconds totalWaitTime{0}; //!< Time started jobs have spent in the queue
+  std::chrono::microseconds maxWaitTime{0}; //!< Longest time a started job has spent in the queue
+};
+
 /*!
  \ingroup jobs
  \brief Job Manager class for scheduling asynchronous jobs.
@@ -30,7 +48,8 @@ class IJobCallback;
  Controls asynchronous job execution, by allowing clients to add and cancel jobs.
  Should be accessed via CServiceBroker::GetJobManager().  Jobs are allocated based
  on priority levels.  Lower priority jobs are executed only if there are sufficient
- spare worker threads free to allow for higher priority jobs that may arise.
+ spare worker threads free to allow for higher priority jobs that may arise.  The number
+ of worker threads scales with the number of CPU cores.
 
  \sa CJob and IJobCallback
  */
@@ -170,6 +189,13 @@ public:
    */
   size_t GetPendingCallbackCount(const CJob* job) const;
 
+  /*!
+   \brief Get the scheduling statistics of all job types seen since startup.
+   \return Statistics indexed by the job type, as returned by CJob::GetType()
+   \sa JobTypeStats
+   */
+  std::map<std::string, JobTypeStats> GetJobTypeStats() const;
+
 private:
   CJobManager(const CJobManager&) = delete;
   CJobManager const& operator=(CJobManager const&) = delete;
@@ -183,7 +209,8 @@ private:
     CWorkItem(CJob* job, unsigned int id, CJob::PRIORITY priority, IJobCallback* callback)
       : m_job(job),
         m_id(id),
-        m_priority(priority)
+        m_priority(priority),
+        m_queuedTime(std::chrono::steady_clock::now())
     {
       if (callback)
         m_callbacks.push_back(callback);
@@ -213,30 +240,54 @@ private:
       return callback;
     }
     CJob::PRIORITY GetPriority() const { return m_priority; }
+    std::chrono::steady_clock::time_point GetQueuedTime() const { return m_queuedTime; }
 
   private:
     CJob* m_job{nullptr};
     unsigned int m_id{0};
     std::vector<IJobCallback*> m_callbacks;
     CJob::PRIORITY m_priority{CJob::PRIORITY::PRIORITY_LOW};
+    std::chrono::steady_clock::time_point m_queuedTime;
   };
 
+  /*!
+   \brief Queue of jobs with the same priority, ordered by their position in the queue
+   */
+  using JobQueue = std::map<uint64_t, CWorkItem>;
+
   /*! \brief Pop a job off the job queue and add to the processing queue ready to process
    \return the job to process, nullptr if no jobs are available
    */
   CJob* PopJob();
 
+  /*!
+   \brief Remove a job from its queue and from the queue indexes
+   \param it the position of the job in the queue of its priority
+   \return the work item of the job
+   */
+  CWorkItem TakeQueuedJob(JobQueue::iterator it);
+
   void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker* worker);
   static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
 
   unsigned int m_jobCounter{0};
+  uint64_t m_queuePosition{0};
 
-  using JobQueue = std::deque<CWorkItem>;
+  using JobIndex = std::unordered_map<unsigned int, JobQueue::iterator>;
+  using JobTypeIndex = std::unordered_map<std::string, std::set<uint64_t>>;
   using Processing = std::vector<CWorkItem>;
   using Workers = std::vector<CJobWorker*>;
 
   std::array<JobQueue, CJob::PRIORITY_DEDICATED + 1> m_jobQueue;
+
+  // Queued jobs by id, so that jobs can be cancelled without searching the queues
+  JobIndex m_queuedJobs;
+
+  // Queue positions by job type, as CJob::Equals() only needs to compare jobs of the same type
+  std::array<JobTypeIndex, CJob::PRIORITY_DEDICATED + 1> m_queuedJobTypes;
+
+  std::map<std::string, JobTypeStats> m_jobTypeStats;
   bool m_pauseJobs{false};
   Processing m_processing;
   Workers m_workers;
@@ -14,7 +14,6 @@
 #include "FileItem.h"
 #include "FileItemList.h"
 #include "GUIInfoManager.h"
-#include "LangInfo.h"
 #include "ServiceBroker.h"
 #include "Song.h"
 #include "TextureCache.h"
@@ -3171,7 +3170,8 @@ void CMusicDatabase::GetFileItemFromDataset(CFileItem* item, const CMusicDbUrl&
   GetFileItemFromDataset(m_pDS->get_sql_record(), item, baseUrl);
 }
 
-void CMusicDatabase::GetFileItemFromDataset(const dbiplus::sql_record* const record,
+template<typename Record>
+void CMusicDatabase::GetFileItemFromDataset(const Record* const record,
                                             CFileItem* item,
                                             const CMusicDbUrl& baseUrl) const
 {
@@ -3331,7 +3331,8 @@ CAlbum CMusicDatabase::GetAlbumFromDataset(const dbiplus::sql_record* const reco
   return album;
 }
 
-CArtistCredit CMusicDatabase::GetArtistCreditFromDataset(const dbiplus::sql_record* const record,
+template<typename Record>
+CArtistCredit CMusicDatabase::GetArtistCreditFromDataset(const Record* const record,
                                                          int offset /* = 0 */) const
 {
   CArtistCredit artistCredit;
@@ -3347,7 +3348,8 @@ CArtistCredit CMusicDatabase::GetArtistCreditFromDataset(const dbiplus::sql_reco
   return artistCredit;
 }
 
-CMusicRole CMusicDatabase::GetArtistRoleFromDataset(const dbiplus::sql_record* const record,
+template<typename Record>
+CMusicRole CMusicDatabase::GetArtistRoleFromDataset(const Record* const record,
                                                     int offset /* = 0 */) const
 {
   CMusicRole ArtistRole(record->at(offset + artistCredit_idRole).get_asInt(),
@@ -6327,16 +6329,10 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string& baseDir,
 
     CLog::LogF(LOGDEBUG, "query = {}", strSQL);
     auto queryStart = std::chrono::steady_clock::now();
-    // run query
-    if (!m_pDS->query(strSQL))
-      return false;
-
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound == 0)
-    {
-      m_pDS->close();
+    // run query, the rows are read in place from a prepared statement of the statement cache
+    const auto statement = m_pDB->prepareStatement(strSQL);
+    if (!statement->step())
       return true;
-    }
 
     auto queryEnd = std::chrono::steady_clock::now();
     auto queryDuration =
@@ -6345,12 +6341,6 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string& baseDir,
     // Store the total number of songs as a property
     items.SetProperty("total", total);
 
-    DatabaseResults results;
-    results.reserve(iRowsFound);
-    // Populate results field vector from dataset
-    FieldList fields;
-    if (!DatabaseUtils::GetDatabaseResults(MediaTypeSong, fields, *m_pDS, results))
-      return false;
     // Store item list sort order
     items.SetSortMethod(sorting.sortBy);
     items.SetSortOrder(sorting.sortOrder);
@@ -6360,13 +6350,10 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string& baseDir,
     int songArtistOffset = song_enumCount;
     int songId = -1;
     std::vector<CArtistCredit> artistCredits;
-    const dbiplus::query_data& data = m_pDS->get_result_set().records;
+    const dbiplus::Statement* const record = statement.get();
     int count = 0;
-    for (const auto& i : results)
+    do
     {
-      const auto targetRow = static_cast<unsigned int>(i.at(Field::ROW).asInteger());
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
       try
       {
         if (songId != record->at(song_idSong).get_asInt())
@@ -6401,11 +6388,10 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string& baseDir,
       }
       catch (...)
       {
-        m_pDS->close();
         CLog::LogF(LOGERROR, "out of memory loading query: {}", filter.where);
         return (items.Size() > 0);
       }
-    }
+    } while (statement->step());
     if (!artistCredits.empty())
     {
       //Store artist credits for final song
@@ -8292,56 +8278,6 @@ bool CMusicDatabase::GetSongsByWhereJSON(
   return false;
 }
 
-std::string CMusicDatabase::GetIgnoreArticleSQL(const std::string& strField) const
-{
-  /*
-  Make SQL clause from ignore article list.
-  Group tokens the same length together, for example :
-    WHEN strArtist LIKE 'the ' OR strArtist LIKE 'the.' strArtist LIKE 'the_' ESCAPE '_'
-    THEN SUBSTR(strArtist, 5)
-    WHEN strArtist LIKE 'an ' OR strArtist LIKE 'an.' strArtist LIKE 'an_' ESCAPE '_'
-    THEN SUBSTR(strArtist, 4)
-  */
-  const CLangInfo::Tokens sortTokens = g_langInfo.GetSortTokens();
-  std::string sortclause;
-  size_t tokenlength = 0;
-  std::string strWhen;
-  for (const auto& token : sortTokens)
-  {
-    if (token.length() != tokenlength)
-    {
-      if (!strWhen.empty())
-      {
-        if (!sortclause.empty())
-          sortclause += " ";
-        std::string strThen = PrepareSQL(" THEN SUBSTR(%s, %i)", strField.c_str(), tokenlength + 1);
-        sortclause += "WHEN " + strWhen + strThen;
-        strWhen.clear();
-      }
-      tokenlength = token.length();
-    }
-    std::string tokenclause = token;
-    //Escape any ' or % in the token
-    StringUtils::Replace(tokenclause, "'", "''");
-    StringUtils::Replace(tokenclause, "%", "%%");
-    // Single %, _ and ' so avoid using PrepareSQL
-    tokenclause = strField + " LIKE '" + tokenclause + "%'";
-    if (token.find('_') != std::string::npos)
-      tokenclause += " ESCAPE '_'";
-    if (!strWhen.empty())
-      strWhen += " OR ";
-    strWhen += tokenclause;
-  }
-  if (!strWhen.empty())
-  {
-    if (!sortclause.empty())
-      sortclause += " ";
-    std::string strThen = PrepareSQL(" THEN SUBSTR(%s, %i)", strField.c_str(), tokenlength + 1);
-    sortclause += "WHEN " + strWhen + strThen;
-  }
-  return sortclause;
-}
-
 std::string CMusicDatabase::SortnameBuildSQL(const std::string& strAlias,
                                              const SortAttribute& sortAttributes,
                                              const std::string& strField,
@@ -8351,8 +8287,8 @@ std::string CMusicDatabase::SortnameBuildSQL(const std::string& strAlias,
   Build SQL for sort name scalar subquery from sort attributes and ignore article list.
   For example :
   CASE WHEN strArtistSort IS NOT NULL THEN strArtistSort
-  WHEN strField LIKE 'the ' OR strField LIKE 'the_' ESCAPE '_' THEN SUBSTR(strArtist, 5)
-  WHEN strField LIKE 'LIKE 'an.' strField LIKE 'an_' ESCAPE '_' THEN SUBSTR(strArtist, 4)
+  WHEN strField LIKE 'the %' OR strField LIKE 'the!_%' ESCAPE '!' THEN SUBSTR(strArtist, 5)
+  WHEN strField LIKE 'an.%' OR strField LIKE 'an!_%' ESCAPE '!' THEN SUBSTR(strArtist, 4)
   ELSE strField
   END AS strAlias
   */
@@ -903,13 +903,14 @@ private:
   CAlbum GetAlbumFromDataset(const dbiplus::sql_record* const record,
                              int offset = 0,
                              bool imageURL = false) const;
-  CArtistCredit GetArtistCreditFromDataset(const dbiplus::sql_record* const record,
-                                           int offset = 0) const;
-  CMusicRole GetArtistRoleFromDataset(const dbiplus::sql_record* const record,
-                                      int offset = 0) const;
+  template<typename Record>
+  CArtistCredit GetArtistCreditFromDataset(const Record* const record, int offset = 0) const;
+  template<typename Record>
+  CMusicRole GetArtistRoleFromDataset(const Record* const record, int offset = 0) const;
   std::string GetMediaDateFromFile(const std::string& strFileNameAndPath) const;
   void GetFileItemFromDataset(CFileItem* item, const CMusicDbUrl& baseUrl);
-  void GetFileItemFromDataset(const dbiplus::sql_record* const record,
+  template<typename Record>
+  void GetFileItemFromDataset(const Record* const record,
                               CFileItem* item,
                               const CMusicDbUrl& baseUrl) const;
   void GetFileItemFromArtistCredits(std::vector<CArtistCredit>& artistCredits,
@@ -933,12 +934,6 @@ private:
   void NormaliseSongDates(std::string& strRelease, std::string& strOriginal) const;
   bool TrimImageURLs(std::string& strImage, const size_t space) const;
 
-  /*! \brief Build SQL  for sort subquery from ignore article token list
-  \param strField original name or title field that articles could be removed from
-  \return SQL string e.g.  WHEN strField LIKE 'the_' ESCAPE '_' THEN SUBSTR(strArtist, 5)
-  */
-  std::string GetIgnoreArticleSQL(const std::string& strField) const;
-
   /*! \brief Build SQL for sort name scalar subquery from sort attributes and ignore article list.
   \param strAlias alias name of scalar subquery field
   \param sortAttributes the sort attributes e.g. SortAttributeIgnoreArticle
@@ -205,6 +205,20 @@ CCPUInfoLinux::CCPUInfoLinux()
 
     if (ecx & CPUID_00000001_ECX_SSE42)
       m_cpuFeatures |= CPU_FEATURE_SSE42;
+
+    // AVX2 is only usable if the OS saves the YMM registers on context switch
+    const unsigned int avxMask = CPUID_00000001_ECX_OSXSAVE | CPUID_00000001_ECX_AVX;
+    if ((ecx & avxMask) == avxMask)
+    {
+      unsigned int xcr0Lo;
+      unsigned int xcr0Hi;
+      __asm__("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+
+      if ((xcr0Lo & 0x6) == 0x6 &&
+          __get_cpuid_count(CPUID_INFOTYPE_STRUCTURED_EXTENDED, 0, &eax, &ebx, &ecx, &edx) &&
+          (ebx & CPUID_00000007_EBX_AVX2))
+        m_cpuFeatures |= CPU_FEATURE_AVX2;
+    }
   }
 
   if (__get_cpuid(CPUID_INFOTYPE_EXTENDED_IMPLEMENTED, &eax, &eax, &ecx, &edx))
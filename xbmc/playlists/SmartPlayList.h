@@ -153,6 +153,8 @@ public:
   void SetGroupMixed(bool mixed) { m_groupMixed = mixed; }
   bool IsGroupMixed() const { return m_groupMixed; }
 
+  const CSmartPlaylistRuleCombination& GetRuleCombination() const { return m_ruleCombination; }
+
   std::optional<WatchedMode> GetWatchedMode() const { return m_watchedMode; }
   void SetWatchedMode(std::optional<WatchedMode> mode) { m_watchedMode = mode; }
 
@@ -59,6 +59,7 @@ public:
   static constexpr auto SETTING_FILELISTS_CONFIRMFILEDELETION = "filelists.confirmfiledeletion";
   static constexpr auto SETTING_FILELISTS_SHOWADDSOURCEBUTTONS = "filelists.showaddsourcebuttons";
   static constexpr auto SETTING_FILELISTS_SHOWHIDDEN = "filelists.showhidden";
+  static constexpr auto SETTING_FILELISTS_PERSISTENTCACHE = "filelists.persistentcache";
   static constexpr auto SETTING_SCREENSAVER_MODE = "screensaver.mode";
   static constexpr auto SETTING_SCREENSAVER_SETTINGS = "screensaver.settings";
   static constexpr auto SETTING_SCREENSAVER_PREVIEW = "screensaver.preview";
@@ -71,6 +72,7 @@ public:
   static constexpr auto SETTING_VIDEOLIBRARY_ACTORTHUMBS = "videolibrary.actorthumbs";
   static constexpr auto SETTING_MYVIDEOS_FLATTEN = "myvideos.flatten";
   static constexpr auto SETTING_VIDEOLIBRARY_FLATTENVERSIONS = "videolibrary.flattenversions";
+  static constexpr auto SETTING_VIDEOLIBRARY_MEMORYINDEX = "videolibrary.memoryindex";
   static constexpr auto SETTING_VIDEOLIBRARY_FLATTENTVSHOWS = "videolibrary.flattentvshows";
   static constexpr auto SETTING_VIDEOLIBRARY_TVSHOWSSELECTFIRSTUNWATCHEDITEM =
       "videolibrary.tvshowsselectfirstunwatcheditem";
@@ -145,6 +147,8 @@ public:
   static constexpr auto SETTING_VIDEOPLAYER_DOVIZEROLEVEL5 = "videoplayer.dovizerolevel5";
   static constexpr auto SETTING_VIDEOPLAYER_QUEUETIMESIZE = "videoplayer.queuetimesize";
   static constexpr auto SETTING_VIDEOPLAYER_QUEUEDATASIZE = "videoplayer.queuedatasize";
+  static constexpr auto SETTING_VIDEOPLAYER_DEMUXREADAHEAD = "videoplayer.demuxreadahead";
+  static constexpr auto SETTING_VIDEOPLAYER_FASTOPEN = "videoplayer.fastopen";
   static constexpr auto SETTING_MYVIDEOS_SELECTACTION = "myvideos.selectaction";
   static constexpr auto SETTING_MYVIDEOS_PLAYACTION = "myvideos.playaction";
   static constexpr auto SETTING_MYVIDEOS_USETAGS = "myvideos.usetags";
@@ -197,6 +201,7 @@ public:
   static constexpr auto SETTING_SCRAPERS_TVSHOWSDEFAULT = "scrapers.tvshowsdefault";
   static constexpr auto SETTING_SCRAPERS_MUSICVIDEOSDEFAULT = "scrapers.musicvideosdefault";
   static constexpr auto SETTING_GAMES_COMPRESSSAVEDGAMES = "games.compresssavedgames";
+  static constexpr auto SETTING_GAMES_DEDUPLICATESAVEDGAMES = "games.deduplicatesavedgames";
   static constexpr auto SETTING_PVRMANAGER_PRESELECTPLAYINGCHANNEL =
       "pvrmanager.preselectplayingchannel";
   static constexpr auto SETTING_PVRMANAGER_BACKENDCHANNELGROUPSORDER =
@@ -489,6 +494,7 @@ public:
   static constexpr auto SETTING_FILECACHE_MEMORYSIZE = "filecache.memorysize"; // in MBytes
   static constexpr auto SETTING_FILECACHE_READFACTOR = "filecache.readfactor"; // as integer (x100)
   static constexpr auto SETTING_FILECACHE_CHUNKSIZE = "filecache.chunksize"; // in Bytes
+  static constexpr auto SETTING_FILECACHE_RANGEREQUESTS = "filecache.rangerequests";
 
   // values for SETTING_VIDEOLIBRARY_SHOWUNWATCHEDPLOTS
   static const int VIDEOLIBRARY_PLOTS_SHOW_UNWATCHED_MOVIES = 0;
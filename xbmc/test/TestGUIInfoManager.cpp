@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "GUIInfoManager.h"
+#include "interfaces/info/Info.h"
+#include "interfaces/info/InfoBool.h"
+
+#include <gtest/gtest.h>
+
+using namespace INFO;
+
+TEST(TestGUIInfoManager, Expressions)
+{
+  CGUIInfoManager infoManager;
+
+  EXPECT_TRUE(infoManager.Register("true")->Get(DEFAULT_CONTEXT));
+  EXPECT_FALSE(infoManager.Register("true + false")->Get(DEFAULT_CONTEXT));
+  EXPECT_TRUE(infoManager.Register("true | false")->Get(DEFAULT_CONTEXT));
+  EXPECT_FALSE(infoManager.Register("!true | false")->Get(DEFAULT_CONTEXT));
+  EXPECT_TRUE(infoManager.Register("![true + false]")->Get(DEFAULT_CONTEXT));
+  EXPECT_TRUE(infoManager.Register("false | [true + !false]")->Get(DEFAULT_CONTEXT));
+  EXPECT_FALSE(infoManager.Register("true + ![false | [true + true]]")->Get(DEFAULT_CONTEXT));
+  EXPECT_TRUE(infoManager.Register("[false | true] + [true | false] + !false")
+                  ->Get(DEFAULT_CONTEXT));
+
+  // a malformed expression is false
+  EXPECT_FALSE(infoManager.Register("true + [false")->Get(DEFAULT_CONTEXT));
+}
+
+TEST(TestGUIInfoManager, SharedSubexpressions)
+{
+  CGUIInfoManager infoManager;
+
+  InfoPtr first = infoManager.Register("System.Platform.Linux | [true + !false]");
+  InfoPtr second = infoManager.Register("[!false + true] | System.Platform.Windows");
+  EXPECT_TRUE(first->Get(DEFAULT_CONTEXT));
+
+  // both expressions share the group, registered with its operands sorted
+  InfoPtr group = infoManager.Register("!false+true");
+  EXPECT_EQ(group.use_count(), 4);
+  EXPECT_TRUE(group->Get(DEFAULT_CONTEXT));
+}
+
+TEST(TestGUIInfoManager, Dependencies)
+{
+  CGUIInfoManager infoManager;
+
+  EXPECT_EQ(infoManager.Register("true")->GetDependency(), InfoDependency::NONE);
+  EXPECT_EQ(infoManager.Register("System.Platform.Linux | [true + false]")->GetDependency(),
+            InfoDependency::NONE);
+  EXPECT_EQ(infoManager.Register("Player.HasMedia")->GetDependency(), InfoDependency::FRAME);
+  EXPECT_EQ(infoManager.Register("true + [false | Player.HasMedia]")->GetDependency(),
+            InfoDependency::FRAME);
+}
+
+TEST(TestGUIInfoManager, Updates)
+{
+  CGUIInfoManager infoManager;
+
+  // an expression, its group and the two conditions
+  InfoPtr constant = infoManager.Register("true + [false | true]");
+  infoManager.ResetBoolUpdates();
+  EXPECT_TRUE(constant->Get(DEFAULT_CONTEXT));
+  infoManager.ResetBoolUpdates();
+  EXPECT_EQ(infoManager.GetBoolUpdates().first, 4u);
+
+  // constant conditions are never updated again
+  infoManager.ResetCache();
+  EXPECT_TRUE(constant->Get(DEFAULT_CONTEXT));
+  infoManager.ResetBoolUpdates();
+  EXPECT_EQ(infoManager.GetBoolUpdates().first, 0u);
+
+  // conditions on the list item are updated for each item
+  InfoPtr folder = infoManager.Register("ListItem.IsFolder + true");
+  CFileItem item("folder", true);
+  EXPECT_TRUE(folder->Get(DEFAULT_CONTEXT, &item));
+  EXPECT_TRUE(folder->Get(DEFAULT_CONTEXT, &item));
+  item.SetFolder(false);
+  EXPECT_FALSE(folder->Get(DEFAULT_CONTEXT, &item));
+  infoManager.ResetBoolUpdates();
+  EXPECT_EQ(infoManager.GetBoolUpdates().first, 6u);
+}
@@ -70,6 +70,7 @@ public:
   bool IsRunning() const;
 
   bool IsCurrentThread() const;
+  const std::string& GetName() const { return m_ThreadName; }
   bool Join(std::chrono::milliseconds duration);
 
   inline static const std::thread::id GetCurrentThreadId()
@@ -18,7 +18,10 @@
 
 #include <algorithm>
 #include <array>
+#include <future>
 #include <limits>
+#include <optional>
+#include <thread>
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -513,143 +516,177 @@ std::string ByBPM(SortAttribute attributes, const SortItem& values)
                              ByLabel(attributes, values));
 }
 
-bool preliminarySort(const SortItem& left,
-                     const SortItem& right,
-                     bool handleFolder,
-                     bool& result,
-                     std::wstring& labelLeft,
-                     std::wstring& labelRight)
+namespace
 {
-  // make sure both items have the necessary data to do the sorting
-  const auto itLeftSort = left.find(Field::SORT);
-  if (itLeftSort == left.end())
-  {
-    result = false;
-    return true;
-  }
-  const auto itRightSort = right.find(Field::SORT);
-  if (itRightSort == right.end())
-  {
-    result = true;
-    return true;
-  }
+// Sort on several threads when each of them gets at least this many items
+constexpr size_t MIN_ITEMS_PER_THREAD = 10000;
 
-  // look at special sorting behaviour
-  SortSpecial leftSortSpecial = SortSpecial::NONE;
-  SortSpecial rightSortSpecial = SortSpecial::NONE;
-  if (const auto itLeft = left.find(Field::SORT_SPECIAL);
-      itLeft != left.end() &&
-      itLeft->second.asInteger() <= static_cast<int64_t>(SortSpecial::BOTTOM))
-    leftSortSpecial = static_cast<SortSpecial>(itLeft->second.asInteger());
-  if (const auto itRight = right.find(Field::SORT_SPECIAL);
-      itRight != right.end() &&
-      itRight->second.asInteger() <= static_cast<int64_t>(SortSpecial::BOTTOM))
-    rightSortSpecial = static_cast<SortSpecial>(itRight->second.asInteger());
-
-  // one has a special sort
-  if (leftSortSpecial != rightSortSpecial)
-  {
-    // left should be sorted on top
-    // or right should be sorted on bottom
-    // => left is sorted above right
-    if (leftSortSpecial == SortSpecial::TOP || rightSortSpecial == SortSpecial::BOTTOM)
-    {
-      result = true;
-      return true;
-    }
+//! The values an item is sorted by, read from the item once before sorting
+struct SortKey
+{
+  std::wstring label;
+  //! The label as StringUtils::AlphaNumericCompare() compares it
+  std::wstring foldedLabel;
+  SortSpecial special{SortSpecial::NONE};
+  //! Whether the item is a folder, if the item tells
+  std::optional<bool> folder;
+  //! The position of the item in the list
+  size_t index{0};
+};
 
-    // otherwise right is sorted above left
-    result = false;
-    return true;
-  }
-  // both have either sort on top or sort on bottom -> leave as-is
-  else if (leftSortSpecial != SortSpecial::NONE)
+SortKey GetSortKey(const SortItem& item, size_t index)
+{
+  SortKey key;
+  key.label = item.at(Field::SORT).asWideString();
+  key.foldedLabel = StringUtils::AlphaNumericFold(key.label);
+  if (const auto special = item.find(Field::SORT_SPECIAL);
+      special != item.end() &&
+      special->second.asInteger() <= static_cast<int64_t>(SortSpecial::BOTTOM))
+    key.special = static_cast<SortSpecial>(special->second.asInteger());
+  if (const auto folder = item.find(Field::FOLDER); folder != item.end())
+    key.folder = folder->second.asBoolean();
+  key.index = index;
+  return key;
+}
+
+class SortKeyLess
+{
+public:
+  SortKeyLess(SortOrder sortOrder, SortAttribute attributes)
+    : m_descending(sortOrder == SortOrder::DESCENDING),
+      m_handleFolders(!(attributes & SortAttributeIgnoreFolders))
   {
-    result = false;
-    return true;
   }
 
-  if (handleFolder)
+  bool operator()(const SortKey& left, const SortKey& right) const
   {
-    const auto itLeft = left.find(Field::FOLDER);
-    const auto itRight = right.find(Field::FOLDER);
-    if (itLeft != left.end() && itRight != right.end() &&
-        itLeft->second.asBoolean() != itRight->second.asBoolean())
+    // one has a special sort
+    if (left.special != right.special)
     {
-      result = itLeft->second.asBoolean();
-      return true;
+      // left should be sorted on top
+      // or right should be sorted on bottom
+      // => left is sorted above right
+      return left.special == SortSpecial::TOP || right.special == SortSpecial::BOTTOM;
     }
-  }
-
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
+    // both have either sort on top or sort on bottom -> leave as-is
+    if (left.special != SortSpecial::NONE)
+      return false;
 
-  return false;
-}
+    if (m_handleFolders && left.folder && right.folder && *left.folder != *right.folder)
+      return *left.folder;
 
-bool SorterAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+    const int64_t result = StringUtils::AlphaNumericCompare(left.label, left.foldedLabel,
+                                                            right.label, right.foldedLabel);
+    return m_descending ? result > 0 : result < 0;
+  }
 
-  return StringUtils::AlphaNumericCompare(labelLeft, labelRight) < 0;
-}
+private:
+  bool m_descending;
+  bool m_handleFolders;
+};
 
-bool SorterDescending(const SortItem &left, const SortItem &right)
+void StableSort(std::vector<SortKey>& keys, const SortKeyLess& less)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+  const size_t threads = std::min(static_cast<size_t>(std::thread::hardware_concurrency()),
+                                  keys.size() / MIN_ITEMS_PER_THREAD);
+  if (threads < 2)
+  {
+    std::stable_sort(keys.begin(), keys.end(), less);
+    return;
+  }
 
-  return StringUtils::AlphaNumericCompare(labelLeft, labelRight) > 0;
-}
+  // Sort a run of keys per thread, then merge neighbouring runs until one is left. Merging keeps
+  // equal keys of the left run ahead of those of the right one, so the sort stays stable.
+  std::vector<size_t> bounds;
+  for (size_t run = 0; run <= threads; run++)
+    bounds.emplace_back(keys.size() * run / threads);
 
-bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+  std::vector<std::future<void>> tasks;
+  for (size_t run = 1; run < threads; run++)
+  {
+    tasks.emplace_back(std::async(std::launch::async,
+                                  [&keys, &bounds, &less, run]
+                                  {
+                                    std::stable_sort(keys.begin() + bounds[run],
+                                                     keys.begin() + bounds[run + 1], less);
+                                  }));
+  }
+  std::stable_sort(keys.begin(), keys.begin() + bounds[1], less);
+  for (const auto& task : tasks)
+    task.wait();
 
-  return StringUtils::AlphaNumericCompare(labelLeft, labelRight) < 0;
+  for (size_t width = 1; width < threads; width *= 2)
+  {
+    tasks.clear();
+    for (size_t run = 0; run + width < threads; run += 2 * width)
+    {
+      const auto first = keys.begin() + bounds[run];
+      const auto middle = keys.begin() + bounds[run + width];
+      const auto last = keys.begin() + bounds[std::min(run + 2 * width, threads)];
+      tasks.emplace_back(std::async(std::launch::async, [first, middle, last, &less]
+                                    { std::inplace_merge(first, middle, last, less); }));
+    }
+    for (const auto& task : tasks)
+      task.wait();
+  }
 }
 
-bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
+template<typename Items, typename GetItem>
+void SortAndLimit(const SortUtils::SortPreparator& preparator,
+                  SortBy sortBy,
+                  SortOrder sortOrder,
+                  SortAttribute attributes,
+                  Items& items,
+                  int limitEnd,
+                  int limitStart,
+                  GetItem getItem)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+  if (sortBy != SortBy::NONE && preparator)
+  {
+    const Fields& sortingFields = SortUtils::GetFieldsForSorting(sortBy);
+
+    // Prepare the string used for sorting and store it under FieldSort, then read the values the
+    // items are sorted by into keys, so that sorting compares the keys without looking them up in
+    // the items or folding their letters again
+    std::vector<SortKey> keys;
+    keys.reserve(items.size());
+    for (size_t index = 0; index < items.size(); index++)
+    {
+      SortItem& item = getItem(items[index]);
 
-  return StringUtils::AlphaNumericCompare(labelLeft, labelRight) > 0;
-}
+      // add all fields to the item that are required for sorting if they are currently missing
+      for (const auto& field : sortingFields)
+      {
+        if (!item.contains(field))
+          item.emplace(field, CVariant::ConstNullVariant);
+      }
 
-bool SorterIndirectAscending(const std::shared_ptr<SortItem>& left,
-                             const std::shared_ptr<SortItem>& right)
-{
-  return SorterAscending(*left, *right);
-}
+      std::wstring sortLabel;
+      g_charsetConverter.utf8ToW(preparator(attributes, item), sortLabel, false);
+      item.emplace(Field::SORT, CVariant(sortLabel));
 
-bool SorterIndirectDescending(const std::shared_ptr<SortItem>& left,
-                              const std::shared_ptr<SortItem>& right)
-{
-  return SorterDescending(*left, *right);
-}
+      keys.emplace_back(GetSortKey(item, index));
+    }
 
-bool SorterIndirectIgnoreFoldersAscending(const std::shared_ptr<SortItem>& left,
-                                          const std::shared_ptr<SortItem>& right)
-{
-  return SorterIgnoreFoldersAscending(*left, *right);
-}
+    // Do the sorting
+    StableSort(keys, SortKeyLess(sortOrder, attributes));
 
-bool SorterIndirectIgnoreFoldersDescending(const std::shared_ptr<SortItem>& left,
-                                           const std::shared_ptr<SortItem>& right)
-{
-  return SorterIgnoreFoldersDescending(*left, *right);
+    Items sortedItems;
+    sortedItems.reserve(items.size());
+    for (const SortKey& key : keys)
+      sortedItems.emplace_back(std::move(items[key.index]));
+    items = std::move(sortedItems);
+  }
+
+  if (limitStart > 0 && static_cast<size_t>(limitStart) < items.size())
+  {
+    items.erase(items.begin(), items.begin() + limitStart);
+    limitEnd -= limitStart;
+  }
+  if (limitEnd > 0 && static_cast<size_t>(limitEnd) < items.size())
+    items.erase(items.begin() + limitEnd, items.end());
 }
+} // namespace
 
 // clang-format off
 std::map<SortBy, SortUtils::SortPreparator> fillPreparators()
@@ -967,6 +1004,54 @@ void SortUtils::GetFieldsForSQLSort(const MediaType& mediaType,
     else if (sortMethod == SortBy::DATE_ADDED)
       fields.emplace_back(Field::DATE_ADDED);
   }
+  else if (mediaType == MediaTypeMovie || mediaType == MediaTypeEpisode)
+  {
+    // The fields the preparators build the sort label from, Field::LABEL is the label of the
+    // item e.g. "102. Title" for an episode
+    if (sortMethod == SortBy::LABEL)
+      fields.emplace_back(Field::LABEL);
+    else if (sortMethod == SortBy::TITLE)
+      fields.emplace_back(Field::TITLE);
+    else if (sortMethod == SortBy::SORT_TITLE && mediaType == MediaTypeMovie)
+      fields.emplace_back(Field::SORT_TITLE);
+    else if (sortMethod == SortBy::YEAR && mediaType == MediaTypeMovie)
+    {
+      fields.emplace_back(Field::YEAR);
+      fields.emplace_back(Field::LABEL);
+    }
+    else if (sortMethod == SortBy::EPISODE_NUMBER && mediaType == MediaTypeEpisode)
+    {
+      fields.emplace_back(Field::EPISODE_NUMBER);
+      fields.emplace_back(Field::LABEL);
+    }
+    else if (sortMethod == SortBy::DATE_ADDED)
+      fields.emplace_back(Field::DATE_ADDED);
+    else if (sortMethod == SortBy::RATING)
+    {
+      fields.emplace_back(Field::RATING);
+      fields.emplace_back(Field::LABEL);
+    }
+    else if (sortMethod == SortBy::USER_RATING)
+    {
+      fields.emplace_back(Field::USER_RATING);
+      fields.emplace_back(Field::LABEL);
+    }
+    else if (sortMethod == SortBy::VOTES)
+    {
+      fields.emplace_back(Field::VOTES);
+      fields.emplace_back(Field::LABEL);
+    }
+    else if (sortMethod == SortBy::PLAYCOUNT)
+    {
+      fields.emplace_back(Field::PLAYCOUNT);
+      fields.emplace_back(Field::LABEL);
+    }
+    else if (sortMethod == SortBy::LAST_PLAYED)
+    {
+      fields.emplace_back(Field::LAST_PLAYED);
+      fields.emplace_back(Field::LABEL);
+    }
+  }
 
   // Add sort by id to define order when other fields same or sort none
   fields.emplace_back(Field::ID);
@@ -975,80 +1060,14 @@ void SortUtils::GetFieldsForSQLSort(const MediaType& mediaType,
 
 void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, DatabaseResults& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
 {
-  if (sortBy != SortBy::NONE)
-  {
-    // get the matching SortPreparator
-    SortPreparator preparator = getPreparator(sortBy);
-    if (preparator)
-    {
-      Fields sortingFields = GetFieldsForSorting(sortBy);
-
-      // Prepare the string used for sorting and store it under FieldSort
-      for (auto& item : items)
-      {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (const auto& field : sortingFields)
-        {
-          if (!item.contains(field))
-            item.emplace(field, CVariant::ConstNullVariant);
-        }
-
-        std::wstring sortLabel;
-        g_charsetConverter.utf8ToW(preparator(attributes, item), sortLabel, false);
-        item.emplace(Field::SORT, CVariant(sortLabel));
-      }
-
-      // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
-    }
-  }
-
-  if (limitStart > 0 && static_cast<size_t>(limitStart) < items.size())
-  {
-    items.erase(items.begin(), items.begin() + limitStart);
-    limitEnd -= limitStart;
-  }
-  if (limitEnd > 0 && static_cast<size_t>(limitEnd) < items.size())
-    items.erase(items.begin() + limitEnd, items.end());
+  SortAndLimit(getPreparator(sortBy), sortBy, sortOrder, attributes, items, limitEnd, limitStart,
+               [](DatabaseResult& item) -> SortItem& { return item; });
 }
 
 void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, SortItems& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
 {
-  if (sortBy != SortBy::NONE)
-  {
-    // get the matching SortPreparator
-    SortPreparator preparator = getPreparator(sortBy);
-    if (preparator)
-    {
-      Fields sortingFields = GetFieldsForSorting(sortBy);
-
-      // Prepare the string used for sorting and store it under FieldSort
-      for (auto& item : items)
-      {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (const auto& field : sortingFields)
-        {
-          if (!item->contains(field))
-            item->emplace(field, CVariant::ConstNullVariant);
-        }
-
-        std::wstring sortLabel;
-        g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
-        item->emplace(Field::SORT, CVariant(sortLabel));
-      }
-
-      // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
-    }
-  }
-
-  if (limitStart > 0 && static_cast<size_t>(limitStart) < items.size())
-  {
-    items.erase(items.begin(), items.begin() + limitStart);
-    limitEnd -= limitStart;
-  }
-  if (limitEnd > 0 && static_cast<size_t>(limitEnd) < items.size())
-    items.erase(items.begin() + limitEnd, items.end());
+  SortAndLimit(getPreparator(sortBy), sortBy, sortOrder, attributes, items, limitEnd, limitStart,
+               [](const std::shared_ptr<SortItem>& item) -> SortItem& { return *item; });
 }
 
 void SortUtils::Sort(const SortDescription &sortDescription, DatabaseResults& items)
@@ -1093,24 +1112,6 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return it == m_preparators.end() ? m_preparators[SortBy::NONE] : it->second;
 }
 
-SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrder::DESCENDING ? SorterIgnoreFoldersDescending
-                                              : SorterIgnoreFoldersAscending;
-
-  return sortOrder == SortOrder::DESCENDING ? SorterDescending : SorterAscending;
-}
-
-SortUtils::SorterIndirect SortUtils::getSorterIndirect(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrder::DESCENDING ? SorterIndirectIgnoreFoldersDescending
-                                              : SorterIndirectIgnoreFoldersAscending;
-
-  return sortOrder == SortOrder::DESCENDING ? SorterIndirectDescending : SorterIndirectAscending;
-}
-
 const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
 {
   const auto it = m_sortingFields.find(sortBy);
@@ -1094,7 +1094,9 @@ static bool CollationMirrorsMySql()
 }
 } // namespace
 
-static wchar_t GetCollationWeight(const wchar_t& r)
+static wchar_t GetCollationWeight(const wchar_t& r,
+                                  bool mirrorsMySql,
+                                  std::string_view languageCode)
 {
   // Nordic languages order some accented vowels as distinct letters at the end of their
   // alphabet rather than as accented variants of a/o (see StringUtils::GetNordicCollationWeight).
@@ -1104,10 +1106,9 @@ static wchar_t GetCollationWeight(const wchar_t& r)
   //! on some platforms. It should be removed once all platforms have a proper collation facet
   //! implementation for the configured language, and the fallback to accent folding is no
   //! longer needed.
-  if (!CollationMirrorsMySql())
+  if (!mirrorsMySql)
   {
-    const wchar_t nordicWeight =
-        StringUtils::GetNordicCollationWeight(g_langInfo.GetLanguageCode(), r);
+    const wchar_t nordicWeight = StringUtils::GetNordicCollationWeight(languageCode, r);
     if (nordicWeight != 0)
       return nordicWeight;
   }
@@ -1124,11 +1125,20 @@ static wchar_t GetCollationWeight(const wchar_t& r)
   return static_cast<wchar_t>(plane[r & 0xFF]);
 }
 
-// Compares separately the numeric and alphabetic parts of a wide string.
-// returns negative if left < right, positive if left > right
-// and 0 if they are identical.
-// See also the equivalent StringUtils::AlphaNumericCollation() for UFT8 data
-int64_t StringUtils::AlphaNumericCompare(std::wstring_view left, std::wstring_view right) noexcept
+static wchar_t GetCollationWeight(const wchar_t& r)
+{
+  return GetCollationWeight(r, CollationMirrorsMySql(), g_langInfo.GetLanguageCode());
+}
+
+namespace
+{
+// Compares separately the numeric and alphabetic parts of a wide string, with fold(i, c) giving
+// the character c at index i of the string as it is compared
+template<typename FoldLeft, typename FoldRight>
+int64_t CompareAlphaNumeric(std::wstring_view left,
+                            std::wstring_view right,
+                            FoldLeft foldLeft,
+                            FoldRight foldRight) noexcept
 {
   auto l{left.cbegin()};
   auto r{right.cbegin()};
@@ -1186,21 +1196,8 @@ int64_t StringUtils::AlphaNumericCompare(std::wstring_view left, std::wstring_vi
         continue;
       }
     }
-    if (!g_langInfo.UseLocaleCollation())
-    {
-      // Apply case sensitive accent folding collation to non-ascii chars.
-      // This mimics utf8_general_ci collation, and provides simple collation of LATIN-1 chars
-      // for any platformthat doesn't have a language specific collate facet implemented
-      if (lc > 128)
-        lc = GetCollationWeight(lc);
-      if (rc > 128)
-        rc = GetCollationWeight(rc);
-    }
-    // Do case less comparison, convert ascii upper case to lower case
-    if (lc >= L'A' && lc <= L'Z')
-      lc += L'a' - L'A';
-    if (rc >= L'A' && rc <= L'Z')
-      rc += L'a' - L'A';
+    lc = foldLeft(std::distance(left.cbegin(), l), lc);
+    rc = foldRight(std::distance(right.cbegin(), r), rc);
 
     if (lc != rc)
     {
@@ -1234,6 +1231,59 @@ int64_t StringUtils::AlphaNumericCompare(std::wstring_view left, std::wstring_vi
   return 0; // files are the same
 }
 
+wchar_t FoldAlphaNumeric(wchar_t c)
+{
+  if (!g_langInfo.UseLocaleCollation())
+  {
+    // Apply case sensitive accent folding collation to non-ascii chars.
+    // This mimics utf8_general_ci collation, and provides simple collation of LATIN-1 chars
+    // for any platformthat doesn't have a language specific collate facet implemented
+    if (c > 128)
+      c = GetCollationWeight(c);
+  }
+  // Do case less comparison, convert ascii upper case to lower case
+  if (c >= L'A' && c <= L'Z')
+    c += L'a' - L'A';
+  return c;
+}
+} // namespace
+
+// Compares separately the numeric and alphabetic parts of a wide string.
+// returns negative if left < right, positive if left > right
+// and 0 if they are identical.
+// See also the equivalent StringUtils::AlphaNumericCollation() for UFT8 data
+int64_t StringUtils::AlphaNumericCompare(std::wstring_view left, std::wstring_view right) noexcept
+{
+  const auto fold = [](size_t, wchar_t c) { return FoldAlphaNumeric(c); };
+  return CompareAlphaNumeric(left, right, fold, fold);
+}
+
+int64_t StringUtils::AlphaNumericCompare(std::wstring_view left,
+                                         std::wstring_view leftFolded,
+                                         std::wstring_view right,
+                                         std::wstring_view rightFolded) noexcept
+{
+  return CompareAlphaNumeric(
+      left, right, [leftFolded](size_t i, wchar_t) { return leftFolded[i]; },
+      [rightFolded](size_t i, wchar_t) { return rightFolded[i]; });
+}
+
+std::wstring StringUtils::AlphaNumericFold(std::wstring_view str)
+{
+  std::wstring folded(str);
+  const bool useLocaleCollation = g_langInfo.UseLocaleCollation();
+  const bool mirrorsMySql = CollationMirrorsMySql();
+  const std::string& languageCode = g_langInfo.GetLanguageCode();
+  for (wchar_t& c : folded)
+  {
+    if (!useLocaleCollation && c > 128)
+      c = GetCollationWeight(c, mirrorsMySql, languageCode);
+    if (c >= L'A' && c <= L'Z')
+      c += L'a' - L'A';
+  }
+  return folded;
+}
+
 /*
   Convert the UTF8 character to which z points into a 31-bit Unicode point.
   Return how many bytes (0 to 3) of UTF8 data encode the character.
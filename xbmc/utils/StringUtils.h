@@ -278,6 +278,26 @@ public:
   [[nodiscard]] static int FindNumber(std::string_view strInput, std::string_view strFind) noexcept;
   [[nodiscard]] static int64_t AlphaNumericCompare(std::wstring_view left,
                                                    std::wstring_view right) noexcept;
+  /*! \brief AlphaNumericCompare() of two strings whose letters have been folded in advance.
+   *
+   * Folding the letters, i.e. looking up their collation weights, is the costly part of
+   * AlphaNumericCompare(). When sorting, fold each string once with AlphaNumericFold() and
+   * compare the folded strings as often as needed.
+   *
+   * \param left the string to compare
+   * \param leftFolded AlphaNumericFold() of left
+   * \param right the string to compare to
+   * \param rightFolded AlphaNumericFold() of right
+   * \return the same as AlphaNumericCompare(left, right)
+   */
+  [[nodiscard]] static int64_t AlphaNumericCompare(std::wstring_view left,
+                                                   std::wstring_view leftFolded,
+                                                   std::wstring_view right,
+                                                   std::wstring_view rightFolded) noexcept;
+  /*! \brief Fold the letters of a string as AlphaNumericCompare() compares them.
+   * \sa AlphaNumericCompare(std::wstring_view, std::wstring_view, std::wstring_view, std::wstring_view)
+   */
+  [[nodiscard]] static std::wstring AlphaNumericFold(std::wstring_view str);
   [[nodiscard]] static int AlphaNumericCollation(int nKey1,
                                                  const void* pKey1,
                                                  int nKey2,
@@ -211,3 +211,94 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+namespace
+{
+struct TypedJobFlags
+{
+  std::atomic<bool> finished{false};
+  std::atomic<bool> deleted{false};
+};
+
+class TypedJob : public CJob
+{
+public:
+  TypedJob(TypedJobFlags* flags, int key) : m_flags(flags), m_key(key) {}
+  ~TypedJob() override { m_flags->deleted = true; }
+
+  const char* GetType() const override { return "TypedJob"; }
+
+  bool Equals(const CJob* job) const override
+  {
+    return m_key == static_cast<const TypedJob*>(job)->m_key;
+  }
+
+  bool DoWork() override
+  {
+    m_flags->finished = true;
+    return true;
+  }
+
+private:
+  TypedJobFlags* m_flags;
+  int m_key;
+};
+
+size_t GetQueuedCount(const std::string& type)
+{
+  const auto stats = CServiceBroker::GetJobManager()->GetJobTypeStats();
+  const auto it = stats.find(type);
+  return it != stats.end() ? it->second.queued : 0;
+}
+} // namespace
+
+TEST_F(TestJobManager, CancelQueuedJob)
+{
+  TypedJobFlags flags1;
+  TypedJobFlags flags2;
+  TypedJobFlags duplicateFlags;
+
+  // Pausable jobs stay queued while paused
+  CServiceBroker::GetJobManager()->PauseJobs();
+
+  const unsigned int id1 = CServiceBroker::GetJobManager()->AddJob(
+      new TypedJob(&flags1, 1), nullptr, CJob::PRIORITY_LOW_PAUSABLE);
+  const unsigned int id2 = CServiceBroker::GetJobManager()->AddJob(
+      new TypedJob(&flags2, 2), nullptr, CJob::PRIORITY_LOW_PAUSABLE);
+  EXPECT_NE(id1, id2);
+  EXPECT_EQ(2u, GetQueuedCount("TypedJob"));
+
+  // An equal job is merged with the queued one
+  EXPECT_EQ(id1, CServiceBroker::GetJobManager()->AddJob(new TypedJob(&duplicateFlags, 1), nullptr,
+                                                         CJob::PRIORITY_LOW_PAUSABLE));
+  EXPECT_TRUE(duplicateFlags.deleted);
+  EXPECT_EQ(2u, GetQueuedCount("TypedJob"));
+
+  // A cancelled job is removed from the queue and destroyed without running
+  CServiceBroker::GetJobManager()->CancelJob(id1);
+  EXPECT_TRUE(flags1.deleted);
+  EXPECT_FALSE(flags1.finished);
+  EXPECT_EQ(1u, GetQueuedCount("TypedJob"));
+
+  CServiceBroker::GetJobManager()->CancelJob(id2);
+  EXPECT_TRUE(flags2.deleted);
+  EXPECT_EQ(0u, GetQueuedCount("TypedJob"));
+
+  CServiceBroker::GetJobManager()->UnPauseJobs();
+}
+
+TEST_F(TestJobManager, JobTypeStats)
+{
+  TypedJobFlags flags;
+  CServiceBroker::GetJobManager()->AddJob(new TypedJob(&flags, 1), nullptr);
+
+  ASSERT_TRUE(poll([&flags]() -> bool { return flags.deleted; }));
+
+  const auto stats = CServiceBroker::GetJobManager()->GetJobTypeStats();
+  const auto it = stats.find("TypedJob");
+  ASSERT_NE(it, stats.end());
+  EXPECT_EQ(0u, it->second.queued);
+  EXPECT_EQ(0u, it->second.processing);
+  EXPECT_EQ(1u, it->second.started);
+  EXPECT_LE(it->second.maxWaitTime, it->second.totalWaitTime);
+}
@@ -6,11 +6,321 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include "LangInfo.h"
+#include "ServiceBroker.h"
+#include "dbwrappers/sqlitedataset.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/CharsetConverter.h"
+#include "utils/DatabaseUtils.h"
 #include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
+#include "video/VideoDatabase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+namespace
+{
+SortItems MakeItems(size_t count, unsigned int seed)
+{
+  const std::string words[] = {"The", "Alien", "alien", "Éclair", "Zebra", "Ångström", "10", "9",
+                               "Part 2", "Part 10", "(Untitled)", "Ölfarbe", "ecran", "-"};
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<size_t> word(0, std::size(words) - 1);
+
+  SortItems items;
+  for (size_t i = 0; i < count; i++)
+  {
+    std::string label = words[word(random)];
+    for (size_t extra = random() % 3; extra > 0; extra--)
+      label += " " + words[word(random)];
+
+    auto item = std::make_shared<SortItem>();
+    (*item)[Field::LABEL] = label;
+    (*item)[Field::ID] = static_cast<int64_t>(i);
+    if (random() % 4 == 0)
+      (*item)[Field::FOLDER] = random() % 2 == 0;
+    if (random() % 50 == 0)
+      (*item)[Field::SORT_SPECIAL] = static_cast<int64_t>(random() % 3);
+    items.emplace_back(std::move(item));
+  }
+  return items;
+}
+
+// The comparison SortUtils::Sort() made on each pair of items before it read them into keys
+bool CompareItems(const SortItem& left, const SortItem& right, bool handleFolder, bool descending)
+{
+  const auto special = [](const SortItem& item)
+  {
+    const auto it = item.find(Field::SORT_SPECIAL);
+    return it != item.end() ? static_cast<SortSpecial>(it->second.asInteger()) : SortSpecial::NONE;
+  };
+  const SortSpecial leftSpecial = special(left);
+  const SortSpecial rightSpecial = special(right);
+  if (leftSpecial != rightSpecial)
+    return leftSpecial == SortSpecial::TOP || rightSpecial == SortSpecial::BOTTOM;
+  if (leftSpecial != SortSpecial::NONE)
+    return false;
+
+  if (handleFolder)
+  {
+    const auto leftFolder = left.find(Field::FOLDER);
+    const auto rightFolder = right.find(Field::FOLDER);
+    if (leftFolder != left.end() && rightFolder != right.end() &&
+        leftFolder->second.asBoolean() != rightFolder->second.asBoolean())
+      return leftFolder->second.asBoolean();
+  }
+
+  const int64_t result = StringUtils::AlphaNumericCompare(left.at(Field::SORT).asWideString(),
+                                                          right.at(Field::SORT).asWideString());
+  return descending ? result > 0 : result < 0;
+}
+
+void SortByComparingItems(SortItems& items, bool handleFolder, bool descending)
+{
+  for (auto& item : items)
+  {
+    std::wstring sortLabel;
+    g_charsetConverter.utf8ToW(item->at(Field::LABEL).asString(), sortLabel, false);
+    item->emplace(Field::SORT, CVariant(sortLabel));
+  }
+  std::stable_sort(items.begin(), items.end(),
+                   [handleFolder, descending](const auto& left, const auto& right)
+                   { return CompareItems(*left, *right, handleFolder, descending); });
+}
+
+SortItems CopyItems(const SortItems& items)
+{
+  SortItems copy;
+  for (const auto& item : items)
+    copy.emplace_back(std::make_shared<SortItem>(*item));
+  return copy;
+}
+
+std::vector<int64_t> GetIds(const SortItems& items)
+{
+  std::vector<int64_t> ids;
+  for (const auto& item : items)
+    ids.emplace_back(item->at(Field::ID).asInteger());
+  return ids;
+}
+} // namespace
+
+class TestSortUtilsHelper
+{
+public:
+  // Only the SQL of the database is prepared, it isn't opened
+  TestSortUtilsHelper() { m_database.m_pDB = std::make_unique<dbiplus::SqliteDatabase>(); }
+
+  bool GetOrderClause(const MediaType& mediaType,
+                      const SortDescription& sorting,
+                      std::string& order) const
+  {
+    return m_database.GetOrderClause(mediaType, sorting, order);
+  }
+
+private:
+  CVideoDatabase m_database;
+};
+
+namespace
+{
+// The rows of a view as the video database has them, with NULLs where a LEFT JOIN finds nothing
+std::string MakeValue(Field field, std::mt19937& random)
+{
+  const std::string words[] = {"The", "the", "Alien", "alien", "Éclair", "ecran", "Zebra",
+                               "10",  "9",   "Part 2", "Part 10", "Thebes", "The_End"};
+  const auto title = [&]()
+  {
+    std::string title = words[random() % std::size(words)];
+    if (random() % 2 == 0)
+      title += " " + words[random() % std::size(words)];
+    return "'" + title + "'";
+  };
+  const auto orNull = [&random](const std::string& value)
+  { return random() % 4 == 0 ? "NULL" : value; };
+
+  switch (field)
+  {
+    case Field::TITLE:
+      return title();
+    case Field::SORT_TITLE:
+      return random() % 2 == 0 ? "''" : orNull(title());
+    case Field::YEAR:
+      return random() % 4 == 0 ? "''" : orNull(StringUtils::Format("'{}-05-01'", random() % 3 + 1990));
+    case Field::DATE_ADDED:
+    case Field::LAST_PLAYED:
+      return orNull(StringUtils::Format("'2024-0{}-01 10:00:00'", random() % 3 + 1));
+    case Field::RATING:
+      return orNull(StringUtils::Format("{:.1f}", (random() % 21) / 2.0));
+    case Field::USER_RATING:
+    case Field::PLAYCOUNT:
+      return orNull(std::to_string(random() % 3));
+    case Field::VOTES:
+      return orNull(std::to_string(random() % 3 * 500));
+    case Field::SEASON:
+      return StringUtils::Format("'{}'", random() % 3);
+    case Field::EPISODE_NUMBER:
+      return StringUtils::Format("'{}'", random() % 12 + 1);
+    default:
+      return "NULL";
+  }
+}
+
+class TestSortUtilsQuery : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_path = std::filesystem::temp_directory_path() / "kodi-TestSortUtilsQuery";
+    std::filesystem::remove_all(m_path);
+    std::filesystem::create_directories(m_path);
+
+    m_db.setHostName(m_path.string().c_str());
+    m_db.setDatabase("test");
+    ASSERT_EQ(m_db.connect(true), static_cast<int>(dbiplus::DB_CONNECTION_OK));
+    m_ds.reset(m_db.CreateDataset());
+    m_sorted.reset(m_db.CreateDataset());
+
+    auto& tokens = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_vecTokens;
+    m_tokens = tokens;
+    tokens = {"the ", "the.", "the_"};
+  }
+
+  void TearDown() override
+  {
+    CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_vecTokens = m_tokens;
+
+    m_sorted.reset();
+    m_ds.reset();
+    m_db.disconnect();
+    std::filesystem::remove_all(m_path);
+  }
+
+  // A table named as the view of the media type, with each field at the index DatabaseUtils
+  // reads it from
+  void CreateView(const MediaType& mediaType, const std::vector<SortBy>& sortMethods, int rows)
+  {
+    FieldList fields{Field::ID,      Field::TITLE,          Field::SORT_TITLE,
+                     Field::SEASON,  Field::EPISODE_NUMBER, Field::SEASON_SPECIAL_SORT,
+                     Field::EPISODE_NUMBER_SPECIAL_SORT};
+    for (const SortBy sortBy : sortMethods)
+    {
+      FieldList selectFields;
+      DatabaseUtils::GetSelectFields(SortUtils::GetFieldsForSorting(sortBy), mediaType,
+                                     selectFields);
+      fields.insert(fields.end(), selectFields.begin(), selectFields.end());
+    }
+
+    std::vector<std::string> columns;
+    std::vector<Field> columnFields;
+    for (const Field field : fields)
+    {
+      const std::string column = DatabaseUtils::GetField(field, mediaType, DatabaseQueryPart::SELECT);
+      const int index = DatabaseUtils::GetFieldIndex(field, mediaType);
+      if (column.empty() || index < 0)
+        continue;
+
+      if (columns.size() <= static_cast<size_t>(index))
+      {
+        columns.resize(index + 1);
+        columnFields.resize(index + 1, Field::NONE);
+      }
+      m_view = column.substr(0, column.find('.'));
+      columns[index] = column.substr(column.find('.') + 1);
+      columnFields[index] = field;
+    }
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+      if (columns[i].empty())
+        columns[i] = "unused" + std::to_string(i);
+    }
+
+    m_ds->exec("CREATE TABLE " + m_view + " (" + StringUtils::Join(columns, ", ") + ")");
+
+    std::mt19937 random(rows);
+    m_db.start_transaction();
+    for (int row = 1; row <= rows; row++)
+    {
+      std::vector<std::string> values;
+      for (const Field field : columnFields)
+        values.emplace_back(field == Field::ID ? std::to_string(row) : MakeValue(field, random));
+
+      // Specials sorted into a season, both or none of the fields are set as by the scrapers
+      const auto setSpecial = [&](Field field, const std::string& value)
+      {
+        const int index = DatabaseUtils::GetFieldIndex(field, mediaType);
+        if (index >= 0 && DatabaseUtils::GetField(field, mediaType, DatabaseQueryPart::SELECT) != "")
+          values[index] = value;
+      };
+      if (random() % 3 == 0)
+      {
+        setSpecial(Field::SEASON, "'0'");
+        setSpecial(Field::SEASON_SPECIAL_SORT, StringUtils::Format("'{}'", random() % 3 + 1));
+        setSpecial(Field::EPISODE_NUMBER_SPECIAL_SORT, StringUtils::Format("'{}'", random() % 12 + 1));
+      }
+      else
+      {
+        setSpecial(Field::SEASON_SPECIAL_SORT, "'-1'");
+        setSpecial(Field::EPISODE_NUMBER_SPECIAL_SORT, "'-1'");
+      }
+
+      m_ds->exec("INSERT INTO " + m_view + " VALUES (" + StringUtils::Join(values, ", ") + ")");
+    }
+    m_db.commit_transaction();
+  }
+
+  // The ids of the rows in the order SortUtils::Sort() sorts them in
+  std::vector<int64_t> Sort(const MediaType& mediaType, const SortDescription& sorting)
+  {
+    DatabaseResults results;
+    m_ds->query("SELECT * FROM " + m_view);
+    EXPECT_TRUE(SortUtils::SortFromDataset(sorting, mediaType, *m_ds, results));
+
+    const int id = DatabaseUtils::GetFieldIndex(Field::ID, mediaType);
+    std::vector<int64_t> ids;
+    for (const auto& result : results)
+    {
+      const auto row = static_cast<size_t>(result.at(Field::ROW).asInteger());
+      ids.emplace_back(m_ds->get_result_set().records[row]->at(id).get_asInt64());
+    }
+    m_ds->close();
+    return ids;
+  }
+
+  // The ids of the rows in the order of the ORDER BY clause of the listing
+  std::vector<int64_t> Query(const MediaType& mediaType, const std::string& order)
+  {
+    m_sorted->query("SELECT " +
+                    DatabaseUtils::GetField(Field::ID, mediaType, DatabaseQueryPart::SELECT) +
+                    " FROM " + m_view + " ORDER BY " + order);
+
+    std::vector<int64_t> ids;
+    for (; !m_sorted->eof(); m_sorted->next())
+      ids.emplace_back(m_sorted->fv(0).get_asInt64());
+    m_sorted->close();
+    return ids;
+  }
+
+  std::filesystem::path m_path;
+  dbiplus::SqliteDatabase m_db;
+  std::unique_ptr<dbiplus::Dataset> m_ds;
+  std::unique_ptr<dbiplus::Dataset> m_sorted;
+  std::string m_view;
+  CLangInfo::Tokens m_tokens;
+};
+} // namespace
+
 TEST(TestSortUtils, Sort_SortBy)
 {
   SortItems items;
@@ -121,3 +431,117 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(Field::TRACK_NUMBER, *it);
   EXPECT_EQ(5U, fields.size());
 }
+
+TEST(TestSortUtils, GetFieldsForSQLSort)
+{
+  FieldList fields;
+
+  SortUtils::GetFieldsForSQLSort(MediaTypeMovie, SortBy::SORT_TITLE, fields);
+  EXPECT_EQ(fields, FieldList({Field::SORT_TITLE, Field::ID}));
+
+  SortUtils::GetFieldsForSQLSort(MediaTypeMovie, SortBy::RATING, fields);
+  EXPECT_EQ(fields, FieldList({Field::RATING, Field::LABEL, Field::ID}));
+
+  SortUtils::GetFieldsForSQLSort(MediaTypeEpisode, SortBy::EPISODE_NUMBER, fields);
+  EXPECT_EQ(fields, FieldList({Field::EPISODE_NUMBER, Field::LABEL, Field::ID}));
+
+  // Sorted in memory
+  SortUtils::GetFieldsForSQLSort(MediaTypeEpisode, SortBy::SORT_TITLE, fields);
+  EXPECT_EQ(fields, FieldList({Field::ID}));
+  SortUtils::GetFieldsForSQLSort(MediaTypeMovie, SortBy::GENRE, fields);
+  EXPECT_EQ(fields, FieldList({Field::ID}));
+}
+
+TEST_F(TestSortUtilsQuery, GetFieldsForSQLSort_SameAsSort)
+{
+  const std::vector<std::pair<MediaType, std::vector<SortBy>>> sortMethods{
+      {MediaTypeMovie,
+       {SortBy::LABEL, SortBy::TITLE, SortBy::SORT_TITLE, SortBy::YEAR, SortBy::DATE_ADDED,
+        SortBy::RATING, SortBy::USER_RATING, SortBy::VOTES, SortBy::PLAYCOUNT,
+        SortBy::LAST_PLAYED}},
+      {MediaTypeEpisode,
+       {SortBy::LABEL, SortBy::TITLE, SortBy::EPISODE_NUMBER, SortBy::DATE_ADDED, SortBy::RATING,
+        SortBy::USER_RATING, SortBy::VOTES, SortBy::PLAYCOUNT, SortBy::LAST_PLAYED}}};
+
+  const TestSortUtilsHelper helper;
+  for (const auto& [mediaType, methods] : sortMethods)
+  {
+    CreateView(mediaType, methods, 500);
+    for (const SortBy sortBy : methods)
+    {
+      for (const SortOrder sortOrder : {SortOrder::ASCENDING, SortOrder::DESCENDING})
+      {
+        for (const SortAttribute attributes :
+             {SortAttributeNone, SortAttributeIgnoreArticle,
+              static_cast<SortAttribute>(SortAttributeIgnoreArticle | SortAttributeIgnoreLabel)})
+        {
+          SortDescription sorting;
+          sorting.sortBy = sortBy;
+          sorting.sortOrder = sortOrder;
+          sorting.sortAttributes = attributes;
+
+          std::string order;
+          ASSERT_TRUE(helper.GetOrderClause(mediaType, sorting, order))
+              << mediaType << " " << static_cast<int>(sortBy);
+          EXPECT_EQ(Query(mediaType, order), Sort(mediaType, sorting))
+              << mediaType << " ORDER BY " << order;
+        }
+      }
+    }
+  }
+}
+
+TEST(TestSortUtils, Sort_SameAsComparingItems)
+{
+  // Enough items to be sorted on several threads
+  for (const size_t count : {100, 50000})
+  {
+    const SortItems items = MakeItems(count, static_cast<unsigned int>(count));
+    for (const SortOrder sortOrder : {SortOrder::ASCENDING, SortOrder::DESCENDING})
+    {
+      for (const SortAttribute attributes : {SortAttributeNone, SortAttributeIgnoreFolders})
+      {
+        SortItems sorted = CopyItems(items);
+        SortUtils::Sort(SortBy::LABEL, sortOrder, attributes, sorted);
+
+        SortItems expected = CopyItems(items);
+        SortByComparingItems(expected, attributes == SortAttributeNone,
+                             sortOrder == SortOrder::DESCENDING);
+
+        EXPECT_EQ(GetIds(sorted), GetIds(expected));
+      }
+    }
+  }
+}
+
+TEST(TestSortUtils, Sort_Limit)
+{
+  SortItems items = MakeItems(1000, 1);
+  SortItems expected = CopyItems(items);
+  SortByComparingItems(expected, true, false);
+
+  SortUtils::Sort(SortBy::LABEL, SortOrder::ASCENDING, SortAttributeNone, items, 30, 10);
+
+  const std::vector<int64_t> ids = GetIds(expected);
+  ASSERT_EQ(items.size(), 20U);
+  EXPECT_EQ(GetIds(items), std::vector<int64_t>(ids.begin() + 10, ids.begin() + 30));
+}
+
+// Compares sorting 100k items with keys to comparing the items. Disabled by default, run with
+// --gtest_also_run_disabled_tests.
+TEST(TestSortUtils, DISABLED_Benchmark)
+{
+  const SortItems items = MakeItems(100000, 1);
+
+  SortItems sorted = CopyItems(items);
+  auto start = std::chrono::steady_clock::now();
+  SortByComparingItems(sorted, true, false);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "Comparing items: " << elapsed.count() << " ms" << std::endl;
+
+  sorted = CopyItems(items);
+  start = std::chrono::steady_clock::now();
+  SortUtils::Sort(SortBy::LABEL, SortOrder::ASCENDING, SortAttributeNone, sorted);
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "Comparing keys: " << elapsed.count() << " ms" << std::endl;
+}
@@ -62,6 +62,7 @@
 #include "video/VideoDbUrl.h"
 #include "video/VideoFileItemClassify.h"
 #include "video/VideoInfoTag.h"
+#include "video/VideoLibraryIndex.h"
 #include "video/VideoLibraryQueue.h"
 #include "video/VideoManagerTypes.h"
 #include "video/VideoThumbLoader.h"
@@ -309,6 +310,132 @@ int CVideoDatabase::RunQuery(const std::string &sql)
   return rows;
 }
 
+int CVideoDatabase::RunStatement(const std::string& sql,
+                                 const std::function<void(const dbiplus::Statement* row)>& onRow)
+{
+  return RunStatement(*m_pDB->prepareStatement(sql), sql, onRow);
+}
+
+int CVideoDatabase::RunStatement(dbiplus::Statement& statement,
+                                 const std::string& sql,
+                                 const std::function<void(const dbiplus::Statement* row)>& onRow)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  int rows = 0;
+  for (; statement.step(); rows++)
+    onRow(&statement);
+
+  auto end = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+  CLog::LogFC(LOGDEBUG, LOGDATABASE, "took {} ms for {} items statement: {}", duration.count(),
+              rows, sql);
+
+  return rows;
+}
+
+bool CVideoDatabase::GetOrderClause(const MediaType& mediaType,
+                                    const SortDescription& sorting,
+                                    std::string& order) const
+{
+  // Only the ALPHANUM collation of SQLite compares strings as the sorters do
+  if (!m_sqlite)
+    return false;
+
+  FieldList fields;
+  SortUtils::GetFieldsForSQLSort(mediaType, sorting.sortBy, fields);
+  // Nothing but the id, the sort label can't be built by SQL
+  if (fields.size() < 2)
+    return false;
+
+  const auto column = [&mediaType](Field field)
+  { return DatabaseUtils::GetField(field, mediaType, DatabaseQueryPart::SELECT); };
+  // NULL reads as 0 in the sorters, as it does for the fields below
+  const auto integer = [&column](Field field)
+  { return "CAST(IFNULL(" + column(field) + ", 0) AS INTEGER)"; };
+  const auto title = [this, &sorting](const std::string& field)
+  {
+    std::string articles;
+    if (sorting.sortAttributes & SortAttributeIgnoreArticle)
+      articles = GetIgnoreArticleSQL(field);
+    if (articles.empty())
+      return field + " COLLATE ALPHANUM";
+    return "CASE " + articles + " ELSE " + field + " END COLLATE ALPHANUM";
+  };
+
+  std::vector<std::string> orderFields;
+  for (const auto field : fields)
+  {
+    if (field == Field::LABEL)
+    {
+      if (sorting.sortBy == SortBy::LAST_PLAYED &&
+          sorting.sortAttributes & SortAttributeIgnoreLabel)
+        continue;
+
+      // Labelled "102. Title"
+      if (mediaType == MediaTypeEpisode)
+      {
+        orderFields.emplace_back(integer(Field::SEASON) + " * 100 + " +
+                                 integer(Field::EPISODE_NUMBER));
+        orderFields.emplace_back(column(Field::TITLE) + " COLLATE ALPHANUM");
+      }
+      else
+        orderFields.emplace_back(title(column(Field::TITLE)));
+    }
+    else if (field == Field::TITLE)
+      orderFields.emplace_back(title(column(Field::TITLE)));
+    else if (field == Field::SORT_TITLE)
+      // The title when there's no sort title
+      orderFields.emplace_back(title(
+          DatabaseUtils::GetField(Field::TITLE, mediaType, DatabaseQueryPart::ORDER_BY)));
+    else if (field == Field::YEAR)
+      orderFields.emplace_back(integer(Field::YEAR));
+    else if (field == Field::EPISODE_NUMBER)
+    {
+      // Specials are sorted in the season and before the episode they air in
+      const std::string season = integer(Field::SEASON);
+      const std::string episode = integer(Field::EPISODE_NUMBER);
+      const std::string sortSeason = integer(Field::SEASON_SPECIAL_SORT);
+      const std::string sortEpisode = integer(Field::EPISODE_NUMBER_SPECIAL_SORT);
+      orderFields.emplace_back(StringUtils::Format(
+          "CASE WHEN {2} > 0 OR {3} > 0 THEN ({2} << 32) + ({3} << 16) - (65536 - {1}) "
+          "ELSE ({0} << 32) + ({1} << 16) END",
+          season, episode, sortSeason, sortEpisode));
+    }
+    else if (field == Field::DATE_ADDED || field == Field::LAST_PLAYED)
+      orderFields.emplace_back("IFNULL(" + column(field) + ", '')");
+    else if (field == Field::ID)
+      orderFields.emplace_back(column(field));
+    else
+      orderFields.emplace_back("IFNULL(" + column(field) + ", 0)");
+  }
+
+  // The id comes last. The sorters keep equal rows in the order of their ids, unless the id is
+  // part of the sort label.
+  const std::string DESC = sorting.sortOrder == SortOrder::DESCENDING ? " DESC" : "";
+  order = StringUtils::Join(orderFields, DESC + ", ");
+  if (sorting.sortBy == SortBy::DATE_ADDED)
+    order += DESC;
+  return true;
+}
+
+void CVideoDatabase::AppendOrderClause(const std::string& strSQL,
+                                       const std::string& order,
+                                       const SortDescription& sorting,
+                                       std::string& strSQLExtra,
+                                       int& total)
+{
+  if (sorting.limitStart > 0 || sorting.limitEnd > 0)
+  {
+    total = GetSingleValueInt(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, *m_pDS);
+    strSQLExtra += " ORDER BY " + order +
+                   DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
+  }
+  else
+    strSQLExtra += " ORDER BY " + order;
+}
+
 bool CVideoDatabase::GetSubPaths(const std::string& basepath,
                                  std::vector<std::pair<int, std::string>>& subpaths,
                                  bool excludeDiscPaths /* = true */)
@@ -4467,8 +4594,8 @@ void CVideoDatabase::DeleteTag(int idTag, VideoDbContentType mediaType)
   }
 }
 
-template<typename T>
-void CVideoDatabase::GetDetailsFromDB(const dbiplus::sql_record* const record,
+template<typename Record, typename T>
+void CVideoDatabase::GetDetailsFromDB(const Record* const record,
                                       int min,
                                       int max,
                                       const T& offsets,
@@ -4744,7 +4871,9 @@ CVideoInfoTag CVideoDatabase::GetDetailsForMovie(dbiplus::Dataset& pDS,
   return GetDetailsForMovie(pDS.get_sql_record(), getDetails);
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+template<typename Record>
+CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const Record* const record,
+                                                 int getDetails /* = VideoDbDetailsNone */)
 {
   CVideoInfoTag details;
 
@@ -4939,8 +5068,8 @@ CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(dbiplus::Dataset& pDS) c
   return GetBasicDetailsForEpisode(pDS.get_sql_record());
 }
 
-CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(
-    const dbiplus::sql_record* const record) const
+template<typename Record>
+CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(const Record* const record) const
 {
   CVideoInfoTag details;
 
@@ -4966,7 +5095,9 @@ CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(dbiplus::Dataset& pDS,
   return GetDetailsForEpisode(pDS.get_sql_record(), getDetails);
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+template<typename Record>
+CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(const Record* const record,
+                                                   int getDetails /* = VideoDbDetailsNone */)
 {
   CVideoInfoTag details;
 
@@ -8009,11 +8140,23 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     const bool videoVersionNav{options.contains("videoversionid")};
     // navigation = list of assets of the movie
     const bool assetsNav{options.contains("assetType")};
-    const bool flattenVersions{CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
-        CSettings::SETTING_VIDEOLIBRARY_FLATTENVERSIONS)};
+    const std::shared_ptr<CSettings> settings{
+        CServiceBroker::GetSettingsComponent()->GetSettings()};
+    const bool flattenVersions{settings->GetBool(CSettings::SETTING_VIDEOLIBRARY_FLATTENVERSIONS)};
 
     int total = -1;
 
+    // Filter, sort and limit in the library index if it can answer the listing, so that only the
+    // rows of the requested range are read
+    std::vector<int> indexedIds;
+    const auto index = CServiceBroker::GetVideoLibraryIndex();
+    const bool indexed{index && settings->GetBool(CSettings::SETTING_VIDEOLIBRARY_MEMORYINDEX) &&
+                       !videoVersionNav && !assetsNav && !flattenVersions &&
+                       sortDescription.sortBy != SortBy::NONE && filter.join.empty() &&
+                       filter.where.empty() && filter.group.empty() && filter.order.empty() &&
+                       filter.limit.empty() &&
+                       index->GetMovies(*this, videoUrl, sortDescription, indexedIds, total)};
+
     std::string strSQL = "select %s from movie_view ";
     std::string strSQLExtra;
     if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
@@ -8028,32 +8171,20 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
 
-    strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
-
-    int iRowsFound = RunQuery(strSQL);
-
-    // store the total value of items as a property
-    if (total < iRowsFound)
-      total = iRowsFound;
-    items.SetProperty("total", total);
-
-    if (iRowsFound <= 0)
-      return iRowsFound == 0;
-
-    DatabaseResults results;
-    results.reserve(iRowsFound);
+    // Sort and limit in the query if it sorts as SortUtils does, so that only the rows of the
+    // requested range are read and none are kept in memory to sort them
+    std::string order;
+    const bool sortedByQuery{!indexed && extFilter.limit.empty() && extFilter.order.empty() &&
+                             sortDescription.sortBy != SortBy::NONE &&
+                             GetOrderClause(MediaTypeMovie, sortDescription, order)};
+    if (sortedByQuery)
+      AppendOrderClause(strSQL, order, sortDescription, strSQLExtra, total);
 
-    if (!SortUtils::SortFromDataset(sortDescription, MediaTypeMovie, *m_pDS, results))
-      return false;
+    strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
     // get data from returned rows
-    items.Reserve(results.size());
-    const query_data &data = m_pDS->get_result_set().records;
-    for (const auto &i : results)
+    const auto addMovie = [&](const auto* record)
     {
-      const auto targetRow = static_cast<unsigned int>(i.at(Field::ROW).asInteger());
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
       CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
       if (m_profileManager.GetMasterProfile().getLockMode() == LockMode::EVERYONE ||
           g_passwordManager.bMasterUser ||
@@ -8120,8 +8251,68 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
                                                        : CGUIListItem::ICON_OVERLAY_UNWATCHED);
         items.Add(item);
       }
+    };
+
+    int iRowsFound = 0;
+    if (indexed)
+    {
+      // Read the rows of the range by id, a bounded number at a time, in the order of the index
+      constexpr size_t IDS_PER_QUERY = 500;
+      const int first = items.Size();
+      const std::string fields = !extFilter.fields.empty() ? extFilter.fields : "*";
+      for (size_t i = 0; i < indexedIds.size(); i += IDS_PER_QUERY)
+      {
+        std::vector<std::string> ids;
+        for (size_t j = i; j < std::min(i + IDS_PER_QUERY, indexedIds.size()); j++)
+          ids.emplace_back(std::to_string(indexedIds[j]));
+        // The ids are part of the query, so it isn't kept in the statement cache
+        const std::string sql =
+            PrepareSQL("SELECT %s FROM movie_view WHERE isDefaultVersion = 1 AND idMovie IN (%s)",
+                       fields.c_str(), StringUtils::Join(ids, ",").c_str());
+        iRowsFound += RunStatement(*m_pDB->prepareUncachedStatement(sql), sql, addMovie);
+      }
+
+      std::unordered_map<int, size_t> positions;
+      for (size_t i = 0; i < indexedIds.size(); i++)
+        positions.emplace(indexedIds[i], i);
+      std::stable_sort(items.begin() + first, items.end(),
+                       [&positions](const auto& left, const auto& right)
+                       {
+                         return positions.at(left->GetVideoInfoTag()->m_iDbId) <
+                                positions.at(right->GetVideoInfoTag()->m_iDbId);
+                       });
+    }
+    else if (sortDescription.sortBy == SortBy::NONE || sortedByQuery)
+    {
+      // Nothing to sort, so the rows are read in the order of the query without copying them
+      iRowsFound = RunStatement(strSQL, addMovie);
+    }
+    else
+    {
+      iRowsFound = RunQuery(strSQL);
+      if (iRowsFound < 0)
+        return false;
+
+      DatabaseResults results;
+      results.reserve(iRowsFound);
+
+      if (!SortUtils::SortFromDataset(sortDescription, MediaTypeMovie, *m_pDS, results))
+        return false;
+
+      items.Reserve(results.size());
+      const query_data& data = m_pDS->get_result_set().records;
+      for (const auto& i : results)
+      {
+        const auto targetRow = static_cast<unsigned int>(i.at(Field::ROW).asInteger());
+        addMovie(data.at(targetRow));
+      }
     }
 
+    // store the total value of items as a property
+    if (total < iRowsFound)
+      total = iRowsFound;
+    items.SetProperty("total", total);
+
     // cleanup
     m_pDS->close();
     return true;
@@ -8133,6 +8324,80 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
   return false;
 }
 
+bool CVideoDatabase::GetIndexedMovies(std::vector<KODI::VIDEO::IndexedMovie>& movies,
+                                      int idMovie /* = -1 */)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+
+    movies.clear();
+    std::unordered_map<int, size_t> rows;
+    // The movie is bound as a parameter, so a single statement is cached for all movies
+    std::string sql = PrepareSQL("SELECT idMovie, c%02d, c%02d, premiered, rating, playCount, "
+                                 "dateAdded FROM movie_view WHERE isDefaultVersion = 1",
+                                 VIDEODB_ID_TITLE, VIDEODB_ID_SORTTITLE);
+    if (idMovie > 0)
+      sql += " AND idMovie = ?";
+
+    auto statement = m_pDB->prepareStatement(sql);
+    if (idMovie > 0)
+      statement->bindInt64(1, idMovie);
+
+    RunStatement(*statement, sql,
+                 [&movies, &rows](const dbiplus::Statement* row)
+                 {
+                   auto& movie = movies.emplace_back();
+                   movie.id = static_cast<int>(row->getInt64(0));
+                   movie.title = row->getStringView(1);
+                   movie.sortTitle = row->getStringView(2);
+                   if (!row->isNull(3))
+                     movie.premiered = row->getStringView(3);
+                   if (!row->isNull(4))
+                     movie.rating = row->getDouble(4);
+                   if (!row->isNull(5))
+                     movie.playCount = static_cast<int>(row->getInt64(5));
+                   if (!row->isNull(6))
+                     movie.dateAdded = row->getStringView(6);
+                   rows.emplace(movie.id, movies.size() - 1);
+                 });
+
+    using KODI::VIDEO::IndexedMovie;
+    for (const auto& [table, member] : std::array{std::pair{"genre", &IndexedMovie::genres},
+                                                  std::pair{"studio", &IndexedMovie::studios},
+                                                  std::pair{"tag", &IndexedMovie::tags}})
+    {
+      sql = StringUtils::Format(
+          "SELECT {0}_link.media_id, {0}.{0}_id, {0}.name FROM {0}_link "
+          "JOIN {0} ON {0}.{0}_id = {0}_link.{0}_id WHERE {0}_link.media_type = 'movie'",
+          table);
+      if (idMovie > 0)
+        sql += StringUtils::Format(" AND {}_link.media_id = ?", table);
+
+      statement = m_pDB->prepareStatement(sql);
+      if (idMovie > 0)
+        statement->bindInt64(1, idMovie);
+
+      RunStatement(*statement, sql,
+                   [&movies, &rows, links = member](const dbiplus::Statement* row)
+                   {
+                     const auto movie = rows.find(static_cast<int>(row->getInt64(0)));
+                     if (movie != rows.end())
+                       (movies[movie->second].*links)
+                           .emplace_back(static_cast<int>(row->getInt64(1)),
+                                         row->getStringView(2));
+                   });
+    }
+    return true;
+  }
+  catch (...)
+  {
+    CLog::LogF(LOGERROR, "({}) failed", idMovie);
+  }
+  return false;
+}
+
 bool CVideoDatabase::GetTvShowsNav(const std::string& strBaseDir, CFileItemList& items,
                                   int idGenre /* = -1 */, int idYear /* = -1 */, int idActor /* = -1 */, int idDirector /* = -1 */, int idStudio /* = -1 */, int idTag /* = -1 */,
                                   const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
@@ -8317,33 +8582,20 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
 
-    strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
-
-    int iRowsFound = RunQuery(strSQL);
-
-    // store the total value of items as a property
-    if (total < iRowsFound)
-      total = iRowsFound;
-    items.SetProperty("total", total);
-
-    if (iRowsFound <= 0)
-      return iRowsFound == 0;
+    // Sort and limit in the query if it sorts as SortUtils does
+    std::string order;
+    const bool sortedByQuery{extFilter.limit.empty() && extFilter.order.empty() &&
+                             sorting.sortBy != SortBy::NONE &&
+                             GetOrderClause(MediaTypeEpisode, sorting, order)};
+    if (sortedByQuery)
+      AppendOrderClause(strSQL, order, sorting, strSQLExtra, total);
 
-    DatabaseResults results;
-    results.reserve(iRowsFound);
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeEpisode, *m_pDS, results))
-      return false;
+    strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
     // get data from returned rows
-    items.Reserve(results.size());
     CLabelFormatter formatter("%H. %T", "");
-
-    const query_data &data = m_pDS->get_result_set().records;
-    for (const auto &i : results)
+    const auto addEpisode = [&](const auto* record)
     {
-      const auto targetRow = static_cast<unsigned int>(i.at(Field::ROW).asInteger());
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
       CVideoInfoTag episode = GetDetailsForEpisode(record, getDetails);
       if (m_profileManager.GetMasterProfile().getLockMode() == LockMode::EVERYONE ||
           g_passwordManager.bMasterUser ||
@@ -8372,8 +8624,39 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
         pItem->SetDateTime(episode.m_firstAired);
         items.Add(std::move(pItem));
       }
+    };
+
+    int iRowsFound;
+    if (sorting.sortBy == SortBy::NONE || sortedByQuery)
+    {
+      // Nothing to sort, so the rows are read in the order of the query without copying them
+      iRowsFound = RunStatement(strSQL, addEpisode);
+    }
+    else
+    {
+      iRowsFound = RunQuery(strSQL);
+      if (iRowsFound < 0)
+        return false;
+
+      DatabaseResults results;
+      results.reserve(iRowsFound);
+      if (!SortUtils::SortFromDataset(sorting, MediaTypeEpisode, *m_pDS, results))
+        return false;
+
+      items.Reserve(results.size());
+      const query_data& data = m_pDS->get_result_set().records;
+      for (const auto& i : results)
+      {
+        const auto targetRow = static_cast<unsigned int>(i.at(Field::ROW).asInteger());
+        addEpisode(data.at(targetRow));
+      }
     }
 
+    // store the total value of items as a property
+    if (total < iRowsFound)
+      total = iRowsFound;
+    items.SetProperty("total", total);
+
     // cleanup
     m_pDS->close();
     return true;
@@ -46,11 +46,13 @@ namespace dbiplus
 {
   class field_value;
   using sql_record = std::vector<field_value>;
+  class Statement;
 }
 
 namespace KODI::VIDEO
 {
   class IVideoInfoScannerObserver;
+  struct IndexedMovie;
   struct SScanSettings;
 }
 
@@ -152,6 +154,8 @@ static constexpr const char* MULTIPLE_EPISODES{"multiple_episodes"};
 
 class CVideoDatabase : public CDatabase
 {
+  friend class TestSortUtilsHelper;
+
   struct FileInformation
   {
     // user-defined ctor required for XCode 15.2 and emplace_back
@@ -804,6 +808,13 @@ public:
   bool GetEpisodesByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, bool appendFullShowPath = true, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
   bool GetMusicVideosByWhere(const std::string &baseDir, const Filter &filter, CFileItemList& items, bool checkLocks = true, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
 
+  /*! \brief Get the values of movies that the library index keeps
+   \param movies [out] the default versions of the movies
+   \param idMovie the movie to get, -1 for all
+   \return true on success
+   */
+  bool GetIndexedMovies(std::vector<KODI::VIDEO::IndexedMovie>& movies, int idMovie = -1);
+
   // retrieve sorted and limited items
   bool GetSortedVideos(const MediaType &mediaType, const std::string& strBaseDir, const SortDescription &sortDescription, CFileItemList& items, const Filter &filter = Filter());
 
@@ -1129,7 +1140,8 @@ protected:
   void AddCast(int mediaId, const char *mediaType, const std::vector<SActorInfo> &cast);
 
   CVideoInfoTag GetDetailsForMovie(dbiplus::Dataset& pDS, int getDetails = VideoDbDetailsNone);
-  CVideoInfoTag GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
+  template<typename Record>
+  CVideoInfoTag GetDetailsForMovie(const Record* const record, int getDetails = VideoDbDetailsNone);
   CSetInfoTag GetDetailsForSet(dbiplus::Dataset& pDS) const;
   CSetInfoTag GetDetailsForSet(const dbiplus::sql_record* const record) const;
   CVideoInfoTag GetDetailsForTvShow(dbiplus::Dataset& pDS,
@@ -1139,9 +1151,11 @@ protected:
                                     int getDetails = VideoDbDetailsNone,
                                     CFileItem* item = nullptr);
   CVideoInfoTag GetBasicDetailsForEpisode(dbiplus::Dataset& pDS) const;
-  CVideoInfoTag GetBasicDetailsForEpisode(const dbiplus::sql_record* const record) const;
+  template<typename Record>
+  CVideoInfoTag GetBasicDetailsForEpisode(const Record* const record) const;
   CVideoInfoTag GetDetailsForEpisode(dbiplus::Dataset& pDS, int getDetails = VideoDbDetailsNone);
-  CVideoInfoTag GetDetailsForEpisode(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
+  template<typename Record>
+  CVideoInfoTag GetDetailsForEpisode(const Record* const record, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForMusicVideo(dbiplus::Dataset& pDS, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForMusicVideo(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
   bool GetPeopleNav(const std::string& strBaseDir,
@@ -1161,8 +1175,8 @@ protected:
   void GetRatings(int media_id, const std::string &media_type, RatingMap &ratings);
   void GetUniqueIDs(int media_id, const std::string &media_type, CVideoInfoTag& details);
 
-  template<typename T>
-  void GetDetailsFromDB(const dbiplus::sql_record* const record,
+  template<typename Record, typename T>
+  void GetDetailsFromDB(const Record* const record,
                         int min,
                         int max,
                         const T& offsets,
@@ -1208,6 +1222,50 @@ private:
    */
   int RunQuery(const std::string &sql);
 
+  /*! \brief Run a query from a prepared statement of the statement cache, reading the rows in
+   place instead of copying them into the main dataset.
+   \param sql the sql query to run
+   \param onRow called for each row, which reads as a dbiplus::sql_record does
+   \return the number of rows, throws DbErrors for an error.
+   */
+  int RunStatement(const std::string& sql,
+                   const std::function<void(const dbiplus::Statement* row)>& onRow);
+
+  /*! \brief Run a query from the given prepared statement, e.g. one outside of the statement
+   cache or with bound parameters, reading the rows in place.
+   \param statement the prepared statement to run
+   \param sql the sql of the statement, for the log
+   \param onRow called for each row, which reads as a dbiplus::sql_record does
+   \return the number of rows, throws DbErrors for an error.
+   */
+  int RunStatement(dbiplus::Statement& statement,
+                   const std::string& sql,
+                   const std::function<void(const dbiplus::Statement* row)>& onRow);
+
+  /*! \brief Get the ORDER BY clause that sorts the rows of a listing as SortUtils::Sort() does,
+   so the rows can be read in place and limited by the query.
+   \param mediaType the media type of the rows, movies and episodes are supported
+   \param sorting the sort description of the listing
+   \param order the ORDER BY clause, without the keywords
+   \return false if the rows have to be sorted in memory
+   */
+  bool GetOrderClause(const MediaType& mediaType,
+                      const SortDescription& sorting,
+                      std::string& order) const;
+
+  /*! \brief Sort and limit a listing in the query.
+   \param strSQL the query, with %s for the fields
+   \param order the ORDER BY clause from GetOrderClause()
+   \param sorting the sort description with the range of rows to get
+   \param strSQLExtra the clauses of the query, the ORDER BY and LIMIT clauses are appended
+   \param total set to the number of rows in all ranges, if the rows are limited
+   */
+  void AppendOrderClause(const std::string& strSQL,
+                         const std::string& order,
+                         const SortDescription& sorting,
+                         std::string& strSQLExtra,
+                         int& total);
+
   void AppendIdLinkFilter(const char* field,
                           const char* table,
                           const MediaType& mediaType,
@@ -0,0 +1,777 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoLibraryIndex.h"
+
+#include "LangInfo.h"
+#include "ServiceBroker.h"
+#include "XBDateTime.h"
+#include "interfaces/AnnouncementManager.h"
+#include "media/MediaType.h"
+#include "playlists/SmartPlayList.h"
+#include "utils/DatabaseUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoDbUrl.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+
+using namespace KODI::VIDEO;
+
+namespace
+{
+using SearchOperator = CDatabaseQueryRule::SearchOperator;
+
+//! Above this many changed movies, reading all of them again is faster than one by one
+constexpr size_t MAX_CHANGED_MOVIES = 100;
+
+constexpr double NULL_VALUE = std::numeric_limits<double>::quiet_NaN();
+
+//! The number a value starts with, as SQLite casts it to a number, e.g. the year of a date
+double ToNumber(std::string_view value)
+{
+  value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+  double number = 0.0;
+  std::from_chars(value.data(), value.data() + value.size(), number);
+  return number;
+}
+
+//! The parameter of a rule as a number, if it is one
+std::optional<double> ToParameter(std::string_view value)
+{
+  double number;
+  const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+  if (error != std::errc() || end != value.data() + value.size())
+    return {};
+  return number;
+}
+
+char FoldCase(char c)
+{
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/*!
+ \brief Match a value as LIKE does with the pattern of the operator, e.g. '%value%' for contains.
+ Like SQLite, only the case of ASCII letters is ignored.
+ */
+bool Like(std::string_view value, std::string_view pattern, SearchOperator op)
+{
+  const auto equal = [](char left, char right) { return FoldCase(left) == FoldCase(right); };
+  switch (op)
+  {
+    case SearchOperator::OPERATOR_CONTAINS:
+    case SearchOperator::OPERATOR_DOES_NOT_CONTAIN:
+      return !std::ranges::search(value, pattern, equal).empty();
+    case SearchOperator::OPERATOR_STARTS_WITH:
+      return value.size() >= pattern.size() &&
+             std::ranges::equal(value.substr(0, pattern.size()), pattern, equal);
+    case SearchOperator::OPERATOR_ENDS_WITH:
+      return value.size() >= pattern.size() &&
+             std::ranges::equal(value.substr(value.size() - pattern.size()), pattern, equal);
+    default:
+      return std::ranges::equal(value, pattern, equal);
+  }
+}
+
+void SetBit(std::vector<uint64_t>& mask, size_t row)
+{
+  mask[row / 64] |= uint64_t{1} << (row % 64);
+}
+
+/*!
+ \brief Rank the values in the order of the comparison, equal values get equal ranks.
+ \param compare returns less than, equal to or greater than 0 as strcmp() does
+ */
+template<typename Compare>
+void RankValues(const std::vector<std::string_view>& values,
+                std::vector<double>& ranks,
+                const Compare& compare)
+{
+  std::vector<uint32_t> order(values.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::sort(order, [&values, &compare](uint32_t left, uint32_t right)
+                    { return compare(values[left], values[right]) < 0; });
+
+  ranks.resize(values.size());
+  double rank = 0;
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    if (i > 0 && compare(values[order[i - 1]], values[order[i]]) != 0)
+      rank++;
+    ranks[order[i]] = rank;
+  }
+}
+
+int Collate(std::string_view left, std::string_view right)
+{
+  return StringUtils::AlphaNumericCollation(static_cast<int>(left.size()), left.data(),
+                                            static_cast<int>(right.size()), right.data());
+}
+} // namespace
+
+void CVideoLibraryIndex::LinkColumn::Set(size_t row,
+                                         const std::vector<std::pair<int, std::string>>& links)
+{
+  std::vector<uint32_t>& rowCodes = rows[row];
+  rowCodes.clear();
+  for (const auto& [dbId, name] : links)
+  {
+    const auto [code, added] = codes.try_emplace(dbId, static_cast<uint32_t>(names.size()));
+    if (added)
+      names.emplace_back(name);
+    else
+      names[code->second] = name;
+    rowCodes.emplace_back(code->second);
+  }
+}
+
+CVideoLibraryIndex::CVideoLibraryIndex()
+{
+  if (const auto announcementManager = CServiceBroker::GetAnnouncementManager())
+    announcementManager->AddAnnouncer(this, ANNOUNCEMENT::VideoLibrary);
+}
+
+CVideoLibraryIndex::~CVideoLibraryIndex()
+{
+  if (const auto announcementManager = CServiceBroker::GetAnnouncementManager())
+    announcementManager->RemoveAnnouncer(this);
+}
+
+void CVideoLibraryIndex::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                                  const std::string& sender,
+                                  const std::string& message,
+                                  const CVariant& data)
+{
+  if (message == "OnScanFinished" || message == "OnCleanFinished" || message == "OnRefresh")
+  {
+    Clear();
+    return;
+  }
+
+  if (message != "OnUpdate" && message != "OnRemove")
+    return;
+
+  // Updates of items name the item, the others the type and id
+  const CVariant& item = data.isMember("item") ? data["item"] : data;
+  if (item["type"].asString() != MediaTypeMovie)
+    return;
+
+  std::unique_lock lock(m_cs);
+  if (m_loaded)
+    m_changed.insert(static_cast<int>(item["id"].asInteger()));
+}
+
+bool CVideoLibraryIndex::GetMovies(CVideoDatabase& db,
+                                   const CVideoDbUrl& videoUrl,
+                                   const SortDescription& sorting,
+                                   std::vector<int>& ids,
+                                   int& total)
+{
+  std::unique_lock lock(m_cs);
+
+  const std::string database = db.GetDatabaseName();
+  if (!m_loaded || database != m_database || m_changed.size() > MAX_CHANGED_MOVIES)
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<IndexedMovie> movies;
+    if (!db.GetIndexedMovies(movies))
+      return false;
+    SetMovies(movies);
+    m_database = database;
+
+    CLog::LogF(LOGDEBUG, "read {} movies in {} ms", movies.size(),
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count());
+  }
+
+  for (const int id : m_changed)
+  {
+    std::vector<IndexedMovie> movies;
+    if (!db.GetIndexedMovies(movies, id))
+      return false;
+    if (movies.empty())
+      RemoveMovie(id);
+    else
+      SetMovie(movies.front());
+  }
+  m_changed.clear();
+
+  return Select(videoUrl, sorting, ids, total);
+}
+
+void CVideoLibraryIndex::SetMovies(const std::vector<IndexedMovie>& movies)
+{
+  std::unique_lock lock(m_cs);
+
+  Clear();
+  Resize(movies.size());
+  for (size_t row = 0; row < movies.size(); row++)
+  {
+    Set(row, movies[row]);
+    m_rows[movies[row].id] = row;
+  }
+  m_loaded = true;
+}
+
+void CVideoLibraryIndex::SetMovie(const IndexedMovie& movie)
+{
+  std::unique_lock lock(m_cs);
+
+  const auto [it, added] = m_rows.try_emplace(movie.id, m_ids.size());
+  const size_t row = it->second;
+  if (added)
+    Resize(row + 1);
+
+  // Most changes are of the play count, which leaves the ranks as they are
+  if (added || m_titles[row] != movie.title || m_sortTitles[row] != movie.sortTitle ||
+      m_dateAdded[row] != movie.dateAdded)
+    m_ranked = false;
+
+  Set(row, movie);
+}
+
+void CVideoLibraryIndex::RemoveMovie(int id)
+{
+  std::unique_lock lock(m_cs);
+
+  const auto it = m_rows.find(id);
+  if (it == m_rows.end())
+    return;
+
+  // Move the last movie into the row, the ranks of the others stay in order
+  const size_t row = it->second;
+  const size_t last = m_ids.size() - 1;
+  m_rows.erase(it);
+  if (row != last)
+  {
+    m_rows[m_ids[last]] = row;
+    const auto move = [row, last](auto& column)
+    {
+      if (column.size() > last)
+        column[row] = std::move(column[last]);
+    };
+    move(m_ids);
+    move(m_titles);
+    move(m_sortTitles);
+    move(m_years);
+    move(m_ratings);
+    move(m_playCounts);
+    move(m_dateAdded);
+    move(m_genres.rows);
+    move(m_studios.rows);
+    move(m_tags.rows);
+    move(m_titleRanks);
+    move(m_titleRanksNoArticles);
+    move(m_sortTitleRanks);
+    move(m_sortTitleRanksNoArticles);
+    move(m_dateAddedRanks);
+  }
+  Resize(last);
+}
+
+void CVideoLibraryIndex::Clear()
+{
+  std::unique_lock lock(m_cs);
+
+  Resize(0);
+  m_rows.clear();
+  m_genres = {};
+  m_studios = {};
+  m_tags = {};
+  m_ranked = false;
+  m_loaded = false;
+  m_database.clear();
+  m_changed.clear();
+}
+
+bool CVideoLibraryIndex::Select(const CVideoDbUrl& videoUrl,
+                                const SortDescription& sorting,
+                                std::vector<int>& ids,
+                                int& total) const
+{
+  std::unique_lock lock(m_cs);
+
+  std::vector<SortKey> keys;
+  Node filter;
+  if (!GetSortKeys(sorting, keys) || !SetFilter(videoUrl, filter))
+    return false;
+
+  const Mask mask = Evaluate(filter);
+  std::vector<uint32_t> rows;
+  for (size_t word = 0; word < mask.size(); word++)
+  {
+    for (uint64_t bits = mask[word]; bits != 0; bits &= bits - 1)
+      rows.emplace_back(static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+  }
+  total = static_cast<int>(rows.size());
+
+  // The range of the sorted movies, as LIMIT gets it
+  size_t first = 0;
+  size_t end = rows.size();
+  if (sorting.limitStart > 0 || sorting.limitEnd > 0)
+  {
+    first = std::min(static_cast<size_t>(std::max(sorting.limitStart, 0)), rows.size());
+    if (sorting.limitEnd > 0)
+      end = std::clamp(static_cast<size_t>(sorting.limitEnd), first, rows.size());
+    else if (sorting.limitEnd == 0)
+      end = first;
+  }
+
+  // The id is the last key, so no two movies are equal and only the range has to be sorted
+  const bool descending = sorting.sortOrder == SortOrder::DESCENDING;
+  const auto less = [this, &keys, descending](uint32_t left, uint32_t right)
+  {
+    for (const SortKey& key : keys)
+    {
+      double leftValue = (*key.values)[left];
+      double rightValue = (*key.values)[right];
+      if (std::isnan(leftValue))
+        leftValue = key.null;
+      if (std::isnan(rightValue))
+        rightValue = key.null;
+      if (leftValue != rightValue)
+        return descending ? leftValue > rightValue : leftValue < rightValue;
+    }
+    return descending ? m_ids[left] > m_ids[right] : m_ids[left] < m_ids[right];
+  };
+  std::partial_sort(rows.begin(), rows.begin() + end, rows.end(), less);
+
+  ids.clear();
+  ids.reserve(end - first);
+  for (size_t i = first; i < end; i++)
+    ids.emplace_back(m_ids[rows[i]]);
+  return true;
+}
+
+bool CVideoLibraryIndex::SetFilter(const CVideoDbUrl& videoUrl, Node& filter) const
+{
+  if (videoUrl.GetType() != "movies")
+    return false;
+
+  const auto linkColumn = [this](std::string_view option) -> const LinkColumn*
+  {
+    if (option == "genre")
+      return &m_genres;
+    if (option == "studio")
+      return &m_studios;
+    if (option == "tag")
+      return &m_tags;
+    return nullptr;
+  };
+
+  for (const auto& [option, value] : videoUrl.GetOptions())
+  {
+    const std::string_view name = option;
+    const LinkColumn* column = linkColumn(name);
+    const LinkColumn* idColumn =
+        name.ends_with("id") ? linkColumn(name.substr(0, name.size() - 2)) : nullptr;
+    if (column)
+    {
+      if (!AddLinkCondition(*column, value.asString(), SearchOperator::OPERATOR_EQUALS, false,
+                            filter))
+        return false;
+    }
+    else if (idColumn)
+    {
+      const auto code = idColumn->codes.find(static_cast<int>(value.asInteger()));
+      const auto id = static_cast<uint32_t>(
+          code != idColumn->codes.end() ? code->second : idColumn->names.size());
+      filter.children.emplace_back().condition = [idColumn, id](size_t row)
+      { return std::ranges::find(idColumn->rows[row], id) != idColumn->rows[row].end(); };
+    }
+    else if (name == "year")
+    {
+      // As premiered LIKE '<year>%'
+      const double year = static_cast<double>(value.asInteger());
+      filter.children.emplace_back().condition = [this, year](size_t row)
+      { return m_years[row] == year; };
+    }
+    else if (name == "xsp" || name == "filter")
+    {
+      PLAYLIST::CSmartPlaylist playlist;
+      if (!playlist.LoadFromJson(value.asString()))
+        return false;
+
+      // Playlists of other types are ignored, unless they group the listing
+      if (playlist.GetType() == videoUrl.GetItemType())
+      {
+        if (!AddRules(playlist.GetRuleCombination(), filter.children.emplace_back()))
+          return false;
+      }
+      else if (name == "xsp" && playlist.GetGroup() == videoUrl.GetItemType())
+        return false;
+    }
+    else
+      return false;
+  }
+
+  return true;
+}
+
+bool CVideoLibraryIndex::AddRules(const CDatabaseQueryRuleCombination& rules, Node& node) const
+{
+  node.all = rules.GetType() == CDatabaseQueryRuleCombination::Type::COMBINATION_AND;
+  for (const auto& combination : rules.GetCombinations())
+  {
+    if (!AddRules(*combination, node.children.emplace_back()))
+      return false;
+  }
+  for (const auto& rule : rules.GetRules())
+  {
+    if (!AddRule(*rule, node))
+      return false;
+  }
+  return true;
+}
+
+bool CVideoLibraryIndex::AddRule(const CDatabaseQueryRule& rule, Node& node) const
+{
+  const auto field = static_cast<Field>(rule.m_field);
+  const SearchOperator op = rule.m_operator;
+
+  // Not part of the query, virtual folders are listed separately
+  if (field == Field::VIRTUAL_FOLDER)
+    return true;
+  if (rule.m_parameter.empty())
+    return false;
+
+  if (field == Field::GENRE || field == Field::STUDIO || field == Field::TAG)
+  {
+    const LinkColumn& column = field == Field::GENRE    ? m_genres
+                               : field == Field::STUDIO ? m_studios
+                                                        : m_tags;
+    if (op != SearchOperator::OPERATOR_EQUALS && op != SearchOperator::OPERATOR_DOES_NOT_EQUAL &&
+        op != SearchOperator::OPERATOR_CONTAINS &&
+        op != SearchOperator::OPERATOR_DOES_NOT_CONTAIN &&
+        op != SearchOperator::OPERATOR_STARTS_WITH && op != SearchOperator::OPERATOR_ENDS_WITH)
+      return false;
+
+    // The negated rules have to hold for all values, the others for any
+    const bool negate = op == SearchOperator::OPERATOR_DOES_NOT_EQUAL ||
+                        op == SearchOperator::OPERATOR_DOES_NOT_CONTAIN;
+    Node& values = node.children.emplace_back();
+    values.all = negate;
+    for (const std::string& parameter : rule.m_parameter)
+    {
+      if (!AddLinkCondition(column, parameter, op, negate, values))
+        return false;
+    }
+    return true;
+  }
+
+  if (field == Field::DATE_ADDED)
+  {
+    std::vector<std::string> parameters;
+    for (const std::string& parameter : rule.m_parameter)
+    {
+      if (op == SearchOperator::OPERATOR_IN_THE_LAST ||
+          op == SearchOperator::OPERATOR_NOT_IN_THE_LAST)
+      {
+        CDateTime date = CDateTime::GetCurrentDateTime();
+        CDateTimeSpan span;
+        span.SetFromPeriod(parameter);
+        date -= span;
+        parameters.emplace_back(date.GetAsDBDate());
+      }
+      else
+        parameters.emplace_back(parameter);
+    }
+
+    Node& values = node.children.emplace_back();
+    values.all = false;
+    if (op == SearchOperator::OPERATOR_BETWEEN)
+    {
+      if (parameters.size() != 2)
+        return false;
+      values.condition = [this, from = parameters[0], to = parameters[1]](size_t row)
+      { return m_dateAdded[row] && *m_dateAdded[row] >= from && *m_dateAdded[row] <= to; };
+      return true;
+    }
+
+    for (std::string& parameter : parameters)
+    {
+      auto& condition = values.children.emplace_back().condition;
+      if (op == SearchOperator::OPERATOR_AFTER || op == SearchOperator::OPERATOR_GREATER_THAN ||
+          op == SearchOperator::OPERATOR_IN_THE_LAST)
+        condition = [this, value = std::move(parameter)](size_t row)
+        { return m_dateAdded[row] && *m_dateAdded[row] > value; };
+      else if (op == SearchOperator::OPERATOR_BEFORE || op == SearchOperator::OPERATOR_LESS_THAN ||
+               op == SearchOperator::OPERATOR_NOT_IN_THE_LAST)
+        condition = [this, value = std::move(parameter)](size_t row)
+        { return !m_dateAdded[row] || *m_dateAdded[row] < value; };
+      else
+        return false;
+    }
+    return true;
+  }
+
+  const std::vector<double>* column = nullptr;
+  if (field == Field::YEAR)
+    column = &m_years;
+  else if (field == Field::RATING)
+    column = &m_ratings;
+  else if (field == Field::PLAYCOUNT)
+    column = &m_playCounts;
+  else
+    return false;
+
+  std::vector<double> parameters;
+  for (const std::string& parameter : rule.m_parameter)
+  {
+    const std::optional<double> number = ToParameter(parameter);
+    if (!number)
+      return false;
+    parameters.emplace_back(*number);
+  }
+
+  Node& values = node.children.emplace_back();
+  values.all = false;
+  if (op == SearchOperator::OPERATOR_BETWEEN)
+  {
+    if (parameters.size() != 2)
+      return false;
+    values.condition = [column, from = parameters[0], to = parameters[1]](size_t row)
+    { return (*column)[row] >= from && (*column)[row] <= to; };
+    return true;
+  }
+
+  for (size_t i = 0; i < parameters.size(); i++)
+  {
+    // Movies that were never played have no play count, which matches as 0 does
+    const std::string& parameter = rule.m_parameter[i];
+    const bool null =
+        field == Field::PLAYCOUNT &&
+        ((op == SearchOperator::OPERATOR_EQUALS && parameter == "0") ||
+         (op == SearchOperator::OPERATOR_DOES_NOT_EQUAL && parameter != "0") ||
+         op == SearchOperator::OPERATOR_LESS_THAN);
+
+    // Comparisons with NaN are false, as they are with NULL
+    auto& condition = values.children.emplace_back().condition;
+    const double value = parameters[i];
+    switch (op)
+    {
+      case SearchOperator::OPERATOR_EQUALS:
+        condition = [column, value, null](size_t row)
+        { return (*column)[row] == value || (null && std::isnan((*column)[row])); };
+        break;
+      case SearchOperator::OPERATOR_DOES_NOT_EQUAL:
+        condition = [column, value, null](size_t row)
+        { return std::isnan((*column)[row]) ? null : (*column)[row] != value; };
+        break;
+      case SearchOperator::OPERATOR_AFTER:
+      case SearchOperator::OPERATOR_GREATER_THAN:
+        condition = [column, value](size_t row) { return (*column)[row] > value; };
+        break;
+      case SearchOperator::OPERATOR_BEFORE:
+      case SearchOperator::OPERATOR_LESS_THAN:
+        condition = [column, value, null](size_t row)
+        { return (*column)[row] < value || (null && std::isnan((*column)[row])); };
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool CVideoLibraryIndex::AddLinkCondition(const LinkColumn& column,
+                                          const std::string& name,
+                                          CDatabaseQueryRule::SearchOperator op,
+                                          bool negate,
+                                          Node& node) const
+{
+  // Patterns are left to LIKE
+  if (name.find_first_of("%_") != std::string::npos)
+    return false;
+
+  // Match the names once, the movies by their codes
+  std::vector<bool> matches(column.names.size());
+  for (size_t code = 0; code < column.names.size(); code++)
+    matches[code] = Like(column.names[code], name, op);
+
+  node.children.emplace_back().condition =
+      [&column, matches = std::move(matches), negate](size_t row)
+  {
+    const bool found =
+        std::ranges::any_of(column.rows[row], [&matches](uint32_t code) { return matches[code]; });
+    return found != negate;
+  };
+  return true;
+}
+
+CVideoLibraryIndex::Mask CVideoLibraryIndex::Evaluate(const Node& node) const
+{
+  const size_t size = m_ids.size();
+  Mask mask((size + 63) / 64);
+
+  if (node.condition)
+  {
+    for (size_t row = 0; row < size; row++)
+    {
+      if (node.condition(row))
+        SetBit(mask, row);
+    }
+    return mask;
+  }
+
+  // Nothing to combine is no condition, as in the query
+  if (node.children.empty())
+  {
+    for (size_t row = 0; row < size; row++)
+      SetBit(mask, row);
+    return mask;
+  }
+
+  mask = Evaluate(node.children.front());
+  for (auto child = node.children.begin() + 1; child != node.children.end(); ++child)
+  {
+    const Mask other = Evaluate(*child);
+    for (size_t word = 0; word < mask.size(); word++)
+    {
+      if (node.all)
+        mask[word] &= other[word];
+      else
+        mask[word] |= other[word];
+    }
+  }
+  return mask;
+}
+
+bool CVideoLibraryIndex::GetSortKeys(const SortDescription& sorting,
+                                     std::vector<SortKey>& keys) const
+{
+  FieldList fields;
+  SortUtils::GetFieldsForSQLSort(MediaTypeMovie, sorting.sortBy, fields);
+  // Nothing but the id
+  if (fields.size() < 2)
+    return false;
+
+  // The keys of CVideoDatabase::GetOrderClause()
+  const bool ignoreArticles = sorting.sortAttributes & SortAttributeIgnoreArticle;
+  for (const Field field : fields)
+  {
+    if (field == Field::LABEL || field == Field::TITLE)
+      keys.emplace_back(ignoreArticles ? &m_titleRanksNoArticles : &m_titleRanks, 0.0);
+    else if (field == Field::SORT_TITLE)
+      keys.emplace_back(ignoreArticles ? &m_sortTitleRanksNoArticles : &m_sortTitleRanks, 0.0);
+    else if (field == Field::YEAR)
+      // NULL sorts first
+      keys.emplace_back(&m_years, -std::numeric_limits<double>::infinity());
+    else if (field == Field::DATE_ADDED)
+      keys.emplace_back(&m_dateAddedRanks, 0.0);
+    else if (field == Field::RATING)
+      keys.emplace_back(&m_ratings, 0.0);
+    else if (field == Field::PLAYCOUNT)
+      keys.emplace_back(&m_playCounts, 0.0);
+    else if (field != Field::ID)
+      return false;
+  }
+
+  Rank();
+  return true;
+}
+
+void CVideoLibraryIndex::Rank() const
+{
+  const CLangInfo::Tokens sortTokens = g_langInfo.GetSortTokens();
+  if (m_ranked && sortTokens == m_sortTokens)
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  const auto removeArticles = [&sortTokens](std::string_view value)
+  {
+    const auto match = std::ranges::find_if(
+        sortTokens, [value](const std::string& token)
+        { return StringUtils::StartsWithNoCase(value, token); });
+    if (match != sortTokens.end())
+      value.remove_prefix(match->size());
+    return value;
+  };
+
+  const size_t size = m_ids.size();
+  std::vector<std::string_view> values(size);
+
+  for (size_t row = 0; row < size; row++)
+    values[row] = m_titles[row];
+  RankValues(values, m_titleRanks, Collate);
+  std::ranges::transform(values, values.begin(), removeArticles);
+  RankValues(values, m_titleRanksNoArticles, Collate);
+
+  // The title when there's no sort title
+  for (size_t row = 0; row < size; row++)
+    values[row] = m_sortTitles[row].empty() ? m_titles[row] : m_sortTitles[row];
+  RankValues(values, m_sortTitleRanks, Collate);
+  std::ranges::transform(values, values.begin(), removeArticles);
+  RankValues(values, m_sortTitleRanksNoArticles, Collate);
+
+  // As IFNULL(dateAdded, '') in the binary order of SQLite
+  for (size_t row = 0; row < size; row++)
+    values[row] = m_dateAdded[row] ? std::string_view(*m_dateAdded[row]) : std::string_view();
+  RankValues(values, m_dateAddedRanks,
+             [](std::string_view left, std::string_view right) { return left.compare(right); });
+
+  m_sortTokens = sortTokens;
+  m_ranked = true;
+
+  CLog::LogF(LOGDEBUG, "ranked {} movies in {} ms", size,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+}
+
+void CVideoLibraryIndex::Resize(size_t rows)
+{
+  m_ids.resize(rows);
+  m_titles.resize(rows);
+  m_sortTitles.resize(rows);
+  m_years.resize(rows);
+  m_ratings.resize(rows);
+  m_playCounts.resize(rows);
+  m_dateAdded.resize(rows);
+  m_genres.rows.resize(rows);
+  m_studios.rows.resize(rows);
+  m_tags.rows.resize(rows);
+
+  // Rows are only removed without invalidating the ranks
+  if (m_ranked)
+  {
+    m_titleRanks.resize(rows);
+    m_titleRanksNoArticles.resize(rows);
+    m_sortTitleRanks.resize(rows);
+    m_sortTitleRanksNoArticles.resize(rows);
+    m_dateAddedRanks.resize(rows);
+  }
+}
+
+void CVideoLibraryIndex::Set(size_t row, const IndexedMovie& movie)
+{
+  m_ids[row] = movie.id;
+  m_titles[row] = movie.title;
+  m_sortTitles[row] = movie.sortTitle;
+  m_years[row] = movie.premiered ? ToNumber(*movie.premiered) : NULL_VALUE;
+  m_ratings[row] = movie.rating.value_or(NULL_VALUE);
+  m_playCounts[row] = movie.playCount ? *movie.playCount : NULL_VALUE;
+  m_dateAdded[row] = movie.dateAdded;
+  m_genres.Set(row, movie.genres);
+  m_studios.Set(row, movie.studios);
+  m_tags.Set(row, movie.tags);
+}
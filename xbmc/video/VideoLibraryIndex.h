@@ -0,0 +1,189 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "dbwrappers/DatabaseQuery.h"
+#include "interfaces/IAnnouncer.h"
+#include "threads/CriticalSection.h"
+#include "utils/SortUtils.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CVideoDatabase;
+class CVideoDbUrl;
+
+namespace KODI::VIDEO
+{
+//! The values of a movie that the library index keeps, as read from movie_view
+struct IndexedMovie
+{
+  int id{-1};
+  std::string title;
+  std::string sortTitle;
+  std::optional<std::string> premiered;
+  std::optional<double> rating;
+  std::optional<int> playCount;
+  std::optional<std::string> dateAdded;
+  //! Database id and name of each linked genre, studio and tag
+  std::vector<std::pair<int, std::string>> genres;
+  std::vector<std::pair<int, std::string>> studios;
+  std::vector<std::pair<int, std::string>> tags;
+};
+
+/*!
+ \brief Index of the movies of the video library, held in memory to filter, sort and limit movie
+ listings without querying the database for each of them.
+
+ The values are kept in columns, one vector per field. Genres, studios and tags are dictionary
+ encoded, so a rule on them is resolved against the few names of the dictionary once and then
+ tests small integer codes per movie. The orders of the titles and dates are kept as ranks, built
+ once and compared as numbers.
+
+ Listings are answered as CVideoDatabase::GetMoviesByWhere() would answer them from SQL. Filters
+ the index can't answer exactly, e.g. on actors or with LIKE wildcards, are left to the database.
+
+ The index is read from the database on first use and kept up to date through the announcements
+ of the video library: changed movies are read again on the next listing, and a scan, clean or
+ refresh of the library reads the whole index again.
+ */
+class CVideoLibraryIndex : public ANNOUNCEMENT::IAnnouncer
+{
+public:
+  CVideoLibraryIndex();
+  ~CVideoLibraryIndex() override;
+  CVideoLibraryIndex(const CVideoLibraryIndex&) = delete;
+  CVideoLibraryIndex& operator=(const CVideoLibraryIndex&) = delete;
+
+  void Announce(ANNOUNCEMENT::AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override;
+
+  /*!
+   \brief Get the movies of a listing, reading the index from the database first if needed.
+   \param db the open database the listing is for
+   \param videoUrl the listing, with the options that filter it
+   \param sorting how to sort the listing and the range of movies to get
+   \param[out] ids the ids of the movies in the range, in the order of the listing
+   \param[out] total the number of movies in all ranges
+   \return false if the index can't answer the listing, so the database has to
+   */
+  bool GetMovies(CVideoDatabase& db,
+                 const CVideoDbUrl& videoUrl,
+                 const SortDescription& sorting,
+                 std::vector<int>& ids,
+                 int& total);
+
+  //! Replace all movies of the index
+  void SetMovies(const std::vector<IndexedMovie>& movies);
+
+  //! Add a movie, or replace the one with the same id
+  void SetMovie(const IndexedMovie& movie);
+
+  void RemoveMovie(int id);
+
+  //! Drop all movies, to read them again on the next listing
+  void Clear();
+
+  /*!
+   \brief Get the movies of a listing from the index as it is.
+   \sa GetMovies()
+   */
+  bool Select(const CVideoDbUrl& videoUrl,
+              const SortDescription& sorting,
+              std::vector<int>& ids,
+              int& total) const;
+
+private:
+  //! The names of the genres, studios or tags, and the codes of each movie
+  struct LinkColumn
+  {
+    std::vector<std::string> names;
+    //! The code of each database id
+    std::unordered_map<int, uint32_t> codes;
+    std::vector<std::vector<uint32_t>> rows;
+
+    void Set(size_t row, const std::vector<std::pair<int, std::string>>& links);
+  };
+
+  //! One bit per movie
+  using Mask = std::vector<uint64_t>;
+
+  //! A filter of the listing, either a condition on each movie or a combination of filters
+  struct Node
+  {
+    bool all{true};
+    std::vector<Node> children;
+    std::function<bool(size_t row)> condition;
+  };
+
+  bool SetFilter(const CVideoDbUrl& videoUrl, Node& filter) const;
+  bool AddRules(const CDatabaseQueryRuleCombination& rules, Node& node) const;
+  bool AddRule(const CDatabaseQueryRule& rule, Node& node) const;
+  bool AddLinkCondition(const LinkColumn& column,
+                        const std::string& name,
+                        CDatabaseQueryRule::SearchOperator op,
+                        bool negate,
+                        Node& node) const;
+  Mask Evaluate(const Node& node) const;
+
+  //! A column to sort by, with the value NULL sorts as
+  struct SortKey
+  {
+    const std::vector<double>* values;
+    double null;
+  };
+
+  bool GetSortKeys(const SortDescription& sorting, std::vector<SortKey>& keys) const;
+
+  //! Build the ranks of the titles and dates if a change has invalidated them. m_cs must be held.
+  void Rank() const;
+
+  void Resize(size_t rows);
+  void Set(size_t row, const IndexedMovie& movie);
+
+  std::vector<int> m_ids;
+  std::vector<std::string> m_titles;
+  std::vector<std::string> m_sortTitles;
+  //! NaN if the field is NULL
+  std::vector<double> m_years;
+  std::vector<double> m_ratings;
+  std::vector<double> m_playCounts;
+  std::vector<std::optional<std::string>> m_dateAdded;
+  LinkColumn m_genres;
+  LinkColumn m_studios;
+  LinkColumn m_tags;
+  std::unordered_map<int, size_t> m_rows;
+
+  //! The order of the title, the title without articles, the sort title and the date added of
+  //! each movie, equal values have equal ranks
+  mutable std::vector<double> m_titleRanks;
+  mutable std::vector<double> m_titleRanksNoArticles;
+  mutable std::vector<double> m_sortTitleRanks;
+  mutable std::vector<double> m_sortTitleRanksNoArticles;
+  mutable std::vector<double> m_dateAddedRanks;
+  mutable std::set<std::string, std::less<>> m_sortTokens;
+  mutable bool m_ranked{false};
+
+  //! Whether the movies have been read from the database, and from which
+  bool m_loaded{false};
+  std::string m_database;
+  //! The movies changed since, to read again
+  std::set<int> m_changed;
+
+  mutable CCriticalSection m_cs;
+};
+} // namespace KODI::VIDEO
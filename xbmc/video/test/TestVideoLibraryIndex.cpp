@@ -0,0 +1,184 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "URL.h"
+#include "utils/SortUtils.h"
+#include "video/VideoDbUrl.h"
+#include "video/VideoLibraryIndex.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace KODI::VIDEO;
+
+namespace
+{
+IndexedMovie Movie(int id,
+                   const std::string& title,
+                   int year,
+                   double rating,
+                   std::vector<std::pair<int, std::string>> genres)
+{
+  IndexedMovie movie;
+  movie.id = id;
+  movie.title = title;
+  movie.premiered = std::to_string(year) + "-01-01";
+  movie.rating = rating;
+  movie.dateAdded = std::to_string(2000 + id) + "-01-01 00:00:00";
+  movie.genres = std::move(genres);
+  return movie;
+}
+
+SortDescription Sorting(SortBy sortBy, SortOrder sortOrder = SortOrder::ASCENDING)
+{
+  SortDescription sorting;
+  sorting.sortBy = sortBy;
+  sorting.sortOrder = sortOrder;
+  return sorting;
+}
+
+class TestVideoLibraryIndex : public testing::Test
+{
+protected:
+  TestVideoLibraryIndex()
+  {
+    m_index.SetMovies({
+        Movie(1, "Casablanca", 1942, 8.5, {{1, "Drama"}, {2, "Romance"}}),
+        Movie(2, "Alien", 1979, 8.4, {{3, "Horror"}, {4, "Science Fiction"}}),
+        Movie(3, "Brazil", 1985, 7.9, {{1, "Drama"}, {4, "Science Fiction"}}),
+        Movie(4, "Dune", 2021, 8.0, {{4, "Science Fiction"}}),
+        Movie(5, "Eraserhead", 1977, 7.3, {}),
+    });
+  }
+
+  std::vector<int> Select(const std::string& url, const SortDescription& sorting, int& total)
+  {
+    CVideoDbUrl videoUrl;
+    EXPECT_TRUE(videoUrl.FromString(url));
+    std::vector<int> ids;
+    EXPECT_TRUE(m_index.Select(videoUrl, sorting, ids, total));
+    return ids;
+  }
+
+  CVideoLibraryIndex m_index;
+};
+} // namespace
+
+TEST_F(TestVideoLibraryIndex, Sort)
+{
+  int total = 0;
+  EXPECT_EQ(Select("videodb://movies/titles/", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{2, 3, 1, 4, 5}));
+  EXPECT_EQ(total, 5);
+
+  EXPECT_EQ(Select("videodb://movies/titles/", Sorting(SortBy::YEAR, SortOrder::DESCENDING), total),
+            (std::vector<int>{4, 3, 2, 5, 1}));
+  EXPECT_EQ(Select("videodb://movies/titles/", Sorting(SortBy::RATING), total),
+            (std::vector<int>{5, 3, 4, 2, 1}));
+}
+
+TEST_F(TestVideoLibraryIndex, Limit)
+{
+  SortDescription sorting = Sorting(SortBy::TITLE);
+  sorting.limitStart = 1;
+  sorting.limitEnd = 3;
+
+  int total = 0;
+  EXPECT_EQ(Select("videodb://movies/titles/", sorting, total), (std::vector<int>{3, 1}));
+  EXPECT_EQ(total, 5);
+}
+
+TEST_F(TestVideoLibraryIndex, Options)
+{
+  int total = 0;
+  EXPECT_EQ(Select("videodb://movies/titles/?genre=Drama", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{3, 1}));
+  EXPECT_EQ(total, 2);
+
+  EXPECT_EQ(Select("videodb://movies/titles/?genreid=4", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{2, 3, 4}));
+  EXPECT_EQ(Select("videodb://movies/titles/?year=1977", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{5}));
+  EXPECT_TRUE(Select("videodb://movies/titles/?genre=Western", Sorting(SortBy::TITLE), total)
+                  .empty());
+  EXPECT_EQ(total, 0);
+}
+
+TEST_F(TestVideoLibraryIndex, Rules)
+{
+  const std::string xsp = R"({"type":"movies","rules":{"and":[)"
+                          R"({"field":"genre","operator":"isnot","value":["Drama"]},)"
+                          R"({"field":"year","operator":"greaterthan","value":"1978"}]}})";
+  const std::string url = "videodb://movies/titles/?xsp=" + CURL::Encode(xsp);
+
+  int total = 0;
+  EXPECT_EQ(Select(url, Sorting(SortBy::TITLE), total), (std::vector<int>{2, 4}));
+}
+
+TEST_F(TestVideoLibraryIndex, Unsupported)
+{
+  CVideoDbUrl videoUrl;
+  ASSERT_TRUE(videoUrl.FromString("videodb://movies/titles/?actor=Someone"));
+
+  std::vector<int> ids;
+  int total = 0;
+  EXPECT_FALSE(m_index.Select(videoUrl, Sorting(SortBy::TITLE), ids, total));
+
+  ASSERT_TRUE(videoUrl.FromString("videodb://movies/titles/"));
+  EXPECT_FALSE(m_index.Select(videoUrl, Sorting(SortBy::COUNTRY), ids, total));
+}
+
+TEST_F(TestVideoLibraryIndex, Update)
+{
+  m_index.SetMovie(Movie(6, "Akira", 1988, 8.0, {{5, "Animation"}}));
+  m_index.SetMovie(Movie(4, "Zodiac", 2007, 7.7, {{1, "Drama"}}));
+  m_index.RemoveMovie(2);
+
+  int total = 0;
+  EXPECT_EQ(Select("videodb://movies/titles/", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{6, 3, 1, 5, 4}));
+  EXPECT_EQ(Select("videodb://movies/titles/?genre=Drama", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{3, 1, 4}));
+  EXPECT_EQ(Select("videodb://movies/titles/?genre=Animation", Sorting(SortBy::TITLE), total),
+            (std::vector<int>{6}));
+}
+
+TEST_F(TestVideoLibraryIndex, DISABLED_Benchmark)
+{
+  std::vector<IndexedMovie> movies;
+  for (int id = 1; id <= 100000; id++)
+  {
+    movies.emplace_back(Movie(id, "Movie " + std::to_string(id * 7919 % 100003), 1900 + id % 120,
+                              (id % 100) / 10.0, {{id % 30, "Genre " + std::to_string(id % 30)}}));
+  }
+  m_index.SetMovies(movies);
+
+  SortDescription sorting = Sorting(SortBy::TITLE);
+  sorting.limitEnd = 50;
+
+  // The first listing ranks the titles
+  auto start = std::chrono::steady_clock::now();
+  int total = 0;
+  Select("videodb://movies/titles/?genre=Genre%207", sorting, total);
+  auto duration = std::chrono::steady_clock::now() - start;
+  std::cout << "First listing: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << " ms"
+            << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 100; i++)
+    Select("videodb://movies/titles/?genre=Genre%207", sorting, total);
+  duration = std::chrono::steady_clock::now() - start;
+  std::cout << "100 listings of " << total << " of 100000 movies: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << " ms"
+            << std::endl;
+}
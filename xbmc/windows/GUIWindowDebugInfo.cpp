@@ -170,6 +170,8 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
             "Focused: {} ({})", control->GetID(),
             CGUIControlFactory::TranslateControlType(control->GetControlType()));
     }
+    const auto [updates, conditions] = CServiceBroker::GetGUI()->GetInfoManager().GetBoolUpdates();
+    info += StringUtils::Format("\nConditions: {} updated of {}", updates, conditions);
   }
 
   float w, h;